@@ -0,0 +1,444 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::CfgTransactions class.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "comms/comms.h"
+
+#include "MsgId.h"
+#include "MsgFactory.h"
+#include "details/FrameWriter.h"
+#include "message/AckAck.h"
+#include "message/AckNak.h"
+
+namespace ublox
+{
+
+/// @brief Pipelined sender of the configuration (CFG-*) messages.
+/// @details The receiver processes the configuration messages in the
+///     order of their arrival and replies to every one of them with
+///     ACK-ACK or ACK-NAK, which reports the class and ID of the acknowledged
+///     message. Instead of waiting for the reply before sending the next
+///     request, up to @b window requests are kept in flight, i.e. the
+///     transmit direction of the link stays busy while the replies are
+///     received. The reply doesn't identify the request beyond its class and
+///     ID, therefore only one request with the same ID is kept in flight,
+///     the following ones stay queued until it completes (while the requests
+///     with other IDs may be sent in the meantime). The reply completes the
+///     request in flight with the same ID. The request is retransmitted when
+///     its reply doesn't arrive in time, and completed with
+///     @ref Status_TimedOut when all the retries are exhausted.@n
+///     The object doesn't perform any I/O nor has its own thread, the
+///     serialised frames are passed to the provided send handler, the
+///     acknowledgements are passed in by the handle() member functions
+///     (suitable for message dispatch), and the timeouts are checked by
+///     @ref tick(), which is expected to be called periodically.
+///     The completion handlers may submit new requests. Note that the
+///     retransmitted request is processed by the receiver after the ones
+///     sent in the meantime, use window of @b 1 when the order of the
+///     configuration changes matters.
+/// @code
+/// ublox::CfgTransactions transactions(
+///     [&engine, dev](const std::uint8_t* data, std::size_t len)
+///     {
+///         return engine.send(dev, data, len);
+///     });
+/// transactions.submit(cfgRateMsg,
+///     [](ublox::CfgTransactions::Status status)
+///     {
+///         ...
+///     });
+/// ...
+/// msg->dispatch(transactions); // for every received message
+/// ...
+/// transactions.tick(); // periodically
+/// @endcode
+class CfgTransactions
+{
+public:
+    /// @brief Clock used to measure the timeouts.
+    typedef std::chrono::steady_clock Clock;
+
+    /// @brief Point in time.
+    typedef Clock::time_point TimePoint;
+
+    /// @brief Duration.
+    typedef Clock::duration Duration;
+
+    /// @brief Completion status of the request.
+    enum Status
+    {
+        Status_Acked, ///< ACK-ACK was received
+        Status_Nacked, ///< ACK-NAK was received
+        Status_TimedOut, ///< No reply after all the retries
+        Status_SendFailed, ///< Send handler reported failure
+        Status_Cancelled, ///< Cancelled by @ref cancelAll()
+        Status_NumOfValues ///< number of available values
+    };
+
+    /// @brief Type of the send handler.
+    /// @details Receives the complete frame, expected to return @b true
+    ///     when it was sent (or queued for sending). The handler may
+    ///     submit, acknowledge or cancel the requests.
+    typedef std::function<bool (const std::uint8_t*, std::size_t)> SendHandler;
+
+    /// @brief Type of the completion handler.
+    typedef std::function<void (Status)> CompletionHandler;
+
+    /// @brief Default maximal number of requests in flight.
+    static const std::size_t DefaultWindow = 8U;
+
+    /// @brief Default number of retransmissions.
+    static const unsigned DefaultRetries = 2U;
+
+    /// @brief Default timeout of the single attempt, in milliseconds.
+    static const unsigned DefaultTimeoutMs = 1000U;
+
+    /// @brief Constructor
+    /// @param[in] sendHandler Handler sending the frames.
+    /// @param[in] window Maximal number of requests in flight, @b 1 makes
+    ///     the exchange fully sequential.
+    /// @param[in] timeout Time to wait for the reply before retransmission.
+    /// @param[in] retries Number of retransmissions.
+    explicit CfgTransactions(
+        SendHandler sendHandler,
+        std::size_t window = DefaultWindow,
+        Duration timeout = std::chrono::milliseconds(static_cast<unsigned>(DefaultTimeoutMs)),
+        unsigned retries = DefaultRetries)
+      : m_sendHandler(std::move(sendHandler)),
+        m_window(window == 0U ? 1U : window),
+        m_timeout(timeout),
+        m_retries(retries)
+    {
+    }
+
+    /// @brief Submit the configuration message.
+    /// @details The message is serialised immediately and sent as soon as
+    ///     the number of requests in flight allows it.
+    /// @param[in] msg Message object of CFG class.
+    /// @param[in] handler Completion handler, may be empty.
+    /// @param[in] now Current time.
+    /// @return true if the request was accepted, false if serialisation
+    ///     of the message failed.
+    template <typename TMsg>
+    bool submit(
+        const TMsg& msg,
+        CompletionHandler handler = CompletionHandler(),
+        TimePoint now = Clock::now())
+    {
+        static const MsgId Id = details::StaticMsgIdRetriever<TMsg>::Value;
+        static_assert(details::msgClassOf(Id) == details::msgClassOf(MsgId_CFG_PRT),
+            "The message is expected to belong to CFG class");
+
+        std::vector<std::uint8_t> payload;
+        if (!details::writePayload(msg, payload)) {
+            return false;
+        }
+
+        return submitPayload(Id, payload.data(), payload.size(), std::move(handler), now);
+    }
+
+    /// @brief Submit already serialised payload of the configuration message.
+    /// @param[in] id ID of the message, expected to belong to CFG class.
+    /// @param[in] payload Pointer to the payload.
+    /// @param[in] len Length of the payload.
+    /// @param[in] handler Completion handler, may be empty.
+    /// @param[in] now Current time.
+    /// @return true if the request was accepted, false if the message
+    ///     doesn't belong to CFG class or the payload is too long.
+    bool submitPayload(
+        MsgId id,
+        const std::uint8_t* payload,
+        std::size_t len,
+        CompletionHandler handler = CompletionHandler(),
+        TimePoint now = Clock::now())
+    {
+        if (details::msgClassOf(id) != details::msgClassOf(MsgId_CFG_PRT)) {
+            return false;
+        }
+
+        Request req;
+        if (!details::writeFrame(id, payload, len, req.frame)) {
+            return false;
+        }
+
+        req.id = id;
+        req.seq = m_nextSeq++;
+        req.handler = std::move(handler);
+        m_queued.push_back(std::move(req));
+        fill(now);
+        return true;
+    }
+
+    /// @brief Handle ACK-ACK message.
+    template <typename TMsgBase>
+    void handle(const message::AckAck<TMsgBase>& msg)
+    {
+        acknowledge(std::get<0>(msg.fields()).value(), true);
+    }
+
+    /// @brief Handle ACK-NAK message.
+    template <typename TMsgBase>
+    void handle(const message::AckNak<TMsgBase>& msg)
+    {
+        acknowledge(std::get<0>(msg.fields()).value(), false);
+    }
+
+    /// @brief Ignore all other messages.
+    template <typename TMsg>
+    void handle(const TMsg&)
+    {
+    }
+
+    /// @brief Report acknowledgement of the message.
+    /// @param[in] id ID of the acknowledged message.
+    /// @param[in] acked @b true for ACK-ACK, @b false for ACK-NAK.
+    /// @param[in] now Current time.
+    /// @return true if the request in flight was completed, false if
+    ///     there is no such request.
+    bool acknowledge(MsgId id, bool acked, TimePoint now = Clock::now())
+    {
+        for (auto iter = m_inFlight.begin(); iter != m_inFlight.end(); ++iter) {
+            if (iter->id != id) {
+                continue;
+            }
+
+            auto req = std::move(*iter);
+            m_inFlight.erase(iter);
+            fill(now);
+            complete(req, acked ? Status_Acked : Status_Nacked);
+            return true;
+        }
+
+        ++m_unmatched;
+        return false;
+    }
+
+    /// @brief Check the timeouts of the requests in flight.
+    /// @details Retransmits the requests whose reply hasn't arrived in time,
+    ///     and completes the ones with exhausted retries.
+    /// @param[in] now Current time.
+    void tick(TimePoint now = Clock::now())
+    {
+        std::size_t idx = 0U;
+        while (idx < m_inFlight.size()) {
+            auto& req = m_inFlight[idx];
+            if (now < req.deadline) {
+                ++idx;
+                continue;
+            }
+
+            if (m_retries < req.attempts) {
+                completeInFlight(idx, Status_TimedOut);
+                continue;
+            }
+
+            ++m_retransmissions;
+            auto pos = idx;
+            bool sent = transmit(pos, now);
+            if (m_inFlight.size() <= pos) {
+                // Completed by the send handler, the requests following it
+                // (if shifted) are checked by the next tick.
+                continue;
+            }
+
+            if (sent) {
+                idx = pos + 1U;
+                continue;
+            }
+
+            completeInFlight(pos, Status_SendFailed);
+            idx = pos;
+        }
+
+        fill(now);
+    }
+
+    /// @brief Complete all the pending requests with @ref Status_Cancelled.
+    void cancelAll()
+    {
+        std::deque<Request> requests;
+        requests.swap(m_inFlight);
+        requests.insert(
+            requests.end(),
+            std::make_move_iterator(m_queued.begin()),
+            std::make_move_iterator(m_queued.end()));
+        m_queued.clear();
+        for (auto& req : requests) {
+            complete(req, Status_Cancelled);
+        }
+    }
+
+    /// @brief Time of the earliest timeout of the requests in flight.
+    /// @details Can be used to limit the waiting for the I/O events.
+    /// @return TimePoint::max() if there are no requests in flight.
+    TimePoint nextDeadline() const
+    {
+        auto result = TimePoint::max();
+        for (auto& req : m_inFlight) {
+            if (req.deadline < result) {
+                result = req.deadline;
+            }
+        }
+        return result;
+    }
+
+    /// @brief Number of requests waiting for the reply.
+    std::size_t inFlightCount() const
+    {
+        return m_inFlight.size();
+    }
+
+    /// @brief Number of requests waiting to be sent.
+    std::size_t queuedCount() const
+    {
+        return m_queued.size();
+    }
+
+    /// @brief Check whether all the requests have been completed.
+    bool idle() const
+    {
+        return m_inFlight.empty() && m_queued.empty();
+    }
+
+    /// @brief Total number of retransmissions.
+    std::size_t retransmissionCount() const
+    {
+        return m_retransmissions;
+    }
+
+    /// @brief Total number of acknowledgements not matching any request
+    ///     in flight.
+    std::size_t unmatchedCount() const
+    {
+        return m_unmatched;
+    }
+
+private:
+    struct Request
+    {
+        MsgId id = MsgId_CFG_PRT;
+        std::size_t seq = 0U;
+        std::vector<std::uint8_t> frame;
+        CompletionHandler handler;
+        TimePoint deadline;
+        unsigned attempts = 0U;
+    };
+
+    /// Sends the request in flight at @b idx. The send handler may modify
+    /// the requests in flight, the frame is sent from the copy and the
+    /// @b idx is updated to the position of the request after the send,
+    /// or to m_inFlight.size() if it doesn't exist any more.
+    bool transmit(std::size_t& idx, TimePoint now)
+    {
+        auto& req = m_inFlight[idx];
+        ++req.attempts;
+        req.deadline = now + m_timeout;
+        auto seq = req.seq;
+        auto frame = req.frame;
+        bool sent = m_sendHandler && m_sendHandler(frame.data(), frame.size());
+
+        auto iter =
+            std::find_if(
+                m_inFlight.begin(), m_inFlight.end(),
+                [seq](const Request& r)
+                {
+                    return r.seq == seq;
+                });
+        idx = static_cast<std::size_t>(std::distance(m_inFlight.begin(), iter));
+        return sent;
+    }
+
+    bool isInFlight(MsgId id) const
+    {
+        return
+            std::any_of(
+                m_inFlight.begin(), m_inFlight.end(),
+                [id](const Request& r)
+                {
+                    return r.id == id;
+                });
+    }
+
+    void fill(TimePoint now)
+    {
+        while (m_inFlight.size() < m_window) {
+            auto iter =
+                std::find_if(
+                    m_queued.begin(), m_queued.end(),
+                    [this](const Request& r)
+                    {
+                        return !isInFlight(r.id);
+                    });
+
+            if (iter == m_queued.end()) {
+                break;
+            }
+
+            m_inFlight.push_back(std::move(*iter));
+            m_queued.erase(iter);
+
+            auto pos = m_inFlight.size() - 1U;
+            if (transmit(pos, now) || (m_inFlight.size() <= pos)) {
+                continue;
+            }
+
+            completeInFlight(pos, Status_SendFailed);
+        }
+    }
+
+    void completeInFlight(std::size_t idx, Status status)
+    {
+        auto req = std::move(m_inFlight[idx]);
+        m_inFlight.erase(m_inFlight.begin() + static_cast<std::ptrdiff_t>(idx));
+        complete(req, status);
+    }
+
+    static void complete(Request& req, Status status)
+    {
+        if (req.handler) {
+            req.handler(status);
+        }
+    }
+
+    SendHandler m_sendHandler;
+    std::deque<Request> m_queued;
+    std::deque<Request> m_inFlight;
+    std::size_t m_window = DefaultWindow;
+    Duration m_timeout;
+    unsigned m_retries = DefaultRetries;
+    std::size_t m_retransmissions = 0U;
+    std::size_t m_unmatched = 0U;
+    std::size_t m_nextSeq = 0U;
+};
+
+}  // namespace ublox
+
+
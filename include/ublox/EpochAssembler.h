@@ -0,0 +1,341 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::EpochAssembler class.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "field/common.h"
+
+namespace ublox
+{
+
+namespace details
+{
+
+/// @brief Index of the type among the ones bundled in std::tuple,
+///     size of the tuple if not found.
+template <typename T, typename TTuple>
+struct TupleIndexOf;
+
+template <typename T>
+struct TupleIndexOf<T, std::tuple<> >
+{
+    static const std::size_t Value = 0U;
+};
+
+template <typename T, typename TFirst, typename... TRest>
+struct TupleIndexOf<T, std::tuple<TFirst, TRest...> >
+{
+    static const std::size_t Value =
+        std::is_same<T, TFirst>::value ? 0U :
+        (1U + TupleIndexOf<T, std::tuple<TRest...> >::Value);
+};
+
+/// @brief Check whether all the messages bundled in std::tuple have
+///     field::common::iTOW as their first field.
+template <typename TMessages>
+struct AllHaveLeadingItow;
+
+template <>
+struct AllHaveLeadingItow<std::tuple<> > : public std::true_type
+{
+};
+
+template <typename TFirst, typename... TRest>
+struct AllHaveLeadingItow<std::tuple<TFirst, TRest...> > : public
+    std::integral_constant<
+        bool,
+        std::is_same<
+            typename std::tuple_element<0, typename TFirst::AllFields>::type,
+            field::common::iTOW
+        >::value &&
+        AllHaveLeadingItow<std::tuple<TRest...> >::value
+    >
+{
+};
+
+}  // namespace details
+
+/// @brief Assembler of the navigation epochs.
+/// @details The receiver reports the navigation solution of the single
+///     epoch in multiple messages (NAV-PVT, NAV-SOL, NAV-SVINFO, etc...)
+///     sharing the same @b iTOW value. The assembler collects the
+///     configured set of messages into the epoch record, and reports the
+///     record when all the expected messages have been received, or when
+///     the message with different @b iTOW arrives, whichever happens
+///     first. The message arriving after its epoch has been reported
+///     (with the same @b iTOW as the last reported epoch) is dropped and
+///     counted by lateCount(), i.e. it doesn't open a new epoch. The
+///     record (see @ref Epoch) is allocated once as part of the
+///     assembler object and contains the copies of the received messages.
+///     It is reused for every epoch, i.e. no dynamic memory allocation is
+///     performed per epoch as long as the messages don't contain list
+///     fields with dynamic storage (see option::FixedListStorage).@n
+///     The assembler is expected to be used as (or invoked from) the
+///     handler of the messages dispatched after being read by the
+///     @ref Stack:
+/// @code
+/// typedef std::tuple<
+///     ublox::message::NavPvt<MyMessage>,
+///     ublox::message::NavSol<MyMessage>,
+///     ublox::message::NavDop<MyMessage>
+/// > EpochMessages;
+/// typedef ublox::EpochAssembler<EpochMessages> Assembler;
+///
+/// Assembler assembler;
+/// assembler.setEpochHandler(
+///     [](const Assembler::Epoch& epoch)
+///     {
+///         if (epoch.has<ublox::message::NavPvt<MyMessage> >()) {
+///             auto& pvt = epoch.get<ublox::message::NavPvt<MyMessage> >();
+///             ...
+///         }
+///     });
+/// ...
+/// msg->dispatch(assembler); // or assembler.handle(*msg) with actual type
+/// @endcode
+/// @tparam TMessages Types of the collected messages bundled in std::tuple.
+///     All of them are expected to have @b iTOW (field::common::iTOW) as
+///     their first field.
+template <typename TMessages>
+class EpochAssembler
+{
+public:
+    /// @brief Types of the collected messages bundled in std::tuple.
+    typedef TMessages Messages;
+
+    /// @brief Number of collected message types.
+    static const std::size_t NumOfMessages = std::tuple_size<Messages>::value;
+
+    static_assert(0U < NumOfMessages, "At least one message is expected");
+    static_assert(NumOfMessages <= 32U, "Too many messages");
+    static_assert(details::AllHaveLeadingItow<Messages>::value,
+        "All the messages are expected to have iTOW as their first field");
+
+    /// @brief Record of the single navigation epoch.
+    class Epoch
+    {
+    public:
+        /// @brief Time of week of the epoch in milliseconds.
+        std::uint32_t iTOW() const
+        {
+            return m_iTOW;
+        }
+
+        /// @brief Check whether the message was received in the epoch.
+        template <typename TMsg>
+        bool has() const
+        {
+            return (m_present & bitOf<TMsg>()) != 0U;
+        }
+
+        /// @brief Get the message received in the epoch.
+        /// @pre @ref has() returns true for the same message type.
+        template <typename TMsg>
+        const TMsg& get() const
+        {
+            return std::get<indexOf<TMsg>()>(m_messages);
+        }
+
+        /// @brief Number of messages received in the epoch.
+        std::size_t size() const
+        {
+            std::size_t count = 0U;
+            for (auto mask = m_present; mask != 0U; mask &= (mask - 1U)) {
+                ++count;
+            }
+            return count;
+        }
+
+        /// @brief Check whether no message was received in the epoch.
+        bool empty() const
+        {
+            return m_present == 0U;
+        }
+
+        /// @brief Check whether all the expected messages were received.
+        bool complete() const
+        {
+            return (m_present & m_expected) == m_expected;
+        }
+
+    private:
+        friend class EpochAssembler<TMessages>;
+
+        Messages m_messages;
+        std::uint32_t m_iTOW = 0U;
+        std::uint32_t m_present = 0U;
+        std::uint32_t m_expected = 0U;
+    };
+
+    /// @brief Type of the callback invoked when the epoch is assembled.
+    typedef std::function<void (const Epoch&)> EpochHandler;
+
+    /// @brief Default constructor, all the messages are expected.
+    EpochAssembler()
+    {
+        m_epoch.m_expected = AllBits;
+    }
+
+    /// @brief Set the callback invoked when the epoch is assembled.
+    template <typename TFunc>
+    void setEpochHandler(TFunc&& func)
+    {
+        m_handler = std::forward<TFunc>(func);
+    }
+
+    /// @brief Specify whether the message is expected in every epoch.
+    /// @details The messages configured with lower output rate than the
+    ///     others are not expected to complete the epoch.
+    template <typename TMsg>
+    void setExpected(bool expected)
+    {
+        if (expected) {
+            m_epoch.m_expected |= bitOf<TMsg>();
+        }
+        else {
+            m_epoch.m_expected &= ~bitOf<TMsg>();
+        }
+    }
+
+    /// @brief Handle the collected message.
+    template <typename TMsg>
+    typename std::enable_if<
+        (details::TupleIndexOf<TMsg, Messages>::Value < NumOfMessages)
+    >::type
+    handle(const TMsg& msg)
+    {
+        auto iTOW = static_cast<std::uint32_t>(std::get<0>(msg.fields()).value());
+        if (m_reported && (iTOW == m_reportedTow)) {
+            ++m_late;
+            return;
+        }
+
+        if ((!m_epoch.empty()) && (iTOW != m_epoch.m_iTOW)) {
+            ++m_incomplete;
+            report();
+        }
+
+        m_epoch.m_iTOW = iTOW;
+        std::get<indexOf<TMsg>()>(m_epoch.m_messages) = msg;
+        m_epoch.m_present |= bitOf<TMsg>();
+        if ((m_epoch.m_expected != 0U) && m_epoch.complete()) {
+            report();
+        }
+    }
+
+    /// @brief Handle any other message, ignored.
+    template <typename TMsg>
+    typename std::enable_if<
+        NumOfMessages <= details::TupleIndexOf<TMsg, Messages>::Value
+    >::type
+    handle(const TMsg&)
+    {
+    }
+
+    /// @brief Report the partially assembled epoch (if any), expected to be
+    ///     called at the end of the input.
+    void flush()
+    {
+        if (!m_epoch.empty()) {
+            ++m_incomplete;
+            report();
+        }
+    }
+
+    /// @brief Drop the partially assembled epoch (if any).
+    void reset()
+    {
+        m_epoch.m_present = 0U;
+    }
+
+    /// @brief Get the partially assembled epoch.
+    const Epoch& pending() const
+    {
+        return m_epoch;
+    }
+
+    /// @brief Total number of the reported epochs.
+    std::size_t epochCount() const
+    {
+        return m_epochs;
+    }
+
+    /// @brief Total number of the epochs reported without all the expected
+    ///     messages.
+    std::size_t incompleteCount() const
+    {
+        return m_incomplete;
+    }
+
+    /// @brief Total number of the messages dropped because their epoch
+    ///     had already been reported.
+    std::size_t lateCount() const
+    {
+        return m_late;
+    }
+
+private:
+    static const std::uint32_t AllBits =
+        static_cast<std::uint32_t>((static_cast<std::uint64_t>(1U) << NumOfMessages) - 1U);
+
+    template <typename TMsg>
+    static constexpr std::size_t indexOf()
+    {
+        static_assert(details::TupleIndexOf<TMsg, Messages>::Value < NumOfMessages,
+            "The message is not collected by the assembler");
+        return details::TupleIndexOf<TMsg, Messages>::Value;
+    }
+
+    template <typename TMsg>
+    static constexpr std::uint32_t bitOf()
+    {
+        return static_cast<std::uint32_t>(1U) << indexOf<TMsg>();
+    }
+
+    void report()
+    {
+        ++m_epochs;
+        if (m_handler) {
+            m_handler(static_cast<const Epoch&>(m_epoch));
+        }
+        m_epoch.m_present = 0U;
+        m_reportedTow = m_epoch.m_iTOW;
+        m_reported = true;
+    }
+
+    Epoch m_epoch;
+    EpochHandler m_handler;
+    std::size_t m_epochs = 0U;
+    std::size_t m_incomplete = 0U;
+    std::size_t m_late = 0U;
+    std::uint32_t m_reportedTow = 0U;
+    bool m_reported = false;
+};
+
+}  // namespace ublox
+
+
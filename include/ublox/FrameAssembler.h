@@ -0,0 +1,225 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::FrameAssembler class.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <array>
+#include <algorithm>
+
+#include "FrameView.h"
+#include "protocol/SyncScanner.h"
+
+namespace ublox
+{
+
+/// @brief Incremental assembler of frames from arbitrary chunks of input data.
+/// @details Data received over serial or socket connections arrives in
+///     fragments, which do not necessarily contain complete frames. The
+///     assembler keeps the state of partially received frame between the
+///     calls to @ref process(), so every input byte is inspected only once.
+///     The bytes preceding the synchronisation word are skipped using
+///     protocol::SyncScanner. The bytes of the frame being assembled
+///     are accumulated in the internal fixed size buffer, which makes the
+///     completed frame contiguous, and reported as FrameView. Then the frame
+///     can be passed to the @b read() member function of @ref Stack to create
+///     a message object:
+/// @code
+/// ublox::FrameAssembler<> assembler;
+/// ...
+/// assembler.process(buf, bufLen,
+///     [&stack](const ublox::FrameView& view)
+///     {
+///         MyStack::MsgPtr msg;
+///         const std::uint8_t* readIter = view.data();
+///         stack.read(msg, readIter, view.length());
+///         ...
+///     });
+/// @endcode
+///     Only when the frame turns out to be invalid (wrong checksum or too
+///     long), the bytes following its first synchronisation character are
+///     searched for the next synchronisation word.
+/// @tparam TMaxPayloadLength Maximal length of the payload. Frames with longer
+///     payload are discarded. It also determines the size of the internal
+///     buffer.
+template <std::size_t TMaxPayloadLength = 0xffff>
+class FrameAssembler
+{
+public:
+    /// @brief Maximal length of full frame.
+    static const std::size_t MaxFrameLength = TMaxPayloadLength + FrameView::OverheadLength;
+
+    /// @brief Default constructor
+    FrameAssembler() = default;
+
+    /// @brief Process chunk of input data.
+    /// @details Invokes provided handler for every complete and valid frame.
+    ///     The FrameView object passed to the handler references internal
+    ///     buffer and is invalidated when the handler returns.
+    /// @param[in] data Pointer to the input data.
+    /// @param[in] len Number of bytes in the input data.
+    /// @param[in] handler Callable object with
+    ///     @code void (const FrameView&) @endcode signature.
+    template <typename THandler>
+    void process(const std::uint8_t* data, std::size_t len, THandler&& handler)
+    {
+        auto* end = data + len;
+        while (data != end) {
+            if (m_size == 0U) {
+                auto* start = data;
+                data = protocol::SyncScanner::find(data, end);
+                m_skipped += static_cast<std::size_t>(data - start);
+                if (data == end) {
+                    break;
+                }
+            }
+
+            auto required = FrameView::HeaderLength;
+            if (required <= m_size) {
+                required = m_expected;
+            }
+
+            auto count =
+                std::min(required - m_size, static_cast<std::size_t>(end - data));
+            std::memcpy(&m_buf[m_size], data, count);
+            m_size += count;
+            data += count;
+            processBuffered(handler);
+        }
+    }
+
+    /// @brief Drop partially assembled frame (if any).
+    void reset()
+    {
+        m_size = 0U;
+        m_expected = 0U;
+    }
+
+    /// @brief Number of bytes of partially assembled frame.
+    std::size_t pendingCount() const
+    {
+        return m_size;
+    }
+
+    /// @brief Total number of valid frames reported so far.
+    std::size_t frameCount() const
+    {
+        return m_frames;
+    }
+
+    /// @brief Total number of input bytes that didn't belong to any valid frame.
+    std::size_t skippedCount() const
+    {
+        return m_skipped;
+    }
+
+    /// @brief Total number of frames discarded due to checksum mismatch.
+    std::size_t checksumErrorCount() const
+    {
+        return m_checksumErrors;
+    }
+
+    /// @brief Total number of frames discarded due to exceeding
+    ///     @ref MaxFrameLength.
+    std::size_t oversizedCount() const
+    {
+        return m_oversized;
+    }
+
+private:
+    template <typename THandler>
+    void processBuffered(THandler& handler)
+    {
+        while (m_size != 0U) {
+            if (m_size < FrameView::HeaderLength) {
+                if ((1U < m_size) && (m_buf[1] != protocol::SyncChar2)) {
+                    drop(1U, true);
+                    continue;
+                }
+                return;
+            }
+
+            if (m_expected == 0U) {
+                auto frameLen = FrameView::frameLength(&m_buf[0], m_size);
+                if (frameLen == 0U) {
+                    drop(1U, true);
+                    continue;
+                }
+
+                if (MaxFrameLength < frameLen) {
+                    ++m_oversized;
+                    drop(1U, true);
+                    continue;
+                }
+
+                m_expected = frameLen;
+            }
+
+            if (m_size < m_expected) {
+                return;
+            }
+
+            FrameView view;
+            const std::uint8_t* readIter = &m_buf[0];
+            auto es = view.read(readIter, m_expected);
+            if (es != comms::ErrorStatus::Success) {
+                ++m_checksumErrors;
+                drop(1U, true);
+                continue;
+            }
+
+            ++m_frames;
+            handler(static_cast<const FrameView&>(view));
+            drop(m_expected, false);
+        }
+    }
+
+    void drop(std::size_t count, bool discarded)
+    {
+        m_expected = 0U;
+        auto* begin = &m_buf[0];
+        auto* from = begin + count;
+        auto* end = begin + m_size;
+        auto* next = protocol::SyncScanner::find(from, end);
+        m_skipped += static_cast<std::size_t>(next - from);
+        if (discarded) {
+            m_skipped += count;
+        }
+
+        m_size = static_cast<std::size_t>(end - next);
+        if (m_size != 0U) {
+            std::memmove(begin, next, m_size);
+        }
+    }
+
+    std::array<std::uint8_t, MaxFrameLength> m_buf;
+    std::size_t m_size = 0U;
+    std::size_t m_expected = 0U;
+    std::size_t m_frames = 0U;
+    std::size_t m_skipped = 0U;
+    std::size_t m_checksumErrors = 0U;
+    std::size_t m_oversized = 0U;
+};
+
+}  // namespace ublox
+
+
@@ -0,0 +1,257 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::FrameView class.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+
+#include "comms/comms.h"
+
+#include "MsgId.h"
+#include "protocol/ChecksumCalc.h"
+#include "protocol/SyncScanner.h"
+
+namespace ublox
+{
+
+/// @brief Lightweight view of a single frame of ublox binary protocol.
+/// @details Unlike @ref Stack it doesn't create any message object. It
+///     validates the synchronisation characters, length and checksum of the
+///     frame residing in the contiguous buffer and provides access to the
+///     message ID as well as the payload. The view doesn't copy the data,
+///     it references the buffer it was read from, i.e. the buffer must
+///     outlive the view. No dynamic memory allocation or virtual function
+///     calls are involved.
+/// @code
+/// ublox::FrameView view;
+/// const std::uint8_t* readIter = buf;
+/// auto es = view.read(readIter, bufLen);
+/// if (es == comms::ErrorStatus::Success) {
+///     route(view.msgId(), view.payload().data(), view.payload().size());
+/// }
+/// @endcode
+class FrameView
+{
+public:
+    /// @brief Number of bytes in the frame preceding the payload.
+    /// @details Two synchronisation characters, class, ID, and two bytes of
+    ///     length.
+    static const std::size_t HeaderLength = 6U;
+
+    /// @brief Number of bytes in the frame following the payload.
+    static const std::size_t ChecksumLength = 2U;
+
+    /// @brief Number of bytes in the frame excluding payload.
+    static const std::size_t OverheadLength = HeaderLength + ChecksumLength;
+
+    /// @brief Non-owning view of the payload bytes.
+    class Payload
+    {
+    public:
+        /// @brief Default constructor, creates empty view.
+        Payload() = default;
+
+        /// @brief Constructor
+        Payload(const std::uint8_t* data, std::size_t size)
+          : m_data(data),
+            m_size(size)
+        {
+        }
+
+        /// @brief Pointer to the first payload byte.
+        const std::uint8_t* data() const
+        {
+            return m_data;
+        }
+
+        /// @brief Number of payload bytes.
+        std::size_t size() const
+        {
+            return m_size;
+        }
+
+        /// @brief Check whether the payload is empty.
+        bool empty() const
+        {
+            return m_size == 0U;
+        }
+
+        /// @brief Iterator to the first payload byte.
+        const std::uint8_t* begin() const
+        {
+            return m_data;
+        }
+
+        /// @brief Iterator past the last payload byte.
+        const std::uint8_t* end() const
+        {
+            return m_data + m_size;
+        }
+
+        /// @brief Access payload byte.
+        std::uint8_t operator[](std::size_t idx) const
+        {
+            return m_data[idx];
+        }
+
+    private:
+        const std::uint8_t* m_data = nullptr;
+        std::size_t m_size = 0U;
+    };
+
+    /// @brief Default constructor, creates invalid view.
+    FrameView() = default;
+
+    /// @brief Read and validate the frame.
+    /// @param[in, out] iter Iterator to the beginning of the frame. In case
+    ///     of success it is advanced past the end of the frame, otherwise
+    ///     it remains intact.
+    /// @param[in] len Number of bytes available for reading.
+    /// @return Status of the operation:
+    ///     @li @b comms::ErrorStatus::Success - valid frame was found.
+    ///     @li @b comms::ErrorStatus::NotEnoughData - the buffer contains
+    ///         incomplete frame.
+    ///     @li @b comms::ErrorStatus::ProtocolError - invalid synchronisation
+    ///         characters or checksum.
+    comms::ErrorStatus read(const std::uint8_t*& iter, std::size_t len)
+    {
+        m_data = nullptr;
+        m_payloadLen = 0U;
+
+        auto frameLen = frameLength(iter, len);
+        if (frameLen == 0U) {
+            if ((HeaderLength <= len) || (!validSync(iter, len))) {
+                return comms::ErrorStatus::ProtocolError;
+            }
+            return comms::ErrorStatus::NotEnoughData;
+        }
+
+        if (len < frameLen) {
+            return comms::ErrorStatus::NotEnoughData;
+        }
+
+        auto payloadLen = frameLen - OverheadLength;
+        const std::uint8_t* csIter = iter + 2U;
+        auto calculated = protocol::ChecksumCalc()(csIter, HeaderLength - 2U + payloadLen);
+        auto expected =
+            static_cast<std::uint16_t>(
+                static_cast<std::uint16_t>(csIter[0]) |
+                (static_cast<std::uint16_t>(csIter[1]) << std::numeric_limits<std::uint8_t>::digits));
+
+        if (calculated != expected) {
+            return comms::ErrorStatus::ProtocolError;
+        }
+
+        m_data = iter;
+        m_payloadLen = payloadLen;
+        iter += frameLen;
+        return comms::ErrorStatus::Success;
+    }
+
+    /// @brief Check whether the view references valid frame.
+    bool valid() const
+    {
+        return m_data != nullptr;
+    }
+
+    /// @brief Get message ID.
+    /// @pre @ref valid() returns true.
+    MsgId msgId() const
+    {
+        return static_cast<MsgId>(
+            (static_cast<unsigned>(classId()) << std::numeric_limits<std::uint8_t>::digits) | id());
+    }
+
+    /// @brief Get class ID of the message.
+    /// @pre @ref valid() returns true.
+    std::uint8_t classId() const
+    {
+        return m_data[2];
+    }
+
+    /// @brief Get ID of the message within its class.
+    /// @pre @ref valid() returns true.
+    std::uint8_t id() const
+    {
+        return m_data[3];
+    }
+
+    /// @brief Get view of the payload.
+    Payload payload() const
+    {
+        if (!valid()) {
+            return Payload();
+        }
+        return Payload(m_data + HeaderLength, m_payloadLen);
+    }
+
+    /// @brief Get pointer to the beginning of the frame (first
+    ///     synchronisation character).
+    const std::uint8_t* data() const
+    {
+        return m_data;
+    }
+
+    /// @brief Get total length of the frame, including synchronisation
+    ///     characters and checksum.
+    std::size_t length() const
+    {
+        if (!valid()) {
+            return 0U;
+        }
+        return m_payloadLen + OverheadLength;
+    }
+
+    /// @brief Get full length of the frame from its header.
+    /// @details Checks only the synchronisation characters, doesn't validate
+    ///     checksum.
+    /// @param[in] buf Pointer to the beginning of the frame.
+    /// @param[in] len Number of available bytes.
+    /// @return Full length of the frame or 0 in case the header is incomplete
+    ///     or invalid.
+    static std::size_t frameLength(const std::uint8_t* buf, std::size_t len)
+    {
+        if ((len < HeaderLength) || (!validSync(buf, len))) {
+            return 0U;
+        }
+
+        auto payloadLen =
+            static_cast<std::size_t>(buf[4]) |
+            (static_cast<std::size_t>(buf[5]) << std::numeric_limits<std::uint8_t>::digits);
+        return payloadLen + OverheadLength;
+    }
+
+private:
+    static bool validSync(const std::uint8_t* buf, std::size_t len)
+    {
+        return
+            ((len < 1U) || (buf[0] == protocol::SyncChar1)) &&
+            ((len < 2U) || (buf[1] == protocol::SyncChar2));
+    }
+
+    const std::uint8_t* m_data = nullptr;
+    std::size_t m_payloadLen = 0U;
+};
+
+}  // namespace ublox
+
+
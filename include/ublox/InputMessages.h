@@ -23,6 +23,7 @@
 #include <tuple>
 
 #include "Message.h"
+#include "options.h"
 
 #include "message/NavPosecef.h"
 #include "message/NavPosllh.h"
@@ -122,7 +123,9 @@ namespace ublox
 /// @brief All input messages (the ones that can be sent out from u-blox receiver)
 ///     are bundled in std::tuple.
 /// @tparam TMessage Common message interface class
-template <typename TMessage = Message>
+/// @tparam TOptions Storage profile of the variable length list fields, see
+///     @ref ublox::option::DynamicListStorage and @ref ublox::option::FixedListStorage.
+template <typename TMessage = Message, typename TOptions = option::DynamicListStorage>
 using InputMessages =
     std::tuple<
         message::NavPosecef<TMessage>,
@@ -136,14 +139,14 @@ using InputMessages =
         message::NavTimegps<TMessage>,
         message::NavTimeutc<TMessage>,
         message::NavClock<TMessage>,
-        message::NavSvinfo<TMessage>,
+        message::NavSvinfo<TMessage, TOptions>,
         message::NavDgps<TMessage>,
         message::NavSbas<TMessage>,
         message::NavEkfstatus<TMessage>,
         message::NavAopstatus<TMessage>,
-        message::RxmRaw<TMessage>,
+        message::RxmRaw<TMessage, TOptions>,
         message::RxmSfrb<TMessage>,
-        message::RxmSvsi<TMessage>,
+        message::RxmSvsi<TMessage, TOptions>,
         message::RxmAlm<TMessage>,
         message::RxmEph<TMessage>,
         message::InfError<TMessage>,
@@ -181,10 +184,10 @@ using InputMessages =
         message::CfgItfm<TMessage>,
         message::CfgPm2<TMessage>,
         message::CfgTmode2<TMessage>,
-        message::CfgGnss<TMessage>,
+        message::CfgGnss<TMessage, TOptions>,
         message::CfgLogfilter<TMessage>,
         message::MonIo<TMessage>,
-        message::MonVer<TMessage>,
+        message::MonVer<TMessage, TOptions>,
         message::MonMsgpp<TMessage>,
         message::MonRxbuf<TMessage>,
         message::MonTxbuf<TMessage>,
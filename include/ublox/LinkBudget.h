@@ -0,0 +1,125 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains calculation of the link capacity and serialisation
+///     length of the frames.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <tuple>
+
+#include "FrameView.h"
+#include "MsgLayout.h"
+#include "message/CfgPrtUart.h"
+
+namespace ublox
+{
+
+/// @brief Expected length of the complete frame of the message.
+/// @details Calculated from the compile time layout of the message
+///     payload (see @ref MsgLayout), i.e. exact for the messages with
+///     fixed length payload.
+/// @tparam TMsg Message type, such as message::MonHw.
+/// @param[in] blocks Number of the repeated blocks, relevant only for the
+///     messages ending with the list of the blocks
+///     (@ref FieldsLayout::BlockLength is not 0), such as message::MonIo.
+template <typename TMsg>
+constexpr std::size_t expectedFrameLength(std::size_t blocks = 0U)
+{
+    return
+        FrameView::OverheadLength +
+        MsgLayout<TMsg>::MinLength +
+        (blocks * MsgLayout<TMsg>::BlockLength);
+}
+
+/// @brief Worst case length of the complete frame of the message.
+/// @details Same as @ref expectedFrameLength() for the messages with fixed
+///     length payload or ending with the list of the repeated blocks.
+///     For the other variable length messages (such as message::AidAlm
+///     with optional data) it's the maximal length of the frame, unless
+///     the payload length is unbounded (such as message::InfNotice),
+///     in which case the minimal one is used.
+/// @tparam TMsg Message type, such as message::AidEph.
+/// @param[in] blocks Number of the repeated blocks, see
+///     @ref expectedFrameLength().
+template <typename TMsg>
+constexpr std::size_t maxFrameLength(std::size_t blocks = 0U)
+{
+    return
+        ((MsgLayout<TMsg>::BlockLength != 0U) ||
+         (details::MaxPayloadLengthLimit <= MsgLayout<TMsg>::MaxLength)) ?
+            expectedFrameLength<TMsg>(blocks) :
+            (FrameView::OverheadLength + MsgLayout<TMsg>::MaxLength);
+}
+
+/// @brief Number of half bit periods needed to transmit single character
+///     over UART.
+/// @details Includes the start bit, the data bits, the parity bit (if any)
+///     and the stop bits.
+inline unsigned uartCharHalfBits(
+    message::CfgPrtUartFields::CharLen charLen,
+    message::CfgPrtUartFields::Parity parity,
+    message::CfgPrtUartFields::StopBits stopBits)
+{
+    typedef message::CfgPrtUartFields Fields;
+
+    unsigned halfBits = 2U + (2U * (static_cast<unsigned>(charLen) + 5U));
+    if ((parity == Fields::Parity::Even) || (parity == Fields::Parity::Odd)) {
+        halfBits += 2U;
+    }
+
+    switch (stopBits) {
+    case Fields::StopBits::OneAndHalf:
+        return halfBits + 3U;
+    case Fields::StopBits::Two:
+        return halfBits + 4U;
+    case Fields::StopBits::Half:
+        return halfBits + 1U;
+    default:
+        break;
+    }
+    return halfBits + 2U;
+}
+
+/// @brief Number of characters per second transmitted over UART in every
+///     direction, as configured by CFG-PRT message.
+/// @param[in] msg CFG-PRT (UART) message, either sent to the receiver or
+///     received as a response to the poll.
+template <typename TMsgBase>
+double uartBytesPerSecond(const message::CfgPrtUart<TMsgBase>& msg)
+{
+    typedef message::CfgPrtUart<TMsgBase> Msg;
+    typedef message::CfgPrtUartFields Fields;
+
+    auto& fields = msg.fields();
+    auto& mode = std::get<Msg::FieldIdx_mode>(fields).value();
+    auto halfBits =
+        uartCharHalfBits(
+            std::get<Fields::mode_charLen>(mode).value(),
+            std::get<Fields::mode_parity>(mode).value(),
+            std::get<Fields::mode_nStopBits>(mode).value());
+
+    auto baudRate = std::get<Msg::FieldIdx_baudRate>(fields).value();
+    return (2.0 * static_cast<double>(baudRate)) / halfBits;
+}
+
+}  // namespace ublox
+
+
@@ -0,0 +1,466 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::MsgFactory class.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+#include "MsgId.h"
+#include "details/MsgIdTables.h"
+#include "MsgLayout.h"
+
+namespace ublox
+{
+
+namespace details
+{
+
+/// @brief Retrieve numeric ID of the message class defined using
+///     @b comms::option::StaticNumIdImpl option.
+template <typename TMsg>
+struct StaticMsgIdRetriever
+{
+    template <typename T>
+    static constexpr MsgId get(decltype(T::doGetId())*)
+    {
+        return static_cast<MsgId>(T::doGetId());
+    }
+
+    template <typename T>
+    static constexpr MsgId get(...)
+    {
+        return static_cast<MsgId>(T::MsgId);
+    }
+
+    static const MsgId Value = get<TMsg>(nullptr);
+};
+
+template <typename TAllMessages>
+struct MsgFactoryIds;
+
+template <typename... TMessages>
+struct MsgFactoryIds<std::tuple<TMessages...> >
+{
+    static constexpr std::uint16_t Values[sizeof...(TMessages)] = {
+        static_cast<std::uint16_t>(StaticMsgIdRetriever<TMessages>::Value)...
+    };
+};
+
+template <typename... TMessages>
+constexpr std::uint16_t MsgFactoryIds<std::tuple<TMessages...> >::Values[sizeof...(TMessages)];
+
+/// @brief Lookup tables used by ublox::MsgFactory.
+/// @details Generated at compile time in stages, every next stage uses
+///     the result of the previous one to keep the amount of compile time
+///     evaluations low.
+template <typename TAllMessages>
+struct MsgFactoryTables : public MsgIdClassTables<MsgFactoryIds<TAllMessages> >
+{
+    typedef MsgIdClassTables<MsgFactoryIds<TAllMessages> > Base;
+    typedef MsgFactoryIds<TAllMessages> Ids;
+    static const std::size_t NumOfMessages = Base::NumOfIds;
+    typedef typename Base::Ops Ops;
+
+    typedef typename std::conditional<
+        NumOfMessages < std::numeric_limits<std::uint8_t>::max(),
+        std::uint8_t,
+        std::uint16_t
+    >::type IndexType;
+
+    // (row, ID within class) -> index of the first message
+    static constexpr std::size_t cell(std::size_t pos)
+    {
+        return
+            (pos < Base::NumOfCells) ? NumOfMessages :
+            Ops::findId(
+                Ids::Values,
+                static_cast<std::uint16_t>(
+                    (static_cast<std::size_t>(Base::RowClassesTable::Values[pos / Base::NumOfCells]) << std::numeric_limits<std::uint8_t>::digits) |
+                    (pos % Base::NumOfCells)));
+    }
+
+    template <typename TSeq>
+    struct Cells;
+
+    template <std::size_t... TIdx>
+    struct Cells<IndexSeq<TIdx...> >
+    {
+        static constexpr IndexType Values[sizeof...(TIdx)] = {
+            static_cast<IndexType>(cell(TIdx))...
+        };
+    };
+
+    typedef Cells<typename MakeIndexSeq<Base::NumOfRows * Base::NumOfCells>::Type> CellsTable;
+
+    // message index -> index of the next message with the same ID
+    template <typename TSeq>
+    struct NextSame;
+
+    template <std::size_t... TIdx>
+    struct NextSame<IndexSeq<TIdx...> >
+    {
+        static constexpr IndexType Values[sizeof...(TIdx)] = {
+            static_cast<IndexType>(Ops::nextSame(Ids::Values, TIdx, TIdx + 1))...
+        };
+    };
+
+    typedef NextSame<typename MakeIndexSeq<NumOfMessages>::Type> NextSameTable;
+};
+
+template <typename TAllMessages>
+template <std::size_t... TIdx>
+constexpr typename MsgFactoryTables<TAllMessages>::IndexType
+MsgFactoryTables<TAllMessages>::Cells<IndexSeq<TIdx...> >::Values[sizeof...(TIdx)];
+
+template <typename TAllMessages>
+template <std::size_t... TIdx>
+constexpr typename MsgFactoryTables<TAllMessages>::IndexType
+MsgFactoryTables<TAllMessages>::NextSame<IndexSeq<TIdx...> >::Values[sizeof...(TIdx)];
+
+/// @brief Value of payload key offset for the messages that don't define
+///     any.
+static const std::size_t NoDispatchKey = std::numeric_limits<std::size_t>::max();
+
+/// @brief Retrieve definition of the payload byte (key) distinguishing
+///     the message from other ones with the same ID.
+/// @details The message class is expected to define static
+///     @b DispatchKeyOffset constant and static constexpr
+///     @b validDispatchKey() function, checking the value of the key.
+template <typename TMsg>
+struct DispatchKeyRetriever
+{
+    template <typename T>
+    static constexpr std::size_t offset(decltype(T::validDispatchKey(0U))*)
+    {
+        return T::DispatchKeyOffset;
+    }
+
+    template <typename T>
+    static constexpr std::size_t offset(...)
+    {
+        return NoDispatchKey;
+    }
+
+    template <typename T>
+    static constexpr bool valid(std::uint8_t value, decltype(T::validDispatchKey(0U))*)
+    {
+        return T::validDispatchKey(value);
+    }
+
+    template <typename T>
+    static constexpr bool valid(std::uint8_t, ...)
+    {
+        return true;
+    }
+
+    // bitmask of valid key values in range [word * 32, (word + 1) * 32)
+    static constexpr std::uint32_t word(std::size_t word, std::size_t bit = 0U)
+    {
+        return
+            (std::numeric_limits<std::uint32_t>::digits <= bit) ? 0U :
+            ((valid<TMsg>(
+                static_cast<std::uint8_t>((word * std::numeric_limits<std::uint32_t>::digits) + bit),
+                nullptr) ? (static_cast<std::uint32_t>(1U) << bit) : 0U) |
+             DispatchKeyRetriever::word(word, bit + 1));
+    }
+
+    static const std::size_t Offset = offset<TMsg>(nullptr);
+};
+
+/// @brief Tables used by ublox::MsgFactory to select message type by
+///     the payload contents.
+template <typename TAllMessages>
+struct MsgFactoryPayloadTables;
+
+template <typename... TMessages>
+struct MsgFactoryPayloadTables<std::tuple<TMessages...> >
+{
+    static const std::size_t NumOfKeyWords =
+        (std::numeric_limits<std::uint8_t>::max() + 1U) / std::numeric_limits<std::uint32_t>::digits;
+
+    static constexpr std::size_t MinLengths[sizeof...(TMessages)] = {
+        MsgLayout<TMessages>::MinLength...
+    };
+
+    static constexpr std::size_t MaxLengths[sizeof...(TMessages)] = {
+        MsgLayout<TMessages>::MaxLength...
+    };
+
+    static constexpr std::size_t BlockLengths[sizeof...(TMessages)] = {
+        MsgLayout<TMessages>::BlockLength...
+    };
+
+    static constexpr std::size_t KeyOffsets[sizeof...(TMessages)] = {
+        DispatchKeyRetriever<TMessages>::Offset...
+    };
+
+    static constexpr std::uint32_t KeyWords[sizeof...(TMessages)][NumOfKeyWords] = {
+        {
+            DispatchKeyRetriever<TMessages>::word(0U),
+            DispatchKeyRetriever<TMessages>::word(1U),
+            DispatchKeyRetriever<TMessages>::word(2U),
+            DispatchKeyRetriever<TMessages>::word(3U),
+            DispatchKeyRetriever<TMessages>::word(4U),
+            DispatchKeyRetriever<TMessages>::word(5U),
+            DispatchKeyRetriever<TMessages>::word(6U),
+            DispatchKeyRetriever<TMessages>::word(7U)
+        }...
+    };
+
+    static_assert(NumOfKeyWords == 8U, "Unexpected number of key words");
+
+    static bool validLength(std::size_t idx, std::size_t len)
+    {
+        auto minLen = MinLengths[idx];
+        auto blockLen = BlockLengths[idx];
+        return
+            (minLen <= len) &&
+            (len <= MaxLengths[idx]) &&
+            ((blockLen == 0U) || (((len - minLen) % blockLen) == 0U));
+    }
+
+    // Payload longer than any serialisation of the fields, read as the
+    // message extended by newer protocol version.
+    static bool extendedLength(std::size_t idx, std::size_t len)
+    {
+        return MaxLengths[idx] < len;
+    }
+
+    static bool validKey(std::size_t idx, const std::uint8_t* payload, std::size_t len)
+    {
+        auto offset = KeyOffsets[idx];
+        if (offset == NoDispatchKey) {
+            return true;
+        }
+
+        if (len <= offset) {
+            return false;
+        }
+
+        auto value = payload[offset];
+        auto word = KeyWords[idx][value / std::numeric_limits<std::uint32_t>::digits];
+        return ((word >> (value % std::numeric_limits<std::uint32_t>::digits)) & 0x1) != 0U;
+    }
+};
+
+template <typename... TMessages>
+constexpr std::size_t MsgFactoryPayloadTables<std::tuple<TMessages...> >::MinLengths[sizeof...(TMessages)];
+
+template <typename... TMessages>
+constexpr std::size_t MsgFactoryPayloadTables<std::tuple<TMessages...> >::MaxLengths[sizeof...(TMessages)];
+
+template <typename... TMessages>
+constexpr std::size_t MsgFactoryPayloadTables<std::tuple<TMessages...> >::BlockLengths[sizeof...(TMessages)];
+
+template <typename... TMessages>
+constexpr std::size_t MsgFactoryPayloadTables<std::tuple<TMessages...> >::KeyOffsets[sizeof...(TMessages)];
+
+template <typename... TMessages>
+constexpr std::uint32_t MsgFactoryPayloadTables<std::tuple<TMessages...> >::KeyWords[sizeof...(TMessages)][MsgFactoryPayloadTables<std::tuple<TMessages...> >::NumOfKeyWords];
+
+template <typename TAllMessages, typename TMsgPtr>
+struct MsgFactoryCreators;
+
+template <typename... TMessages, typename TMsgPtr>
+struct MsgFactoryCreators<std::tuple<TMessages...>, TMsgPtr>
+{
+    typedef TMsgPtr (*Creator)();
+
+    template <typename TMsg>
+    static TMsgPtr create()
+    {
+        return TMsgPtr(new TMsg);
+    }
+
+    static TMsgPtr create(std::size_t idx)
+    {
+        static const Creator Creators[] = { &MsgFactoryCreators::template create<TMessages>... };
+        return Creators[idx]();
+    }
+};
+
+}  // namespace details
+
+/// @brief Factory of message objects with direct indexed lookup of the
+///     message type.
+/// @details The message types bundled in @b TAllMessages tuple are identified
+///     by their position in the tuple (index). The factory contains two
+///     level lookup table generated at compile time: the first one is
+///     indexed by the class ID and references the row of the second level,
+///     which is indexed by the ID of the message within the class and
+///     contains index of the first message type with such ID. As the result
+///     finding the message type takes the same time regardless of the number
+///     of the messages in the bundle. @n
+///     Multiple message types may share the same ID (for example
+///     message::CfgPrtUart, message::CfgPrtUsb, etc...). Such types are
+///     chained in the order of their appearance in the bundle, use
+///     nextIndex() to move along the chain, or selectIndex() to choose the
+///     type by the payload length and contents without constructing any
+///     message object.
+/// @tparam TMsgBase Common interface class for all the messages.
+/// @tparam TAllMessages All the message types bundled in std::tuple.
+template <typename TMsgBase, typename TAllMessages>
+class MsgFactory
+{
+    typedef details::MsgFactoryTables<TAllMessages> Tables;
+    typedef details::MsgFactoryPayloadTables<TAllMessages> PayloadTables;
+
+public:
+    /// @brief Common interface class for all the messages.
+    typedef TMsgBase Message;
+
+    /// @brief All message types.
+    typedef TAllMessages AllMessages;
+
+    /// @brief Smart pointer to the created message object.
+    typedef std::unique_ptr<Message> MsgPtr;
+
+    /// @brief Number of message types.
+    static const std::size_t NumOfMessages = Tables::NumOfMessages;
+
+    static_assert(0U < NumOfMessages, "At least one message is expected");
+
+    /// @brief Get index of the first message type with specified ID.
+    /// @return Index of the message type or @ref NumOfMessages in case
+    ///     there is no message with such ID.
+    static std::size_t firstIndex(MsgId id)
+    {
+        auto row = Tables::rowOf(id);
+        return Tables::CellsTable::Values[(row * Tables::NumOfCells) + static_cast<std::uint8_t>(id)];
+    }
+
+    /// @brief Get index of the next message type with the same ID.
+    /// @return Index of the message type or @ref NumOfMessages in case
+    ///     there are no more messages with the same ID.
+    static std::size_t nextIndex(std::size_t idx)
+    {
+        return Tables::NextSameTable::Values[idx];
+    }
+
+    /// @brief Select the message type the payload is expected to be read into.
+    /// @details Applicable when multiple message types share the same ID.
+    ///     The candidate types are checked in order of their appearance in
+    ///     the bundle. The type is accepted when the payload length is allowed
+    ///     by its fields (see @ref FieldsLayout::validLength()), and the
+    ///     payload byte distinguishing it from the other types (if the message
+    ///     class defines one, such as @b portID of message::CfgPrtUart) has
+    ///     valid value. When no such type exists, the first type with valid
+    ///     key, which payload is shorter than the provided one, is selected,
+    ///     allowing the messages extended by newer protocol versions to be
+    ///     read. The same length rule is applied by validLength().
+    /// @param[in] id ID of the message.
+    /// @param[in] payload Pointer to the payload.
+    /// @param[in] len Length of the payload.
+    /// @return Index of the message type or @ref NumOfMessages in case
+    ///     there is no suitable message.
+    static std::size_t selectIndex(MsgId id, const std::uint8_t* payload, std::size_t len)
+    {
+        auto fallback = NumOfMessages;
+        for (auto idx = firstIndex(id); idx < NumOfMessages; idx = nextIndex(idx)) {
+            if (!PayloadTables::validKey(idx, payload, len)) {
+                continue;
+            }
+
+            if (PayloadTables::validLength(idx, len)) {
+                return idx;
+            }
+
+            if ((fallback == NumOfMessages) &&
+                (PayloadTables::extendedLength(idx, len))) {
+                fallback = idx;
+            }
+        }
+
+        return fallback;
+    }
+
+    /// @brief Check whether the payload length is allowed for the message ID.
+    /// @details The length is allowed when at least one of the message types
+    ///     with such ID accepts it (see @ref FieldsLayout::validLength()), or
+    ///     it exceeds the maximal serialisation length of such type, i.e.
+    ///     the payload is accepted by selectIndex() as the extended message.
+    /// @param[in] id ID of the message.
+    /// @param[in] len Length of the payload.
+    /// @return @b true if the length is allowed, @b false if not or there is
+    ///     no message with such ID.
+    static bool validLength(MsgId id, std::size_t len)
+    {
+        for (auto idx = firstIndex(id); idx < NumOfMessages; idx = nextIndex(idx)) {
+            if ((PayloadTables::validLength(idx, len)) ||
+                (PayloadTables::extendedLength(idx, len))) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /// @brief Get ID of the message type by its index.
+    static MsgId msgIdOf(std::size_t idx)
+    {
+        return static_cast<MsgId>(Tables::Ids::Values[idx]);
+    }
+
+    /// @brief Get number of message types having the same ID.
+    static std::size_t msgCount(MsgId id)
+    {
+        std::size_t count = 0U;
+        for (auto idx = firstIndex(id); idx < NumOfMessages; idx = nextIndex(idx)) {
+            ++count;
+        }
+        return count;
+    }
+
+    /// @brief Dynamically allocate message object by its index.
+    static MsgPtr createByIndex(std::size_t idx)
+    {
+        return details::MsgFactoryCreators<AllMessages, MsgPtr>::create(idx);
+    }
+
+    /// @brief Dynamically allocate message object.
+    /// @param[in] id ID of the message.
+    /// @param[in] idx Relative index of the message type among all the types
+    ///     sharing the same ID.
+    /// @return Allocated message object or empty pointer in case there is
+    ///     no such message type.
+    static MsgPtr createMsg(MsgId id, unsigned idx = 0)
+    {
+        auto msgIdx = firstIndex(id);
+        while ((msgIdx < NumOfMessages) && (0U < idx)) {
+            msgIdx = nextIndex(msgIdx);
+            --idx;
+        }
+
+        if (NumOfMessages <= msgIdx) {
+            return MsgPtr();
+        }
+
+        return createByIndex(msgIdx);
+    }
+};
+
+}  // namespace ublox
+
+
@@ -25,11 +25,107 @@
 namespace ublox
 {
 
+/// @brief List of all the message IDs.
+/// @details Expands @b func_(name_, value_) for every message ID, where
+///     @b name_ is the name of the message (such as @b NAV_DOP) and @b value_
+///     is its ID. The list of valid IDs used by @ref ublox::field::MsgId
+///     is generated from it, and every @ref MsgId enumerator is checked
+///     against it at compile time. The values are expected to be sorted.
+#define UBLOX_MSG_ID_LIST(func_) \
+    func_(NAV_POSECEF, 0x0101) \
+    func_(NAV_POSLLH, 0x0102) \
+    func_(NAV_STATUS, 0x0103) \
+    func_(NAV_DOP, 0x0104) \
+    func_(NAV_SOL, 0x0106) \
+    func_(NAV_PVT, 0x0107) \
+    func_(NAV_VELECEF, 0x0111) \
+    func_(NAV_VELNED, 0x0112) \
+    func_(NAV_TIMEGPS, 0x0120) \
+    func_(NAV_TIMEUTC, 0x0121) \
+    func_(NAV_CLOCK, 0x0122) \
+    func_(NAV_SVINFO, 0x0130) \
+    func_(NAV_DGPS, 0x0131) \
+    func_(NAV_SBAS, 0x0132) \
+    func_(NAV_EKFSTATUS, 0x0140) \
+    func_(NAV_AOPSTATUS, 0x0160) \
+    func_(RXM_RAW, 0x0210) \
+    func_(RXM_SFRB, 0x0211) \
+    func_(RXM_SVSI, 0x0220) \
+    func_(RXM_ALM, 0x0230) \
+    func_(RXM_EPH, 0x0231) \
+    func_(RXM_PMREQ, 0x0241) \
+    func_(INF_ERROR, 0x0400) \
+    func_(INF_WARNING, 0x0401) \
+    func_(INF_NOTICE, 0x0402) \
+    func_(INF_TEST, 0x0403) \
+    func_(INF_DEBUG, 0x0404) \
+    func_(ACK_NAK, 0x0500) \
+    func_(ACK_ACK, 0x0501) \
+    func_(CFG_PRT, 0x0600) \
+    func_(CFG_MSG, 0x0601) \
+    func_(CFG_INF, 0x0602) \
+    func_(CFG_RST, 0x0604) \
+    func_(CFG_DAT, 0x0606) \
+    func_(CFG_TP, 0x0607) \
+    func_(CFG_RATE, 0x0608) \
+    func_(CFG_CFG, 0x0609) \
+    func_(CFG_FXN, 0x060E) \
+    func_(CFG_RXM, 0x0611) \
+    func_(CFG_EKF, 0x0612) \
+    func_(CFG_ANT, 0x0613) \
+    func_(CFG_SBAS, 0x0616) \
+    func_(CFG_NMEA, 0x0617) \
+    func_(CFG_USB, 0x061b) \
+    func_(CFG_TMODE, 0x061d) \
+    func_(CFG_NVS, 0x0622) \
+    func_(CFG_NAVX5, 0x0623) \
+    func_(CFG_NAV5, 0x0624) \
+    func_(CFG_ESFGWT, 0x0629) \
+    func_(CFG_TP5, 0x0631) \
+    func_(CFG_PM, 0x0632) \
+    func_(CFG_RINV, 0x0634) \
+    func_(CFG_ITFM, 0x0639) \
+    func_(CFG_PM2, 0x063b) \
+    func_(CFG_TMODE2, 0x063d) \
+    func_(CFG_GNSS, 0x063e) \
+    func_(CFG_LOGFILTER, 0x0647) \
+    func_(MON_IO, 0x0a02) \
+    func_(MON_VER, 0x0a04) \
+    func_(MON_MSGPP, 0x0a06) \
+    func_(MON_RXBUF, 0x0a07) \
+    func_(MON_TXBUF, 0x0a08) \
+    func_(MON_HW, 0x0a09) \
+    func_(MON_HW2, 0x0a0b) \
+    func_(MON_RXR, 0x0a21) \
+    func_(AID_REQ, 0x0b00) \
+    func_(AID_INI, 0x0b01) \
+    func_(AID_HUI, 0x0b02) \
+    func_(AID_DATA, 0x0b10) \
+    func_(AID_ALM, 0x0b30) \
+    func_(AID_EPH, 0x0b31) \
+    func_(AID_ALPSRV, 0x0b32) \
+    func_(AID_AOP, 0x0b33) \
+    func_(AID_ALP, 0x0b50) \
+    func_(TIM_TP, 0x0d01) \
+    func_(TIM_TM2, 0x0d03) \
+    func_(TIM_SVIN, 0x0d04) \
+    func_(TIM_VRFY, 0x0d06) \
+    func_(LOG_ERASE, 0x2103) \
+    func_(LOG_STRING, 0x2104) \
+    func_(LOG_CREATE, 0x2107) \
+    func_(LOG_INFO, 0x2108) \
+    func_(LOG_RETRIEVE, 0x2109) \
+    func_(LOG_RETRIEVEPOS, 0x210b) \
+    func_(LOG_RETRIEVESTRING, 0x210d) \
+    func_(LOG_FINDTIME, 0x210e)
+
 /// @brief Enumeration type of message ID.
 /// @details Contains both Class ID and Message ID. The class ID is most
 ///     significant byte, while Message ID is least significant one.@n
 ///     For example: ID of @b NAV-DOP message is 0x0104, where 0x01 is @b NAV Class ID
-///     while 0x04 is @b DOP message ID within the @b NAV class.
+///     while 0x04 is @b DOP message ID within the @b NAV class.@n
+///     The enumerators are checked at compile time against
+///     @ref UBLOX_MSG_ID_LIST, new message ID must be added to both.
 enum MsgId : std::uint16_t
 {
     MsgId_NAV_POSECEF = 0x0101, ///< ID of NAV-POSECEF message
@@ -54,12 +150,12 @@ enum MsgId : std::uint16_t
     MsgId_RXM_ALM = 0x0230, ///< ID of RXM-ALM message
     MsgId_RXM_EPH = 0x0231, ///< ID of RXM-EPH message
     MsgId_RXM_PMREQ = 0x0241, ///< ID of RXM-PMREQ message
-    MsgId_INF_ERROR = 0x0400, ///< ID of RXM-ERROR message
+    MsgId_INF_ERROR = 0x0400, ///< ID of INF-ERROR message
     MsgId_INF_WARNING = 0x0401, ///< ID of INF-WARNING message
     MsgId_INF_NOTICE = 0x0402, ///< ID of INF-NOTICE message
     MsgId_INF_TEST = 0x0403, ///< ID of INF-TEST message
     MsgId_INF_DEBUG = 0x0404, ///< ID of INF-DEBUG message
-    MsgId_ACK_NAK = 0x0500, ///< ID of ACK-NACK message
+    MsgId_ACK_NAK = 0x0500, ///< ID of ACK-NAK message
     MsgId_ACK_ACK = 0x0501, ///< ID of ACK-ACK message
     MsgId_CFG_PRT = 0x0600, ///< ID of CFG-PRT message
     MsgId_CFG_MSG = 0x0601, ///< ID of CFG-MSG message
@@ -120,6 +216,31 @@ enum MsgId : std::uint16_t
     MsgId_LOG_FINDTIME = 0x210e ///< ID of LOG-FINDTIME message
 };
 
+namespace details
+{
+
+#define UBLOX_MSG_ID_ENUMERATOR_CHECK(name_, value_) \
+    static_assert(MsgId_ ## name_ == value_, \
+        "MsgId_" #name_ " doesn't match UBLOX_MSG_ID_LIST");
+UBLOX_MSG_ID_LIST(UBLOX_MSG_ID_ENUMERATOR_CHECK)
+#undef UBLOX_MSG_ID_ENUMERATOR_CHECK
+
+/// @brief Check whether the ID is present in @ref UBLOX_MSG_ID_LIST.
+/// @details Besides the run time check, the switch statement makes the
+///     compiler report (@b -Wswitch) every enumerator missing in the list.
+inline bool msgIdListed(MsgId id)
+{
+#define UBLOX_MSG_ID_CASE(name_, value_) case MsgId_ ## name_:
+    switch (id) {
+        UBLOX_MSG_ID_LIST(UBLOX_MSG_ID_CASE)
+            return true;
+    }
+#undef UBLOX_MSG_ID_CASE
+    return false;
+}
+
+}  // namespace details
+
 }  // namespace ublox
 
 
@@ -0,0 +1,209 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of compile time payload layout information.
+
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+#include "comms/comms.h"
+
+#include "details/FieldsLength.h"
+
+namespace ublox
+{
+
+namespace details
+{
+
+/// @brief Serialisation length of the list element being a field, 0 if
+///     not fixed.
+template <typename TElem>
+constexpr std::size_t listElemLength(
+    typename std::enable_if<std::is_class<TElem>::value>::type* = nullptr)
+{
+    return (TElem::minLength() == TElem::maxLength()) ? TElem::maxLength() : 0U;
+}
+
+/// @brief Serialisation length of the list element being raw data.
+template <typename TElem>
+constexpr std::size_t listElemLength(
+    typename std::enable_if<!std::is_class<TElem>::value>::type* = nullptr)
+{
+    return sizeof(TElem);
+}
+
+/// @brief Serialisation length of the single element of the list field,
+///     0 if the field is not a list or the length of the element is not
+///     fixed.
+template <typename TField>
+struct ListElemLength
+{
+    static const std::size_t Value = 0U;
+};
+
+template <typename TFieldBase, typename TElem, typename... TOptions>
+struct ListElemLength<comms::field::ArrayList<TFieldBase, TElem, TOptions...> >
+{
+    static const std::size_t Value = listElemLength<TElem>();
+};
+
+/// @brief Length of the repeated block, when the fields end with the list
+///     of fixed length elements preceded by the fixed length fields only,
+///     0 otherwise.
+template <typename TFields>
+struct TrailingBlockLength;
+
+template <>
+struct TrailingBlockLength<std::tuple<> >
+{
+    static const std::size_t Value = 0U;
+};
+
+template <typename... TFields>
+struct TrailingBlockLength<std::tuple<TFields...> >
+{
+    static const std::size_t NumOfFields = sizeof...(TFields);
+
+    static const bool FixedPrefix =
+        saturatedPrefixSum(MaxPayloadLengthLimit, NumOfFields - 1, TFields::minLength()...) ==
+        saturatedPrefixSum(MaxPayloadLengthLimit, NumOfFields - 1, TFields::maxLength()...);
+
+    typedef typename std::tuple_element<NumOfFields - 1, std::tuple<TFields...> >::type LastField;
+
+    static const std::size_t Value =
+        FixedPrefix ? ListElemLength<LastField>::Value : 0U;
+};
+
+}  // namespace details
+
+/// @brief Compile time layout information of the fields bundled in
+///     std::tuple.
+/// @details All the lengths are serialisation lengths in bytes, limited
+///     by the maximal value of @b LENGTH field of the frame
+///     (@ref details::MaxPayloadLengthLimit). All the member functions are
+///     @b constexpr, i.e. can be used in compile time evaluations as well
+///     as at run time.
+/// @code
+/// typedef ublox::MsgLayout<ublox::message::NavPvt<> > Layout;
+/// static_assert(Layout::FixedLength, "Fixed length is expected");
+/// static const std::size_t LonOffset =
+///     Layout::fieldOffset(ublox::message::NavPvt<>::FieldIdx_lon);
+/// @endcode
+/// @tparam TFields Fields bundled in std::tuple.
+template <typename TFields>
+struct FieldsLayout;
+
+template <typename... TFields>
+struct FieldsLayout<std::tuple<TFields...> >
+{
+    /// @brief All the fields bundled in std::tuple.
+    typedef std::tuple<TFields...> AllFields;
+
+    /// @brief Number of fields.
+    static const std::size_t NumOfFields = sizeof...(TFields);
+
+    /// @brief Minimal serialisation length of all the fields.
+    static const std::size_t MinLength =
+        details::FieldsMinLength<AllFields>::Value;
+
+    /// @brief Maximal serialisation length of all the fields.
+    static const std::size_t MaxLength =
+        details::FieldsMaxLength<AllFields>::Value;
+
+    /// @brief Whether the serialisation length of all the fields is fixed.
+    static const bool FixedLength = (MinLength == MaxLength);
+
+    /// @brief Length of the repeated block of variable length payload.
+    /// @details Non-zero when the fields end with the list of fixed length
+    ///     elements (such as message::NavSvinfoFields::data), i.e. the
+    ///     payload length is @ref MinLength plus multiple of the block length.
+    static const std::size_t BlockLength =
+        FixedLength ? 0U : details::TrailingBlockLength<AllFields>::Value;
+
+    /// @brief Minimal serialisation length of the field.
+    /// @param[in] idx Index of the field, 0 is returned for invalid one.
+    static constexpr std::size_t fieldMinLength(std::size_t idx)
+    {
+        return details::lengthAt(idx, TFields::minLength()...);
+    }
+
+    /// @brief Maximal serialisation length of the field.
+    /// @param[in] idx Index of the field, 0 is returned for invalid one.
+    static constexpr std::size_t fieldMaxLength(std::size_t idx)
+    {
+        return details::lengthAt(idx, TFields::maxLength()...);
+    }
+
+    /// @brief Whether the serialisation length of the field is fixed.
+    /// @param[in] idx Index of the field.
+    static constexpr bool fieldFixedLength(std::size_t idx)
+    {
+        return fieldMinLength(idx) == fieldMaxLength(idx);
+    }
+
+    /// @brief Minimal offset of the field from the beginning of the payload.
+    /// @details The offset is exact when fieldFixedOffset() returns true.
+    ///     The index equal to @ref NumOfFields is allowed, @ref MinLength
+    ///     is returned for it.
+    /// @param[in] idx Index of the field.
+    static constexpr std::size_t fieldOffset(std::size_t idx)
+    {
+        return
+            details::saturatedPrefixSum(
+                details::MaxPayloadLengthLimit, idx, TFields::minLength()...);
+    }
+
+    /// @brief Whether the offset of the field doesn't depend on the
+    ///     contents of the payload, i.e. all the preceding fields have
+    ///     fixed length.
+    /// @param[in] idx Index of the field.
+    static constexpr bool fieldFixedOffset(std::size_t idx)
+    {
+        return
+            fieldOffset(idx) ==
+            details::saturatedPrefixSum(
+                details::MaxPayloadLengthLimit, idx, TFields::maxLength()...);
+    }
+
+    /// @brief Check whether the payload length is allowed.
+    /// @details The length must be within [@ref MinLength, @ref MaxLength]
+    ///     range, and consist of whole blocks when @ref BlockLength is
+    ///     not 0.
+    /// @param[in] len Length of the payload.
+    static constexpr bool validLength(std::size_t len)
+    {
+        return
+            (MinLength <= len) &&
+            (len <= MaxLength) &&
+            ((BlockLength == 0U) || (((len - MinLength) % BlockLength) == 0U));
+    }
+};
+
+/// @brief Compile time layout information of the message payload.
+/// @details Same as @ref FieldsLayout of all the message fields.
+/// @tparam TMsg Message type, such as message::NavPvt.
+template <typename TMsg>
+using MsgLayout = FieldsLayout<typename TMsg::AllFields>;
+
+}  // namespace ublox
+
+
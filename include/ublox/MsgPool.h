@@ -0,0 +1,345 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::MsgPool class.
+
+#pragma once
+
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "MsgFactory.h"
+
+namespace ublox
+{
+
+namespace details
+{
+
+/// @brief Free list and usage statistics of single message type in
+///     @ref ublox::MsgPool.
+template <typename TMsgBase>
+class MsgPoolSlot
+{
+public:
+    MsgPoolSlot() = default;
+    MsgPoolSlot(const MsgPoolSlot&) = delete;
+    MsgPoolSlot& operator=(const MsgPoolSlot&) = delete;
+
+    ~MsgPoolSlot()
+    {
+        clear();
+    }
+
+    TMsgBase* acquire()
+    {
+        TMsgBase* msg = nullptr;
+        if (!m_free.empty()) {
+            msg = m_free.back();
+            m_free.pop_back();
+        }
+        return msg;
+    }
+
+    void reserve(std::size_t capacity)
+    {
+        m_free.reserve(capacity);
+    }
+
+    void acquired(bool created)
+    {
+        if (created) {
+            ++m_created;
+            // Every created object may end up in the free list, make sure
+            // its release doesn't allocate.
+            if (m_free.capacity() < m_created) {
+                m_free.reserve(std::max(m_created, 2U * m_free.capacity()));
+            }
+        }
+
+        ++m_inUse;
+        if (m_highWater < m_inUse) {
+            m_highWater = m_inUse;
+        }
+    }
+
+    void release(TMsgBase* msg)
+    {
+        --m_inUse;
+        m_free.push_back(msg);
+    }
+
+    void clear()
+    {
+        for (auto* msg : m_free) {
+            delete msg;
+        }
+        m_free.clear();
+    }
+
+    std::size_t inUseCount() const
+    {
+        return m_inUse;
+    }
+
+    std::size_t freeCount() const
+    {
+        return m_free.size();
+    }
+
+    std::size_t createdCount() const
+    {
+        return m_created;
+    }
+
+    std::size_t highWaterMark() const
+    {
+        return m_highWater;
+    }
+
+private:
+    std::vector<TMsgBase*> m_free;
+    std::size_t m_inUse = 0U;
+    std::size_t m_created = 0U;
+    std::size_t m_highWater = 0U;
+};
+
+/// @brief Restore default state of the recycled message object.
+/// @details The fields are copy assigned from the default constructed
+///     instance of the message, which assigns the scalar values, while
+///     the list and string fields are cleared in place and keep the
+///     capacity of their storage.
+template <typename TAllMessages, typename TMsgBase>
+struct MsgPoolResetters;
+
+template <typename... TMessages, typename TMsgBase>
+struct MsgPoolResetters<std::tuple<TMessages...>, TMsgBase>
+{
+    typedef void (*Resetter)(TMsgBase&);
+
+    template <typename TMsg>
+    static void reset(TMsgBase& msg)
+    {
+        static const TMsg Default;
+        static_cast<TMsg&>(msg).fields() = Default.fields();
+    }
+
+    static void reset(std::size_t idx, TMsgBase& msg)
+    {
+        static const Resetter Resetters[] = { &MsgPoolResetters::template reset<TMessages>... };
+        Resetters[idx](msg);
+    }
+};
+
+/// @brief Find index of the message type in the types bundled in std::tuple.
+template <typename TMsg, typename TAllMessages>
+struct MsgTypeIndex;
+
+template <typename TMsg, typename... TRest>
+struct MsgTypeIndex<TMsg, std::tuple<TMsg, TRest...> >
+{
+    static const std::size_t Value = 0U;
+};
+
+template <typename TMsg, typename TFirst, typename... TRest>
+struct MsgTypeIndex<TMsg, std::tuple<TFirst, TRest...> >
+{
+    static const std::size_t Value = 1U + MsgTypeIndex<TMsg, std::tuple<TRest...> >::Value;
+};
+
+}  // namespace details
+
+/// @brief Deleter of the message objects allocated by @ref ublox::MsgPool.
+/// @details Returns the message object to the free list of its type instead
+///     of destructing it. Default constructed deleter destructs the object.
+template <typename TMsgBase>
+class MsgPoolDeleter
+{
+public:
+    /// @brief Default constructor.
+    MsgPoolDeleter() = default;
+
+    /// @brief Constructor.
+    explicit MsgPoolDeleter(details::MsgPoolSlot<TMsgBase>* slot)
+      : m_slot(slot)
+    {
+    }
+
+    /// @brief Release the message object.
+    void operator()(TMsgBase* msg) const
+    {
+        if (m_slot == nullptr) {
+            delete msg;
+            return;
+        }
+
+        m_slot->release(msg);
+    }
+
+private:
+    details::MsgPoolSlot<TMsgBase>* m_slot = nullptr;
+};
+
+/// @brief Pool of recycled message objects.
+/// @details Keeps separate free list for every message type bundled in
+///     @b TAllMessages. The released message objects are not destructed,
+///     but returned to the free list of their type by the deleter of the
+///     smart pointer (@ref MsgPoolDeleter) and handed out again on the next
+///     allocation of the same type. As the result, once the pool is warmed
+///     up, reading the message involves neither new/delete of the message
+///     object nor reallocation of its list fields, which keep their capacity
+///     across the reads. @n
+///     Used by protocol::MsgIdLayer when ublox::option::PooledAllocation
+///     option is provided to @ref ublox::Stack. The pool is not thread safe
+///     and all the allocated message objects must be released before the pool
+///     is destructed.
+/// @tparam TMsgBase Common interface class for all the messages.
+/// @tparam TAllMessages All the message types bundled in std::tuple.
+template <typename TMsgBase, typename TAllMessages>
+class MsgPool
+{
+    typedef details::MsgPoolSlot<TMsgBase> Slot;
+
+public:
+    /// @brief Common interface class for all the messages.
+    typedef TMsgBase Message;
+
+    /// @brief All message types.
+    typedef TAllMessages AllMessages;
+
+    /// @brief Deleter of the allocated message objects.
+    typedef MsgPoolDeleter<Message> Deleter;
+
+    /// @brief Smart pointer to the allocated message object.
+    typedef std::unique_ptr<Message, Deleter> MsgPtr;
+
+    /// @brief Number of message types.
+    static const std::size_t NumOfMessages = std::tuple_size<AllMessages>::value;
+
+    /// @brief Default initial capacity of the free list of every message type.
+    static const std::size_t DefaultCapacity = 4U;
+
+    /// @brief Constructor.
+    /// @details Reserves the free lists, so returning the message objects
+    ///     to the pool doesn't allocate. The free list grows together with
+    ///     number of the created objects when the capacity is exceeded.
+    /// @param[in] capacity Initial capacity of the free list of every
+    ///     message type.
+    explicit MsgPool(std::size_t capacity = DefaultCapacity)
+    {
+        for (auto& slot : m_slots) {
+            slot.reserve(capacity);
+        }
+    }
+
+    /// @brief Copy constructor is deleted.
+    MsgPool(const MsgPool&) = delete;
+
+    /// @brief Copy assignment is deleted.
+    MsgPool& operator=(const MsgPool&) = delete;
+
+    /// @brief Allocate message object by the index of its type.
+    /// @details The recycled object retains the contents of the previous
+    ///     message, including the modes of the optional fields, use
+    ///     @ref createByIndex() to get the object in its default state
+    ///     (for example before reading it).
+    MsgPtr allocByIndex(std::size_t idx)
+    {
+        auto& slot = m_slots[idx];
+        auto* msg = slot.acquire();
+        bool created = (msg == nullptr);
+        if (created) {
+            msg = details::MsgFactoryCreators<AllMessages, Message*>::create(idx);
+        }
+
+        slot.acquired(created);
+        return MsgPtr(msg, Deleter(&slot));
+    }
+
+    /// @brief Allocate message object in its default state by the index
+    ///     of its type.
+    /// @details The recycled object is reset without reallocation of its
+    ///     list and string fields.
+    MsgPtr createByIndex(std::size_t idx)
+    {
+        auto msg = allocByIndex(idx);
+        details::MsgPoolResetters<AllMessages, Message>::reset(idx, *msg);
+        return msg;
+    }
+
+    /// @brief Destruct all the message objects in the free lists.
+    void clear()
+    {
+        for (auto& slot : m_slots) {
+            slot.clear();
+        }
+    }
+
+    /// @brief Get number of currently allocated objects of the message type.
+    std::size_t inUseCount(std::size_t idx) const
+    {
+        return m_slots[idx].inUseCount();
+    }
+
+    /// @brief Get number of the objects of the message type in the free list.
+    std::size_t freeCount(std::size_t idx) const
+    {
+        return m_slots[idx].freeCount();
+    }
+
+    /// @brief Get number of objects of the message type created with
+    ///     dynamic memory allocation.
+    std::size_t createdCount(std::size_t idx) const
+    {
+        return m_slots[idx].createdCount();
+    }
+
+    /// @brief Get maximal number of simultaneously allocated objects of the
+    ///     message type.
+    std::size_t highWaterMark(std::size_t idx) const
+    {
+        return m_slots[idx].highWaterMark();
+    }
+
+    /// @brief Get index of the message type.
+    template <typename TMsg>
+    static constexpr std::size_t indexOf()
+    {
+        return details::MsgTypeIndex<TMsg, AllMessages>::Value;
+    }
+
+    /// @brief Get maximal number of simultaneously allocated objects of the
+    ///     message type.
+    template <typename TMsg>
+    std::size_t highWaterMark() const
+    {
+        return highWaterMark(indexOf<TMsg>());
+    }
+
+private:
+    std::array<Slot, NumOfMessages> m_slots;
+};
+
+}  // namespace ublox
+
+
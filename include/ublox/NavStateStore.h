@@ -0,0 +1,306 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::NavStateStore class.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <type_traits>
+
+#include "message/NavPvt.h"
+#include "message/NavSol.h"
+#include "message/NavTimeutc.h"
+
+namespace ublox
+{
+
+/// @brief Flat snapshot of the latest navigation state.
+/// @details All the values are kept in units of the relevant fields of the
+///     messages they are taken from, see @ref message::NavPvtFields,
+///     @ref message::NavSolFields and @ref message::NavTimeutcFields.
+struct NavState
+{
+    /// @brief Bits of @ref sources member.
+    enum Source : std::uint8_t
+    {
+        Source_NavPvt = 0x1, ///< NAV-PVT was received
+        Source_NavSol = 0x2, ///< NAV-SOL was received
+        Source_NavTimeutc = 0x4 ///< NAV-TIMEUTC was received
+    };
+
+    // time
+    std::uint32_t iTOW = 0U; ///< GPS time of week of the latest update, ms
+    std::int32_t fTOW = 0; ///< fractional part of iTOW, ns (NAV-SOL)
+    std::int16_t week = 0; ///< GPS week number (NAV-SOL)
+    std::uint16_t year = 0U; ///< UTC year
+    std::uint8_t month = 0U; ///< UTC month
+    std::uint8_t day = 0U; ///< UTC day
+    std::uint8_t hour = 0U; ///< UTC hour
+    std::uint8_t min = 0U; ///< UTC minute
+    std::uint8_t sec = 0U; ///< UTC second
+    std::uint8_t dateValid = 0U; ///< UTC date is valid
+    std::uint8_t timeValid = 0U; ///< UTC time is valid
+    std::uint8_t weekValid = 0U; ///< GPS week number is valid
+    std::int32_t nano = 0; ///< fraction of UTC second, ns
+    std::uint32_t tAcc = 0U; ///< time accuracy estimate, ns
+
+    // fix
+    std::uint8_t fixType = 0U; ///< value of @ref field::nav::GpsFix
+    std::uint8_t fixOk = 0U; ///< fix is within DOP and accuracy masks
+    std::uint8_t diffSoln = 0U; ///< differential corrections were applied
+    std::uint8_t numSV = 0U; ///< number of satellites used in solution
+    std::uint16_t pDOP = 0U; ///< position DOP, 0.01
+
+    // position
+    std::int32_t lon = 0; ///< longitude, 1e-7 deg
+    std::int32_t lat = 0; ///< latitude, 1e-7 deg
+    std::int32_t height = 0; ///< height above ellipsoid, mm
+    std::int32_t hMSL = 0; ///< height above mean sea level, mm
+    std::uint32_t hAcc = 0U; ///< horizontal accuracy estimate, mm
+    std::uint32_t vAcc = 0U; ///< vertical accuracy estimate, mm
+    std::int32_t ecefX = 0; ///< ECEF X coordinate, cm
+    std::int32_t ecefY = 0; ///< ECEF Y coordinate, cm
+    std::int32_t ecefZ = 0; ///< ECEF Z coordinate, cm
+    std::uint32_t pAcc = 0U; ///< 3D position accuracy estimate, cm
+
+    // velocity
+    std::int32_t velN = 0; ///< NED north velocity, mm/s
+    std::int32_t velE = 0; ///< NED east velocity, mm/s
+    std::int32_t velD = 0; ///< NED down velocity, mm/s
+    std::int32_t gSpeed = 0; ///< ground speed, mm/s
+    std::int32_t heading = 0; ///< heading of motion, 1e-5 deg
+    std::uint32_t sAcc = 0U; ///< speed accuracy estimate, mm/s
+    std::uint32_t headingAcc = 0U; ///< heading accuracy estimate, 1e-5 deg
+    std::int32_t ecefVX = 0; ///< ECEF X velocity, cm/s
+    std::int32_t ecefVY = 0; ///< ECEF Y velocity, cm/s
+    std::int32_t ecefVZ = 0; ///< ECEF Z velocity, cm/s
+
+    std::uint8_t sources = 0U; ///< bitmask of @ref Source values
+    std::uint32_t updates = 0U; ///< number of updates since creation
+};
+
+/// @brief Store of the latest navigation state shared between the threads.
+/// @details Expected to be updated by the single thread (writer) handling
+///     the messages read by the @ref Stack, and read by any number of
+///     threads. The snapshot is published using sequence lock: the readers
+///     never block the writer and never take any lock, they only retry the
+///     copy of the snapshot in the unlikely case it was being updated at the
+///     same time. The snapshot is kept in the array of atomic words, i.e.
+///     there is no data race in terms of C++ memory model.
+/// @code
+/// ublox::NavStateStore store;
+///
+/// // Writer thread
+/// msg->dispatch(store); // or store.handle(pvtMsg);
+///
+/// // Reader threads
+/// auto state = store.read();
+/// auto lat = state.lat;
+/// @endcode
+class NavStateStore
+{
+public:
+    /// @brief Default constructor
+    NavStateStore()
+    {
+        storeWords();
+    }
+
+    /// @brief Update the state with NAV-PVT message (writer thread only).
+    template <typename TMsgBase>
+    void handle(const message::NavPvt<TMsgBase>& msg)
+    {
+        typedef message::NavPvt<TMsgBase> Msg;
+        auto& fields = msg.fields();
+        auto& s = m_current;
+        s.iTOW = std::get<Msg::FieldIdx_iTOW>(fields).value();
+        s.year = std::get<Msg::FieldIdx_year>(fields).value();
+        s.month = std::get<Msg::FieldIdx_month>(fields).value();
+        s.day = std::get<Msg::FieldIdx_day>(fields).value();
+        s.hour = std::get<Msg::FieldIdx_hour>(fields).value();
+        s.min = std::get<Msg::FieldIdx_min>(fields).value();
+        s.sec = std::get<Msg::FieldIdx_sec>(fields).value();
+        auto valid = std::get<Msg::FieldIdx_valid>(fields).value();
+        s.dateValid = static_cast<std::uint8_t>(valid & 0x1);
+        s.timeValid = static_cast<std::uint8_t>((valid >> 1) & 0x1);
+        s.tAcc = std::get<Msg::FieldIdx_tAcc>(fields).value();
+        s.nano = std::get<Msg::FieldIdx_nano>(fields).value();
+        s.fixType = static_cast<std::uint8_t>(std::get<Msg::FieldIdx_fixType>(fields).value());
+        auto flags = std::get<0>(std::get<Msg::FieldIdx_flags>(fields).value()).value();
+        s.fixOk = static_cast<std::uint8_t>(flags & 0x1);
+        s.diffSoln = static_cast<std::uint8_t>((flags >> 1) & 0x1);
+        s.numSV = std::get<Msg::FieldIdx_numSV>(fields).value();
+        s.lon = std::get<Msg::FieldIdx_lon>(fields).value();
+        s.lat = std::get<Msg::FieldIdx_lat>(fields).value();
+        s.height = std::get<Msg::FieldIdx_height>(fields).value();
+        s.hMSL = std::get<Msg::FieldIdx_hMSL>(fields).value();
+        s.hAcc = std::get<Msg::FieldIdx_hAcc>(fields).value();
+        s.vAcc = std::get<Msg::FieldIdx_vAcc>(fields).value();
+        s.velN = std::get<Msg::FieldIdx_velN>(fields).value();
+        s.velE = std::get<Msg::FieldIdx_velE>(fields).value();
+        s.velD = std::get<Msg::FieldIdx_velD>(fields).value();
+        s.gSpeed = std::get<Msg::FieldIdx_gSpeed>(fields).value();
+        s.heading = std::get<Msg::FieldIdx_heading>(fields).value();
+        s.sAcc = std::get<Msg::FieldIdx_sAcc>(fields).value();
+        s.headingAcc = std::get<Msg::FieldIdx_headingAcc>(fields).value();
+        s.pDOP = std::get<Msg::FieldIdx_pDOP>(fields).value();
+        s.sources |= NavState::Source_NavPvt;
+        publish();
+    }
+
+    /// @brief Update the state with NAV-SOL message (writer thread only).
+    template <typename TMsgBase>
+    void handle(const message::NavSol<TMsgBase>& msg)
+    {
+        typedef message::NavSol<TMsgBase> Msg;
+        auto& fields = msg.fields();
+        auto& s = m_current;
+        s.iTOW = std::get<Msg::FieldIdx_iTOW>(fields).value();
+        s.fTOW = std::get<Msg::FieldIdx_fTOW>(fields).value();
+        s.week = std::get<Msg::FieldIdx_week>(fields).value();
+        s.fixType = static_cast<std::uint8_t>(std::get<Msg::FieldIdx_gpsFix>(fields).value());
+        auto flags = std::get<Msg::FieldIdx_flags>(fields).value();
+        s.fixOk = static_cast<std::uint8_t>(flags & 0x1);
+        s.diffSoln = static_cast<std::uint8_t>((flags >> 1) & 0x1);
+        s.weekValid = static_cast<std::uint8_t>((flags >> 2) & 0x1);
+        s.ecefX = std::get<Msg::FieldIdx_ecefX>(fields).value();
+        s.ecefY = std::get<Msg::FieldIdx_ecefY>(fields).value();
+        s.ecefZ = std::get<Msg::FieldIdx_ecefZ>(fields).value();
+        s.pAcc = std::get<Msg::FieldIdx_pAcc>(fields).value();
+        s.ecefVX = std::get<Msg::FieldIdx_ecefVX>(fields).value();
+        s.ecefVY = std::get<Msg::FieldIdx_ecefVY>(fields).value();
+        s.ecefVZ = std::get<Msg::FieldIdx_ecefVZ>(fields).value();
+        s.pDOP = std::get<Msg::FieldIdx_pDOP>(fields).value();
+        s.numSV = std::get<Msg::FieldIdx_numSV>(fields).value();
+        s.sources |= NavState::Source_NavSol;
+        publish();
+    }
+
+    /// @brief Update the state with NAV-TIMEUTC message (writer thread only).
+    template <typename TMsgBase>
+    void handle(const message::NavTimeutc<TMsgBase>& msg)
+    {
+        typedef message::NavTimeutc<TMsgBase> Msg;
+        auto& fields = msg.fields();
+        auto& s = m_current;
+        s.iTOW = std::get<Msg::FieldIdx_iTOW>(fields).value();
+        s.tAcc = std::get<Msg::FieldIdx_tAcc>(fields).value();
+        s.nano = std::get<Msg::FieldIdx_nano>(fields).value();
+        s.year = std::get<Msg::FieldIdx_year>(fields).value();
+        s.month = std::get<Msg::FieldIdx_month>(fields).value();
+        s.day = std::get<Msg::FieldIdx_day>(fields).value();
+        s.hour = std::get<Msg::FieldIdx_hour>(fields).value();
+        s.min = std::get<Msg::FieldIdx_min>(fields).value();
+        s.sec = std::get<Msg::FieldIdx_sec>(fields).value();
+        auto utcValid =
+            static_cast<std::uint8_t>((std::get<Msg::FieldIdx_valid>(fields).value() >> 2) & 0x1);
+        s.dateValid = utcValid;
+        s.timeValid = utcValid;
+        s.sources |= NavState::Source_NavTimeutc;
+        publish();
+    }
+
+    /// @brief Handle any other message, ignored.
+    template <typename TMsg>
+    void handle(const TMsg&)
+    {
+    }
+
+    /// @brief Get copy of the latest state (any thread).
+    /// @details Yields the processor between the attempts, so the writer
+    ///     preempted in the middle of the update is not starved.
+    NavState read() const
+    {
+        NavState state;
+        while (!tryRead(state)) {
+            std::this_thread::yield();
+        }
+        return state;
+    }
+
+    /// @brief Try to get copy of the latest state (any thread).
+    /// @return false if the state was being updated at the same time,
+    ///     the output value is not valid.
+    bool tryRead(NavState& state) const
+    {
+        auto before = m_seq.load(std::memory_order_acquire);
+        if ((before & 0x1) != 0U) {
+            return false;
+        }
+
+        Words words;
+        for (std::size_t idx = 0U; idx < NumOfWords; ++idx) {
+            words[idx] = m_words[idx].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_seq.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+
+        std::memcpy(static_cast<void*>(&state), words.data(), sizeof(state));
+        return true;
+    }
+
+    /// @brief Number of updates published so far (any thread).
+    std::uint32_t updateCount() const
+    {
+        return m_seq.load(std::memory_order_acquire) / 2U;
+    }
+
+private:
+    static_assert(std::is_trivially_copyable<NavState>::value,
+        "NavState is expected to be trivially copyable");
+
+    typedef std::uint64_t Word;
+    static const std::size_t NumOfWords = (sizeof(NavState) + sizeof(Word) - 1U) / sizeof(Word);
+    typedef std::array<Word, NumOfWords> Words;
+
+    void publish()
+    {
+        ++m_current.updates;
+        auto seq = m_seq.load(std::memory_order_relaxed);
+        m_seq.store(seq + 1U, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        storeWords();
+        m_seq.store(seq + 2U, std::memory_order_release);
+    }
+
+    void storeWords()
+    {
+        Words words = Words();
+        std::memcpy(words.data(), &m_current, sizeof(m_current));
+        for (std::size_t idx = 0U; idx < NumOfWords; ++idx) {
+            m_words[idx].store(words[idx], std::memory_order_relaxed);
+        }
+    }
+
+    NavState m_current;
+    alignas(64) std::atomic<std::uint32_t> m_seq{0U};
+    std::array<std::atomic<Word>, NumOfWords> m_words;
+};
+
+}  // namespace ublox
+
+
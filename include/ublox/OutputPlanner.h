@@ -0,0 +1,478 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::OutputPlanner class.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <vector>
+
+#include "MsgId.h"
+#include "MsgFactory.h"
+#include "LinkBudget.h"
+#include "options.h"
+#include "message/CfgMsg.h"
+#include "message/CfgMsgCurrent.h"
+#include "message/CfgRate.h"
+#include "message/NavSvinfo.h"
+#include "message/RxmRaw.h"
+#include "message/RxmSvsi.h"
+
+namespace ublox
+{
+
+namespace details
+{
+
+/// @brief Worst case number of the repeated blocks in the message.
+/// @details The capacity specified in the storage profile for the lists
+///     mentioned there, maximal number of channels for all other lists.
+template <typename TMsg, typename TListStorage>
+struct WorstCaseBlocks
+{
+    static const std::size_t Value = TListStorage::MaxChannels;
+};
+
+template <typename TMsgBase, typename TOptions, typename TListStorage>
+struct WorstCaseBlocks<message::NavSvinfo<TMsgBase, TOptions>, TListStorage>
+{
+    static const std::size_t Value = TListStorage::NavSvinfoData;
+};
+
+template <typename TMsgBase, typename TOptions, typename TListStorage>
+struct WorstCaseBlocks<message::RxmRaw<TMsgBase, TOptions>, TListStorage>
+{
+    static const std::size_t Value = TListStorage::RxmRawData;
+};
+
+template <typename TMsgBase, typename TOptions, typename TListStorage>
+struct WorstCaseBlocks<message::RxmSvsi<TMsgBase, TOptions>, TListStorage>
+{
+    static const std::size_t Value = TListStorage::RxmSvsiData;
+};
+
+/// @brief Worst case length of the frame of the message.
+template <typename TMsg, typename TListStorage>
+constexpr std::size_t worstCaseFrameLength()
+{
+    return
+        maxFrameLength<TMsg>(
+            MsgLayout<TMsg>::BlockLength == 0U ? 0U :
+            WorstCaseBlocks<TMsg, TListStorage>::Value);
+}
+
+}  // namespace details
+
+/// @brief Planner of the periodic output of the receiver's port.
+/// @details The receiver outputs the message every @b rate navigation
+///     epochs, as configured by CFG-MSG, where the epoch period is configured
+///     by CFG-RATE. All the messages are aligned to the same epoch count,
+///     i.e. once in a while all the enabled messages are output in the same
+///     epoch, and the resulting burst has to fit the transmit buffer of the
+///     port. The average output has to fit the capacity of the link,
+///     configured by CFG-PRT.@n
+///     The planner calculates both using the worst case frame length of
+///     every message: exact for the messages with fixed length payload, and
+///     the maximal number of the repeated blocks according to @b TListStorage
+///     profile (see @ref option::FixedListStorage) for the messages ending
+///     with the list of blocks (such as message::NavSvinfo), and the maximal
+///     length for other variable length messages (see @ref maxFrameLength()).
+///     The minimal length is used when the payload length is unbounded,
+///     use setFrameLength() to override it.
+/// @code
+/// typedef std::tuple<
+///     ublox::message::NavPvt<>,
+///     ublox::message::NavSvinfo<>,
+///     ublox::message::RxmRaw<>
+/// > OutputMessages;
+/// ublox::OutputPlanner<OutputMessages> planner;
+/// planner.setRate(cfgRateMsg);
+/// planner.setPort(cfgPrtUartMsg);
+/// planner.setMsgRate(ublox::MsgId_NAV_PVT, 1);
+/// planner.setMsgRate(ublox::MsgId_NAV_SVINFO, 1);
+/// planner.setMsgRate(ublox::MsgId_RXM_RAW, 1);
+/// if (!planner.evaluate().feasible) {
+///     auto rates = planner.suggest();
+///     ...
+/// }
+/// @endcode
+/// @tparam TMessages Output messages bundled in std::tuple.
+/// @tparam TListStorage Storage profile defining the worst case number
+///     of the repeated blocks.
+template <typename TMessages, typename TListStorage = option::FixedListStorage>
+class OutputPlanner
+{
+public:
+    /// @brief Number of the known messages.
+    static const std::size_t NumOfMessages = std::tuple_size<TMessages>::value;
+
+    /// @brief Default link capacity, bytes per second (9600 baud, 8N1).
+    static const unsigned DefaultLinkCapacity = 960U;
+
+    /// @brief Default maximal utilisation of the link, percent.
+    static const unsigned DefaultUtilisation = 80U;
+
+    /// @brief Default length of the transmit buffer of the port, bytes.
+    static const std::size_t DefaultTxBufferLength = 4096U;
+
+    /// @brief Default measurement period, milliseconds.
+    static const unsigned DefaultMeasPeriodMs = 1000U;
+
+    /// @brief Output rate of the single message.
+    struct MsgRate
+    {
+        /// @brief ID of the message.
+        MsgId id;
+
+        /// @brief Number of the epochs between the outputs, @b 0 means
+        ///     disabled.
+        std::uint8_t rate;
+    };
+
+    /// @brief List of the output rates.
+    typedef std::vector<MsgRate> MsgRates;
+
+    /// @brief Result of the plan evaluation.
+    struct Plan
+    {
+        /// @brief Average number of bytes per second.
+        double bytesPerSecond = 0.0;
+
+        /// @brief Number of bytes output in the epoch when all the enabled
+        ///     messages are output.
+        std::size_t burstLength = 0U;
+
+        /// @brief Number of bytes per second allowed by the utilisation limit.
+        double budget = 0.0;
+
+        /// @brief Average output fits the budget.
+        bool rateFits = true;
+
+        /// @brief Burst fits the transmit buffer.
+        bool burstFits = true;
+
+        /// @brief Both average output and burst fit.
+        bool feasible = true;
+    };
+
+    /// @brief Default constructor.
+    OutputPlanner()
+    {
+        initInfos(typename details::MakeIndexSeq<NumOfMessages>::Type());
+    }
+
+    /// @brief Set capacity of the link.
+    /// @param[in] bytesPerSecond Number of bytes per second the receiver
+    ///     can transmit.
+    void setLinkCapacity(double bytesPerSecond)
+    {
+        m_capacity = std::max(bytesPerSecond, 0.0);
+    }
+
+    /// @brief Set capacity of the link from the UART port configuration.
+    /// @param[in] msg CFG-PRT (UART) message, see @ref uartBytesPerSecond().
+    template <typename TMsgBase>
+    void setPort(const message::CfgPrtUart<TMsgBase>& msg)
+    {
+        setLinkCapacity(uartBytesPerSecond(msg));
+    }
+
+    /// @brief Set maximal utilisation of the link, percent, limited to 100.
+    void setUtilisation(unsigned percent)
+    {
+        m_utilisation = std::min(percent, 100U);
+    }
+
+    /// @brief Set length of the transmit buffer of the port.
+    void setTxBufferLength(std::size_t len)
+    {
+        m_txBufferLength = len;
+    }
+
+    /// @brief Set measurement (epoch) period.
+    /// @param[in] ms Period in milliseconds, @b 0 is ignored.
+    void setMeasPeriod(unsigned ms)
+    {
+        if (ms != 0U) {
+            m_measPeriodMs = ms;
+        }
+    }
+
+    /// @brief Set measurement period from CFG-RATE message.
+    template <typename TMsgBase>
+    void setRate(const message::CfgRate<TMsgBase>& msg)
+    {
+        typedef message::CfgRate<TMsgBase> Msg;
+        setMeasPeriod(static_cast<unsigned>(std::get<Msg::FieldIdx_measRate>(msg.fields()).value()));
+    }
+
+    /// @brief Set output rate of the message.
+    /// @param[in] id ID of the message.
+    /// @param[in] rate Number of the epochs between the outputs, @b 0
+    ///     disables the output.
+    /// @return false if the message is not known to the planner.
+    bool setMsgRate(MsgId id, std::uint8_t rate)
+    {
+        auto idx = indexOf(id);
+        if (NumOfMessages <= idx) {
+            return false;
+        }
+
+        m_rates[idx] = rate;
+        return true;
+    }
+
+    /// @brief Set output rate of the message from CFG-MSG (current port).
+    template <typename TMsgBase>
+    bool setMsgRate(const message::CfgMsgCurrent<TMsgBase>& msg)
+    {
+        typedef message::CfgMsgCurrent<TMsgBase> Msg;
+        auto& fields = msg.fields();
+        return
+            setMsgRate(
+                std::get<Msg::FieldIdx_id>(fields).value(),
+                static_cast<std::uint8_t>(std::get<Msg::FieldIdx_rate>(fields).value()));
+    }
+
+    /// @brief Set output rate of the message from CFG-MSG (all ports).
+    /// @param[in] msg CFG-MSG message.
+    /// @param[in] port Index of the port (I/O target) in the rates list.
+    template <typename TMsgBase>
+    bool setMsgRate(const message::CfgMsg<TMsgBase>& msg, std::size_t port)
+    {
+        typedef message::CfgMsg<TMsgBase> Msg;
+        auto& fields = msg.fields();
+        auto& rates = std::get<Msg::FieldIdx_rate>(fields).value();
+        if (rates.size() <= port) {
+            return false;
+        }
+
+        return
+            setMsgRate(
+                std::get<Msg::FieldIdx_id>(fields).value(),
+                static_cast<std::uint8_t>(rates[port].value()));
+    }
+
+    /// @brief Override worst case frame length of the message.
+    /// @return false if the message is not known to the planner.
+    bool setFrameLength(MsgId id, std::size_t len)
+    {
+        auto idx = indexOf(id);
+        if (NumOfMessages <= idx) {
+            return false;
+        }
+
+        m_infos[idx].frameLength = len;
+        return true;
+    }
+
+    /// @brief Worst case frame length of the message, @b 0 if the message
+    ///     is not known to the planner.
+    std::size_t frameLength(MsgId id) const
+    {
+        auto idx = indexOf(id);
+        if (NumOfMessages <= idx) {
+            return 0U;
+        }
+        return m_infos[idx].frameLength;
+    }
+
+    /// @brief Current output rates of all the known messages.
+    MsgRates rates() const
+    {
+        MsgRates result;
+        result.reserve(NumOfMessages);
+        for (std::size_t idx = 0U; idx < NumOfMessages; ++idx) {
+            MsgRate entry;
+            entry.id = m_infos[idx].id;
+            entry.rate = m_rates[idx];
+            result.push_back(entry);
+        }
+        return result;
+    }
+
+    /// @brief Evaluate current output rates.
+    Plan evaluate() const
+    {
+        return evaluate(m_rates);
+    }
+
+    /// @brief Suggest feasible output rates.
+    /// @details Starting with the current rates, the output of the message
+    ///     with the largest contribution to the average output is reduced
+    ///     by doubling its rate (number of epochs between the outputs),
+    ///     limited to 255, until the average output fits the budget. The
+    ///     message already output every 255 epochs is skipped in favour of
+    ///     the next largest contribution, and only when none of the enabled
+    ///     messages can be reduced any further the ones with the longest
+    ///     frames are disabled. Then the messages
+    ///     with the longest frames are disabled until the burst fits the
+    ///     transmit buffer. The current rates are not modified, use
+    ///     setMsgRate() to apply the suggestion.
+    /// @return Rates of all the known messages, the ones differing from
+    ///     the current rates are adjusted.
+    MsgRates suggest() const
+    {
+        auto rates = m_rates;
+        while (true) {
+            auto plan = evaluate(rates);
+            if (plan.feasible) {
+                break;
+            }
+
+            if ((!plan.rateFits) && reduceLargestLoad(rates)) {
+                continue;
+            }
+
+            disableLongest(rates);
+        }
+
+        MsgRates result;
+        result.reserve(NumOfMessages);
+        for (std::size_t idx = 0U; idx < NumOfMessages; ++idx) {
+            MsgRate entry;
+            entry.id = m_infos[idx].id;
+            entry.rate = rates[idx];
+            result.push_back(entry);
+        }
+        return result;
+    }
+
+private:
+    struct MsgInfo
+    {
+        MsgId id;
+        std::size_t frameLength;
+    };
+
+    typedef std::array<MsgInfo, NumOfMessages> Infos;
+    typedef std::array<std::uint8_t, NumOfMessages> Rates;
+
+    template <std::size_t... TIdx>
+    void initInfos(details::IndexSeq<TIdx...>)
+    {
+        int dummy[] = {(initInfo<TIdx>(), 0)..., 0};
+        static_cast<void>(dummy);
+    }
+
+    template <std::size_t TIdx>
+    void initInfo()
+    {
+        typedef typename std::tuple_element<TIdx, TMessages>::type Msg;
+        m_infos[TIdx].id = details::StaticMsgIdRetriever<Msg>::Value;
+        m_infos[TIdx].frameLength = details::worstCaseFrameLength<Msg, TListStorage>();
+        m_rates[TIdx] = 0U;
+    }
+
+    std::size_t indexOf(MsgId id) const
+    {
+        std::size_t idx = 0U;
+        while ((idx < NumOfMessages) && (m_infos[idx].id != id)) {
+            ++idx;
+        }
+        return idx;
+    }
+
+    double load(std::size_t idx, std::uint8_t rate) const
+    {
+        if (rate == 0U) {
+            return 0.0;
+        }
+
+        return
+            (static_cast<double>(m_infos[idx].frameLength) * 1000.0) /
+            (static_cast<double>(m_measPeriodMs) * rate);
+    }
+
+    Plan evaluate(const Rates& rates) const
+    {
+        Plan plan;
+        for (std::size_t idx = 0U; idx < NumOfMessages; ++idx) {
+            if (rates[idx] == 0U) {
+                continue;
+            }
+
+            plan.bytesPerSecond += load(idx, rates[idx]);
+            plan.burstLength += m_infos[idx].frameLength;
+        }
+
+        plan.budget = (m_capacity * m_utilisation) / 100U;
+        plan.rateFits = (plan.bytesPerSecond <= plan.budget);
+        plan.burstFits = (plan.burstLength <= m_txBufferLength);
+        plan.feasible = plan.rateFits && plan.burstFits;
+        return plan;
+    }
+
+    bool reduceLargestLoad(Rates& rates) const
+    {
+        static const unsigned MaxRate = 0xff;
+        std::size_t largest = NumOfMessages;
+        double largestLoad = 0.0;
+        for (std::size_t idx = 0U; idx < NumOfMessages; ++idx) {
+            if (MaxRate <= rates[idx]) {
+                continue;
+            }
+
+            auto msgLoad = load(idx, rates[idx]);
+            if (largestLoad < msgLoad) {
+                largest = idx;
+                largestLoad = msgLoad;
+            }
+        }
+
+        if (NumOfMessages <= largest) {
+            return false;
+        }
+
+        auto rate = static_cast<unsigned>(rates[largest]) * 2U;
+        rates[largest] = static_cast<std::uint8_t>(std::min(rate, MaxRate));
+        return true;
+    }
+
+    void disableLongest(Rates& rates) const
+    {
+        std::size_t longest = NumOfMessages;
+        for (std::size_t idx = 0U; idx < NumOfMessages; ++idx) {
+            if ((rates[idx] != 0U) &&
+                ((NumOfMessages <= longest) ||
+                 (m_infos[longest].frameLength < m_infos[idx].frameLength))) {
+                longest = idx;
+            }
+        }
+
+        if (longest < NumOfMessages) {
+            rates[longest] = 0U;
+        }
+    }
+
+    Infos m_infos;
+    Rates m_rates;
+    double m_capacity = DefaultLinkCapacity;
+    unsigned m_utilisation = DefaultUtilisation;
+    std::size_t m_txBufferLength = DefaultTxBufferLength;
+    unsigned m_measPeriodMs = DefaultMeasPeriodMs;
+};
+
+}  // namespace ublox
+
+
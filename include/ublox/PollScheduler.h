@@ -0,0 +1,546 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::PollScheduler class.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "MsgId.h"
+#include "MsgFactory.h"
+#include "LinkBudget.h"
+#include "details/FrameWriter.h"
+
+namespace ublox
+{
+
+/// @brief Scheduler of the periodic polls (such as message::MonHwPoll),
+///     which respects the capacity of the link.
+/// @details The responses to the polls share the output direction of the
+///     receiver's port with the periodic output (such as NAV-PVT). Sending
+///     the polls whenever their timers expire may exceed the capacity
+///     of the link, the responses accumulate in the transmit buffer of the
+///     receiver, which eventually overflows. The scheduler knows the
+///     expected length and number of the response frames (for example
+///     AID-ALM poll is answered with a frame per satellite) and sends the
+///     polls only when the budget allows it. The budget is maintained as a
+///     token bucket, replenished at the rate of the link capacity (see
+///     setPort() or setLinkCapacity()) limited by the utilisation
+///     percentage, minus the load of the periodic output (see
+///     setPeriodicLoad()). The capacity of the bucket (see
+///     setBurstLength()) limits the number of bytes the receiver is
+///     allowed to queue at once. The due polls are sent in the order of
+///     their due time, the one that doesn't fit the budget holds back the
+///     others, i.e. the long responses are not starved by the short ones.@n
+///     The poll is pending from the moment it's sent until the expected
+///     number of the messages with the same ID is received or the response
+///     timeout expires. The pending poll is not sent again, and the
+///     identical polls (same ID and payload) added or triggered while
+///     pending or due are coalesced.@n
+///     The object doesn't perform any I/O nor has its own thread, the frames
+///     are passed to the provided send handler, the received messages are
+///     passed in by the handle() member function (suitable for message
+///     dispatch), and @ref tick() is expected to be called periodically.
+/// @code
+/// ublox::PollScheduler scheduler(
+///     [&engine, dev](const std::uint8_t* data, std::size_t len)
+///     {
+///         return engine.send(dev, data, len);
+///     });
+/// scheduler.setPort(cfgPrtUartMsg);
+/// scheduler.add<ublox::message::MonHw<> >(
+///     ublox::message::MonHwPoll<>(), std::chrono::seconds(5));
+/// scheduler.add<ublox::message::MonIo<> >(
+///     ublox::message::MonIoPoll<>(), std::chrono::seconds(10), 3);
+/// scheduler.add<ublox::message::AidAlm<> >(
+///     ublox::message::AidAlmPoll<>(), std::chrono::minutes(10), 0, 32);
+/// ...
+/// msg->dispatch(scheduler); // for every received message
+/// ...
+/// scheduler.tick(); // periodically
+/// @endcode
+class PollScheduler
+{
+public:
+    /// @brief Clock used to schedule the polls.
+    typedef std::chrono::steady_clock Clock;
+
+    /// @brief Point in time.
+    typedef Clock::time_point TimePoint;
+
+    /// @brief Duration.
+    typedef Clock::duration Duration;
+
+    /// @brief Type of the send handler.
+    /// @details Receives the complete frame, expected to return @b true
+    ///     when it was sent (or queued for sending).
+    typedef std::function<bool (const std::uint8_t*, std::size_t)> SendHandler;
+
+    /// @brief Identifier of the poll.
+    typedef std::size_t PollId;
+
+    /// @brief Value of the poll identifier indicating failure.
+    static const PollId InvalidPoll = static_cast<PollId>(-1);
+
+    /// @brief Default link capacity, bytes per second (9600 baud, 8N1).
+    static const unsigned DefaultLinkCapacity = 960U;
+
+    /// @brief Default maximal utilisation of the link, percent.
+    static const unsigned DefaultUtilisation = 80U;
+
+    /// @brief Default capacity of the token bucket, bytes.
+    static const std::size_t DefaultBurstLength = 1024U;
+
+    /// @brief Default time to wait for the response, in milliseconds.
+    static const unsigned DefaultResponseTimeoutMs = 1000U;
+
+    /// @brief Constructor
+    /// @param[in] sendHandler Handler sending the frames.
+    explicit PollScheduler(SendHandler sendHandler)
+      : m_sendHandler(std::move(sendHandler)),
+        m_responseTimeout(std::chrono::milliseconds(static_cast<unsigned>(DefaultResponseTimeoutMs)))
+    {
+    }
+
+    /// @brief Set capacity of the link.
+    /// @param[in] bytesPerSecond Number of bytes per second the receiver
+    ///     can transmit.
+    void setLinkCapacity(double bytesPerSecond)
+    {
+        m_capacity = std::max(bytesPerSecond, 0.0);
+    }
+
+    /// @brief Set capacity of the link from the UART port configuration.
+    /// @param[in] msg CFG-PRT (UART) message, see @ref uartBytesPerSecond().
+    template <typename TMsgBase>
+    void setPort(const message::CfgPrtUart<TMsgBase>& msg)
+    {
+        setLinkCapacity(uartBytesPerSecond(msg));
+    }
+
+    /// @brief Set load of the periodic output of the receiver.
+    /// @param[in] bytesPerSecond Number of bytes per second.
+    void setPeriodicLoad(double bytesPerSecond)
+    {
+        m_periodicLoad = std::max(bytesPerSecond, 0.0);
+    }
+
+    /// @brief Set maximal utilisation of the link.
+    /// @param[in] percent Percentage of the link capacity available to the
+    ///     periodic output and the responses, limited to 100.
+    void setUtilisation(unsigned percent)
+    {
+        m_utilisation = std::min(percent, 100U);
+    }
+
+    /// @brief Set capacity of the token bucket.
+    /// @details The bucket always fits the longest expected response.
+    void setBurstLength(std::size_t len)
+    {
+        m_burstLength = len;
+    }
+
+    /// @brief Set time to wait for the response before the poll is
+    ///     allowed to be sent again.
+    /// @details The timeout is extended by the time of transmission of
+    ///     the expected response frames at the rate available to the
+    ///     responses (see @ref responseBudget()).
+    void setResponseTimeout(Duration timeout)
+    {
+        m_responseTimeout = timeout;
+    }
+
+    /// @brief Add the poll.
+    /// @tparam TResponse Type of the response message, such as
+    ///     message::MonHw, expected to have the same ID as the poll.
+    /// @param[in] poll Poll message object, such as message::MonHwPoll.
+    /// @param[in] period Polling period, @b 0 means the poll is sent only
+    ///     when triggered (see @ref trigger()).
+    /// @param[in] responseBlocks Expected number of the repeated blocks in the
+    ///     response, see @ref maxFrameLength().
+    /// @param[in] responseFrames Expected number of the response frames,
+    ///     such as number of satellites for message::AidAlmPoll.
+    /// @param[in] now Current time, the periodic poll is due immediately.
+    /// @return Identifier of the poll, @ref InvalidPoll if the serialisation
+    ///     fails.
+    template <typename TResponse, typename TPoll>
+    PollId add(
+        const TPoll& poll,
+        Duration period,
+        std::size_t responseBlocks = 0U,
+        std::size_t responseFrames = 1U,
+        TimePoint now = Clock::now())
+    {
+        static const MsgId Id = details::StaticMsgIdRetriever<TPoll>::Value;
+        static_assert(Id == details::StaticMsgIdRetriever<TResponse>::Value,
+            "The poll and the response are expected to have the same ID");
+
+        std::vector<std::uint8_t> payload;
+        if (!details::writePayload(poll, payload)) {
+            return InvalidPoll;
+        }
+
+        return
+            addPayload(
+                Id,
+                payload.data(),
+                payload.size(),
+                maxFrameLength<TResponse>(responseBlocks),
+                period,
+                responseFrames,
+                now);
+    }
+
+    /// @brief Add the poll with already serialised payload.
+    /// @details The poll identical to already added one (same ID and payload)
+    ///     is coalesced with it: the shorter period and the longer response
+    ///     are used.
+    /// @param[in] id ID of the poll message.
+    /// @param[in] payload Pointer to the payload.
+    /// @param[in] len Length of the payload.
+    /// @param[in] responseLength Expected (worst case) length of the single
+    ///     response frame.
+    /// @param[in] period Polling period, @b 0 means the poll is sent only
+    ///     when triggered.
+    /// @param[in] responseFrames Expected number of the response frames,
+    ///     the budget of the poll is @b responseFrames times
+    ///     @b responseLength.
+    /// @param[in] now Current time, the periodic poll is due immediately.
+    /// @return Identifier of the poll, @ref InvalidPoll if the payload is
+    ///     too long.
+    PollId addPayload(
+        MsgId id,
+        const std::uint8_t* payload,
+        std::size_t len,
+        std::size_t responseLength,
+        Duration period,
+        std::size_t responseFrames = 1U,
+        TimePoint now = Clock::now())
+    {
+        if (responseFrames == 0U) {
+            responseFrames = 1U;
+        }
+
+        Poll poll;
+        if (!details::writeFrame(id, payload, len, poll.frame)) {
+            return InvalidPoll;
+        }
+
+        for (PollId pollId = 0U; pollId < m_polls.size(); ++pollId) {
+            auto& existing = m_polls[pollId];
+            if ((!existing.active) || (existing.frame != poll.frame)) {
+                continue;
+            }
+
+            ++m_coalesced;
+            existing.responseLength = std::max(existing.responseLength, responseLength);
+            existing.responseFrames = std::max(existing.responseFrames, responseFrames);
+            if (period == Duration::zero()) {
+                return pollId;
+            }
+
+            if (existing.period == Duration::zero()) {
+                existing.period = period;
+                schedule(existing, now);
+            }
+            else if (period < existing.period) {
+                existing.period = period;
+                schedule(existing, now + period);
+            }
+            return pollId;
+        }
+
+        poll.id = id;
+        poll.responseLength = responseLength;
+        poll.responseFrames = responseFrames;
+        poll.period = period;
+        poll.active = true;
+        if (period != Duration::zero()) {
+            schedule(poll, now);
+        }
+
+        m_polls.push_back(std::move(poll));
+        return m_polls.size() - 1U;
+    }
+
+    /// @brief Remove the poll.
+    /// @return false if there is no such poll.
+    bool remove(PollId pollId)
+    {
+        if (!valid(pollId)) {
+            return false;
+        }
+
+        auto& poll = m_polls[pollId];
+        poll.active = false;
+        poll.scheduled = false;
+        poll.pending = false;
+        poll.remainingFrames = 0U;
+        poll.frame.clear();
+        return true;
+    }
+
+    /// @brief Request the poll to be sent as soon as the budget allows.
+    /// @details The request is coalesced when the poll is already due or
+    ///     pending.
+    /// @return true if the poll was scheduled, false if it was coalesced or
+    ///     there is no such poll.
+    bool trigger(PollId pollId, TimePoint now = Clock::now())
+    {
+        if (!valid(pollId)) {
+            return false;
+        }
+
+        auto& poll = m_polls[pollId];
+        if (poll.pending || (poll.scheduled && (poll.due <= now))) {
+            ++m_coalesced;
+            return false;
+        }
+
+        poll.due = now;
+        poll.scheduled = true;
+        return true;
+    }
+
+    /// @brief Handle received message, see @ref received().
+    template <typename TMsg>
+    void handle(const TMsg&)
+    {
+        received(details::StaticMsgIdRetriever<TMsg>::Value);
+    }
+
+    /// @brief Report reception of the message.
+    /// @details Counts the message as the response to the oldest pending
+    ///     poll with the same ID, the poll is completed when all the expected
+    ///     response frames are received.
+    /// @return true if the message is the response to the pending poll.
+    bool received(MsgId id)
+    {
+        Poll* oldest = nullptr;
+        for (auto& poll : m_polls) {
+            if (poll.pending && (poll.id == id) &&
+                ((oldest == nullptr) || (poll.sequence < oldest->sequence))) {
+                oldest = &poll;
+            }
+        }
+
+        if (oldest == nullptr) {
+            return false;
+        }
+
+        if (1U < oldest->remainingFrames) {
+            --oldest->remainingFrames;
+            return true;
+        }
+
+        oldest->remainingFrames = 0U;
+        oldest->pending = false;
+        return true;
+    }
+
+    /// @brief Send the due polls the budget allows.
+    /// @param[in] now Current time.
+    void tick(TimePoint now = Clock::now())
+    {
+        refill(now);
+        for (auto& poll : m_polls) {
+            if (poll.pending && (poll.deadline <= now)) {
+                poll.pending = false;
+                ++m_missed;
+            }
+        }
+
+        while (true) {
+            auto* poll = nextDue(now);
+            if ((poll == nullptr) || (m_tokens < static_cast<double>(poll->budget()))) {
+                break;
+            }
+
+            if ((!m_sendHandler) || (!m_sendHandler(poll->frame.data(), poll->frame.size()))) {
+                ++m_sendFailures;
+                break;
+            }
+
+            ++m_sent;
+            m_tokens -= static_cast<double>(poll->budget());
+            poll->pending = true;
+            poll->remainingFrames = poll->responseFrames;
+            poll->deadline = now + responseTimeout(*poll);
+            poll->sequence = m_sequence;
+            ++m_sequence;
+            poll->scheduled = false;
+            if (poll->period != Duration::zero()) {
+                schedule(*poll, now + poll->period);
+            }
+        }
+    }
+
+    /// @brief Number of bytes per second available to the responses.
+    double responseBudget() const
+    {
+        auto available = ((m_capacity * m_utilisation) / 100U) - m_periodicLoad;
+        return std::max(available, 0.0);
+    }
+
+    /// @brief Number of polls sent so far.
+    std::size_t sentCount() const
+    {
+        return m_sent;
+    }
+
+    /// @brief Number of polls without response within the timeout.
+    std::size_t missedCount() const
+    {
+        return m_missed;
+    }
+
+    /// @brief Number of coalesced polls.
+    std::size_t coalescedCount() const
+    {
+        return m_coalesced;
+    }
+
+    /// @brief Number of times the send handler reported failure.
+    std::size_t sendFailureCount() const
+    {
+        return m_sendFailures;
+    }
+
+private:
+    struct Poll
+    {
+        MsgId id = MsgId_CFG_PRT;
+        std::vector<std::uint8_t> frame;
+        std::size_t responseLength = 0U;
+        std::size_t responseFrames = 1U;
+        std::size_t remainingFrames = 0U;
+        Duration period = Duration::zero();
+        TimePoint due;
+        TimePoint deadline;
+        std::size_t sequence = 0U;
+        bool active = false;
+        bool scheduled = false;
+        bool pending = false;
+
+        std::size_t budget() const
+        {
+            return responseLength * responseFrames;
+        }
+    };
+
+    bool valid(PollId pollId) const
+    {
+        return (pollId < m_polls.size()) && m_polls[pollId].active;
+    }
+
+    static void schedule(Poll& poll, TimePoint due)
+    {
+        if ((!poll.scheduled) || (due < poll.due)) {
+            poll.due = due;
+        }
+        poll.scheduled = true;
+    }
+
+    Poll* nextDue(TimePoint now)
+    {
+        Poll* result = nullptr;
+        for (auto& poll : m_polls) {
+            if ((!poll.active) || (!poll.scheduled) || poll.pending || (now < poll.due)) {
+                continue;
+            }
+
+            if ((result == nullptr) || (poll.due < result->due)) {
+                result = &poll;
+            }
+        }
+        return result;
+    }
+
+    void refill(TimePoint now)
+    {
+        if (!m_started) {
+            m_started = true;
+            m_lastRefill = now;
+            m_tokens = static_cast<double>(bucketLength());
+            return;
+        }
+
+        if (now <= m_lastRefill) {
+            return;
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::duration<double> >(now - m_lastRefill);
+        m_lastRefill = now;
+        m_tokens =
+            std::min(
+                m_tokens + (responseBudget() * elapsed.count()),
+                static_cast<double>(bucketLength()));
+    }
+
+    // The multi-frame responses (such as AID-ALM) may take longer to
+    // transmit than the timeout alone.
+    Duration responseTimeout(const Poll& poll) const
+    {
+        auto budget = responseBudget();
+        if (budget <= 0.0) {
+            return m_responseTimeout;
+        }
+
+        auto transmission =
+            std::chrono::duration<double>(static_cast<double>(poll.budget()) / budget);
+        return m_responseTimeout + std::chrono::duration_cast<Duration>(transmission);
+    }
+
+    std::size_t bucketLength() const
+    {
+        auto result = m_burstLength;
+        for (auto& poll : m_polls) {
+            if (poll.active) {
+                result = std::max(result, poll.budget());
+            }
+        }
+        return result;
+    }
+
+    SendHandler m_sendHandler;
+    std::vector<Poll> m_polls;
+    double m_capacity = DefaultLinkCapacity;
+    double m_periodicLoad = 0.0;
+    unsigned m_utilisation = DefaultUtilisation;
+    std::size_t m_burstLength = DefaultBurstLength;
+    Duration m_responseTimeout;
+    TimePoint m_lastRefill;
+    double m_tokens = 0.0;
+    bool m_started = false;
+    std::size_t m_sequence = 0U;
+    std::size_t m_sent = 0U;
+    std::size_t m_missed = 0U;
+    std::size_t m_coalesced = 0U;
+    std::size_t m_sendFailures = 0U;
+};
+
+}  // namespace ublox
+
+
@@ -26,6 +26,10 @@
 #include "Message.h"
 #include "field/MsgId.h"
 #include "protocol/ChecksumCalc.h"
+#include "protocol/SyncScanner.h"
+#include "protocol/MsgIdLayer.h"
+#include "options.h"
+#include "details/FieldsLength.h"
 
 namespace ublox
 {
@@ -42,8 +46,8 @@ using SyncField1 =
     comms::field::IntValue<
         TField,
         std::uint8_t,
-        comms::option::DefaultNumValue<0xb5>,
-        comms::option::ValidNumValueRange<0xb5, 0xb5>
+        comms::option::DefaultNumValue<protocol::SyncChar1>,
+        comms::option::ValidNumValueRange<protocol::SyncChar1, protocol::SyncChar1>
     >;
 
 /// @brief Field representing second byte in synchronisation information in
@@ -55,8 +59,8 @@ using SyncField2 =
     comms::field::IntValue<
         TField,
         std::uint8_t,
-        comms::option::DefaultNumValue<0x62>,
-        comms::option::ValidNumValueRange<0x62, 0x62>
+        comms::option::DefaultNumValue<protocol::SyncChar2>,
+        comms::option::ValidNumValueRange<protocol::SyncChar2, protocol::SyncChar2>
     >;
 
 /// @brief Field representing last two checksum bytes in message wrapping.
@@ -86,6 +90,60 @@ using DataField =
         TOptions...
     >;
 
+/// @brief Selection of message ID layer based on provided options.
+/// @details Uses protocol::MsgIdLayer if ublox::option::DirectMsgIdLookup,
+///     ublox::option::PooledAllocation, or ublox::option::PayloadLengthCheck
+///     option is provided, comms::protocol::MsgIdLayer otherwise.
+template <typename TMessages, typename TNextLayer, typename TMsgAllocOptions>
+struct MsgIdLayerSelector
+{
+    typedef typename OptionsTuple<TMsgAllocOptions>::Type AllocOptions;
+
+    typedef typename std::conditional<
+        HasOption<option::DirectMsgIdLookup, AllocOptions>::value ||
+            HasOption<option::PooledAllocation, AllocOptions>::value ||
+            HasOption<option::PayloadLengthCheck, AllocOptions>::value,
+        protocol::MsgIdLayer<
+            ublox::field::MsgId,
+            TMessages,
+            TNextLayer,
+            AllocOptions
+        >,
+        comms::protocol::MsgIdLayer<
+            ublox::field::MsgId,
+            TMessages,
+            TNextLayer,
+            TMsgAllocOptions
+        >
+    >::type Type;
+};
+
+/// @brief Message ID layer used by @ref ublox::Stack.
+template <typename TMessages, typename TNextLayer, typename TMsgAllocOptions>
+using MsgIdLayer =
+    typename MsgIdLayerSelector<TMessages, TNextLayer, TMsgAllocOptions>::Type;
+
+/// @brief Maximal payload length of all the messages bundled in std::tuple.
+template <typename TMessages>
+struct MaxPayloadLength;
+
+template <>
+struct MaxPayloadLength<std::tuple<> >
+{
+    static const std::size_t Value = 0U;
+};
+
+template <typename TFirst, typename... TRest>
+struct MaxPayloadLength<std::tuple<TFirst, TRest...> >
+{
+    static const std::size_t FirstValue =
+        FieldsMaxLength<typename TFirst::AllFields>::Value;
+    static const std::size_t RestValue =
+        MaxPayloadLength<std::tuple<TRest...> >::Value;
+    static const std::size_t Value =
+        (FirstValue < RestValue) ? RestValue : FirstValue;
+};
+
 } // namespace details
 
 /// @brief Definition of Ublox binary protocol stack of layers.
@@ -96,7 +154,10 @@ using DataField =
 ///     page in @b COMMS library tutorial for more information.@n
 ///     The outermost layer is
 ///     <a href="https://dl.dropboxusercontent.com/u/46999418/comms_champion/comms/html/classcomms_1_1protocol_1_1SyncPrefixLayer.html">comms::protocol::SyncPrefixLayer</a>.
-///     Please see its documentation for public interface description.
+///     Please see its documentation for public interface description.@n
+///     When the input data may contain long sequences of garbage (such as
+///     NMEA sentences), consider using protocol::SyncScanner to skip them
+///     before invoking @b read() of the stack.
 /// @tparam TMsgBase Interface class for all the messages, expected to be some
 ///     variant of ublox::MessageT class with options.
 /// @tparam TMessages Types of all messages that this protocol stack must
@@ -111,6 +172,12 @@ using DataField =
 ///     message objects must be implemented. It is expected to be either
 ///     single @b COMMS library option or multiple options bundled in
 ///     <a href="http://en.cppreference.com/w/cpp/utility/tuple">std::tuple</a>.
+///     The ublox::option::DirectMsgIdLookup option may also be added to
+///     replace the lookup of the message type with direct indexed one
+///     (see protocol::MsgIdLayer), ublox::option::PooledAllocation
+///     to recycle the message objects (see ublox::MsgPool), or
+///     ublox::option::PayloadLengthCheck to discard the frames with invalid
+///     payload length before any message object is created.
 /// @tparam TDataFieldStorageOptions The contents of this template parameters
 ///     are passed to the definition of storage field of
 ///     <a href="https://dl.dropboxusercontent.com/u/46999418/comms_champion/comms/html/classcomms_1_1protocol_1_1MsgDataLayer.html">comms::protocol::MsgDataLayer</a>
@@ -133,8 +200,7 @@ using Stack =
             comms::protocol::ChecksumLayer<
                 details::ChecksumField<typename TMsgBase::Field>,
                 protocol::ChecksumCalc,
-                comms::protocol::MsgIdLayer<
-                    ublox::field::MsgId,
+                details::MsgIdLayer<
                     TMessages,
                     comms::protocol::MsgSizeLayer<
                         details::LengthField<typename TMsgBase::Field>,
@@ -149,6 +215,48 @@ using Stack =
         >
     >;
 
+/// @brief Definition of Ublox binary protocol stack of layers that doesn't
+///     use dynamic memory allocation.
+/// @details Same as @ref Stack, but the message object is allocated "in place"
+///     (only single message object can exist at a time), and the storage of
+///     the payload field of the
+///     <a href="https://dl.dropboxusercontent.com/u/46999418/comms_champion/comms/html/classcomms_1_1protocol_1_1MsgDataLayer.html">comms::protocol::MsgDataLayer</a>
+///     layer has fixed capacity. The capacity is calculated at compile time
+///     to be the maximal serialisation length of the largest message in
+///     @b TMessages bundle (limited by maximal value of @b LENGTH field). @n
+///     @b NOTE, that the stack is free of dynamic memory allocation only if
+///     the message objects themselves don't allocate. The messages with
+///     variable length lists, which capacity is controlled by the storage
+///     options (message::NavSvinfo, message::RxmRaw, message::RxmSvsi,
+///     message::CfgGnss, message::MonVer), @b must be defined with
+///     option::FixedListStorage (or its derivative), for example:
+///     @code
+///     typedef std::tuple<
+///         ublox::message::NavPvt<>,
+///         ublox::message::NavSvinfo<ublox::Message, ublox::option::FixedListStorage>,
+///         ublox::message::RxmRaw<ublox::Message, ublox::option::FixedListStorage>
+///     > MyMessages;
+///     typedef ublox::StaticStack<ublox::Message, MyMessages> MyStack;
+///     @endcode
+///     Other list fields (for example in message::RxmSfrb, message::MonHw,
+///     message::CfgMsg) and the string fields (message::InfNotice and other
+///     INF-* messages, string part of message::MonVer) always use
+///     @b std::vector and @b std::string storage, i.e. reading such
+///     messages allocates.
+/// @tparam TMsgBase Interface class for all the messages, expected to be some
+///     variant of ublox::MessageT class with options.
+/// @tparam TMessages Types of all messages that this protocol stack must
+///     identify during read and support creation of proper message object.
+///     The types of the messages must be bundled in
+///     <a href="http://en.cppreference.com/w/cpp/utility/tuple">std::tuple</a>.
+template <typename TMsgBase, typename TMessages>
+using StaticStack =
+    Stack<
+        TMsgBase,
+        TMessages,
+        comms::option::InPlaceAllocation,
+        comms::option::FixedSizeStorage<details::MaxPayloadLength<TMessages>::Value>
+    >;
 
 }  // namespace ublox
 
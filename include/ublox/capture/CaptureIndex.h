@@ -0,0 +1,533 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::capture::CaptureIndex class.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ublox/MsgId.h"
+#include "ublox/FrameView.h"
+#include "FrameScanner.h"
+#include "FrameTime.h"
+
+namespace ublox
+{
+
+namespace capture
+{
+
+/// @brief Single entry of @ref CaptureIndex.
+struct CaptureIndexEntry
+{
+    /// @brief Offset of the frame from the beginning of the capture.
+    std::uint64_t offset = 0U;
+
+    /// @brief GPS time of week in milliseconds, see @ref TimeTracker.
+    std::uint32_t iTOW = GpsTime::UnknownTow;
+
+    /// @brief GPS week number, see @ref TimeTracker.
+    std::uint16_t week = GpsTime::UnknownWeek;
+
+    /// @brief ID of the message.
+    std::uint16_t msgId = 0U;
+
+    /// @brief GPS time of the frame.
+    GpsTime time() const
+    {
+        return GpsTime(week, iTOW);
+    }
+};
+
+/// @brief Fingerprint of the capture contents.
+/// @details Used to detect stale sidecar file of @ref CaptureIndex. Consists
+///     of the length and modification time of the capture as well as
+///     FNV-1a hash of its first and last @ref HashedLength bytes, i.e.
+///     rewriting the capture with the contents of the same length is detected
+///     even if the file system doesn't update the modification time.
+struct CaptureFingerprint
+{
+    /// @brief Number of bytes hashed at the beginning and at the end of
+    ///     the capture.
+    static const std::size_t HashedLength = 64U * 1024U;
+
+    /// @brief Length of the capture.
+    std::uint64_t length = 0U;
+
+    /// @brief Modification time of the capture, 0 if unknown.
+    std::uint64_t modTime = 0U;
+
+    /// @brief Hash of the first and last @ref HashedLength bytes.
+    std::uint64_t hash = 0U;
+
+    /// @brief Calculate fingerprint of the capture contents.
+    /// @param[in] data Pointer to the capture contents.
+    /// @param[in] len Length of the capture.
+    /// @param[in] modTime Modification time of the capture file, 0 if
+    ///     unknown.
+    static CaptureFingerprint of(
+        const std::uint8_t* data,
+        std::size_t len,
+        std::uint64_t modTime = 0U)
+    {
+        CaptureFingerprint result;
+        result.length = len;
+        result.modTime = modTime;
+
+        std::size_t hashedLen = HashedLength;
+        auto headLen = std::min(len, hashedLen);
+        auto tailBegin = std::max(headLen, len - headLen);
+        auto hash = hashBytes(OffsetBasis, data, headLen);
+        result.hash = hashBytes(hash, data + tailBegin, len - tailBegin);
+        return result;
+    }
+
+    /// @brief Equality comparison.
+    bool operator==(const CaptureFingerprint& other) const
+    {
+        return
+            (length == other.length) &&
+            (modTime == other.modTime) &&
+            (hash == other.hash);
+    }
+
+    /// @brief Inequality comparison.
+    bool operator!=(const CaptureFingerprint& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    static const std::uint64_t OffsetBasis = 0xcbf29ce484222325ULL;
+    static const std::uint64_t Prime = 0x100000001b3ULL;
+
+    static std::uint64_t hashBytes(
+        std::uint64_t hash,
+        const std::uint8_t* data,
+        std::size_t len)
+    {
+        for (std::size_t idx = 0U; idx < len; ++idx) {
+            hash ^= data[idx];
+            hash *= Prime;
+        }
+        return hash;
+    }
+};
+
+/// @brief Index of the frames in the capture of the receiver output.
+/// @details Contains offset, message ID and GPS time of every valid frame.
+///     The time of the frame is the time of the latest navigation message
+///     preceding the frame (see @ref TimeTracker), the frames preceding the
+///     first reported time of week (or week number) get the first reported
+///     value. If the capture doesn't report week number at all, all the
+///     entries have GpsTime::UnknownWeek, and the lookups by time are
+///     expected to use it as well. The lookups by the GPS time assume that
+///     the time doesn't decrease throughout the capture.@n
+///     The index can be saved into and loaded from the binary stream
+///     (sidecar file), which avoids scanning of the whole capture again.
+///     The sidecar file contains @ref CaptureFingerprint of the indexed
+///     capture and is rejected when it doesn't match the capture being
+///     opened. The binary format is little endian regardless of the platform.
+class CaptureIndex
+{
+public:
+    /// @brief Type of the entry.
+    typedef CaptureIndexEntry Entry;
+
+    /// @brief Value returned by the lookups when nothing is found.
+    static const std::size_t NotFound = static_cast<std::size_t>(-1);
+
+    /// @brief Maximal number of indexed frames.
+    /// @details The index by message type stores 32 bit frame numbers.
+    static const std::size_t MaxSize = 0xffffffffUL;
+
+    /// @brief Build the index of the capture.
+    /// @param[in] data Pointer to the capture contents.
+    /// @param[in] len Length of the capture.
+    /// @param[in] modTime Modification time of the capture file, 0 if
+    ///     unknown, stored in the @ref fingerprint().
+    /// @return true on success, false if the capture contains more than
+    ///     @ref MaxSize frames, in which case the index becomes empty.
+    bool build(const std::uint8_t* data, std::size_t len, std::uint64_t modTime = 0U)
+    {
+        clear();
+        m_fingerprint = CaptureFingerprint::of(data, len, modTime);
+
+        FrameScanner scanner(data, len);
+        TimeTracker tracker;
+        FrameView frame;
+        std::size_t noTow = 0U;
+        std::size_t noWeek = 0U;
+        while (scanner.next(frame)) {
+            if (MaxSize <= m_entries.size()) {
+                clear();
+                return false;
+            }
+
+            auto& time = tracker.update(frame);
+            Entry entry;
+            entry.offset = scanner.offsetOf(frame);
+            entry.iTOW = time.iTOW;
+            entry.week = time.week;
+            entry.msgId = static_cast<std::uint16_t>(frame.msgId());
+            m_entries.push_back(entry);
+
+            auto count = m_entries.size();
+            if (time.iTOW == GpsTime::UnknownTow) {
+                noTow = count;
+            }
+            else if (noTow == (count - 1)) {
+                for (std::size_t idx = 0U; idx < noTow; ++idx) {
+                    m_entries[idx].iTOW = time.iTOW;
+                }
+            }
+
+            if (time.week == GpsTime::UnknownWeek) {
+                noWeek = count;
+            }
+            else if (noWeek == (count - 1)) {
+                for (std::size_t idx = 0U; idx < noWeek; ++idx) {
+                    m_entries[idx].week = time.week;
+                }
+            }
+        }
+
+        buildTypeIndex();
+        return true;
+    }
+
+    /// @brief Remove all the entries.
+    void clear()
+    {
+        m_entries.clear();
+        m_byType.clear();
+        m_fingerprint = CaptureFingerprint();
+    }
+
+    /// @brief Number of indexed frames.
+    std::size_t size() const
+    {
+        return m_entries.size();
+    }
+
+    /// @brief Check whether there are no indexed frames.
+    bool empty() const
+    {
+        return m_entries.empty();
+    }
+
+    /// @brief Get entry of the frame.
+    /// @param[in] idx Frame number, must be less than @ref size().
+    const Entry& entry(std::size_t idx) const
+    {
+        return m_entries[idx];
+    }
+
+    /// @brief Length of the indexed capture.
+    std::uint64_t sourceLength() const
+    {
+        return m_fingerprint.length;
+    }
+
+    /// @brief Fingerprint of the indexed capture.
+    const CaptureFingerprint& fingerprint() const
+    {
+        return m_fingerprint;
+    }
+
+    /// @brief Number of frames of the message.
+    std::size_t countOf(MsgId id) const
+    {
+        auto range = typeRange(id);
+        return static_cast<std::size_t>(range.second - range.first);
+    }
+
+    /// @brief Find the frame number of the message occurrence.
+    /// @param[in] id ID of the message.
+    /// @param[in] nth Number of the occurrence of the message, starting
+    ///     from 0.
+    /// @return Frame number or @ref NotFound.
+    std::size_t findNth(MsgId id, std::size_t nth) const
+    {
+        auto range = typeRange(id);
+        if (static_cast<std::size_t>(range.second - range.first) <= nth) {
+            return NotFound;
+        }
+
+        return *(range.first + nth);
+    }
+
+    /// @brief Find the first frame of the message not preceding
+    ///     the provided frame number.
+    /// @return Frame number or @ref NotFound.
+    std::size_t findNext(MsgId id, std::size_t from) const
+    {
+        if (MaxSize < from) {
+            return NotFound;
+        }
+
+        auto range = typeRange(id);
+        auto iter = std::lower_bound(range.first, range.second, static_cast<FrameNum>(from));
+        if (iter == range.second) {
+            return NotFound;
+        }
+
+        return *iter;
+    }
+
+    /// @brief Find the first frame with the GPS time not less than provided.
+    /// @return Frame number or @ref size() if there is no such frame.
+    std::size_t findTime(const GpsTime& time) const
+    {
+        auto iter =
+            std::lower_bound(
+                m_entries.begin(), m_entries.end(), time,
+                [](const Entry& entry, const GpsTime& t) -> bool
+                {
+                    return entry.time() < t;
+                });
+        return static_cast<std::size_t>(iter - m_entries.begin());
+    }
+
+    /// @brief Save the index into the binary stream.
+    /// @return true on success.
+    bool save(std::ostream& stream) const
+    {
+        Buffer buf;
+        auto* iter = buf.data();
+        writeValue(iter, Magic, sizeof(Magic));
+        writeValue(iter, m_fingerprint.length, sizeof(m_fingerprint.length));
+        writeValue(iter, m_fingerprint.modTime, sizeof(m_fingerprint.modTime));
+        writeValue(iter, m_fingerprint.hash, sizeof(m_fingerprint.hash));
+        writeValue(iter, m_entries.size(), sizeof(std::uint64_t));
+        writeBuf(stream, buf, iter);
+
+        for (auto& e : m_entries) {
+            iter = buf.data();
+            writeValue(iter, e.offset, sizeof(e.offset));
+            writeValue(iter, e.iTOW, sizeof(e.iTOW));
+            writeValue(iter, e.week, sizeof(e.week));
+            writeValue(iter, e.msgId, sizeof(e.msgId));
+            writeBuf(stream, buf, iter);
+        }
+
+        for (auto frameNum : m_byType) {
+            iter = buf.data();
+            writeValue(iter, frameNum, sizeof(frameNum));
+            writeBuf(stream, buf, iter);
+        }
+
+        return static_cast<bool>(stream);
+    }
+
+    /// @brief Load the index from the binary stream.
+    /// @details Besides the fingerprint check, verifies that the frame
+    ///     offsets are increasing and within the capture, and that the
+    ///     index by message type is a permutation of the frame numbers
+    ///     sorted by the message ID, which the lookups rely on.
+    /// @param[in] stream Input stream.
+    /// @param[in] source Fingerprint of the capture (see
+    ///     CaptureFingerprint::of()), the index of the capture with different
+    ///     fingerprint is rejected as stale.
+    /// @return true on success, false if the data is invalid or stale, in
+    ///     which case the index becomes empty.
+    bool load(std::istream& stream, const CaptureFingerprint& source)
+    {
+        clear();
+
+        Buffer buf;
+        if (!readBuf(stream, buf, sizeof(Magic) + sizeof(std::uint64_t) * 4)) {
+            return false;
+        }
+
+        const std::uint8_t* iter = buf.data();
+        CaptureFingerprint fingerprint;
+        auto magic = readValue<std::uint64_t>(iter, sizeof(Magic));
+        fingerprint.length = readValue<std::uint64_t>(iter, sizeof(fingerprint.length));
+        fingerprint.modTime = readValue<std::uint64_t>(iter, sizeof(fingerprint.modTime));
+        fingerprint.hash = readValue<std::uint64_t>(iter, sizeof(fingerprint.hash));
+        auto count = readValue<std::uint64_t>(iter, sizeof(std::uint64_t));
+        auto length = fingerprint.length;
+        if ((magic != Magic) ||
+            (fingerprint != source) ||
+            (MaxSize < count) ||
+            (length < count * FrameView::OverheadLength)) {
+            return false;
+        }
+
+        m_entries.resize(static_cast<std::size_t>(count));
+        std::uint64_t minOffset = 0U;
+        for (auto& e : m_entries) {
+            if (!readBuf(stream, buf, EntryLength)) {
+                clear();
+                return false;
+            }
+
+            iter = buf.data();
+            e.offset = readValue<std::uint64_t>(iter, sizeof(e.offset));
+            e.iTOW = readValue<std::uint32_t>(iter, sizeof(e.iTOW));
+            e.week = readValue<std::uint16_t>(iter, sizeof(e.week));
+            e.msgId = readValue<std::uint16_t>(iter, sizeof(e.msgId));
+            if ((e.offset < minOffset) ||
+                (length < e.offset + FrameView::OverheadLength)) {
+                clear();
+                return false;
+            }
+
+            minOffset = e.offset + FrameView::OverheadLength;
+        }
+
+        m_byType.resize(static_cast<std::size_t>(count));
+        std::vector<bool> seen(m_byType.size(), false);
+        for (std::size_t idx = 0U; idx < m_byType.size(); ++idx) {
+            if (!readBuf(stream, buf, sizeof(FrameNum))) {
+                clear();
+                return false;
+            }
+
+            iter = buf.data();
+            auto frameNum = readValue<FrameNum>(iter, sizeof(FrameNum));
+            if ((count <= frameNum) ||
+                seen[frameNum] ||
+                ((idx != 0U) && (!typeOrdered(m_byType[idx - 1], frameNum)))) {
+                clear();
+                return false;
+            }
+
+            seen[frameNum] = true;
+            m_byType[idx] = frameNum;
+        }
+
+        m_fingerprint = fingerprint;
+        return true;
+    }
+
+    /// @brief Get conventional path of the sidecar file of the capture.
+    static std::string sidecarPath(const std::string& capturePath)
+    {
+        return capturePath + ".idx";
+    }
+
+private:
+    typedef std::uint32_t FrameNum;
+    typedef std::vector<FrameNum>::const_iterator FrameNumIter;
+    typedef std::array<std::uint8_t, 64> Buffer;
+
+    static const std::uint64_t Magic = 0x0258444958425500ULL; // "\0UBXIDX\2"
+    static const std::size_t EntryLength = 16U;
+
+    static_assert(MaxSize <= std::numeric_limits<FrameNum>::max(),
+        "Every frame number is expected to fit FrameNum");
+
+    // The number of entries is limited by build() and load(), so the
+    // frame numbers are not truncated.
+    void buildTypeIndex()
+    {
+        m_byType.resize(m_entries.size());
+        for (std::size_t idx = 0U; idx < m_byType.size(); ++idx) {
+            m_byType[idx] = static_cast<FrameNum>(idx);
+        }
+
+        std::stable_sort(
+            m_byType.begin(), m_byType.end(),
+            [this](FrameNum first, FrameNum second) -> bool
+            {
+                return m_entries[first].msgId < m_entries[second].msgId;
+            });
+    }
+
+    bool typeOrdered(FrameNum first, FrameNum second) const
+    {
+        auto firstId = m_entries[first].msgId;
+        auto secondId = m_entries[second].msgId;
+        return (firstId < secondId) || ((firstId == secondId) && (first < second));
+    }
+
+    std::pair<FrameNumIter, FrameNumIter> typeRange(MsgId id) const
+    {
+        auto value = static_cast<std::uint16_t>(id);
+        auto begin =
+            std::lower_bound(
+                m_byType.begin(), m_byType.end(), value,
+                [this](FrameNum frameNum, std::uint16_t v) -> bool
+                {
+                    return m_entries[frameNum].msgId < v;
+                });
+
+        auto end =
+            std::upper_bound(
+                begin, m_byType.end(), value,
+                [this](std::uint16_t v, FrameNum frameNum) -> bool
+                {
+                    return v < m_entries[frameNum].msgId;
+                });
+
+        return std::make_pair(begin, end);
+    }
+
+    template <typename T>
+    static void writeValue(std::uint8_t*& iter, T value, std::size_t len)
+    {
+        auto v = static_cast<std::uint64_t>(value);
+        for (std::size_t idx = 0U; idx < len; ++idx) {
+            *iter = static_cast<std::uint8_t>(v >> (idx * std::numeric_limits<std::uint8_t>::digits));
+            ++iter;
+        }
+    }
+
+    template <typename T>
+    static T readValue(const std::uint8_t*& iter, std::size_t len)
+    {
+        std::uint64_t v = 0U;
+        for (std::size_t idx = 0U; idx < len; ++idx) {
+            v |= static_cast<std::uint64_t>(*iter) << (idx * std::numeric_limits<std::uint8_t>::digits);
+            ++iter;
+        }
+        return static_cast<T>(v);
+    }
+
+    static void writeBuf(std::ostream& stream, const Buffer& buf, const std::uint8_t* end)
+    {
+        stream.write(reinterpret_cast<const char*>(buf.data()), end - buf.data());
+    }
+
+    static bool readBuf(std::istream& stream, Buffer& buf, std::size_t len)
+    {
+        stream.read(reinterpret_cast<char*>(buf.data()), static_cast<std::streamsize>(len));
+        return static_cast<std::size_t>(stream.gcount()) == len;
+    }
+
+    std::vector<Entry> m_entries;
+    std::vector<FrameNum> m_byType;
+    CaptureFingerprint m_fingerprint;
+};
+
+}  // namespace capture
+
+}  // namespace ublox
+
+
@@ -0,0 +1,170 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::capture::CaptureReader class.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+#include "comms/comms.h"
+
+#include "ublox/FrameView.h"
+#include "MappedFile.h"
+#include "CaptureIndex.h"
+
+namespace ublox
+{
+
+namespace capture
+{
+
+/// @brief Random access reader of the capture file of the receiver output.
+/// @details The file is mapped into memory (see @ref MappedFile), and the
+///     frames are accessed in place, as FrameView objects referencing the
+///     mapped pages. The frames are located using @ref CaptureIndex, which
+///     is loaded from the sidecar file (see CaptureIndex::sidecarPath())
+///     when it matches the capture (see @ref CaptureFingerprint), or built and saved otherwise. The
+///     lookup of the frame by its number costs O(1), the lookups by the
+///     message type and GPS time cost O(log n).
+/// @code
+/// ublox::capture::CaptureReader reader;
+/// if (!reader.open("capture.ubx")) {
+///     ... // report error
+/// }
+///
+/// auto from = reader.index().findTime(ublox::capture::GpsTime(1890, 300000000));
+/// for (auto idx = from; idx < reader.size(); ++idx) {
+///     auto frame = reader.frame(idx);
+///     ... // process the frame
+/// }
+/// @endcode
+class CaptureReader
+{
+public:
+    /// @brief Default constructor
+    CaptureReader() = default;
+
+    /// @brief Open the capture file.
+    /// @param[in] path Path to the capture file.
+    /// @param[in] useSidecar Whether to load and save the index using
+    ///     the sidecar file.
+    /// @return true on success, false if the file cannot be mapped or
+    ///     contains too many frames to be indexed (see CaptureIndex::build()).
+    bool open(const std::string& path, bool useSidecar = true)
+    {
+        m_index.clear();
+        m_indexLoaded = false;
+        if (!m_file.open(path)) {
+            return false;
+        }
+
+        if (useSidecar) {
+            auto fingerprint =
+                CaptureFingerprint::of(
+                    m_file.data(), m_file.size(), m_file.modificationTime());
+            std::ifstream stream(
+                CaptureIndex::sidecarPath(path), std::ios::in | std::ios::binary);
+            m_indexLoaded = static_cast<bool>(stream) && m_index.load(stream, fingerprint);
+        }
+
+        if (m_indexLoaded) {
+            return true;
+        }
+
+        m_file.adviseSequential();
+        if (!m_index.build(m_file.data(), m_file.size(), m_file.modificationTime())) {
+            m_file.close();
+            return false;
+        }
+
+        if (useSidecar) {
+            std::ofstream stream(
+                CaptureIndex::sidecarPath(path),
+                std::ios::out | std::ios::binary | std::ios::trunc);
+            if (stream) {
+                m_index.save(stream);
+            }
+        }
+        return true;
+    }
+
+    /// @brief Close the capture file.
+    void close()
+    {
+        m_index.clear();
+        m_file.close();
+        m_indexLoaded = false;
+    }
+
+    /// @brief Check whether the index was loaded from the sidecar file
+    ///     when the capture was opened.
+    bool indexLoaded() const
+    {
+        return m_indexLoaded;
+    }
+
+    /// @brief Number of frames in the capture.
+    std::size_t size() const
+    {
+        return m_index.size();
+    }
+
+    /// @brief Get the frame.
+    /// @param[in] idx Frame number, must be less than @ref size().
+    /// @return View of the frame, invalid one if the frame cannot be
+    ///     read (the capture was modified after the index was created).
+    FrameView frame(std::size_t idx) const
+    {
+        FrameView view;
+        auto offset = static_cast<std::size_t>(m_index.entry(idx).offset);
+        if (m_file.size() <= offset) {
+            return view;
+        }
+
+        const std::uint8_t* iter = m_file.data() + offset;
+        view.read(iter, m_file.size() - offset);
+        return view;
+    }
+
+    /// @brief Get access to the index.
+    const CaptureIndex& index() const
+    {
+        return m_index;
+    }
+
+    /// @brief Get access to the mapped file.
+    const MappedFile& file() const
+    {
+        return m_file;
+    }
+
+private:
+    MappedFile m_file;
+    CaptureIndex m_index;
+    bool m_indexLoaded = false;
+};
+
+}  // namespace capture
+
+}  // namespace ublox
+
+
@@ -0,0 +1,123 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::capture::FrameScanner class.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "comms/comms.h"
+
+#include "ublox/FrameView.h"
+#include "ublox/protocol/SyncScanner.h"
+
+namespace ublox
+{
+
+namespace capture
+{
+
+/// @brief Scanner of the valid frames in the contiguous buffer, such as
+///     contents of the capture file.
+/// @details The bytes preceding the synchronisation word are skipped using
+///     protocol::SyncScanner. Every candidate frame is confirmed by its
+///     checksum (see FrameView::read()), the search is resumed from the
+///     byte following the synchronisation character of the rejected
+///     candidate. Truncated frame at the end of the buffer is skipped
+///     as well.
+/// @code
+/// ublox::capture::FrameScanner scanner(data, len);
+/// ublox::FrameView frame;
+/// while (scanner.next(frame)) {
+///     ... // process the frame
+/// }
+/// @endcode
+class FrameScanner
+{
+public:
+    /// @brief Constructor
+    /// @param[in] data Pointer to the buffer.
+    /// @param[in] len Number of bytes in the buffer.
+    FrameScanner(const std::uint8_t* data, std::size_t len)
+      : m_begin(data),
+        m_iter(data),
+        m_end(data + len)
+    {
+    }
+
+    /// @brief Find next valid frame.
+    /// @param[out] frame View of the found frame.
+    /// @return true if the frame is found, false when the end of the buffer
+    ///     is reached.
+    bool next(FrameView& frame)
+    {
+        while (m_iter != m_end) {
+            auto* start = m_iter;
+            m_iter = protocol::SyncScanner::find(m_iter, m_end);
+            m_skipped += static_cast<std::size_t>(m_iter - start);
+            if (m_iter == m_end) {
+                break;
+            }
+
+            auto es = frame.read(m_iter, static_cast<std::size_t>(m_end - m_iter));
+            if (es == comms::ErrorStatus::Success) {
+                return true;
+            }
+
+            ++m_iter;
+            ++m_skipped;
+        }
+
+        return false;
+    }
+
+    /// @brief Offset from the beginning of the buffer to the first byte
+    ///     not scanned yet.
+    std::size_t offset() const
+    {
+        return static_cast<std::size_t>(m_iter - m_begin);
+    }
+
+    /// @brief Offset of the frame from the beginning of the buffer.
+    /// @pre The frame was found by this scanner.
+    std::size_t offsetOf(const FrameView& frame) const
+    {
+        return static_cast<std::size_t>(frame.data() - m_begin);
+    }
+
+    /// @brief Number of bytes not belonging to any valid frame skipped
+    ///     so far.
+    std::size_t skippedCount() const
+    {
+        return m_skipped;
+    }
+
+private:
+    const std::uint8_t* m_begin = nullptr;
+    const std::uint8_t* m_iter = nullptr;
+    const std::uint8_t* m_end = nullptr;
+    std::size_t m_skipped = 0U;
+};
+
+}  // namespace capture
+
+}  // namespace ublox
+
+
@@ -0,0 +1,342 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains extraction of GPS time from the frames of navigation
+///     messages.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "ublox/MsgId.h"
+#include "ublox/MsgLayout.h"
+#include "ublox/FrameView.h"
+#include "ublox/field/common.h"
+#include "ublox/message/NavPosecef.h"
+#include "ublox/message/NavPosllh.h"
+#include "ublox/message/NavStatus.h"
+#include "ublox/message/NavDop.h"
+#include "ublox/message/NavSol.h"
+#include "ublox/message/NavPvt.h"
+#include "ublox/message/NavVelecef.h"
+#include "ublox/message/NavVelned.h"
+#include "ublox/message/NavTimegps.h"
+#include "ublox/message/NavTimeutc.h"
+#include "ublox/message/NavClock.h"
+#include "ublox/message/NavSvinfo.h"
+#include "ublox/message/NavDgps.h"
+#include "ublox/message/NavSbas.h"
+#include "ublox/message/NavAopstatus.h"
+
+namespace ublox
+{
+
+namespace capture
+{
+
+namespace details
+{
+
+template <typename TMsg>
+struct LeadingItow : public
+    std::is_same<
+        typename std::tuple_element<0, typename TMsg::AllFields>::type,
+        field::common::iTOW
+    >
+{
+};
+
+inline std::uint32_t loadU4(const std::uint8_t* data)
+{
+    static const std::size_t BitsInByte = std::numeric_limits<std::uint8_t>::digits;
+    return
+        static_cast<std::uint32_t>(data[0]) |
+        (static_cast<std::uint32_t>(data[1]) << BitsInByte) |
+        (static_cast<std::uint32_t>(data[2]) << (BitsInByte * 2)) |
+        (static_cast<std::uint32_t>(data[3]) << (BitsInByte * 3));
+}
+
+inline std::uint16_t loadU2(const std::uint8_t* data)
+{
+    static const std::size_t BitsInByte = std::numeric_limits<std::uint8_t>::digits;
+    return
+        static_cast<std::uint16_t>(
+            static_cast<unsigned>(data[0]) |
+            (static_cast<unsigned>(data[1]) << BitsInByte));
+}
+
+}  // namespace details
+
+/// @brief GPS time, week number and time of week in milliseconds.
+struct GpsTime
+{
+    /// @brief Number of milliseconds in the week.
+    static const std::uint32_t MsInWeek = 1000UL * 60 * 60 * 24 * 7;
+
+    /// @brief Value of @ref week when it's unknown.
+    static const std::uint16_t UnknownWeek = 0xffff;
+
+    /// @brief Value of @ref iTOW when it's unknown.
+    static const std::uint32_t UnknownTow = 0xffffffff;
+
+    /// @brief GPS week number.
+    std::uint16_t week = UnknownWeek;
+
+    /// @brief GPS time of week in milliseconds.
+    std::uint32_t iTOW = UnknownTow;
+
+    /// @brief Default constructor, creates unknown time.
+    GpsTime() = default;
+
+    /// @brief Constructor
+    GpsTime(std::uint16_t weekValue, std::uint32_t iTowValue)
+      : week(weekValue),
+        iTOW(iTowValue)
+    {
+    }
+
+    /// @brief Check whether the time is known.
+    bool known() const
+    {
+        return (week != UnknownWeek) && (iTOW != UnknownTow);
+    }
+
+    /// @brief Total number of milliseconds since the beginning of GPS time.
+    std::uint64_t totalMs() const
+    {
+        return (static_cast<std::uint64_t>(week) * MsInWeek) + iTOW;
+    }
+};
+
+/// @brief Equality comparison operator.
+inline bool operator==(const GpsTime& first, const GpsTime& second)
+{
+    return (first.week == second.week) && (first.iTOW == second.iTOW);
+}
+
+/// @brief Inequality comparison operator.
+inline bool operator!=(const GpsTime& first, const GpsTime& second)
+{
+    return !(first == second);
+}
+
+/// @brief Ordering operator, the unknown time is greater than any other.
+inline bool operator<(const GpsTime& first, const GpsTime& second)
+{
+    return
+        (first.week < second.week) ||
+        ((first.week == second.week) && (first.iTOW < second.iTOW));
+}
+
+/// @brief Extraction of the GPS time from the frames without creating the
+///     message objects.
+/// @details The time of week is taken from the @b iTOW field
+///     (field::common::iTOW) leading the payload of all the NAV messages
+///     except NAV-EKFSTATUS. The week number is taken from NAV-TIMEGPS and
+///     NAV-SOL messages when reported as valid.
+struct FrameTime
+{
+    /// @brief Get time of week reported in the frame.
+    /// @param[in] frame Valid frame.
+    /// @param[out] iTOW Time of week in milliseconds.
+    /// @return true if the frame reports time of week.
+    static bool timeOfWeek(const FrameView& frame, std::uint32_t& iTOW)
+    {
+        if (!hasLeadingItow(frame.msgId())) {
+            return false;
+        }
+
+        auto payload = frame.payload();
+        if (payload.size() < field::common::iTOW::maxLength()) {
+            return false;
+        }
+
+        auto value = details::loadU4(payload.data());
+        if (GpsTime::MsInWeek <= value) {
+            return false;
+        }
+
+        iTOW = value;
+        return true;
+    }
+
+    /// @brief Get week number reported in the frame.
+    /// @param[in] frame Valid frame.
+    /// @param[out] week Week number.
+    /// @return true if the frame reports valid week number.
+    static bool weekNumber(const FrameView& frame, std::uint16_t& week)
+    {
+        auto payload = frame.payload();
+        if (frame.msgId() == MsgId_NAV_TIMEGPS) {
+            typedef MsgLayout<message::NavTimegps<> > Layout;
+            typedef message::NavTimegps<> Msg;
+            static const std::size_t WeekOffset = Layout::fieldOffset(Msg::FieldIdx_week);
+            static const std::size_t ValidOffset = Layout::fieldOffset(Msg::FieldIdx_valid);
+            static const std::uint8_t WeekValidMask = 0x2;
+            return
+                readWeek(payload, Layout::MinLength, WeekOffset, ValidOffset, WeekValidMask, week);
+        }
+
+        if (frame.msgId() == MsgId_NAV_SOL) {
+            typedef MsgLayout<message::NavSol<> > Layout;
+            typedef message::NavSol<> Msg;
+            static const std::size_t WeekOffset = Layout::fieldOffset(Msg::FieldIdx_week);
+            static const std::size_t FlagsOffset = Layout::fieldOffset(Msg::FieldIdx_flags);
+            static const std::uint8_t WeekSetMask = 0x4;
+            return
+                readWeek(payload, Layout::MinLength, WeekOffset, FlagsOffset, WeekSetMask, week);
+        }
+
+        return false;
+    }
+
+    /// @brief Check whether the payload of the message starts with
+    ///     field::common::iTOW.
+    static bool hasLeadingItow(MsgId id)
+    {
+        static_assert(details::LeadingItow<message::NavPosecef<> >::value, "iTOW is expected");
+        static_assert(details::LeadingItow<message::NavPosllh<> >::value, "iTOW is expected");
+        static_assert(details::LeadingItow<message::NavStatus<> >::value, "iTOW is expected");
+        static_assert(details::LeadingItow<message::NavDop<> >::value, "iTOW is expected");
+        static_assert(details::LeadingItow<message::NavSol<> >::value, "iTOW is expected");
+        static_assert(details::LeadingItow<message::NavPvt<> >::value, "iTOW is expected");
+        static_assert(details::LeadingItow<message::NavVelecef<> >::value, "iTOW is expected");
+        static_assert(details::LeadingItow<message::NavVelned<> >::value, "iTOW is expected");
+        static_assert(details::LeadingItow<message::NavTimegps<> >::value, "iTOW is expected");
+        static_assert(details::LeadingItow<message::NavTimeutc<> >::value, "iTOW is expected");
+        static_assert(details::LeadingItow<message::NavClock<> >::value, "iTOW is expected");
+        static_assert(details::LeadingItow<message::NavSvinfo<> >::value, "iTOW is expected");
+        static_assert(details::LeadingItow<message::NavDgps<> >::value, "iTOW is expected");
+        static_assert(details::LeadingItow<message::NavSbas<> >::value, "iTOW is expected");
+        static_assert(details::LeadingItow<message::NavAopstatus<> >::value, "iTOW is expected");
+
+        switch (id) {
+            case MsgId_NAV_POSECEF:
+            case MsgId_NAV_POSLLH:
+            case MsgId_NAV_STATUS:
+            case MsgId_NAV_DOP:
+            case MsgId_NAV_SOL:
+            case MsgId_NAV_PVT:
+            case MsgId_NAV_VELECEF:
+            case MsgId_NAV_VELNED:
+            case MsgId_NAV_TIMEGPS:
+            case MsgId_NAV_TIMEUTC:
+            case MsgId_NAV_CLOCK:
+            case MsgId_NAV_SVINFO:
+            case MsgId_NAV_DGPS:
+            case MsgId_NAV_SBAS:
+            case MsgId_NAV_AOPSTATUS:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+private:
+    static bool readWeek(
+        const FrameView::Payload& payload,
+        std::size_t minLength,
+        std::size_t weekOffset,
+        std::size_t flagsOffset,
+        std::uint8_t validMask,
+        std::uint16_t& week)
+    {
+        if ((payload.size() < minLength) ||
+            ((payload[flagsOffset] & validMask) == 0U)) {
+            return false;
+        }
+
+        auto value = details::loadU2(payload.data() + weekOffset);
+        if (value == GpsTime::UnknownWeek) {
+            return false;
+        }
+
+        week = value;
+        return true;
+    }
+};
+
+/// @brief Tracker of the GPS time over the sequence of frames.
+/// @details The time of every frame is the time of the latest navigation
+///     message preceding or being the frame. When the time of week wraps
+///     around without the week number being reported, the week number is
+///     incremented.
+class TimeTracker
+{
+public:
+    /// @brief Default constructor, the time is unknown.
+    TimeTracker() = default;
+
+    /// @brief Constructor
+    /// @param[in] initial Initial time, may be partially known.
+    explicit TimeTracker(const GpsTime& initial)
+      : m_time(initial)
+    {
+    }
+
+    /// @brief Update the time with the frame.
+    /// @return Current time.
+    const GpsTime& update(const FrameView& frame)
+    {
+        std::uint16_t week = 0U;
+        bool weekReported = FrameTime::weekNumber(frame, week);
+        if (weekReported) {
+            m_time.week = week;
+        }
+
+        std::uint32_t iTOW = 0U;
+        if (!FrameTime::timeOfWeek(frame, iTOW)) {
+            return m_time;
+        }
+
+        static const std::uint32_t HalfWeek = GpsTime::MsInWeek / 2;
+        if ((m_time.iTOW != GpsTime::UnknownTow) &&
+            (m_time.week != GpsTime::UnknownWeek) &&
+            (!weekReported) &&
+            (iTOW + HalfWeek < m_time.iTOW)) {
+            ++m_time.week;
+        }
+
+        m_time.iTOW = iTOW;
+        return m_time;
+    }
+
+    /// @brief Get current time.
+    const GpsTime& time() const
+    {
+        return m_time;
+    }
+
+    /// @brief Forget the current time.
+    void reset()
+    {
+        m_time = GpsTime();
+    }
+
+private:
+    GpsTime m_time;
+};
+
+}  // namespace capture
+
+}  // namespace ublox
+
+
@@ -0,0 +1,215 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::capture::MappedFile class.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define UBLOX_CAPTURE_MMAP
+#else
+#include <fstream>
+#include <iterator>
+#include <vector>
+#endif
+
+namespace ublox
+{
+
+namespace capture
+{
+
+/// @brief Read-only contents of the file mapped into memory.
+/// @details Uses @b mmap() on POSIX platforms, i.e. the pages are loaded
+///     on demand and nothing is copied. On other platforms the contents
+///     are read into the memory buffer. The object is movable, but not
+///     copyable.
+class MappedFile
+{
+public:
+    /// @brief Default constructor, creates closed file.
+    MappedFile() = default;
+
+    /// @brief Copy constructor is deleted.
+    MappedFile(const MappedFile&) = delete;
+
+    /// @brief Move constructor.
+    MappedFile(MappedFile&& other)
+    {
+        swap(other);
+    }
+
+    /// @brief Destructor, unmaps the file.
+    ~MappedFile()
+    {
+        close();
+    }
+
+    /// @brief Copy assignment is deleted.
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// @brief Move assignment.
+    MappedFile& operator=(MappedFile&& other)
+    {
+        if (this != &other) {
+            close();
+            swap(other);
+        }
+        return *this;
+    }
+
+    /// @brief Map the file.
+    /// @param[in] path Path to the file.
+    /// @return true on success, false if the file cannot be opened or mapped.
+    bool open(const std::string& path)
+    {
+        close();
+
+#ifdef UBLOX_CAPTURE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat info;
+        if ((::fstat(fd, &info) != 0) || (info.st_size < 0)) {
+            ::close(fd);
+            return false;
+        }
+
+        m_modTime = static_cast<std::uint64_t>(info.st_mtime);
+        auto size = static_cast<std::size_t>(info.st_size);
+        if (size == 0U) {
+            ::close(fd);
+            m_open = true;
+            return true;
+        }
+
+        void* addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            return false;
+        }
+
+        m_data = static_cast<const std::uint8_t*>(addr);
+        m_size = size;
+#else
+        std::ifstream stream(path, std::ios::in | std::ios::binary);
+        if (!stream) {
+            return false;
+        }
+
+        m_buf.assign(
+            std::istreambuf_iterator<char>(stream),
+            std::istreambuf_iterator<char>());
+        m_data = reinterpret_cast<const std::uint8_t*>(m_buf.data());
+        m_size = m_buf.size();
+#endif
+        m_open = true;
+        return true;
+    }
+
+    /// @brief Unmap the file.
+    void close()
+    {
+#ifdef UBLOX_CAPTURE_MMAP
+        if (m_data != nullptr) {
+            ::munmap(const_cast<std::uint8_t*>(m_data), m_size);
+        }
+#else
+        m_buf.clear();
+#endif
+        m_data = nullptr;
+        m_size = 0U;
+        m_modTime = 0U;
+        m_open = false;
+    }
+
+    /// @brief Advise the system that the contents are going to be accessed
+    ///     sequentially.
+    /// @details Has no effect on non-POSIX platforms.
+    void adviseSequential() const
+    {
+#ifdef UBLOX_CAPTURE_MMAP
+        if (m_data != nullptr) {
+            ::madvise(const_cast<std::uint8_t*>(m_data), m_size, MADV_SEQUENTIAL);
+        }
+#endif
+    }
+
+    /// @brief Check whether the file is open.
+    bool isOpen() const
+    {
+        return m_open;
+    }
+
+    /// @brief Pointer to the first byte of the file contents.
+    const std::uint8_t* data() const
+    {
+        return m_data;
+    }
+
+    /// @brief Size of the file.
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /// @brief Modification time of the file when it was opened, seconds
+    ///     since the epoch.
+    /// @details Always 0 on non-POSIX platforms.
+    std::uint64_t modificationTime() const
+    {
+        return m_modTime;
+    }
+
+private:
+    void swap(MappedFile& other)
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_modTime, other.m_modTime);
+        std::swap(m_open, other.m_open);
+#ifndef UBLOX_CAPTURE_MMAP
+        m_buf.swap(other.m_buf);
+#endif
+    }
+
+    const std::uint8_t* m_data = nullptr;
+    std::size_t m_size = 0U;
+    std::uint64_t m_modTime = 0U;
+    bool m_open = false;
+#ifndef UBLOX_CAPTURE_MMAP
+    std::vector<char> m_buf;
+#endif
+};
+
+}  // namespace capture
+
+}  // namespace ublox
+
+
@@ -0,0 +1,552 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::capture::ParallelDecoder class.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "comms/comms.h"
+
+#include "ublox/FrameView.h"
+#include "FrameScanner.h"
+
+namespace ublox
+{
+
+namespace capture
+{
+
+/// @brief Statistics of the decoding performed by @ref ParallelDecoder.
+struct DecodeStats
+{
+    /// @brief Number of valid frames.
+    std::size_t frames = 0U;
+
+    /// @brief Number of messages successfully read by the protocol stack.
+    std::size_t messages = 0U;
+
+    /// @brief Number of valid frames rejected by the protocol stack
+    ///     (unknown or invalid messages).
+    std::size_t failures = 0U;
+
+    /// @brief Number of bytes in the valid frames.
+    std::size_t bytes = 0U;
+
+    /// @brief Number of bytes not belonging to any valid frame.
+    std::size_t skipped = 0U;
+
+    /// @brief Accumulate statistics of other decoding.
+    DecodeStats& operator+=(const DecodeStats& other)
+    {
+        frames += other.frames;
+        messages += other.messages;
+        failures += other.failures;
+        bytes += other.bytes;
+        skipped += other.skipped;
+        return *this;
+    }
+};
+
+/// @brief Multi-threaded decoder of the large capture of the receiver output
+///     residing in contiguous buffer (such as @ref MappedFile).
+/// @details The buffer is split into chunks of approximately equal length.
+///     Every chunk tentatively starts at the safe frame boundary, i.e. the
+///     valid frame (confirmed by its checksum) followed by another valid
+///     frame or the end of the buffer, found by scanning for the
+///     synchronisation word from the split point. Such boundary may still
+///     be a "phantom" frame embedded in the payload of the frame starting
+///     before the split point. Therefore the chunks are first scanned in
+///     parallel, and then the boundaries are confirmed by following the
+///     chain of frames of the previous chunk: the frames of the chunk that
+///     start before the end of the last frame of the previous chunk are
+///     skipped until both chains reach the same frame, and the frames of
+///     the previous chain found on the way are added to the chunk. As the
+///     result, exactly the same frames are decoded as by decodeSequential().
+///     The chunk contains all the frames starting before the boundary of the
+///     next chunk. The chunks are decoded by the worker threads, every
+///     worker uses its own instance of the protocol stack. The worker
+///     threads are created for every decoding operation and joined before
+///     it returns.@n
+///     The messages can be delivered in two ways:
+///     @li decodeUnordered() - the handler is invoked directly by the worker
+///         threads in the order of the messages within the chunk, but
+///         in arbitrary order of the chunks. The handler must be thread
+///         safe.
+///     @li decodeOrdered() - the messages are stored by the workers and
+///         delivered in the original order by the calling thread. The number
+///         of the chunks decoded ahead of delivery is limited to twice the
+///         number of the worker threads. Requires
+///         the message objects to be dynamically allocated (not
+///         @ref StaticStack).
+///
+///     Using of the multiple threads requires linking with the platform
+///     threads library (such as @b -pthread).
+/// @code
+/// typedef ublox::Stack<MyMessage, ublox::InputMessages<MyMessage> > MyStack;
+/// ublox::capture::MappedFile file;
+/// file.open("capture.ubx");
+/// ublox::capture::ParallelDecoder<MyStack> decoder;
+/// decoder.decodeOrdered(file.data(), file.size(),
+///     [&handler](MyStack::MsgPtr& msg)
+///     {
+///         msg->dispatch(handler);
+///     });
+/// @endcode
+/// @tparam TStack Type of the protocol stack, such as @ref ublox::Stack.
+template <typename TStack>
+class ParallelDecoder
+{
+public:
+    /// @brief Type of the protocol stack.
+    typedef TStack Stack;
+
+    /// @brief Type of the smart pointer to the message object.
+    typedef typename Stack::MsgPtr MsgPtr;
+
+    /// @brief Boundaries of the chunk.
+    struct Chunk
+    {
+        /// @brief Offset of the first frame of the chunk found by scanning
+        ///     from @ref begin.
+        std::size_t begin;
+
+        /// @brief Offset of the first frame of the next chunk.
+        std::size_t end;
+
+        /// @brief Offsets of the frames of the chunk preceding @ref begin.
+        /// @details Not empty only when the tentative boundary of the chunk
+        ///     turned out to be inside the frame of the previous chunk.
+        std::vector<std::size_t> prefix;
+    };
+
+    /// @brief Default length of the chunk.
+    static const std::size_t DefaultChunkLength = 4U * 1024U * 1024U;
+
+    /// @brief Constructor
+    /// @param[in] threads Number of the worker threads, 0 means number of
+    ///     hardware threads.
+    /// @param[in] chunkLength Approximate length of the chunk.
+    explicit ParallelDecoder(
+        std::size_t threads = 0U,
+        std::size_t chunkLength = DefaultChunkLength)
+      : m_threads(threads),
+        m_chunkLength(std::max(chunkLength, FrameView::OverheadLength))
+    {
+        if (m_threads == 0U) {
+            m_threads = std::max(1U, std::thread::hardware_concurrency());
+        }
+    }
+
+    /// @brief Number of the worker threads.
+    std::size_t threads() const
+    {
+        return m_threads;
+    }
+
+    /// @brief Approximate length of the chunk.
+    std::size_t chunkLength() const
+    {
+        return m_chunkLength;
+    }
+
+    /// @brief Split the buffer into chunks.
+    /// @details Scans the chunks using the worker threads and confirms
+    ///     their boundaries (see the class description). The chunks without
+    ///     any frames are omitted.
+    std::vector<Chunk> split(const std::uint8_t* data, std::size_t len) const
+    {
+        std::vector<Chunk> chunks;
+        std::size_t prev = findBoundary(data, len, 0U);
+        while (prev < len) {
+            auto next = len;
+            if (m_chunkLength < (len - prev)) {
+                next = findBoundary(data, len, prev + m_chunkLength);
+            }
+
+            chunks.push_back(Chunk{prev, next, std::vector<std::size_t>()});
+            prev = next;
+        }
+
+        // Offset of the first frame following the last frame of every chunk
+        std::vector<std::size_t> tails(chunks.size(), len);
+        std::atomic<std::size_t> nextChunk(0U);
+        runWorkers(
+            [&](std::size_t)
+            {
+                while (true) {
+                    auto chunkIdx = nextChunk.fetch_add(1U);
+                    if (chunks.size() <= chunkIdx) {
+                        break;
+                    }
+
+                    tails[chunkIdx] = scanChunk(data, len, chunks[chunkIdx]);
+                }
+            });
+
+        // Next frame of the sequential chain
+        auto frame = nextFrame(data, len, 0U);
+        for (std::size_t idx = 0U; idx < chunks.size(); ++idx) {
+            auto& chunk = chunks[idx];
+            auto own = chunk.begin;
+            while ((frame != own) && (frame < chunk.end)) {
+                if (frame < own) {
+                    chunk.prefix.push_back(frame);
+                    frame = nextFrame(data, len, frameEnd(data, len, frame));
+                    continue;
+                }
+
+                own = nextFrame(data, len, frameEnd(data, len, own));
+            }
+
+            if (chunk.end <= frame) {
+                chunk.begin = chunk.end;
+                continue;
+            }
+
+            chunk.begin = frame;
+            frame = tails[idx];
+        }
+
+        chunks.erase(
+            std::remove_if(
+                chunks.begin(), chunks.end(),
+                [](const Chunk& chunk) -> bool
+                {
+                    return (chunk.end <= chunk.begin) && chunk.prefix.empty();
+                }),
+            chunks.end());
+        return chunks;
+    }
+
+    /// @brief Decode the buffer delivering the messages in arbitrary order
+    ///     of the chunks.
+    /// @param[in] data Pointer to the buffer.
+    /// @param[in] len Length of the buffer.
+    /// @param[in] handler Thread safe callable object with
+    ///     @code void (std::size_t chunkIdx, MsgPtr& msg) @endcode
+    ///     signature, invoked by the worker threads.
+    /// @return Accumulated statistics.
+    template <typename THandler>
+    DecodeStats decodeUnordered(const std::uint8_t* data, std::size_t len, THandler&& handler)
+    {
+        auto chunks = split(data, len);
+        std::atomic<std::size_t> nextChunk(0U);
+        std::vector<DecodeStats> stats(m_threads);
+
+        runWorkers(
+            [&](std::size_t workerIdx)
+            {
+                Stack stack;
+                while (true) {
+                    auto chunkIdx = nextChunk.fetch_add(1U);
+                    if (chunks.size() <= chunkIdx) {
+                        break;
+                    }
+
+                    stats[workerIdx] +=
+                        decodeChunk(
+                            stack, data, len, chunks[chunkIdx],
+                            [&handler, chunkIdx](MsgPtr& msg)
+                            {
+                                handler(chunkIdx, msg);
+                            });
+                }
+            });
+
+        return accumulate(stats, len);
+    }
+
+    /// @brief Decode the buffer delivering the messages in the original
+    ///     order.
+    /// @param[in] data Pointer to the buffer.
+    /// @param[in] len Length of the buffer.
+    /// @param[in] handler Callable object with
+    ///     @code void (MsgPtr& msg) @endcode signature, invoked by the
+    ///     calling thread.
+    /// @return Accumulated statistics.
+    template <typename THandler>
+    DecodeStats decodeOrdered(const std::uint8_t* data, std::size_t len, THandler&& handler)
+    {
+        auto chunks = split(data, len);
+        std::vector<std::vector<MsgPtr> > results(chunks.size());
+        std::vector<bool> ready(chunks.size(), false);
+        std::vector<DecodeStats> stats(m_threads);
+        std::size_t nextChunk = 0U;
+        std::size_t delivered = 0U;
+        std::mutex lock;
+        std::condition_variable workerCond;
+        std::condition_variable deliveryCond;
+        auto window = m_threads * 2U;
+
+        auto worker =
+            [&](std::size_t workerIdx)
+            {
+                Stack stack;
+                std::vector<MsgPtr> msgs;
+                std::unique_lock<std::mutex> guard(lock);
+                while (true) {
+                    workerCond.wait(guard,
+                        [&]()
+                        {
+                            return
+                                (chunks.size() <= nextChunk) ||
+                                (nextChunk < (delivered + window));
+                        });
+
+                    if (chunks.size() <= nextChunk) {
+                        break;
+                    }
+
+                    auto chunkIdx = nextChunk;
+                    ++nextChunk;
+                    guard.unlock();
+
+                    stats[workerIdx] +=
+                        decodeChunk(
+                            stack, data, len, chunks[chunkIdx],
+                            [&msgs](MsgPtr& msg)
+                            {
+                                msgs.push_back(std::move(msg));
+                            });
+
+                    guard.lock();
+                    results[chunkIdx] = std::move(msgs);
+                    msgs.clear();
+                    ready[chunkIdx] = true;
+                    deliveryCond.notify_one();
+                }
+            };
+
+        std::vector<std::thread> workers;
+        workers.reserve(m_threads);
+        for (std::size_t idx = 0U; idx < m_threads; ++idx) {
+            workers.emplace_back(worker, idx);
+        }
+
+        std::unique_lock<std::mutex> guard(lock);
+        while (delivered < chunks.size()) {
+            deliveryCond.wait(guard, [&]() { return ready[delivered]; });
+            std::vector<MsgPtr> msgs(std::move(results[delivered]));
+            guard.unlock();
+            for (auto& msg : msgs) {
+                handler(msg);
+            }
+            msgs.clear();
+            guard.lock();
+            ++delivered;
+            workerCond.notify_all();
+        }
+        guard.unlock();
+
+        for (auto& w : workers) {
+            w.join();
+        }
+
+        return accumulate(stats, len);
+    }
+
+    /// @brief Decode the buffer using the calling thread only.
+    /// @details Single threaded reference path, the messages are delivered
+    ///     in the original order.
+    /// @param[in] data Pointer to the buffer.
+    /// @param[in] len Length of the buffer.
+    /// @param[in] handler Callable object with
+    ///     @code void (MsgPtr& msg) @endcode signature.
+    /// @return Statistics of the decoding.
+    template <typename THandler>
+    static DecodeStats decodeSequential(const std::uint8_t* data, std::size_t len, THandler&& handler)
+    {
+        Stack stack;
+        Chunk chunk{0U, len, std::vector<std::size_t>()};
+        auto stats = decodeChunk(stack, data, len, chunk, handler);
+        stats.skipped = len - stats.bytes;
+        return stats;
+    }
+
+private:
+    template <typename TFunc>
+    void runWorkers(TFunc&& func) const
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(m_threads - 1U);
+        for (std::size_t idx = 1U; idx < m_threads; ++idx) {
+            workers.emplace_back(
+                [&func, idx]()
+                {
+                    func(idx);
+                });
+        }
+
+        func(0U);
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+
+    template <typename THandler>
+    static DecodeStats decodeChunk(
+        Stack& stack,
+        const std::uint8_t* data,
+        std::size_t len,
+        const Chunk& chunk,
+        THandler&& handler)
+    {
+        DecodeStats stats;
+        FrameView frame;
+        for (auto offset : chunk.prefix) {
+            const std::uint8_t* iter = data + offset;
+            if (frame.read(iter, len - offset) == comms::ErrorStatus::Success) {
+                decodeFrame(stack, frame, stats, handler);
+            }
+        }
+
+        if (chunk.end <= chunk.begin) {
+            return stats;
+        }
+
+        FrameScanner scanner(data + chunk.begin, len - chunk.begin);
+        auto* chunkEnd = data + chunk.end;
+        while (scanner.next(frame)) {
+            if (chunkEnd <= frame.data()) {
+                break;
+            }
+
+            decodeFrame(stack, frame, stats, handler);
+        }
+
+        return stats;
+    }
+
+    template <typename THandler>
+    static void decodeFrame(
+        Stack& stack,
+        const FrameView& frame,
+        DecodeStats& stats,
+        THandler& handler)
+    {
+        ++stats.frames;
+        stats.bytes += frame.length();
+
+        MsgPtr msg;
+        const std::uint8_t* readIter = frame.data();
+        auto es = stack.read(msg, readIter, frame.length());
+        if ((es != comms::ErrorStatus::Success) || (!msg)) {
+            ++stats.failures;
+            return;
+        }
+
+        ++stats.messages;
+        handler(msg);
+    }
+
+    static DecodeStats accumulate(const std::vector<DecodeStats>& stats, std::size_t len)
+    {
+        DecodeStats result;
+        for (auto& s : stats) {
+            result += s;
+        }
+        result.skipped = (result.bytes < len) ? (len - result.bytes) : 0U;
+        return result;
+    }
+
+    // Offset of the first frame following the last frame of the chunk,
+    // "len" if none
+    static std::size_t scanChunk(const std::uint8_t* data, std::size_t len, const Chunk& chunk)
+    {
+        FrameScanner scanner(data + chunk.begin, len - chunk.begin);
+        FrameView frame;
+        auto* chunkEnd = data + chunk.end;
+        while (scanner.next(frame)) {
+            if (chunkEnd <= frame.data()) {
+                return chunk.begin + scanner.offsetOf(frame);
+            }
+        }
+
+        return len;
+    }
+
+    // Offset of the first valid frame not preceding "from", "len" if none
+    static std::size_t nextFrame(const std::uint8_t* data, std::size_t len, std::size_t from)
+    {
+        if (len <= from) {
+            return len;
+        }
+
+        FrameScanner scanner(data + from, len - from);
+        FrameView frame;
+        if (!scanner.next(frame)) {
+            return len;
+        }
+
+        return from + scanner.offsetOf(frame);
+    }
+
+    // Offset following the valid frame
+    static std::size_t frameEnd(const std::uint8_t* data, std::size_t len, std::size_t offset)
+    {
+        FrameView frame;
+        const std::uint8_t* iter = data + offset;
+        if (frame.read(iter, len - offset) != comms::ErrorStatus::Success) {
+            return offset + 1U;
+        }
+
+        return offset + frame.length();
+    }
+
+    static bool validFrameAt(const std::uint8_t* data, std::size_t len, std::size_t offset)
+    {
+        FrameView frame;
+        const std::uint8_t* iter = data + offset;
+        return frame.read(iter, len - offset) == comms::ErrorStatus::Success;
+    }
+
+    // Offset of the first safe boundary not preceding "from", "len" if none
+    static std::size_t findBoundary(const std::uint8_t* data, std::size_t len, std::size_t from)
+    {
+        FrameScanner scanner(data + from, len - from);
+        FrameView frame;
+        while (scanner.next(frame)) {
+            auto offset = from + scanner.offsetOf(frame);
+            auto next = offset + frame.length();
+            if ((next == len) || validFrameAt(data, len, next)) {
+                return offset;
+            }
+        }
+
+        return len;
+    }
+
+    std::size_t m_threads = 1U;
+    std::size_t m_chunkLength = DefaultChunkLength;
+};
+
+}  // namespace capture
+
+}  // namespace ublox
+
+
@@ -0,0 +1,232 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::capture::TimeSeeker class.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+#include "ublox/FrameView.h"
+#include "FrameScanner.h"
+#include "FrameTime.h"
+
+namespace ublox
+{
+
+namespace capture
+{
+
+/// @brief Seeker of the position in the capture of the receiver output by
+///     the GPS time.
+/// @details Unlike @ref CaptureIndex it doesn't scan the whole capture.
+///     It performs binary search over the byte offsets, where every probe
+///     scans the frames following the probe point until the first frame
+///     reporting GPS time (see FrameTime), but not more than the probe
+///     limit. When the requested time contains valid week number, only the
+///     NAV-TIMEGPS and NAV-SOL frames with valid week are used, otherwise
+///     the time of week of any NAV frame is used, and the capture is
+///     expected not to cross the week boundary. Once the search range is
+///     not longer than the probe limit, the frames are scanned sequentially.
+///     The capture is expected to have non-decreasing time, otherwise the
+///     found position is not necessarily the first one with the requested
+///     time, but still within the capture. The capture is expected to be
+///     mapped into memory (see @ref MappedFile), so only the pages around
+///     the probe points are actually read.
+/// @code
+/// ublox::capture::MappedFile file;
+/// file.open("capture.ubx");
+/// ublox::capture::TimeSeeker seeker(file.data(), file.size());
+/// auto range =
+///     seeker.window(
+///         ublox::capture::GpsTime(1890, 300000000),
+///         ublox::capture::GpsTime(1890, 303600000));
+/// ublox::capture::FrameScanner scanner(file.data() + range.first, range.second - range.first);
+/// ublox::FrameView frame;
+/// while (scanner.next(frame)) {
+///     ... // process the frame
+/// }
+/// @endcode
+class TimeSeeker
+{
+public:
+    /// @brief Default limit of the bytes scanned by the single probe.
+    static const std::size_t DefaultProbeLimit = 64U * 1024U;
+
+    /// @brief Constructor
+    /// @param[in] data Pointer to the capture contents.
+    /// @param[in] len Length of the capture.
+    /// @param[in] probeLimit Maximal number of bytes scanned by the single
+    ///     probe, expected to be greater than the length of the single
+    ///     navigation epoch.
+    TimeSeeker(
+        const std::uint8_t* data,
+        std::size_t len,
+        std::size_t probeLimit = DefaultProbeLimit)
+      : m_data(data),
+        m_len(len),
+        m_probeLimit(probeLimit)
+    {
+    }
+
+    /// @brief Find the first frame of the navigation epoch with the GPS time
+    ///     not less than provided.
+    /// @param[in] time Requested time, the week may be
+    ///     GpsTime::UnknownWeek.
+    /// @return Offset of the frame from the beginning of the capture, or its
+    ///     length if there is no such frame.
+    std::size_t seek(const GpsTime& time)
+    {
+        bool useWeek = (time.week != GpsTime::UnknownWeek);
+        std::size_t lo = 0U;
+        std::size_t hi = m_len;
+        GpsTime loTime;
+        while (m_probeLimit < (hi - lo)) {
+            auto mid = lo + ((hi - lo) / 2);
+            auto anchor = probe(mid, useWeek);
+            // The anchor beyond the upper bound (possible when the time
+            // decreases or the frames are found inside the payload of
+            // other frames) doesn't narrow the range.
+            if ((!anchor.valid) ||
+                (hi <= anchor.offset) ||
+                (!before(anchor.time, time, useWeek))) {
+                hi = mid;
+                continue;
+            }
+
+            lo = anchor.offset;
+            loTime = anchor.time;
+        }
+
+        if (useWeek && (loTime.week == GpsTime::UnknownWeek)) {
+            auto anchor = probe(lo, useWeek);
+            if (anchor.valid) {
+                loTime.week = anchor.time.week;
+            }
+        }
+
+        loTime.iTOW = GpsTime::UnknownTow;
+        return scan(lo, loTime, time, useWeek);
+    }
+
+    /// @brief Find the range of the capture containing frames with GPS
+    ///     time in the provided range.
+    /// @return Pair of offsets, the first frame with time not less than
+    ///     @b from, and the first frame with time not less than @b to.
+    std::pair<std::size_t, std::size_t> window(const GpsTime& from, const GpsTime& to)
+    {
+        auto begin = seek(from);
+        auto end = seek(to);
+        if (end < begin) {
+            end = begin;
+        }
+        return std::make_pair(begin, end);
+    }
+
+    /// @brief Total number of bytes scanned so far.
+    std::size_t scannedCount() const
+    {
+        return m_scanned;
+    }
+
+    /// @brief Reset the counter of scanned bytes.
+    void resetScannedCount()
+    {
+        m_scanned = 0U;
+    }
+
+private:
+    struct Anchor
+    {
+        std::size_t offset = 0U;
+        GpsTime time;
+        bool valid = false;
+    };
+
+    static bool before(const GpsTime& time, const GpsTime& requested, bool useWeek)
+    {
+        if (useWeek) {
+            return time < requested;
+        }
+
+        return time.iTOW < requested.iTOW;
+    }
+
+    Anchor probe(std::size_t from, bool useWeek)
+    {
+        Anchor anchor;
+        FrameScanner scanner(m_data + from, m_len - from);
+        FrameView frame;
+        while (scanner.next(frame)) {
+            auto offset = from + scanner.offsetOf(frame);
+            if ((from + m_probeLimit) <= offset) {
+                break;
+            }
+
+            if (!FrameTime::timeOfWeek(frame, anchor.time.iTOW)) {
+                continue;
+            }
+
+            if (useWeek && (!FrameTime::weekNumber(frame, anchor.time.week))) {
+                continue;
+            }
+
+            anchor.offset = offset;
+            anchor.valid = true;
+            break;
+        }
+
+        m_scanned += scanner.offset();
+        return anchor;
+    }
+
+    std::size_t scan(std::size_t from, const GpsTime& initial, const GpsTime& time, bool useWeek)
+    {
+        FrameScanner scanner(m_data + from, m_len - from);
+        TimeTracker tracker(initial);
+        FrameView frame;
+        std::size_t result = m_len;
+        while (scanner.next(frame)) {
+            auto& current = tracker.update(frame);
+            if ((!FrameTime::hasLeadingItow(frame.msgId())) ||
+                (useWeek && (current.week == GpsTime::UnknownWeek)) ||
+                (before(current, time, useWeek))) {
+                continue;
+            }
+
+            result = from + scanner.offsetOf(frame);
+            break;
+        }
+
+        m_scanned += scanner.offset();
+        return result;
+    }
+
+    const std::uint8_t* m_data = nullptr;
+    std::size_t m_len = 0U;
+    std::size_t m_probeLimit = DefaultProbeLimit;
+    std::size_t m_scanned = 0U;
+};
+
+}  // namespace capture
+
+}  // namespace ublox
+
+
@@ -0,0 +1,138 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains compile time calculation of serialisation length of
+///     the fields.
+
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+
+namespace ublox
+{
+
+namespace details
+{
+
+/// @brief Maximal payload length allowed by @b LENGTH field.
+static const std::size_t MaxPayloadLengthLimit = 0xffff;
+
+/// @brief Sum of two lengths saturated at provided limit.
+constexpr std::size_t saturatedAdd(std::size_t limit, std::size_t first, std::size_t second)
+{
+    return
+        ((limit <= first) || ((limit - first) <= second)) ? limit :
+        (first + second);
+}
+
+/// @brief Sum of the lengths saturated at provided limit.
+constexpr std::size_t saturatedSum(std::size_t)
+{
+    return 0U;
+}
+
+template <typename... TLengths>
+constexpr std::size_t saturatedSum(std::size_t limit, std::size_t first, TLengths... rest)
+{
+    return saturatedAdd(limit, first, saturatedSum(limit, rest...));
+}
+
+/// @brief Length with provided index among the listed ones, 0 if there
+///     is no such index.
+constexpr std::size_t lengthAt(std::size_t)
+{
+    return 0U;
+}
+
+template <typename... TLengths>
+constexpr std::size_t lengthAt(std::size_t idx, std::size_t first, TLengths... rest)
+{
+    return (idx == 0U) ? first : lengthAt(idx - 1, rest...);
+}
+
+/// @brief Sum of the first @b count lengths among the listed ones,
+///     saturated at provided limit.
+constexpr std::size_t saturatedPrefixSum(std::size_t, std::size_t)
+{
+    return 0U;
+}
+
+template <typename... TLengths>
+constexpr std::size_t saturatedPrefixSum(
+    std::size_t limit,
+    std::size_t count,
+    std::size_t first,
+    TLengths... rest)
+{
+    return
+        (count == 0U) ? 0U :
+        saturatedAdd(limit, first, saturatedPrefixSum(limit, count - 1, rest...));
+}
+
+/// @brief Minimal serialisation length of the fields bundled in std::tuple,
+///     limited by @ref MaxPayloadLengthLimit.
+template <typename TFields>
+struct FieldsMinLength;
+
+template <typename... TFields>
+struct FieldsMinLength<std::tuple<TFields...> >
+{
+    static const std::size_t Value =
+        saturatedSum(MaxPayloadLengthLimit, TFields::minLength()...);
+};
+
+/// @brief Maximal serialisation length of the fields bundled in std::tuple,
+///     limited by @ref MaxPayloadLengthLimit.
+template <typename TFields>
+struct FieldsMaxLength;
+
+template <typename... TFields>
+struct FieldsMaxLength<std::tuple<TFields...> >
+{
+    static const std::size_t Value =
+        saturatedSum(MaxPayloadLengthLimit, TFields::maxLength()...);
+};
+
+/// @brief Offset of the field with index @b TIdx from the beginning of
+///     the fields bundled in std::tuple.
+/// @details Expects all the preceding fields to have fixed serialisation
+///     length.
+template <typename TFields, std::size_t TIdx>
+struct FieldsOffset
+{
+    typedef typename std::tuple_element<TIdx - 1, TFields>::type PrevField;
+
+    static_assert(PrevField::minLength() == PrevField::maxLength(),
+        "The preceding fields are expected to have fixed length");
+
+    static const std::size_t Value =
+        FieldsOffset<TFields, TIdx - 1>::Value + PrevField::maxLength();
+};
+
+template <typename TFields>
+struct FieldsOffset<TFields, 0U>
+{
+    static const std::size_t Value = 0U;
+};
+
+}  // namespace details
+
+}  // namespace ublox
+
+
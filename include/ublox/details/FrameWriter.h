@@ -0,0 +1,97 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains serialisation of the complete frames into memory buffer.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "comms/comms.h"
+
+#include "ublox/MsgId.h"
+#include "ublox/FrameView.h"
+#include "ublox/protocol/ChecksumCalc.h"
+#include "ublox/protocol/SyncScanner.h"
+
+namespace ublox
+{
+
+namespace details
+{
+
+/// @brief Class ID of the message ID.
+constexpr unsigned msgClassOf(MsgId id)
+{
+    return static_cast<unsigned>(id) >> std::numeric_limits<std::uint8_t>::digits;
+}
+
+/// @brief Write complete frame with provided ID and payload.
+/// @param[in] id ID of the message.
+/// @param[in] payload Pointer to the payload.
+/// @param[in] len Length of the payload.
+/// @param[out] frame Buffer receiving the frame, resized to the frame length.
+/// @return false if the payload is too long, true otherwise.
+inline bool writeFrame(
+    MsgId id,
+    const std::uint8_t* payload,
+    std::size_t len,
+    std::vector<std::uint8_t>& frame)
+{
+    if (std::numeric_limits<std::uint16_t>::max() < len) {
+        return false;
+    }
+
+    static const std::size_t Digits = std::numeric_limits<std::uint8_t>::digits;
+    frame.resize(len + FrameView::OverheadLength);
+    frame[0] = protocol::SyncChar1;
+    frame[1] = protocol::SyncChar2;
+    frame[2] = static_cast<std::uint8_t>(msgClassOf(id));
+    frame[3] = static_cast<std::uint8_t>(id);
+    frame[4] = static_cast<std::uint8_t>(len);
+    frame[5] = static_cast<std::uint8_t>(len >> Digits);
+    std::copy(payload, payload + len, &frame[FrameView::HeaderLength]);
+
+    const std::uint8_t* csIter = &frame[2];
+    auto checksum = protocol::ChecksumCalc()(csIter, FrameView::HeaderLength - 2U + len);
+    frame[frame.size() - 2U] = static_cast<std::uint8_t>(checksum);
+    frame[frame.size() - 1U] = static_cast<std::uint8_t>(checksum >> Digits);
+    return true;
+}
+
+/// @brief Write payload of the message object.
+/// @param[in] msg Message object.
+/// @param[out] payload Buffer receiving the payload, resized to its length.
+/// @return false if the serialisation fails, true otherwise.
+template <typename TMsg>
+bool writePayload(const TMsg& msg, std::vector<std::uint8_t>& payload)
+{
+    payload.resize(msg.length());
+    std::uint8_t* writeIter = payload.data();
+    return msg.write(writeIter, payload.size()) == comms::ErrorStatus::Success;
+}
+
+}  // namespace details
+
+}  // namespace ublox
+
+
@@ -0,0 +1,263 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+/// @file
+/// @brief Contains compile time generation of lookup tables indexed by
+///     message ID.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "ublox/MsgId.h"
+
+namespace ublox
+{
+
+namespace details
+{
+
+template <std::size_t... TIdx>
+struct IndexSeq
+{
+};
+
+template <typename TFirst, typename TSecond>
+struct IndexSeqConcat;
+
+template <std::size_t... TFirst, std::size_t... TSecond>
+struct IndexSeqConcat<IndexSeq<TFirst...>, IndexSeq<TSecond...> >
+{
+    typedef IndexSeq<TFirst..., (sizeof...(TFirst) + TSecond)...> Type;
+};
+
+template <std::size_t TSize>
+struct MakeIndexSeq
+{
+    typedef typename IndexSeqConcat<
+        typename MakeIndexSeq<TSize / 2>::Type,
+        typename MakeIndexSeq<TSize - (TSize / 2)>::Type
+    >::Type Type;
+};
+
+template <>
+struct MakeIndexSeq<0>
+{
+    typedef IndexSeq<> Type;
+};
+
+template <>
+struct MakeIndexSeq<1>
+{
+    typedef IndexSeq<0> Type;
+};
+
+/// @brief Compile time calculations over the list of message IDs.
+/// @details All the functions are recursive (C++11 constexpr restrictions),
+///     and are expected to be evaluated by the compiler only.
+template <std::size_t TCount>
+struct MsgIdListOps
+{
+    typedef const std::uint16_t (&Ids)[TCount];
+
+    static constexpr std::uint8_t classOf(std::uint16_t id)
+    {
+        return static_cast<std::uint8_t>(id >> std::numeric_limits<std::uint8_t>::digits);
+    }
+
+    // Index of the first message with specified ID, TCount if not found
+    static constexpr std::size_t findId(Ids ids, std::uint16_t id, std::size_t from = 0)
+    {
+        return
+            (TCount <= from) ? TCount :
+            (ids[from] == id) ? from :
+            findId(ids, id, from + 1);
+    }
+
+    // Index of the first message with specified class, TCount if not found
+    static constexpr std::size_t findClass(Ids ids, std::uint8_t cls, std::size_t from = 0)
+    {
+        return
+            (TCount <= from) ? TCount :
+            (classOf(ids[from]) == cls) ? from :
+            findClass(ids, cls, from + 1);
+    }
+
+    // Number of distinct classes among first "count" messages
+    static constexpr std::size_t distinctClasses(Ids ids, std::size_t count)
+    {
+        return
+            (count == 0U) ? 0U :
+            distinctClasses(ids, count - 1) +
+                ((findClass(ids, classOf(ids[count - 1])) == (count - 1)) ? 1U : 0U);
+    }
+
+    // Row in the table for class, 0 (empty row) if class is not used
+    static constexpr std::size_t rowOfClass(Ids ids, std::uint8_t cls)
+    {
+        return
+            (findClass(ids, cls) == TCount) ? 0U :
+            distinctClasses(ids, findClass(ids, cls)) + 1U;
+    }
+
+    // Whether the IDs are sorted and unique
+    static constexpr bool sortedUnique(Ids ids, std::size_t from = 1)
+    {
+        return
+            (TCount <= from) ? true :
+            (ids[from] <= ids[from - 1]) ? false :
+            sortedUnique(ids, from + 1);
+    }
+
+    // Index of the next message with the same ID, TCount if none
+    static constexpr std::size_t nextSame(Ids ids, std::size_t idx, std::size_t from)
+    {
+        return
+            (TCount <= from) ? TCount :
+            (ids[from] == ids[idx]) ? from :
+            nextSame(ids, idx, from + 1);
+    }
+};
+
+/// @brief Two level lookup tables indexed by class ID.
+/// @details Every class present in the list of IDs gets its own row, while
+///     row 0 is shared by all the other (unknown) classes.
+/// @tparam TIds Type containing list of IDs in its static @b Values array.
+template <typename TIds>
+struct MsgIdClassTables
+{
+    static const std::size_t NumOfIds = std::extent<decltype(TIds::Values)>::value;
+    typedef MsgIdListOps<NumOfIds> Ops;
+
+    static const std::size_t NumOfCells =
+        static_cast<std::size_t>(std::numeric_limits<std::uint8_t>::max()) + 1U;
+
+    static const std::size_t NumOfRows = Ops::distinctClasses(TIds::Values, NumOfIds) + 1U;
+
+    // Class ID -> row
+    template <typename TSeq>
+    struct ClassRows;
+
+    template <std::size_t... TIdx>
+    struct ClassRows<IndexSeq<TIdx...> >
+    {
+        static constexpr std::uint8_t Values[sizeof...(TIdx)] = {
+            static_cast<std::uint8_t>(Ops::rowOfClass(TIds::Values, static_cast<std::uint8_t>(TIdx)))...
+        };
+    };
+
+    typedef ClassRows<typename MakeIndexSeq<NumOfCells>::Type> ClassRowsTable;
+
+    // Row -> class ID
+    static constexpr std::size_t findRow(std::size_t row, std::size_t cls = 0)
+    {
+        return
+            (NumOfCells <= cls) ? 0U :
+            (ClassRowsTable::Values[cls] == row) ? cls :
+            findRow(row, cls + 1);
+    }
+
+    template <typename TSeq>
+    struct RowClasses;
+
+    template <std::size_t... TIdx>
+    struct RowClasses<IndexSeq<TIdx...> >
+    {
+        static constexpr std::uint8_t Values[sizeof...(TIdx)] = {
+            static_cast<std::uint8_t>(findRow(TIdx))...
+        };
+    };
+
+    typedef RowClasses<typename MakeIndexSeq<NumOfRows>::Type> RowClassesTable;
+
+    static constexpr std::size_t rowOf(MsgId id)
+    {
+        return ClassRowsTable::Values[static_cast<std::uint8_t>(id >> std::numeric_limits<std::uint8_t>::digits)];
+    }
+};
+
+template <typename TIds>
+template <std::size_t... TIdx>
+constexpr std::uint8_t MsgIdClassTables<TIds>::ClassRows<IndexSeq<TIdx...> >::Values[sizeof...(TIdx)];
+
+template <typename TIds>
+template <std::size_t... TIdx>
+constexpr std::uint8_t MsgIdClassTables<TIds>::RowClasses<IndexSeq<TIdx...> >::Values[sizeof...(TIdx)];
+
+/// @brief Class indexed bitset of IDs.
+/// @details Every row contains 256 bits, one for every ID within the class.
+/// @tparam TIds Type containing list of IDs in its static @b Values array.
+template <typename TIds>
+struct MsgIdBitTable : public MsgIdClassTables<TIds>
+{
+    typedef MsgIdClassTables<TIds> Base;
+    typedef std::uint32_t WordType;
+
+    static const std::size_t BitsPerWord = std::numeric_limits<WordType>::digits;
+    static const std::size_t WordsPerRow = Base::NumOfCells / BitsPerWord;
+
+    static constexpr WordType bitOf(std::uint16_t id, std::size_t row, std::size_t word)
+    {
+        return
+            ((Base::Ops::classOf(id) == Base::RowClassesTable::Values[row]) &&
+             (((id & 0xff) / BitsPerWord) == word)) ?
+                (static_cast<WordType>(1U) << (id % BitsPerWord)) :
+                0U;
+    }
+
+    static constexpr WordType word(std::size_t pos, std::size_t from = 0)
+    {
+        return
+            ((pos < WordsPerRow) || (Base::NumOfIds <= from)) ? 0U :
+            bitOf(TIds::Values[from], pos / WordsPerRow, pos % WordsPerRow) | word(pos, from + 1);
+    }
+
+    template <typename TSeq>
+    struct Words;
+
+    template <std::size_t... TIdx>
+    struct Words<IndexSeq<TIdx...> >
+    {
+        static constexpr WordType Values[sizeof...(TIdx)] = {
+            word(TIdx)...
+        };
+    };
+
+    typedef Words<typename MakeIndexSeq<Base::NumOfRows * WordsPerRow>::Type> WordsTable;
+
+    static constexpr bool contains(MsgId id)
+    {
+        return
+            (WordsTable::Values[(Base::rowOf(id) * WordsPerRow) + ((id & 0xff) / BitsPerWord)] &
+             (static_cast<WordType>(1U) << (id % BitsPerWord))) != 0U;
+    }
+};
+
+template <typename TIds>
+template <std::size_t... TIdx>
+constexpr typename MsgIdBitTable<TIds>::WordType
+MsgIdBitTable<TIds>::Words<IndexSeq<TIdx...> >::Values[sizeof...(TIdx)];
+
+}  // namespace details
+
+}  // namespace ublox
+
+
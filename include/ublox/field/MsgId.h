@@ -21,10 +21,12 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include <limits>
-#include <algorithm>
+#include <type_traits>
 #include "comms/comms.h"
 #include "ublox/MsgId.h"
+#include "ublox/details/MsgIdTables.h"
 
 namespace ublox
 {
@@ -35,252 +37,52 @@ namespace field
 namespace details
 {
 
-struct MsgIdValueValidator
+/// @brief All the valid message IDs.
+/// @details Generated from @ref UBLOX_MSG_ID_LIST, i.e. contains every
+///     value of ublox::MsgId enumeration.
+template <typename TDummy = void>
+struct ValidMsgIdsT
 {
-    template <typename TField>
-    bool operator()(const TField& field) const
-    {
-        typedef bool (*ValidateFunc)(ublox::MsgId);
-
-        static const ValidateFunc Funcs[] = {
-            &MsgIdValueValidator::validateNav,
-            &MsgIdValueValidator::validateRxm,
-            &MsgIdValueValidator::validateInf,
-            &MsgIdValueValidator::validateAck,
-            &MsgIdValueValidator::validateCfg,
-            &MsgIdValueValidator::validateMon,
-            &MsgIdValueValidator::validateAid,
-            &MsgIdValueValidator::validateTim,
-            &MsgIdValueValidator::validateLog
-        };
-
-        ublox::MsgId id = field.value();
-        return std::any_of(
-            std::begin(Funcs), std::end(Funcs),
-            [id](ValidateFunc func) -> bool
-            {
-                return func(id);
-            });
-    }
-
-private:
-    static constexpr std::uint8_t classId(ublox::MsgId id)
-    {
-        return static_cast<std::uint8_t>(
-            (unsigned)id >> std::numeric_limits<std::uint8_t>::digits);
-    }
-
-    static bool validateNav(ublox::MsgId id)
-    {
-        static const auto NavClassId = classId(MsgId_NAV_POSECEF);
-
-        if (classId(id) != NavClassId) {
-            return false;
-        }
-
-        static const ublox::MsgId IDs[] = {
-            MsgId_NAV_POSECEF,
-            MsgId_NAV_POSLLH,
-            MsgId_NAV_STATUS,
-            MsgId_NAV_DOP,
-            MsgId_NAV_SOL,
-            MsgId_NAV_PVT,
-            MsgId_NAV_VELECEF,
-            MsgId_NAV_VELNED,
-            MsgId_NAV_TIMEGPS,
-            MsgId_NAV_TIMEUTC,
-            MsgId_NAV_CLOCK,
-            MsgId_NAV_SVINFO,
-            MsgId_NAV_DGPS,
-            MsgId_NAV_SBAS,
-            MsgId_NAV_EKFSTATUS,
-            MsgId_NAV_AOPSTATUS
-        };
-
-        auto iter = std::lower_bound(std::begin(IDs), std::end(IDs), id);
-        return (iter != std::end(IDs)) && (*iter == id);
-    }
-
-    static bool validateRxm(ublox::MsgId id)
-    {
-        static const auto RxmClassId = classId(MsgId_RXM_RAW);
-
-        if (classId(id) != RxmClassId) {
-            return false;
-        }
-
-        static const ublox::MsgId IDs[] = {
-            MsgId_RXM_RAW,
-            MsgId_RXM_SFRB,
-            MsgId_RXM_SVSI,
-            MsgId_RXM_ALM,
-            MsgId_RXM_EPH,
-            MsgId_RXM_PMREQ,
-        };
-
-        auto iter = std::lower_bound(std::begin(IDs), std::end(IDs), id);
-        return (iter != std::end(IDs)) && (*iter == id);
-    }
-
-    static bool validateInf(ublox::MsgId id)
-    {
-        static const auto InfClassId = classId(MsgId_INF_ERROR);
-
-        if (classId(id) != InfClassId) {
-            return false;
-        }
-
-        static const ublox::MsgId IDs[] = {
-            MsgId_INF_ERROR,
-            MsgId_INF_WARNING,
-            MsgId_INF_NOTICE,
-            MsgId_INF_TEST,
-            MsgId_INF_DEBUG
-        };
-
-        auto iter = std::lower_bound(std::begin(IDs), std::end(IDs), id);
-        return (iter != std::end(IDs)) && (*iter == id);
-    }
-
-    static bool validateAck(ublox::MsgId id)
-    {
-        return (ublox::MsgId_ACK_NAK <= id) && (id <= MsgId_ACK_ACK);
-    }
-
-    static bool validateCfg(ublox::MsgId id)
-    {
-        static const auto CfgClassId = classId(MsgId_CFG_PRT);
-
-        if (classId(id) != CfgClassId) {
-            return false;
-        }
-
-        static const ublox::MsgId IDs[] = {
-            MsgId_CFG_PRT,
-            MsgId_CFG_MSG,
-            MsgId_CFG_INF,
-            MsgId_CFG_RST,
-            MsgId_CFG_DAT,
-            MsgId_CFG_TP,
-            MsgId_CFG_RATE,
-            MsgId_CFG_CFG,
-            MsgId_CFG_FXN,
-            MsgId_CFG_RXM,
-            MsgId_CFG_EKF,
-            MsgId_CFG_ANT,
-            MsgId_CFG_SBAS,
-            MsgId_CFG_NMEA,
-            MsgId_CFG_USB,
-            MsgId_CFG_TMODE,
-            MsgId_CFG_NVS,
-            MsgId_CFG_NAVX5,
-            MsgId_CFG_NAV5,
-            MsgId_CFG_ESFGWT,
-            MsgId_CFG_TP5,
-            MsgId_CFG_PM,
-            MsgId_CFG_RINV,
-            MsgId_CFG_ITFM,
-            MsgId_CFG_PM2,
-            MsgId_CFG_TMODE2,
-            MsgId_CFG_GNSS,
-            MsgId_CFG_LOGFILTER
-        };
-
-        auto iter = std::lower_bound(std::begin(IDs), std::end(IDs), id);
-        return (iter != std::end(IDs)) && (*iter == id);
-    }
-
-    static bool validateMon(ublox::MsgId id)
-    {
-        static const auto MonClassId = classId(MsgId_MON_IO);
-
-        if (classId(id) != MonClassId) {
-            return false;
-        }
-
-        static const ublox::MsgId IDs[] = {
-            MsgId_MON_IO,
-            MsgId_MON_VER,
-            MsgId_MON_MSGPP,
-            MsgId_MON_RXBUF,
-            MsgId_MON_TXBUF,
-            MsgId_MON_HW,
-            MsgId_MON_HW2,
-            MsgId_MON_RXR
-        };
-
-        auto iter = std::lower_bound(std::begin(IDs), std::end(IDs), id);
-        return (iter != std::end(IDs)) && (*iter == id);
-    }
-
-    static bool validateAid(ublox::MsgId id)
-    {
-        static const auto AidClassId = classId(MsgId_AID_REQ);
-
-        if (classId(id) != AidClassId) {
-            return false;
-        }
+#define UBLOX_MSG_ID_VALUE(name_, value_) MsgId_ ## name_,
+    static constexpr std::uint16_t Values[] = {
+        UBLOX_MSG_ID_LIST(UBLOX_MSG_ID_VALUE)
+    };
+#undef UBLOX_MSG_ID_VALUE
+};
 
-        static const ublox::MsgId IDs[] = {
-            MsgId_AID_REQ,
-            MsgId_AID_INI,
-            MsgId_AID_HUI,
-            MsgId_AID_DATA,
-            MsgId_AID_ALM,
-            MsgId_AID_EPH,
-            MsgId_AID_ALPSRV,
-            MsgId_AID_AOP,
-            MsgId_AID_ALP
-        };
+template <typename TDummy>
+constexpr std::uint16_t ValidMsgIdsT<TDummy>::Values[];
 
-        auto iter = std::lower_bound(std::begin(IDs), std::end(IDs), id);
-        return (iter != std::end(IDs)) && (*iter == id);
-    }
+/// @brief Definition of the list of valid message IDs.
+typedef ValidMsgIdsT<> ValidMsgIds;
 
-    static bool validateTim(ublox::MsgId id)
-    {
-        static const auto TimClassId = classId(MsgId_TIM_TP);
+/// @brief Number of values in ublox::MsgId enumeration.
+static const std::size_t NumOfValidMsgIds = std::extent<decltype(ValidMsgIds::Values)>::value;
 
-        if (classId(id) != TimClassId) {
-            return false;
-        }
+/// @brief Class indexed bitset of the valid message IDs.
+typedef ublox::details::MsgIdBitTable<ValidMsgIds> ValidMsgIdsBitTable;
 
-        static const ublox::MsgId IDs[] = {
-            MsgId_TIM_TP,
-            MsgId_TIM_TM2,
-            MsgId_TIM_SVIN,
-            MsgId_TIM_VRFY,
-        };
+static_assert(
+    ublox::details::MsgIdListOps<NumOfValidMsgIds>::sortedUnique(ValidMsgIds::Values),
+    "The list of valid IDs must be sorted and not contain duplicates");
 
-        auto iter = std::lower_bound(std::begin(IDs), std::end(IDs), id);
-        return (iter != std::end(IDs)) && (*iter == id);
-    }
+#define UBLOX_MSG_ID_CHECK(name_, value_) \
+    static_assert(ValidMsgIdsBitTable::contains(MsgId_ ## name_), \
+        "MsgId_" #name_ " is not recognised as valid message ID");
+UBLOX_MSG_ID_LIST(UBLOX_MSG_ID_CHECK)
+#undef UBLOX_MSG_ID_CHECK
 
-    static bool validateLog(ublox::MsgId id)
+/// @brief Validator of the message ID field.
+/// @details Uses class indexed bitset (256 bits per known class) generated
+///     at compile time from the @ref ValidMsgIds list, i.e. the validation
+///     is a single bit test.
+struct MsgIdValueValidator
+{
+    template <typename TField>
+    bool operator()(const TField& field) const
     {
-        static const auto LogClassId = classId(MsgId_LOG_ERASE);
-
-        if (classId(id) != LogClassId) {
-            return false;
-        }
-
-        static const ublox::MsgId IDs[] = {
-            MsgId_LOG_ERASE,
-            MsgId_LOG_STRING,
-            MsgId_LOG_CREATE,
-            MsgId_LOG_INFO,
-            MsgId_LOG_RETRIEVE,
-            MsgId_LOG_RETRIEVEPOS,
-            MsgId_LOG_RETRIEVESTRING,
-            MsgId_LOG_FINDTIME
-        };
-
-        auto iter = std::lower_bound(std::begin(IDs), std::end(IDs), id);
-        return (iter != std::end(IDs)) && (*iter == id);
+        return ValidMsgIdsBitTable::contains(field.value());
     }
-
-
-
 };
 
 }  // namespace details
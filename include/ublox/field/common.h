@@ -21,7 +21,9 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include <limits>
+#include <type_traits>
 
 #include "comms/comms.h"
 
@@ -312,6 +314,23 @@ using ListT =
         TOptions...
     >;
 
+/// @brief Common definition of list field with selectable storage.
+/// @details Same as @ref ListT when @b TCapacity is @b 0, i.e. the elements
+///     are stored in dynamically allocated std::vector. Otherwise
+///     <a href="https://dl.dropboxusercontent.com/u/46999418/comms_champion/comms/html/structcomms_1_1option_1_1FixedSizeStorage.html">comms::option::FixedSizeStorage</a>
+///     option is added, i.e. up to @b TCapacity elements are stored
+///     in place.
+/// @tparam TElem Element of the list.
+/// @tparam TCapacity Maximal number of stored elements, 0 for unlimited.
+/// @tparam TOptions Extra options.
+template <typename TElem, std::size_t TCapacity, typename... TOptions>
+using StoredListT =
+    typename std::conditional<
+        TCapacity == 0U,
+        ListT<TElem, TOptions...>,
+        ListT<TElem, TOptions..., comms::option::FixedSizeStorage<TCapacity> >
+    >::type;
+
 /// @brief Common definition of enum value field.
 /// @details Defined to be
 ///     <a href="https://dl.dropboxusercontent.com/u/46999418/comms_champion/comms/html/classcomms_1_1field_1_1EnumValue.html">comms::field::EnumValue</a>
@@ -0,0 +1,569 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::io::ReceiverEngine class.
+
+#pragma once
+
+#ifndef __linux__
+#error "ublox::io::ReceiverEngine requires epoll, available on Linux only"
+#endif
+
+#include <cstdint>
+#include <cstddef>
+#include <cerrno>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "comms/comms.h"
+
+#include "ublox/FrameView.h"
+#include "ublox/FrameAssembler.h"
+
+namespace ublox
+{
+
+namespace io
+{
+
+/// @brief Statistics of the single device served by @ref ReceiverEngine.
+struct DeviceStats
+{
+    /// @brief Number of bytes received.
+    std::size_t bytes = 0U;
+
+    /// @brief Number of valid frames.
+    std::size_t frames = 0U;
+
+    /// @brief Number of messages successfully read by the protocol stack.
+    std::size_t messages = 0U;
+
+    /// @brief Number of valid frames rejected by the protocol stack
+    ///     (unknown or invalid messages).
+    std::size_t failures = 0U;
+
+    /// @brief Number of received bytes not belonging to any valid frame.
+    std::size_t skipped = 0U;
+};
+
+/// @brief Event driven engine receiving the output of multiple ublox
+///     receivers.
+/// @details Multiplexes any number of file descriptors (serial ports,
+///     pseudo terminals, sockets) on a single @b epoll instance and
+///     performs all the I/O in the thread calling @ref poll() or @ref run().
+///     The descriptors are switched to non-blocking mode. Every device
+///     has its own @ref FrameAssembler and protocol stack, the messages
+///     are delivered to the handler provided when the device is added.
+///     Every readiness event results in at most one read of up to
+///     @b readLength bytes, i.e. a busy device cannot starve the others.
+///     The data submitted by @ref send() is written when the descriptor
+///     becomes writable, without blocking the loop.@n
+///     The engine is not thread safe, all its member functions except
+///     @ref stop() must be invoked from the thread running the loop,
+///     including the handlers. The handler may remove any device including
+///     the one the message belongs to.
+/// @code
+/// typedef ublox::Stack<MyMessage, ublox::InputMessages<MyMessage> > MyStack;
+/// typedef ublox::io::ReceiverEngine<MyStack> Engine;
+/// Engine engine;
+/// engine.addDevice(fd,
+///     [&handler](Engine::DeviceId id, MyStack::MsgPtr& msg)
+///     {
+///         msg->dispatch(handler);
+///     });
+/// engine.run();
+/// @endcode
+/// @tparam TStack Type of the protocol stack, such as @ref ublox::Stack.
+/// @tparam TMaxPayloadLength Maximal length of the payload, passed to
+///     @ref FrameAssembler.
+template <typename TStack, std::size_t TMaxPayloadLength = 0xffff>
+class ReceiverEngine
+{
+public:
+    /// @brief Type of the protocol stack.
+    typedef TStack Stack;
+
+    /// @brief Type of the smart pointer to the message object.
+    typedef typename Stack::MsgPtr MsgPtr;
+
+    /// @brief Identifier of the device.
+    typedef std::size_t DeviceId;
+
+    /// @brief Type of the handler of the received messages.
+    typedef std::function<void (DeviceId, MsgPtr&)> MessageHandler;
+
+    /// @brief Type of the handler of the device closure.
+    /// @details The second parameter is the error code (errno) or @b 0
+    ///     when end of file is reached.
+    typedef std::function<void (DeviceId, int)> CloseHandler;
+
+    /// @brief Value of the device identifier indicating failure.
+    static const DeviceId InvalidDevice = static_cast<DeviceId>(-1);
+
+    /// @brief Default maximal number of bytes read at once.
+    static const std::size_t DefaultReadLength = 4096U;
+
+    /// @brief Constructor
+    /// @param[in] readLength Maximal number of bytes read from the
+    ///     device at once.
+    explicit ReceiverEngine(std::size_t readLength = DefaultReadLength)
+      : m_buf(readLength)
+    {
+        if (m_buf.empty()) {
+            m_buf.resize(DefaultReadLength);
+        }
+
+        m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+        m_wakeFd = ::eventfd(0U, EFD_NONBLOCK | EFD_CLOEXEC);
+        if ((m_epollFd < 0) || (m_wakeFd < 0)) {
+            return;
+        }
+
+        epoll_event event = epoll_event();
+        event.events = EPOLLIN;
+        event.data.u64 = WakeId;
+        if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &event) == 0) {
+            m_open = true;
+        }
+    }
+
+    /// @brief Copy constructor is deleted.
+    ReceiverEngine(const ReceiverEngine&) = delete;
+
+    /// @brief Destructor, closes the owned descriptors of the devices.
+    ~ReceiverEngine()
+    {
+        for (auto& dev : m_devices) {
+            if (dev) {
+                closeDevice(*dev);
+            }
+        }
+
+        if (0 <= m_wakeFd) {
+            ::close(m_wakeFd);
+        }
+
+        if (0 <= m_epollFd) {
+            ::close(m_epollFd);
+        }
+    }
+
+    /// @brief Copy assignment is deleted.
+    ReceiverEngine& operator=(const ReceiverEngine&) = delete;
+
+    /// @brief Check whether the engine was successfully initialised.
+    bool isOpen() const
+    {
+        return m_open;
+    }
+
+    /// @brief Set handler invoked when the device is closed due to the end
+    ///     of file or read/write error.
+    /// @details The device is already removed when the handler is invoked.
+    ///     It is not invoked for the devices removed by @ref removeDevice().
+    void setCloseHandler(CloseHandler handler)
+    {
+        m_closeHandler = std::move(handler);
+    }
+
+    /// @brief Add the device.
+    /// @param[in] fd Open file descriptor, switched to non-blocking mode.
+    /// @param[in] handler Handler of the messages received from the device.
+    /// @param[in] owned Whether the descriptor is closed by the engine
+    ///     when the device is removed. The ownership is not taken on failure.
+    /// @return Identifier of the device, @ref InvalidDevice on failure.
+    DeviceId addDevice(int fd, MessageHandler handler, bool owned = true)
+    {
+        if ((!m_open) || (fd < 0)) {
+            return InvalidDevice;
+        }
+
+        int flags = ::fcntl(fd, F_GETFL);
+        if ((flags < 0) || (::fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0)) {
+            return InvalidDevice;
+        }
+
+        DeviceId id = 0U;
+        while ((id < m_devices.size()) && m_devices[id]) {
+            ++id;
+        }
+
+        epoll_event event = epoll_event();
+        event.events = EPOLLIN;
+        event.data.u64 = id;
+        if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            return InvalidDevice;
+        }
+
+        std::unique_ptr<Device> dev(new Device);
+        dev->fd = fd;
+        dev->owned = owned;
+        dev->handler = std::move(handler);
+        if (id == m_devices.size()) {
+            m_devices.push_back(std::move(dev));
+        }
+        else {
+            m_devices[id] = std::move(dev);
+        }
+
+        ++m_deviceCount;
+        return id;
+    }
+
+    /// @brief Remove the device.
+    /// @details The pending output data is discarded.
+    /// @return true if the device was removed, false if there is no such
+    ///     device.
+    bool removeDevice(DeviceId id)
+    {
+        if (!hasDevice(id)) {
+            return false;
+        }
+
+        auto& dev = m_devices[id];
+        ::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, dev->fd, nullptr);
+        closeDevice(*dev);
+        dev->removed = true;
+        --m_deviceCount;
+        if (m_polling) {
+            // The device may be referenced by the caller in the stack
+            m_retired.push_back(std::move(dev));
+        }
+        else {
+            dev.reset();
+        }
+        return true;
+    }
+
+    /// @brief Check whether the device with provided identifier exists.
+    bool hasDevice(DeviceId id) const
+    {
+        return (id < m_devices.size()) && static_cast<bool>(m_devices[id]);
+    }
+
+    /// @brief Number of devices.
+    std::size_t deviceCount() const
+    {
+        return m_deviceCount;
+    }
+
+    /// @brief Get statistics of the device.
+    /// @details Default constructed statistics are returned for the
+    ///     invalid identifier.
+    DeviceStats stats(DeviceId id) const
+    {
+        DeviceStats result;
+        if (!hasDevice(id)) {
+            return result;
+        }
+
+        auto& dev = *m_devices[id];
+        result = dev.stats;
+        result.frames = dev.assembler.frameCount();
+        result.skipped = dev.assembler.skippedCount();
+        return result;
+    }
+
+    /// @brief Get access to the protocol stack of the device.
+    /// @return Pointer to the stack, nullptr for invalid identifier.
+    Stack* stack(DeviceId id)
+    {
+        if (!hasDevice(id)) {
+            return nullptr;
+        }
+        return &m_devices[id]->stack;
+    }
+
+    /// @brief Send data to the device.
+    /// @details Writes as much of the data as possible immediately, the
+    ///     rest is queued and written when the descriptor becomes writable.
+    ///     The device is closed (and the close handler is invoked) on
+    ///     write error.
+    /// @return true if the data was written or queued, false on failure.
+    bool send(DeviceId id, const std::uint8_t* data, std::size_t len)
+    {
+        if (!hasDevice(id)) {
+            return false;
+        }
+
+        auto& dev = *m_devices[id];
+        if (!dev.output.empty()) {
+            dev.output.insert(dev.output.end(), data, data + len);
+            return true;
+        }
+
+        while (len != 0U) {
+            auto count = ::write(dev.fd, data, len);
+            if (0 <= count) {
+                data += count;
+                len -= static_cast<std::size_t>(count);
+                continue;
+            }
+
+            if (errno == EINTR) {
+                continue;
+            }
+
+            if (wouldBlock(errno)) {
+                break;
+            }
+
+            fail(id, errno);
+            return false;
+        }
+
+        if (len == 0U) {
+            return true;
+        }
+
+        dev.output.assign(data, data + len);
+        return watchOutput(id, true);
+    }
+
+    /// @brief Number of bytes queued for sending to the device.
+    std::size_t pendingOutput(DeviceId id) const
+    {
+        if (!hasDevice(id)) {
+            return 0U;
+        }
+        return m_devices[id]->output.size();
+    }
+
+    /// @brief Wait for the I/O events and process them.
+    /// @param[in] timeoutMs Maximal wait time in milliseconds, negative
+    ///     value means infinite wait, @b 0 means no wait.
+    /// @return Number of processed events, @b -1 on failure (interruption
+    ///     by a signal is not considered failure).
+    int poll(int timeoutMs = -1)
+    {
+        if (!m_open) {
+            return -1;
+        }
+
+        int count = ::epoll_wait(m_epollFd, m_events.data(), static_cast<int>(m_events.size()), timeoutMs);
+        if (count < 0) {
+            return (errno == EINTR) ? 0 : -1;
+        }
+
+        m_polling = true;
+        for (int idx = 0; idx < count; ++idx) {
+            auto& event = m_events[static_cast<std::size_t>(idx)];
+            if (event.data.u64 == WakeId) {
+                std::uint64_t value = 0U;
+                static_cast<void>(::read(m_wakeFd, &value, sizeof(value)));
+                continue;
+            }
+
+            auto id = static_cast<DeviceId>(event.data.u64);
+            if ((event.events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0U) {
+                receive(id);
+            }
+
+            if (((event.events & EPOLLOUT) != 0U) && hasDevice(id)) {
+                flush(id);
+            }
+        }
+        m_polling = false;
+        m_retired.clear();
+        return count;
+    }
+
+    /// @brief Process the I/O events until @ref stop() is called or there
+    ///     are no more devices.
+    /// @details The stop request issued before the call makes it return
+    ///     immediately.
+    /// @return true if stopped or no devices left, false on failure.
+    bool run()
+    {
+        bool result = true;
+        while ((!m_stopRequested.load(std::memory_order_relaxed)) && (m_deviceCount != 0U)) {
+            if (poll(-1) < 0) {
+                result = false;
+                break;
+            }
+        }
+        m_stopRequested = false;
+        return result;
+    }
+
+    /// @brief Request @ref run() to return.
+    /// @details Can be invoked from any thread.
+    void stop()
+    {
+        m_stopRequested = true;
+        if (0 <= m_wakeFd) {
+            std::uint64_t value = 1U;
+            static_cast<void>(::write(m_wakeFd, &value, sizeof(value)));
+        }
+    }
+
+private:
+    struct Device
+    {
+        int fd = -1;
+        bool owned = false;
+        bool removed = false;
+        MessageHandler handler;
+        Stack stack;
+        FrameAssembler<TMaxPayloadLength> assembler;
+        std::vector<std::uint8_t> output;
+        DeviceStats stats;
+    };
+
+    static const std::uint64_t WakeId = ~static_cast<std::uint64_t>(0U);
+    static const std::size_t MaxEvents = 64U;
+
+    void receive(DeviceId id)
+    {
+        if (!hasDevice(id)) {
+            return;
+        }
+
+        auto* dev = m_devices[id].get();
+        auto count = ::read(dev->fd, m_buf.data(), m_buf.size());
+        if (count < 0) {
+            if ((!wouldBlock(errno)) && (errno != EINTR)) {
+                fail(id, errno);
+            }
+            return;
+        }
+
+        if (count == 0) {
+            fail(id, 0);
+            return;
+        }
+
+        dev->stats.bytes += static_cast<std::size_t>(count);
+        dev->assembler.process(m_buf.data(), static_cast<std::size_t>(count),
+            [this, id, dev](const FrameView& frame)
+            {
+                if (dev->removed) {
+                    return;
+                }
+
+                MsgPtr msg;
+                const std::uint8_t* readIter = frame.data();
+                auto es = dev->stack.read(msg, readIter, frame.length());
+                if ((es != comms::ErrorStatus::Success) || (!msg)) {
+                    ++dev->stats.failures;
+                    return;
+                }
+
+                ++dev->stats.messages;
+                if (dev->handler) {
+                    dev->handler(id, msg);
+                }
+            });
+    }
+
+    void flush(DeviceId id)
+    {
+        auto& dev = *m_devices[id];
+        std::size_t written = 0U;
+        while (written < dev.output.size()) {
+            auto count = ::write(dev.fd, &dev.output[written], dev.output.size() - written);
+            if (0 <= count) {
+                written += static_cast<std::size_t>(count);
+                continue;
+            }
+
+            if (errno == EINTR) {
+                continue;
+            }
+
+            if (wouldBlock(errno)) {
+                break;
+            }
+
+            fail(id, errno);
+            return;
+        }
+
+        dev.output.erase(dev.output.begin(), dev.output.begin() + static_cast<std::ptrdiff_t>(written));
+        if (dev.output.empty()) {
+            watchOutput(id, false);
+        }
+    }
+
+    bool watchOutput(DeviceId id, bool enabled)
+    {
+        epoll_event event = epoll_event();
+        event.events = EPOLLIN;
+        if (enabled) {
+            event.events |= EPOLLOUT;
+        }
+        event.data.u64 = id;
+        if (::epoll_ctl(m_epollFd, EPOLL_CTL_MOD, m_devices[id]->fd, &event) != 0) {
+            fail(id, errno);
+            return false;
+        }
+        return true;
+    }
+
+    void fail(DeviceId id, int error)
+    {
+        removeDevice(id);
+        if (m_closeHandler) {
+            m_closeHandler(id, error);
+        }
+    }
+
+    static bool wouldBlock(int error)
+    {
+#if EAGAIN != EWOULDBLOCK
+        if (error == EWOULDBLOCK) {
+            return true;
+        }
+#endif
+        return error == EAGAIN;
+    }
+
+    static void closeDevice(Device& dev)
+    {
+        if (dev.owned && (0 <= dev.fd)) {
+            ::close(dev.fd);
+        }
+        dev.fd = -1;
+    }
+
+    std::vector<std::unique_ptr<Device> > m_devices;
+    std::vector<std::unique_ptr<Device> > m_retired;
+    std::vector<std::uint8_t> m_buf;
+    std::array<epoll_event, MaxEvents> m_events;
+    CloseHandler m_closeHandler;
+    std::atomic<bool> m_stopRequested{false};
+    std::size_t m_deviceCount = 0U;
+    int m_epollFd = -1;
+    int m_wakeFd = -1;
+    bool m_open = false;
+    bool m_polling = false;
+};
+
+}  // namespace io
+
+}  // namespace ublox
+
+
@@ -150,6 +150,19 @@ public:
     /// @brief Move assignment
     AidAlpsrv& operator=(AidAlpsrv&&) = default;
 
+    /// @brief Offset of the payload byte distinguishing this message from
+    ///     the other ones with the same ID.
+    /// @details Used by ublox::MsgFactory::selectIndex() together with
+    ///     validDispatchKey().
+    static const std::size_t DispatchKeyOffset = 1U;
+
+    /// @brief Check whether the value of @b type field (@ref AidAlpsrvFields::type)
+    ///     belongs to this message.
+    static constexpr bool validDispatchKey(std::uint8_t value)
+    {
+        return value != 0xff;
+    }
+
 protected:
 
     /// @brief Overrides read functionality provided by the base class.
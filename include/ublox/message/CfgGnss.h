@@ -23,6 +23,7 @@
 #include <algorithm>
 
 #include "ublox/Message.h"
+#include "ublox/options.h"
 #include "ublox/field/common.h"
 
 namespace ublox
@@ -131,17 +132,32 @@ struct CfgGnssFields
         >;
 
     /// @brief Definition of the list of configuration blocks
-    using blocksList = field::common::ListT<block>;
+    /// @tparam TOptions Storage profile, see @ref ublox::option::DynamicListStorage
+    template <typename TOptions>
+    using blocksListT =
+        field::common::StoredListT<
+            block,
+            TOptions::CfgGnssBlocksList,
+            comms::option::SequenceSizeForcingEnabled
+        >;
+
+    /// @brief Definition of "blocksList" field with default storage profile.
+    using blocksList = blocksListT<ublox::option::DynamicListStorage>;
 
     /// @brief All the fields bundled in std::tuple.
-    using All = std::tuple<
+    /// @tparam TOptions Storage profile, see @ref ublox::option::DynamicListStorage
+    template <typename TOptions>
+    using AllT = std::tuple<
         msgVer,
         numTrkChHw,
         numTrkChUse,
         numConfigBlocks,
-        blocksList
+        blocksListT<TOptions>
     >;
 
+    /// @brief All the fields with default storage profile bundled in std::tuple.
+    using All = AllT<ublox::option::DynamicListStorage>;
+
 };
 
 /// @brief Definition of CFG-GNSS message
@@ -152,20 +168,22 @@ struct CfgGnssFields
 ///     @b comms::option::DispatchImpl as options. @n
 ///     See @ref CfgGnssFields and for definition of the fields this message contains.
 /// @tparam TMsgBase Common interface class for all the messages.
-template <typename TMsgBase = Message>
+/// @tparam TOptions Storage profile of the list fields, see
+///     @ref ublox::option::DynamicListStorage and @ref ublox::option::FixedListStorage.
+template <typename TMsgBase = Message, typename TOptions = ublox::option::DynamicListStorage>
 class CfgGnss : public
     comms::MessageBase<
         TMsgBase,
         comms::option::StaticNumIdImpl<MsgId_CFG_GNSS>,
-        comms::option::FieldsImpl<CfgGnssFields::All>,
-        comms::option::DispatchImpl<CfgGnss<TMsgBase> >
+        comms::option::FieldsImpl<CfgGnssFields::AllT<TOptions> >,
+        comms::option::DispatchImpl<CfgGnss<TMsgBase, TOptions> >
     >
 {
     typedef comms::MessageBase<
         TMsgBase,
         comms::option::StaticNumIdImpl<MsgId_CFG_GNSS>,
-        comms::option::FieldsImpl<CfgGnssFields::All>,
-        comms::option::DispatchImpl<CfgGnss<TMsgBase> >
+        comms::option::FieldsImpl<CfgGnssFields::AllT<TOptions> >,
+        comms::option::DispatchImpl<CfgGnss<TMsgBase, TOptions> >
     > Base;
 public:
 
@@ -219,6 +237,10 @@ protected:
         auto& allFields = Base::fields();
         auto& numBlocksField = std::get<FieldIdx_numConfigBlocks>(allFields);
         auto& dataField = std::get<FieldIdx_blocksList>(allFields);
+        if (!ublox::details::fitsListCapacity(TOptions::CfgGnssBlocksList, numBlocksField.value())) {
+            return comms::ErrorStatus::InvalidMsgData;
+        }
+
         dataField.forceReadElemCount(numBlocksField.value());
 
         return Base::template readFieldsFrom<FieldIdx_blocksList>(iter, len);
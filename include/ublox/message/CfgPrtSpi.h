@@ -180,6 +180,19 @@ public:
     /// @brief Move assignment
     CfgPrtSpi& operator=(CfgPrtSpi&&) = default;
 
+    /// @brief Offset of the payload byte distinguishing this message from
+    ///     the other ones with the same ID.
+    /// @details Used by ublox::MsgFactory::selectIndex() together with
+    ///     validDispatchKey().
+    static const std::size_t DispatchKeyOffset = 0U;
+
+    /// @brief Check whether the value of @b portID field (@ref CfgPrtSpiFields::portID)
+    ///     belongs to this message.
+    static constexpr bool validDispatchKey(std::uint8_t value)
+    {
+        return value == static_cast<std::uint8_t>(CfgPrtSpiFields::PortId::SPI);
+    }
+
 protected:
     /// @brief Overrides read functionality provided by the base class.
     /// @details Reads only first "portID" field (@ref CfgPrtSpiFields::portID) and
@@ -19,7 +19,10 @@
 /// @brief Contains definition of MON-VER message and its fields.
 #pragma once
 
+#include <iterator>
+
 #include "ublox/Message.h"
+#include "ublox/options.h"
 #include "ublox/field/common.h"
 
 namespace ublox
@@ -38,18 +41,32 @@ struct MonVerFields
     /// @brief Definition of "pullL" field.
     using hwVersion = field::common::ZString<10>;
 
-    /// @brief Definition of "pullL" field.
-    using extensions =
-        field::common::ListT<
-            field::common::ZString<30>
+    /// @brief Definition of single element of "extensions" list.
+    using extension = field::common::ZString<30>;
+
+    /// @brief Definition of "extensions" field.
+    /// @tparam TOptions Storage profile, see @ref ublox::option::DynamicListStorage
+    template <typename TOptions>
+    using extensionsT =
+        field::common::StoredListT<
+            extension,
+            TOptions::MonVerExtensions
         >;
 
+    /// @brief Definition of "extensions" field with default storage profile.
+    using extensions = extensionsT<ublox::option::DynamicListStorage>;
+
     /// @brief All the fields bundled in std::tuple.
-    using All = std::tuple<
+    /// @tparam TOptions Storage profile, see @ref ublox::option::DynamicListStorage
+    template <typename TOptions>
+    using AllT = std::tuple<
         swVersion,
         hwVersion,
-        extensions
+        extensionsT<TOptions>
     >;
+
+    /// @brief All the fields with default storage profile bundled in std::tuple.
+    using All = AllT<ublox::option::DynamicListStorage>;
 };
 
 /// @brief Definition of MON-VER message
@@ -60,20 +77,22 @@ struct MonVerFields
 ///     @b comms::option::DispatchImpl as options. @n
 ///     See @ref MonVerFields and for definition of the fields this message contains.
 /// @tparam TMsgBase Common interface class for all the messages.
-template <typename TMsgBase = Message>
+/// @tparam TOptions Storage profile of the list fields, see
+///     @ref ublox::option::DynamicListStorage and @ref ublox::option::FixedListStorage.
+template <typename TMsgBase = Message, typename TOptions = ublox::option::DynamicListStorage>
 class MonVer : public
     comms::MessageBase<
         TMsgBase,
         comms::option::StaticNumIdImpl<MsgId_MON_VER>,
-        comms::option::FieldsImpl<MonVerFields::All>,
-        comms::option::DispatchImpl<MonVer<TMsgBase> >
+        comms::option::FieldsImpl<MonVerFields::AllT<TOptions> >,
+        comms::option::DispatchImpl<MonVer<TMsgBase, TOptions> >
     >
 {
     typedef comms::MessageBase<
         TMsgBase,
         comms::option::StaticNumIdImpl<MsgId_MON_VER>,
-        comms::option::FieldsImpl<MonVerFields::All>,
-        comms::option::DispatchImpl<MonVer<TMsgBase> >
+        comms::option::FieldsImpl<MonVerFields::AllT<TOptions> >,
+        comms::option::DispatchImpl<MonVer<TMsgBase, TOptions> >
     > Base;
 public:
 
@@ -106,6 +125,33 @@ public:
 
     /// @brief Move assignment
     MonVer& operator=(MonVer&&) = default;
+
+protected:
+
+    /// @brief Overrides read functionality provided by the base class.
+    /// @details Rejects the message when number of the elements in
+    ///     @b extensions (@ref MonVerFields::extensions) list exceeds its
+    ///     capacity specified by the storage profile.
+    virtual comms::ErrorStatus readImpl(
+        typename Base::ReadIterator& iter,
+        std::size_t len) override
+    {
+        auto fromIter = iter;
+        auto fromLen = len;
+        auto es = Base::template readFieldsUntil<FieldIdx_extensions>(iter, len);
+        if (es != comms::ErrorStatus::Success) {
+            return es;
+        }
+
+        auto consumed = static_cast<std::size_t>(std::distance(fromIter, iter));
+        auto extLen = MonVerFields::extension::maxLength();
+        auto count = ((fromLen - consumed) + (extLen - 1)) / extLen;
+        if (!ublox::details::fitsListCapacity(TOptions::MonVerExtensions, count)) {
+            return comms::ErrorStatus::InvalidMsgData;
+        }
+
+        return Base::template readFieldsFrom<FieldIdx_extensions>(iter, len);
+    }
 };
 
 
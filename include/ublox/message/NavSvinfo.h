@@ -21,6 +21,7 @@
 #pragma once
 
 #include "ublox/Message.h"
+#include "ublox/options.h"
 #include "ublox/field/nav.h"
 
 namespace ublox
@@ -159,20 +160,31 @@ struct NavSvinfoFields
         >;
 
     /// @brief Definition of "data" field as list of blocks (@ref block).
-    using data =
-        field::common::ListT<
+    /// @tparam TOptions Storage profile, see @ref ublox::option::DynamicListStorage
+    template <typename TOptions>
+    using dataT =
+        field::common::StoredListT<
             block,
+            TOptions::NavSvinfoData,
             comms::option::SequenceSizeForcingEnabled
         >;
 
+    /// @brief Definition of "data" field with default storage profile.
+    using data = dataT<ublox::option::DynamicListStorage>;
+
     /// @brief All the fields bundled in std::tuple.
-    using All = std::tuple<
+    /// @tparam TOptions Storage profile, see @ref ublox::option::DynamicListStorage
+    template <typename TOptions>
+    using AllT = std::tuple<
         iTOW,
         numCh,
         globalFlags,
         reserved2,
-        data
+        dataT<TOptions>
     >;
+
+    /// @brief All the fields with default storage profile bundled in std::tuple.
+    using All = AllT<ublox::option::DynamicListStorage>;
 };
 
 /// @brief Definition of NAV-SVINFO message
@@ -183,20 +195,22 @@ struct NavSvinfoFields
 ///     @b comms::option::DispatchImpl as options. @n
 ///     See @ref NavSvinfoFields and for definition of the fields this message contains.
 /// @tparam TMsgBase Common interface class for all the messages.
-template <typename TMsgBase = Message>
+/// @tparam TOptions Storage profile of the list fields, see
+///     @ref ublox::option::DynamicListStorage and @ref ublox::option::FixedListStorage.
+template <typename TMsgBase = Message, typename TOptions = ublox::option::DynamicListStorage>
 class NavSvinfo : public
     comms::MessageBase<
         TMsgBase,
         comms::option::StaticNumIdImpl<MsgId_NAV_SVINFO>,
-        comms::option::FieldsImpl<NavSvinfoFields::All>,
-        comms::option::DispatchImpl<NavSvinfo<TMsgBase> >
+        comms::option::FieldsImpl<NavSvinfoFields::AllT<TOptions> >,
+        comms::option::DispatchImpl<NavSvinfo<TMsgBase, TOptions> >
     >
 {
     typedef comms::MessageBase<
         TMsgBase,
         comms::option::StaticNumIdImpl<MsgId_NAV_SVINFO>,
-        comms::option::FieldsImpl<NavSvinfoFields::All>,
-        comms::option::DispatchImpl<NavSvinfo<TMsgBase> >
+        comms::option::FieldsImpl<NavSvinfoFields::AllT<TOptions> >,
+        comms::option::DispatchImpl<NavSvinfo<TMsgBase, TOptions> >
     > Base;
 public:
 
@@ -250,6 +264,10 @@ protected:
         auto& allFields = Base::fields();
         auto& numChField = std::get<FieldIdx_numCh>(allFields);
         auto& dataField = std::get<FieldIdx_data>(allFields);
+        if (!ublox::details::fitsListCapacity(TOptions::NavSvinfoData, numChField.value())) {
+            return comms::ErrorStatus::InvalidMsgData;
+        }
+
         dataField.forceReadElemCount(numChField.value());
 
         return Base::template readFieldsFrom<FieldIdx_data>(iter, len);
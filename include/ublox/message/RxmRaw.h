@@ -21,6 +21,7 @@
 #pragma once
 
 #include "ublox/Message.h"
+#include "ublox/options.h"
 #include "ublox/field/rxm.h"
 
 namespace ublox
@@ -94,20 +95,31 @@ struct RxmRawFields
         >;
 
     /// @brief Definition of the list of blocks (@ref block)
-    using data =
-        field::common::ListT<
+    /// @tparam TOptions Storage profile, see @ref ublox::option::DynamicListStorage
+    template <typename TOptions>
+    using dataT =
+        field::common::StoredListT<
             block,
+            TOptions::RxmRawData,
             comms::option::SequenceSizeForcingEnabled
         >;
 
+    /// @brief Definition of "data" field with default storage profile.
+    using data = dataT<ublox::option::DynamicListStorage>;
+
     /// @brief All the fields bundled in std::tuple.
-    using All = std::tuple<
+    /// @tparam TOptions Storage profile, see @ref ublox::option::DynamicListStorage
+    template <typename TOptions>
+    using AllT = std::tuple<
         rcvTow,
         week,
         numSV,
         reserved1,
-        data
+        dataT<TOptions>
     >;
+
+    /// @brief All the fields with default storage profile bundled in std::tuple.
+    using All = AllT<ublox::option::DynamicListStorage>;
 };
 
 /// @brief Definition of RXM-RAW message
@@ -118,20 +130,22 @@ struct RxmRawFields
 ///     @b comms::option::DispatchImpl as options. @n
 ///     See @ref RxmRawFields and for definition of the fields this message contains.
 /// @tparam TMsgBase Common interface class for all the messages.
-template <typename TMsgBase = Message>
+/// @tparam TOptions Storage profile of the list fields, see
+///     @ref ublox::option::DynamicListStorage and @ref ublox::option::FixedListStorage.
+template <typename TMsgBase = Message, typename TOptions = ublox::option::DynamicListStorage>
 class RxmRaw : public
     comms::MessageBase<
         TMsgBase,
         comms::option::StaticNumIdImpl<MsgId_RXM_RAW>,
-        comms::option::FieldsImpl<RxmRawFields::All>,
-        comms::option::DispatchImpl<RxmRaw<TMsgBase> >
+        comms::option::FieldsImpl<RxmRawFields::AllT<TOptions> >,
+        comms::option::DispatchImpl<RxmRaw<TMsgBase, TOptions> >
     >
 {
     typedef comms::MessageBase<
         TMsgBase,
         comms::option::StaticNumIdImpl<MsgId_RXM_RAW>,
-        comms::option::FieldsImpl<RxmRawFields::All>,
-        comms::option::DispatchImpl<RxmRaw<TMsgBase> >
+        comms::option::FieldsImpl<RxmRawFields::AllT<TOptions> >,
+        comms::option::DispatchImpl<RxmRaw<TMsgBase, TOptions> >
     > Base;
 public:
 
@@ -184,6 +198,10 @@ protected:
         auto& allFields = Base::fields();
         auto& numSvField = std::get<FieldIdx_numSV>(allFields);
         auto& dataField = std::get<FieldIdx_data>(allFields);
+        if (!ublox::details::fitsListCapacity(TOptions::RxmRawData, numSvField.value())) {
+            return comms::ErrorStatus::InvalidMsgData;
+        }
+
         dataField.forceReadElemCount(numSvField.value());
 
         return Base::template readFieldsFrom<FieldIdx_data>(iter, len);
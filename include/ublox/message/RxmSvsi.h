@@ -21,6 +21,7 @@
 #pragma once
 
 #include "ublox/Message.h"
+#include "ublox/options.h"
 #include "ublox/field/rxm.h"
 
 namespace ublox
@@ -147,20 +148,31 @@ struct RxmSvsiFields
         >;
 
     /// @brief Definition of the list of blocks (@ref block)
-    using data =
-        field::common::ListT<
+    /// @tparam TOptions Storage profile, see @ref ublox::option::DynamicListStorage
+    template <typename TOptions>
+    using dataT =
+        field::common::StoredListT<
             block,
+            TOptions::RxmSvsiData,
             comms::option::SequenceSizeForcingEnabled
         >;
 
+    /// @brief Definition of "data" field with default storage profile.
+    using data = dataT<ublox::option::DynamicListStorage>;
+
     /// @brief All the fields bundled in std::tuple.
-    using All = std::tuple<
+    /// @tparam TOptions Storage profile, see @ref ublox::option::DynamicListStorage
+    template <typename TOptions>
+    using AllT = std::tuple<
         iTOW,
         week,
         numVis,
         numSV,
-        data
+        dataT<TOptions>
     >;
+
+    /// @brief All the fields with default storage profile bundled in std::tuple.
+    using All = AllT<ublox::option::DynamicListStorage>;
 };
 
 /// @brief Definition of RXM-SVSI message
@@ -171,20 +183,22 @@ struct RxmSvsiFields
 ///     @b comms::option::DispatchImpl as options. @n
 ///     See @ref RxmSvsiFields and for definition of the fields this message contains.
 /// @tparam TMsgBase Common interface class for all the messages.
-template <typename TMsgBase = Message>
+/// @tparam TOptions Storage profile of the list fields, see
+///     @ref ublox::option::DynamicListStorage and @ref ublox::option::FixedListStorage.
+template <typename TMsgBase = Message, typename TOptions = ublox::option::DynamicListStorage>
 class RxmSvsi : public
     comms::MessageBase<
         TMsgBase,
         comms::option::StaticNumIdImpl<MsgId_RXM_SVSI>,
-        comms::option::FieldsImpl<RxmSvsiFields::All>,
-        comms::option::DispatchImpl<RxmSvsi<TMsgBase> >
+        comms::option::FieldsImpl<RxmSvsiFields::AllT<TOptions> >,
+        comms::option::DispatchImpl<RxmSvsi<TMsgBase, TOptions> >
     >
 {
     typedef comms::MessageBase<
         TMsgBase,
         comms::option::StaticNumIdImpl<MsgId_RXM_SVSI>,
-        comms::option::FieldsImpl<RxmSvsiFields::All>,
-        comms::option::DispatchImpl<RxmSvsi<TMsgBase> >
+        comms::option::FieldsImpl<RxmSvsiFields::AllT<TOptions> >,
+        comms::option::DispatchImpl<RxmSvsi<TMsgBase, TOptions> >
     > Base;
 public:
 
@@ -233,6 +247,10 @@ protected:
         auto& allFields = Base::fields();
         auto& numSvField = std::get<FieldIdx_numSV>(allFields);
         auto& dataField = std::get<FieldIdx_data>(allFields);
+        if (!ublox::details::fitsListCapacity(TOptions::RxmSvsiData, numSvField.value())) {
+            return comms::ErrorStatus::InvalidMsgData;
+        }
+
         dataField.forceReadElemCount(numSvField.value());
 
         return Base::template readFieldsFrom<FieldIdx_data>(iter, len);
@@ -0,0 +1,199 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox specific options.
+
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+namespace ublox
+{
+
+namespace option
+{
+
+/// @brief Option for @ref ublox::Stack to use compile time generated
+///     lookup table (see @ref ublox::MsgFactory) to find message type by
+///     its ID.
+/// @details Expected to be passed in @b TMsgAllocOptions template parameter
+///     of @ref ublox::Stack. Requires dynamic memory allocation of the
+///     message objects.
+struct DirectMsgIdLookup {};
+
+/// @brief Option for @ref ublox::Stack to recycle the message objects using
+///     @ref ublox::MsgPool.
+/// @details Expected to be passed in @b TMsgAllocOptions template parameter
+///     of @ref ublox::Stack. Implies @ref DirectMsgIdLookup.
+struct PooledAllocation {};
+
+/// @brief Option for @ref ublox::Stack to discard the frames with payload
+///     length not allowed for the message ID before any message object is
+///     created.
+/// @details Expected to be passed in @b TMsgAllocOptions template parameter
+///     of @ref ublox::Stack. The allowed lengths are defined by the fields
+///     of the message (see @ref ublox::MsgFactory::validLength()), the
+///     payload longer than maximal length of the message is accepted as the
+///     extended one. The number of discarded frames is counted by
+///     protocol::MsgIdLayer.
+struct PayloadLengthCheck {};
+
+/// @brief Storage profile of the variable length list fields, where all the
+///     lists use dynamically allocated storage (std::vector).
+/// @details Every static member specifies maximal number of elements stored
+///     in place by the corresponding list field, where @b 0 means unlimited
+///     (dynamic) storage. Expected to be passed as @b TOptions template
+///     parameter to the message definitions, such as @ref ublox::message::NavSvinfo.
+///     It is the default profile.
+struct DynamicListStorage
+{
+    /// @brief Capacity of @ref ublox::message::NavSvinfoFields::data list.
+    static const std::size_t NavSvinfoData = 0U;
+
+    /// @brief Capacity of @ref ublox::message::RxmRawFields::data list.
+    static const std::size_t RxmRawData = 0U;
+
+    /// @brief Capacity of @ref ublox::message::RxmSvsiFields::data list.
+    static const std::size_t RxmSvsiData = 0U;
+
+    /// @brief Capacity of @ref ublox::message::CfgGnssFields::blocksList list.
+    static const std::size_t CfgGnssBlocksList = 0U;
+
+    /// @brief Capacity of @ref ublox::message::MonVerFields::extensions list.
+    static const std::size_t MonVerExtensions = 0U;
+};
+
+/// @brief Storage profile of the variable length list fields, where all the
+///     lists use fixed size storage residing inside the message object.
+/// @details Decoding of the messages defined with this profile doesn't
+///     involve any dynamic memory allocation. The capacities are derived
+///     from the protocol: maximal number of receiver channels, known
+///     satellites, GNSS systems and software version extensions. The
+///     messages reporting more elements than the list can store are rejected
+///     by their read operation with @b comms::ErrorStatus::InvalidMsgData.
+///     Derive from this struct and redefine relevant members to adjust the
+///     capacities.
+struct FixedListStorage
+{
+    /// @brief Maximal number of the tracking channels.
+    static const std::size_t MaxChannels = 72U;
+
+    /// @brief Maximal number of the satellites the receiver reports
+    ///     information about.
+    static const std::size_t MaxSatellites = 128U;
+
+    /// @brief Capacity of @ref ublox::message::NavSvinfoFields::data list.
+    static const std::size_t NavSvinfoData = MaxChannels;
+
+    /// @brief Capacity of @ref ublox::message::RxmRawFields::data list.
+    static const std::size_t RxmRawData = MaxChannels;
+
+    /// @brief Capacity of @ref ublox::message::RxmSvsiFields::data list.
+    static const std::size_t RxmSvsiData = MaxSatellites;
+
+    /// @brief Capacity of @ref ublox::message::CfgGnssFields::blocksList list.
+    static const std::size_t CfgGnssBlocksList = 8U;
+
+    /// @brief Capacity of @ref ublox::message::MonVerFields::extensions list.
+    static const std::size_t MonVerExtensions = 16U;
+};
+
+}  // namespace option
+
+namespace details
+{
+
+/// @brief Check whether the number of list elements fits the list capacity
+///     specified in the storage profile (see @ref option::DynamicListStorage).
+inline bool fitsListCapacity(std::size_t capacity, std::size_t count)
+{
+    return (capacity == 0U) || (count <= capacity);
+}
+
+/// @brief Wrap single option into std::tuple, leave std::tuple as is.
+template <typename TOptions>
+struct OptionsTuple
+{
+    typedef std::tuple<TOptions> Type;
+};
+
+template <typename... TOptions>
+struct OptionsTuple<std::tuple<TOptions...> >
+{
+    typedef std::tuple<TOptions...> Type;
+};
+
+/// @brief Check whether option is present in the options bundled in
+///     std::tuple.
+template <typename TOption, typename TOptionsTuple>
+struct HasOption;
+
+template <typename TOption>
+struct HasOption<TOption, std::tuple<> > : public std::false_type
+{
+};
+
+template <typename TOption, typename TFirst, typename... TRest>
+struct HasOption<TOption, std::tuple<TFirst, TRest...> > : public
+    std::integral_constant<
+        bool,
+        std::is_same<TOption, TFirst>::value ||
+            HasOption<TOption, std::tuple<TRest...> >::value
+    >
+{
+};
+
+/// @brief Prepend option to the options bundled in std::tuple.
+template <typename TOption, typename TOptionsTuple>
+struct PrependOption;
+
+template <typename TOption, typename... TOptions>
+struct PrependOption<TOption, std::tuple<TOptions...> >
+{
+    typedef std::tuple<TOption, TOptions...> Type;
+};
+
+/// @brief Remove option from the options bundled in std::tuple.
+template <typename TOption, typename TOptionsTuple>
+struct RemoveOption;
+
+template <typename TOption>
+struct RemoveOption<TOption, std::tuple<> >
+{
+    typedef std::tuple<> Type;
+};
+
+template <typename TOption, typename TFirst, typename... TRest>
+struct RemoveOption<TOption, std::tuple<TFirst, TRest...> >
+{
+    typedef typename RemoveOption<TOption, std::tuple<TRest...> >::Type Rest;
+
+    typedef typename std::conditional<
+        std::is_same<TOption, TFirst>::value,
+        Rest,
+        typename PrependOption<TFirst, Rest>::Type
+    >::type Type;
+};
+
+}  // namespace details
+
+}  // namespace ublox
+
+
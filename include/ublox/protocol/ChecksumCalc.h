@@ -21,7 +21,16 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include <limits>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define UBLOX_CHECKSUM_CALC_SSE2
+#endif
 
 namespace ublox
 {
@@ -29,26 +38,227 @@ namespace ublox
 namespace protocol
 {
 
+namespace details
+{
+
+/// @brief Helper functions used by @ref ChecksumCalc.
+/// @details All the calculations are performed on 32 bit unsigned accumulators,
+///     which wrap modulo 2^32. Only 8 least significant bits of every
+///     accumulator are used in the final result, so the wrapping doesn't
+///     influence the outcome.
+struct ChecksumCalcHelper
+{
+    /// @brief Generic byte by byte calculation using any input iterator.
+    template <typename TIter>
+    static void calcGeneric(TIter& iter, std::size_t len, std::uint32_t& ckA, std::uint32_t& ckB)
+    {
+        std::uint8_t a = static_cast<std::uint8_t>(ckA);
+        std::uint8_t b = static_cast<std::uint8_t>(ckB);
+        for (auto idx = 0U; idx < len; ++idx) {
+            a += static_cast<std::uint8_t>(*iter);
+            b += a;
+            ++iter;
+        }
+        ckA = a;
+        ckB = b;
+    }
+
+    /// @brief Calculation over contiguous buffer.
+    /// @details Uses SIMD kernel when available and finishes the remaining
+    ///     tail bytes with scalar loop.
+    static void calcContiguous(const std::uint8_t* buf, std::size_t len, std::uint32_t& ckA, std::uint32_t& ckB)
+    {
+#if defined(__AVX2__)
+        auto blocksLen = len & ~static_cast<std::size_t>(AvxBlockSize - 1);
+        calcAvx2(buf, blocksLen, ckA, ckB);
+        buf += blocksLen;
+        len -= blocksLen;
+#elif defined(UBLOX_CHECKSUM_CALC_SSE2)
+        auto blocksLen = len & ~static_cast<std::size_t>(SseBlockSize - 1);
+        calcSse2(buf, blocksLen, ckA, ckB);
+        buf += blocksLen;
+        len -= blocksLen;
+#endif
+        calcScalar(buf, len, ckA, ckB);
+    }
+
+    /// @brief Scalar fallback over contiguous buffer.
+    static void calcScalar(const std::uint8_t* buf, std::size_t len, std::uint32_t& ckA, std::uint32_t& ckB)
+    {
+        auto a = ckA;
+        auto b = ckB;
+        auto* end = buf + len;
+        while (buf != end) {
+            a += *buf;
+            b += a;
+            ++buf;
+        }
+        ckA = a;
+        ckB = b;
+    }
+
+private:
+#if defined(__AVX2__)
+    static const std::size_t AvxBlockSize = 32U;
+
+    // The buffer is split into blocks of 32 bytes. For every block
+    //     A' = A + S, B' = B + 32 * A + W,
+    // where S is a sum of block bytes and W is a sum of bytes weighted
+    // by their distance (32 ... 1) to the end of the block. Sums of A values
+    // preceding every block are accumulated in "prefix" vector.
+    static void calcAvx2(const std::uint8_t* buf, std::size_t len, std::uint32_t& ckA, std::uint32_t& ckB)
+    {
+        auto numOfBlocks = len / AvxBlockSize;
+        if (numOfBlocks == 0U) {
+            return;
+        }
+
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i ones = _mm256_set1_epi16(1);
+        const __m256i weights =
+            _mm256_setr_epi8(
+                32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+                16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+
+        __m256i sum = zero;
+        __m256i prefix = zero;
+        __m256i weighted = zero;
+        for (auto idx = 0U; idx < numOfBlocks; ++idx) {
+            auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buf));
+            prefix = _mm256_add_epi32(prefix, sum);
+            sum = _mm256_add_epi32(sum, _mm256_sad_epu8(block, zero));
+            weighted =
+                _mm256_add_epi32(
+                    weighted,
+                    _mm256_madd_epi16(_mm256_maddubs_epi16(block, weights), ones));
+            buf += AvxBlockSize;
+        }
+
+        auto s = horizontalSum(sum);
+        auto p = horizontalSum(prefix);
+        auto w = horizontalSum(weighted);
+        auto blocksCount = static_cast<std::uint32_t>(numOfBlocks);
+        ckB += (AvxBlockSize * ((blocksCount * ckA) + p)) + w;
+        ckA += s;
+    }
+
+    static std::uint32_t horizontalSum(__m256i value)
+    {
+        __m128i result =
+            _mm_add_epi32(
+                _mm256_castsi256_si128(value),
+                _mm256_extracti128_si256(value, 1));
+        result = _mm_add_epi32(result, _mm_shuffle_epi32(result, 0x4e));
+        result = _mm_add_epi32(result, _mm_shuffle_epi32(result, 0xb1));
+        return static_cast<std::uint32_t>(_mm_cvtsi128_si32(result));
+    }
+#elif defined(UBLOX_CHECKSUM_CALC_SSE2)
+    static const std::size_t SseBlockSize = 16U;
+
+    // Same approach as with AVX2, but on blocks of 16 bytes. SSE2 doesn't
+    // have multiplication of bytes, so the block is unpacked into
+    // 16 bit values before being multiplied by the weights (16 ... 1).
+    static void calcSse2(const std::uint8_t* buf, std::size_t len, std::uint32_t& ckA, std::uint32_t& ckB)
+    {
+        auto numOfBlocks = len / SseBlockSize;
+        if (numOfBlocks == 0U) {
+            return;
+        }
+
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i weightsLo = _mm_setr_epi16(16, 15, 14, 13, 12, 11, 10, 9);
+        const __m128i weightsHi = _mm_setr_epi16(8, 7, 6, 5, 4, 3, 2, 1);
+
+        __m128i sum = zero;
+        __m128i prefix = zero;
+        __m128i weighted = zero;
+        for (auto idx = 0U; idx < numOfBlocks; ++idx) {
+            auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf));
+            prefix = _mm_add_epi32(prefix, sum);
+            sum = _mm_add_epi32(sum, _mm_sad_epu8(block, zero));
+            weighted =
+                _mm_add_epi32(
+                    weighted,
+                    _mm_add_epi32(
+                        _mm_madd_epi16(_mm_unpacklo_epi8(block, zero), weightsLo),
+                        _mm_madd_epi16(_mm_unpackhi_epi8(block, zero), weightsHi)));
+            buf += SseBlockSize;
+        }
+
+        auto s = horizontalSum(sum);
+        auto p = horizontalSum(prefix);
+        auto w = horizontalSum(weighted);
+        auto blocksCount = static_cast<std::uint32_t>(numOfBlocks);
+        ckB += (SseBlockSize * ((blocksCount * ckA) + p)) + w;
+        ckA += s;
+    }
+
+    static std::uint32_t horizontalSum(__m128i value)
+    {
+        value = _mm_add_epi32(value, _mm_shuffle_epi32(value, 0x4e));
+        value = _mm_add_epi32(value, _mm_shuffle_epi32(value, 0xb1));
+        return static_cast<std::uint32_t>(_mm_cvtsi128_si32(value));
+    }
+#endif
+};
+
+}  // namespace details
+
 /// @brief Checksum calculator.
 /// @details Provided to
 ///     <a href="https://dl.dropboxusercontent.com/u/46999418/comms_champion/comms/html/classcomms_1_1protocol_1_1ChecksumLayer.html">comms::protocol::ChecksumLayer</a>
-///     when defining protocol stack (@ref ublox::Stack).
+///     when defining protocol stack (@ref ublox::Stack).@n
+///     When the iterator is a pointer to @b std::uint8_t (const or not), the
+///     calculation is performed on the contiguous buffer using SSE2 / AVX2
+///     instructions (if enabled at compile time) with scalar fallback.
+///     Any other iterator type is processed one byte at a time.
 struct ChecksumCalc
 {
+    /// @brief Calculate checksum.
+    /// @param[in, out] iter Iterator used for reading. It is advanced by
+    ///     @b len bytes.
+    /// @param[in] len Number of bytes to process.
+    /// @return 16 bit checksum, @b CK_A is the least significant byte, while
+    ///     @b CK_B is the most significant one.
     template <typename TIter>
     std::uint16_t operator()(TIter& iter, std::size_t len) const
     {
-        std::uint8_t ckA = 0;
-        std::uint8_t ckB = 0;
-        for (auto idx = 0U; idx < len; ++idx) {
-            ckA += *iter;
-            ckB += ckA;
-            ++iter;
-        }
+        typedef typename std::decay<TIter>::type IterType;
+        typedef typename std::conditional<
+            std::is_pointer<IterType>::value &&
+                std::is_same<
+                    std::uint8_t,
+                    typename std::remove_cv<typename std::remove_pointer<IterType>::type>::type
+                >::value,
+            ContiguousTag,
+            GenericTag
+        >::type Tag;
+
+        std::uint32_t ckA = 0;
+        std::uint32_t ckB = 0;
+        calcInternal(iter, len, ckA, ckB, Tag());
 
         return
-            (static_cast<std::uint16_t>(ckB) << std::numeric_limits<std::uint8_t>::digits) |
-            ckA;
+            static_cast<std::uint16_t>(
+                (static_cast<std::uint16_t>(ckB & 0xff) << std::numeric_limits<std::uint8_t>::digits) |
+                (ckA & 0xff));
+    }
+
+private:
+    struct GenericTag {};
+    struct ContiguousTag {};
+
+    template <typename TIter>
+    static void calcInternal(TIter& iter, std::size_t len, std::uint32_t& ckA, std::uint32_t& ckB, GenericTag)
+    {
+        details::ChecksumCalcHelper::calcGeneric(iter, len, ckA, ckB);
+    }
+
+    template <typename TIter>
+    static void calcInternal(TIter& iter, std::size_t len, std::uint32_t& ckA, std::uint32_t& ckB, ContiguousTag)
+    {
+        details::ChecksumCalcHelper::calcContiguous(iter, len, ckA, ckB);
+        iter += len;
     }
 };
 
@@ -56,4 +266,6 @@ struct ChecksumCalc
 
 }  // namespace ublox
 
-
+#ifdef UBLOX_CHECKSUM_CALC_SSE2
+#undef UBLOX_CHECKSUM_CALC_SSE2
+#endif
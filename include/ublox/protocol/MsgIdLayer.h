@@ -0,0 +1,432 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox specific message ID protocol layer.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#include "comms/comms.h"
+
+#include "ublox/MsgId.h"
+#include "ublox/MsgFactory.h"
+#include "ublox/MsgPool.h"
+#include "ublox/options.h"
+
+namespace ublox
+{
+
+namespace protocol
+{
+
+namespace details
+{
+
+/// @brief Allocation of message objects using dynamic memory allocation.
+template <typename TFactory>
+class MsgIdLayerHeapAllocator
+{
+public:
+    typedef typename TFactory::MsgPtr MsgPtr;
+
+    MsgPtr createByIndex(std::size_t idx)
+    {
+        return TFactory::createByIndex(idx);
+    }
+};
+
+/// @brief Options of comms::protocol::MsgIdLayer with ublox specific options
+///     removed.
+template <typename TOptions>
+using MsgIdLayerBaseOptions =
+    typename ublox::details::RemoveOption<
+        option::PayloadLengthCheck,
+        typename ublox::details::RemoveOption<
+            option::PooledAllocation,
+            typename ublox::details::RemoveOption<
+                option::DirectMsgIdLookup,
+                typename ublox::details::OptionsTuple<TOptions>::Type
+            >::Type
+        >::Type
+    >::Type;
+
+}  // namespace details
+
+/// @brief Message ID protocol layer with ublox specific extensions.
+/// @details Extends
+///     <a href="https://dl.dropboxusercontent.com/u/46999418/comms_champion/comms/html/classcomms_1_1protocol_1_1MsgIdLayer.html">comms::protocol::MsgIdLayer</a>
+///     and replaces its read and message creation functionality. Used by
+///     @ref ublox::Stack when any of the following options is provided:
+///     @li ublox::option::DirectMsgIdLookup - The message type is found
+///         using @ref ublox::MsgFactory, i.e. the lookup takes the same time
+///         regardless of number of the message types in @b TAllMessages
+///         bundle. When several message types share the same
+///         ID (such as message::CfgPrtUart, message::CfgPrtUsb, etc...) and
+///         the full frame is available, the message type is selected by the
+///         payload length and contents (see MsgFactory::selectIndex()) before
+///         any message object is created. Otherwise they are tried in order of
+///         their appearance in the bundle until read operation of the next
+///         layer succeeds.
+///     @li ublox::option::PooledAllocation - Same as above, but the message
+///         objects are recycled using @ref ublox::MsgPool, which is accessible
+///         using msgPool() member function.
+///     @li ublox::option::PayloadLengthCheck - The value of @b LENGTH field
+///         (read by the next layer) is checked to be allowed for the message
+///         ID (see MsgFactory::validLength()) before any message object is
+///         created. The frame is rejected with
+///         @b comms::ErrorStatus::ProtocolError otherwise, and the number of
+///         such frames is reported by invalidLengthCount(). Doesn't require
+///         dynamic memory allocation when used alone.
+/// @tparam TField Field of message ID.
+/// @tparam TAllMessages All message types bundled in std::tuple.
+/// @tparam TNextLayer Next transport layer in protocol stack.
+/// @tparam TOptions Extra options. The ublox specific ones are
+///     removed, and the rest are forwarded to
+///     <a href="https://dl.dropboxusercontent.com/u/46999418/comms_champion/comms/html/classcomms_1_1protocol_1_1MsgIdLayer.html">comms::protocol::MsgIdLayer</a>.
+template <
+    typename TField,
+    typename TAllMessages,
+    typename TNextLayer,
+    typename TOptions = std::tuple<> >
+class MsgIdLayer : public
+    comms::protocol::MsgIdLayer<
+        TField,
+        TAllMessages,
+        TNextLayer,
+        details::MsgIdLayerBaseOptions<TOptions>
+    >
+{
+    typedef comms::protocol::MsgIdLayer<
+        TField,
+        TAllMessages,
+        TNextLayer,
+        details::MsgIdLayerBaseOptions<TOptions>
+    > Base;
+
+    typedef typename ublox::details::OptionsTuple<TOptions>::Type AllOptions;
+
+    static const bool Pooled =
+        ublox::details::HasOption<option::PooledAllocation, AllOptions>::value;
+
+    static const bool DirectLookup =
+        Pooled || ublox::details::HasOption<option::DirectMsgIdLookup, AllOptions>::value;
+
+    static const bool LengthCheck =
+        ublox::details::HasOption<option::PayloadLengthCheck, AllOptions>::value;
+
+    struct DirectLookupTag {};
+    struct BaseLookupTag {};
+
+    typedef typename std::conditional<
+        DirectLookup,
+        DirectLookupTag,
+        BaseLookupTag
+    >::type LookupTag;
+
+public:
+    /// @brief Type of the field object used to read/write message ID value.
+    typedef typename Base::Field Field;
+
+    /// @brief Type of the common message interface class.
+    typedef typename Base::MsgPtr::element_type Message;
+
+    /// @brief Factory used to find message types.
+    typedef ublox::MsgFactory<Message, TAllMessages> Factory;
+
+    static_assert((!DirectLookup) || std::is_same<typename Base::MsgPtr, typename Factory::MsgPtr>::value,
+        "Direct message ID lookup requires dynamic memory allocation of message objects");
+
+    /// @brief Pool of message objects, used when ublox::option::PooledAllocation
+    ///     option is provided.
+    typedef ublox::MsgPool<Message, TAllMessages> MsgPool;
+
+    /// @brief Type of the allocator of message objects.
+    typedef typename std::conditional<
+        Pooled,
+        MsgPool,
+        details::MsgIdLayerHeapAllocator<Factory>
+    >::type Allocator;
+
+    /// @brief Type of smart pointer that holds allocated message object.
+    /// @details Hides the definition of the base class.
+    typedef typename std::conditional<
+        DirectLookup,
+        typename Allocator::MsgPtr,
+        typename Base::MsgPtr
+    >::type MsgPtr;
+
+    /// @brief Deserialise message ID and create appropriate message object.
+    /// @details Hides the read() member function of the base class.
+    /// @param[out] msgPtr Smart pointer to hold allocated message object.
+    /// @param[in, out] iter Iterator used for reading.
+    /// @param[in] size Number of bytes available for reading.
+    /// @param[in] params Extra parameters forwarded to the next layer
+    ///     (such as pointer to "missing size" variable).
+    /// @return Status of the read operation.
+    template <typename TMsgPtr, typename TIter, typename... TParams>
+    comms::ErrorStatus read(
+        TMsgPtr& msgPtr,
+        TIter& iter,
+        std::size_t size,
+        TParams... params)
+    {
+        Field field;
+        auto es = field.read(iter, size);
+        if (es == comms::ErrorStatus::NotEnoughData) {
+            updateMissingSize(field.length() - size, params...);
+        }
+
+        if (es != comms::ErrorStatus::Success) {
+            return es;
+        }
+
+        auto remSize = size - field.length();
+        if (LengthCheck && (!validLength(field.value(), iter, remSize))) {
+            ++m_invalidLengthCount;
+            return comms::ErrorStatus::ProtocolError;
+        }
+
+        return readMessage(field.value(), msgPtr, iter, remSize, LookupTag(), params...);
+    }
+
+    /// @brief Create message object given the ID of the message.
+    /// @details Hides the createMsg() member function of the base class.
+    /// @param[in] id ID of the message.
+    /// @param[in] idx Relative index of the message type among all the types
+    ///     sharing the same ID.
+    /// @return Smart pointer to the created object, empty if no such
+    ///     message type.
+    MsgPtr createMsg(MsgId id, unsigned idx = 0)
+    {
+        return createMsg(id, idx, LookupTag());
+    }
+
+    /// @brief Get access to the pool of message objects.
+    /// @details Available only when ublox::option::PooledAllocation option
+    ///     is provided.
+    const MsgPool& msgPool() const
+    {
+        static_assert(std::is_same<Allocator, MsgPool>::value,
+            "ublox::option::PooledAllocation option is not provided");
+        return m_allocator;
+    }
+
+    /// @brief Get access to the pool of message objects.
+    /// @details Available only when ublox::option::PooledAllocation option
+    ///     is provided.
+    MsgPool& msgPool()
+    {
+        static_assert(std::is_same<Allocator, MsgPool>::value,
+            "ublox::option::PooledAllocation option is not provided");
+        return m_allocator;
+    }
+
+    /// @brief Get number of frames rejected due to payload length not
+    ///     allowed for the message ID.
+    /// @details Always 0 unless ublox::option::PayloadLengthCheck option is
+    ///     provided.
+    std::size_t invalidLengthCount() const
+    {
+        return m_invalidLengthCount;
+    }
+
+    /// @brief Reset the value reported by invalidLengthCount().
+    void resetInvalidLengthCount()
+    {
+        m_invalidLengthCount = 0U;
+    }
+
+private:
+    template <typename TMsgPtr, typename TIter, typename... TParams>
+    comms::ErrorStatus readMessage(
+        MsgId id,
+        TMsgPtr& msgPtr,
+        TIter& iter,
+        std::size_t size,
+        DirectLookupTag,
+        TParams... params)
+    {
+        auto idx = Factory::NumOfMessages;
+        if (preDispatch(id, iter, size, idx)) {
+            if (Factory::NumOfMessages <= idx) {
+                return comms::ErrorStatus::InvalidMsgData;
+            }
+
+            return readByIndex(idx, msgPtr, iter, size, params...);
+        }
+
+        idx = Factory::firstIndex(id);
+        auto es = comms::ErrorStatus::InvalidMsgId;
+        while (idx < Factory::NumOfMessages) {
+            es = readByIndex(idx, msgPtr, iter, size, params...);
+            if (es == comms::ErrorStatus::Success) {
+                return es;
+            }
+
+            idx = Factory::nextIndex(idx);
+        }
+
+        return es;
+    }
+
+    template <typename TMsgPtr, typename TIter, typename... TParams>
+    comms::ErrorStatus readMessage(
+        MsgId id,
+        TMsgPtr& msgPtr,
+        TIter& iter,
+        std::size_t size,
+        BaseLookupTag,
+        TParams... params)
+    {
+        auto es = comms::ErrorStatus::InvalidMsgId;
+        for (unsigned idx = 0U; ; ++idx) {
+            msgPtr.reset();
+            msgPtr = Base::createMsg(id, idx);
+            if (!msgPtr) {
+                break;
+            }
+
+            auto readIter = iter;
+            es = Base::nextLayer().read(msgPtr, readIter, size, params...);
+            if (es == comms::ErrorStatus::Success) {
+                iter = readIter;
+                return es;
+            }
+        }
+
+        msgPtr.reset();
+        return es;
+    }
+
+    template <typename TMsgPtr, typename TIter, typename... TParams>
+    comms::ErrorStatus readByIndex(
+        std::size_t idx,
+        TMsgPtr& msgPtr,
+        TIter& iter,
+        std::size_t size,
+        TParams... params)
+    {
+        auto readIter = iter;
+        // The recycled message object must be reset, the optional fields
+        // keep their mode from the previous read.
+        msgPtr = m_allocator.createByIndex(idx);
+        auto es = Base::nextLayer().read(msgPtr, readIter, size, params...);
+        if (es == comms::ErrorStatus::Success) {
+            iter = readIter;
+            return es;
+        }
+
+        msgPtr.reset();
+        return es;
+    }
+
+    MsgPtr createMsg(MsgId id, unsigned idx, DirectLookupTag)
+    {
+        auto msgIdx = Factory::firstIndex(id);
+        while ((msgIdx < Factory::NumOfMessages) && (0U < idx)) {
+            msgIdx = Factory::nextIndex(msgIdx);
+            --idx;
+        }
+
+        if (Factory::NumOfMessages <= msgIdx) {
+            return MsgPtr();
+        }
+
+        return m_allocator.createByIndex(msgIdx);
+    }
+
+    MsgPtr createMsg(MsgId id, unsigned idx, BaseLookupTag)
+    {
+        return Base::createMsg(id, idx);
+    }
+
+    // Peek the payload length read by the next layer, the frames of
+    // unknown messages and incomplete length are left to be rejected by
+    // the regular read.
+    template <typename TIter>
+    static bool validLength(MsgId id, TIter iter, std::size_t size)
+    {
+        if (Factory::NumOfMessages <= Factory::firstIndex(id)) {
+            return true;
+        }
+
+        typename TNextLayer::Field sizeField;
+        auto es = sizeField.read(iter, size);
+        if (es != comms::ErrorStatus::Success) {
+            return true;
+        }
+
+        return Factory::validLength(id, static_cast<std::size_t>(sizeField.value()));
+    }
+
+    // Select the message type by the payload when the ID is shared, expects
+    // the next layer to be the one that reads the payload length.
+    bool preDispatch(MsgId id, const std::uint8_t* iter, std::size_t size, std::size_t& idx)
+    {
+        auto firstIdx = Factory::firstIndex(id);
+        if ((Factory::NumOfMessages <= firstIdx) ||
+            (Factory::NumOfMessages <= Factory::nextIndex(firstIdx))) {
+            return false;
+        }
+
+        typename TNextLayer::Field sizeField;
+        auto* payload = iter;
+        auto es = sizeField.read(payload, size);
+        if (es != comms::ErrorStatus::Success) {
+            return false;
+        }
+
+        auto payloadLen = static_cast<std::size_t>(sizeField.value());
+        if ((size - sizeField.length()) < payloadLen) {
+            return false;
+        }
+
+        idx = Factory::selectIndex(id, payload, payloadLen);
+        return true;
+    }
+
+    template <typename TIter>
+    bool preDispatch(MsgId, TIter&, std::size_t, std::size_t&)
+    {
+        return false;
+    }
+
+    template <typename... TParams>
+    static void updateMissingSize(std::size_t, TParams...)
+    {
+    }
+
+    static void updateMissingSize(std::size_t value, std::size_t* missingSize)
+    {
+        if (missingSize != nullptr) {
+            *missingSize = value;
+        }
+    }
+
+    Allocator m_allocator;
+    std::size_t m_invalidLengthCount = 0U;
+};
+
+}  // namespace protocol
+
+}  // namespace ublox
+
+
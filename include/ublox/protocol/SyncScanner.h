@@ -0,0 +1,203 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of synchronisation word scanner.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define UBLOX_SYNC_SCANNER_SSE2
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace ublox
+{
+
+namespace protocol
+{
+
+/// @brief Value of @b SYNC @b CHAR @b 1 in message wrapping.
+static const std::uint8_t SyncChar1 = 0xb5;
+
+/// @brief Value of @b SYNC @b CHAR @b 2 in message wrapping.
+static const std::uint8_t SyncChar2 = 0x62;
+
+/// @brief Pre-scanner of the input data for the synchronisation word.
+/// @details The outermost layers of @ref ublox::Stack reject invalid bytes
+///     one at a time, which requires full read attempt per byte. This
+///     scanner is expected to be used before the data is passed to the
+///     protocol stack. It locates next @b 0xb5 @b 0x62 sequence
+///     using SSE2 / AVX2 compare instructions (if enabled at compile time)
+///     or @b std::memchr() otherwise, and accumulates number of the skipped
+///     bytes.
+/// @code
+/// ublox::protocol::SyncScanner scanner;
+/// const std::uint8_t* readIter = buf;
+/// std::size_t len = bufLen;
+/// while (len != 0U) {
+///     len -= scanner.scan(readIter, len);
+///     ... // invoke read() of the protocol stack
+/// }
+/// @endcode
+class SyncScanner
+{
+public:
+
+    /// @brief Find the beginning of the synchronisation word.
+    /// @details If the last byte of the buffer is equal to @ref SyncChar1,
+    ///     it is reported as a candidate, because the second synchronisation
+    ///     byte may arrive with the next chunk of data.
+    /// @param[in] begin Beginning of the buffer.
+    /// @param[in] end End of the buffer.
+    /// @return Pointer to the first byte of the candidate or @b end if none
+    ///     was found.
+    static const std::uint8_t* find(const std::uint8_t* begin, const std::uint8_t* end)
+    {
+        auto* iter = findSimd(begin, end);
+        while (iter != end) {
+            iter = static_cast<const std::uint8_t*>(
+                std::memchr(iter, SyncChar1, static_cast<std::size_t>(end - iter)));
+
+            if (iter == nullptr) {
+                return end;
+            }
+
+            auto* next = iter + 1;
+            if ((next == end) || (*next == SyncChar2)) {
+                return iter;
+            }
+
+            iter = next;
+        }
+
+        return end;
+    }
+
+    /// @brief Skip the bytes preceding the next synchronisation word.
+    /// @param[in, out] iter Iterator to the input data, advanced to the
+    ///     beginning of the synchronisation word (or past the end of the
+    ///     input data when none found).
+    /// @param[in] len Number of bytes available for reading.
+    /// @return Number of skipped bytes.
+    std::size_t scan(const std::uint8_t*& iter, std::size_t len)
+    {
+        auto* start = iter;
+        iter = find(start, start + len);
+        auto skipped = static_cast<std::size_t>(iter - start);
+        m_skipped += skipped;
+        return skipped;
+    }
+
+    /// @brief Get total number of bytes skipped so far.
+    std::size_t skippedCount() const
+    {
+        return m_skipped;
+    }
+
+    /// @brief Reset the counter of skipped bytes.
+    void resetSkippedCount()
+    {
+        m_skipped = 0U;
+    }
+
+private:
+
+#if defined(__AVX2__)
+    static const std::uint8_t* findSimd(const std::uint8_t* iter, const std::uint8_t* end)
+    {
+        static const std::size_t BlockSize = 32U;
+        const __m256i first = _mm256_set1_epi8(static_cast<char>(SyncChar1));
+        const __m256i second = _mm256_set1_epi8(static_cast<char>(SyncChar2));
+        while (BlockSize < static_cast<std::size_t>(end - iter)) {
+            auto curr = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(iter));
+            auto next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(iter + 1));
+            auto mask =
+                static_cast<std::uint32_t>(
+                    _mm256_movemask_epi8(
+                        _mm256_and_si256(
+                            _mm256_cmpeq_epi8(curr, first),
+                            _mm256_cmpeq_epi8(next, second))));
+            if (mask != 0U) {
+                return iter + countTrailingZeros(mask);
+            }
+            iter += BlockSize;
+        }
+        return iter;
+    }
+#elif defined(UBLOX_SYNC_SCANNER_SSE2)
+    static const std::uint8_t* findSimd(const std::uint8_t* iter, const std::uint8_t* end)
+    {
+        static const std::size_t BlockSize = 16U;
+        const __m128i first = _mm_set1_epi8(static_cast<char>(SyncChar1));
+        const __m128i second = _mm_set1_epi8(static_cast<char>(SyncChar2));
+        while (BlockSize < static_cast<std::size_t>(end - iter)) {
+            auto curr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iter));
+            auto next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iter + 1));
+            auto mask =
+                static_cast<std::uint32_t>(
+                    _mm_movemask_epi8(
+                        _mm_and_si128(
+                            _mm_cmpeq_epi8(curr, first),
+                            _mm_cmpeq_epi8(next, second))));
+            if (mask != 0U) {
+                return iter + countTrailingZeros(mask);
+            }
+            iter += BlockSize;
+        }
+        return iter;
+    }
+#else
+    static const std::uint8_t* findSimd(const std::uint8_t* iter, const std::uint8_t*)
+    {
+        return iter;
+    }
+#endif
+
+#if defined(__AVX2__) || defined(UBLOX_SYNC_SCANNER_SSE2)
+    static unsigned countTrailingZeros(std::uint32_t mask)
+    {
+#ifdef _MSC_VER
+        unsigned long idx = 0;
+        _BitScanForward(&idx, mask);
+        return static_cast<unsigned>(idx);
+#else
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+    }
+#endif
+
+    std::size_t m_skipped = 0U;
+};
+
+}  // namespace protocol
+
+}  // namespace ublox
+
+#ifdef UBLOX_SYNC_SCANNER_SSE2
+#undef UBLOX_SYNC_SCANNER_SSE2
+#endif
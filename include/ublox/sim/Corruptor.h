@@ -0,0 +1,217 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::sim::Corruptor class.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace ublox
+{
+
+namespace sim
+{
+
+/// @brief Configuration of the corruption injected into the output stream.
+/// @details All the probabilities are in [0, 1] range, @b 0 disables the
+///     corruption of the relevant kind.
+struct CorruptionConfig
+{
+    /// @brief Probability of the single bit flip in every output byte.
+    double bitFlip = 0.0;
+
+    /// @brief Probability of every output byte to be dropped.
+    double drop = 0.0;
+
+    /// @brief Probability of the random garbage inserted into every chunk
+    ///     of output passed to Corruptor::apply().
+    double garbage = 0.0;
+
+    /// @brief Maximal length of the inserted garbage.
+    std::size_t garbageLength = 32U;
+
+    /// @brief Seed of the pseudo-random generator.
+    std::uint32_t seed = 1U;
+};
+
+/// @brief Injector of the transmission errors into the output stream.
+/// @details Flips bits, drops bytes and inserts random garbage, emulating
+///     noisy serial line. The positions of the corrupted bytes are
+///     drawn from geometric distribution, i.e. the cost doesn't depend on
+///     the number of bytes when the probabilities are low. The corruption
+///     is reproducible for the same seed and sequence of the inputs.
+class Corruptor
+{
+public:
+    /// @brief Constructor
+    explicit Corruptor(const CorruptionConfig& config = CorruptionConfig())
+      : m_config(config),
+        m_random(config.seed)
+    {
+        m_config.bitFlip = clamp(m_config.bitFlip);
+        m_config.drop = clamp(m_config.drop);
+        m_config.garbage = clamp(m_config.garbage);
+    }
+
+    /// @brief Get current configuration.
+    const CorruptionConfig& config() const
+    {
+        return m_config;
+    }
+
+    /// @brief Check whether any corruption is enabled.
+    bool enabled() const
+    {
+        return
+            (0.0 < m_config.bitFlip) ||
+            (0.0 < m_config.drop) ||
+            ((0.0 < m_config.garbage) && (0U < m_config.garbageLength));
+    }
+
+    /// @brief Corrupt the data.
+    /// @param[in, out] data Buffer of the output data.
+    /// @param[in] from Index of the first byte to corrupt, the preceding
+    ///     bytes are not modified.
+    /// @return Number of injected errors.
+    std::size_t apply(std::vector<std::uint8_t>& data, std::size_t from = 0U)
+    {
+        if ((data.size() <= from) || (!enabled())) {
+            return 0U;
+        }
+
+        auto count = flipBits(data, from);
+        count += dropBytes(data, from);
+        count += insertGarbage(data, from);
+        return count;
+    }
+
+    /// @brief Total number of flipped bits.
+    std::size_t flippedCount() const
+    {
+        return m_flipped;
+    }
+
+    /// @brief Total number of dropped bytes.
+    std::size_t droppedCount() const
+    {
+        return m_dropped;
+    }
+
+    /// @brief Total number of inserted garbage bytes.
+    std::size_t garbageCount() const
+    {
+        return m_garbage;
+    }
+
+private:
+    static double clamp(double value)
+    {
+        return std::min(std::max(value, 0.0), 1.0);
+    }
+
+    /// Number of the bytes preceding the next corrupted one. The
+    /// std::geometric_distribution requires the probability below 1,
+    /// the probability of 1 corrupts every byte.
+    std::size_t skip(double probability)
+    {
+        if (1.0 <= probability) {
+            return 0U;
+        }
+
+        return std::geometric_distribution<std::size_t>(probability)(m_random);
+    }
+
+    std::size_t flipBits(std::vector<std::uint8_t>& data, std::size_t from)
+    {
+        if (m_config.bitFlip <= 0.0) {
+            return 0U;
+        }
+
+        std::uniform_int_distribution<unsigned> bit(0U, 7U);
+        std::size_t count = 0U;
+        for (auto pos = from + skip(m_config.bitFlip); pos < data.size(); pos += 1U + skip(m_config.bitFlip)) {
+            data[pos] ^= static_cast<std::uint8_t>(1U << bit(m_random));
+            ++count;
+        }
+
+        m_flipped += count;
+        return count;
+    }
+
+    std::size_t dropBytes(std::vector<std::uint8_t>& data, std::size_t from)
+    {
+        if (m_config.drop <= 0.0) {
+            return 0U;
+        }
+
+        auto pos = from + skip(m_config.drop);
+        auto writePos = pos;
+        std::size_t count = 0U;
+        while (pos < data.size()) {
+            ++count;
+            auto next = std::min(pos + 1U + skip(m_config.drop), data.size());
+            writePos = static_cast<std::size_t>(
+                std::copy(data.begin() + pos + 1U, data.begin() + next, data.begin() + writePos) -
+                data.begin());
+            pos = next;
+        }
+
+        data.resize(data.size() - count);
+        m_dropped += count;
+        return count;
+    }
+
+    std::size_t insertGarbage(std::vector<std::uint8_t>& data, std::size_t from)
+    {
+        if ((m_config.garbage <= 0.0) ||
+            (m_config.garbageLength == 0U) ||
+            (!std::bernoulli_distribution(m_config.garbage)(m_random))) {
+            return 0U;
+        }
+
+        std::uniform_int_distribution<std::size_t> lenDistr(1U, m_config.garbageLength);
+        std::uniform_int_distribution<std::size_t> posDistr(from, data.size());
+        std::uniform_int_distribution<unsigned> byteDistr(0U, 0xffU);
+        auto len = lenDistr(m_random);
+        auto pos = posDistr(m_random);
+        data.insert(data.begin() + pos, len, std::uint8_t(0U));
+        for (std::size_t idx = 0U; idx < len; ++idx) {
+            data[pos + idx] = static_cast<std::uint8_t>(byteDistr(m_random));
+        }
+
+        m_garbage += len;
+        return 1U;
+    }
+
+    CorruptionConfig m_config;
+    std::minstd_rand m_random;
+    std::size_t m_flipped = 0U;
+    std::size_t m_dropped = 0U;
+    std::size_t m_garbage = 0U;
+};
+
+}  // namespace sim
+
+}  // namespace ublox
+
+
@@ -0,0 +1,538 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::sim::Generator class.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ublox/Message.h"
+#include "ublox/MsgFactory.h"
+#include "ublox/details/FrameWriter.h"
+#include "ublox/message/NavPvt.h"
+#include "ublox/message/NavSol.h"
+#include "ublox/message/NavSvinfo.h"
+#include "ublox/message/RxmRaw.h"
+#include "ublox/message/InfNotice.h"
+
+namespace ublox
+{
+
+namespace sim
+{
+
+/// @brief Configuration of the simulated receiver output.
+struct GeneratorConfig
+{
+    /// @brief Measurement (epoch) period, milliseconds.
+    unsigned measPeriodMs = 1000U;
+
+    /// @brief GPS week of the first epoch.
+    std::uint16_t week = 1890U;
+
+    /// @brief GPS time of week of the first epoch, milliseconds.
+    std::uint32_t iTOW = 0U;
+
+    /// @brief Latitude of the centre of the trajectory, 1e-7 degrees.
+    std::int32_t lat = 515000000;
+
+    /// @brief Longitude of the centre of the trajectory, 1e-7 degrees.
+    std::int32_t lon = -1000000;
+
+    /// @brief Height above ellipsoid, millimetres.
+    std::int32_t height = 50000;
+
+    /// @brief Radius of the circular trajectory, metres.
+    double radius = 100.0;
+
+    /// @brief Ground speed, metres per second.
+    double speed = 10.0;
+
+    /// @brief Number of tracking channels reported in NAV-SVINFO.
+    std::size_t channels = 12U;
+
+    /// @brief Number of satellites reported in RXM-RAW.
+    std::size_t svs = 8U;
+
+    /// @brief Epochs between NAV-PVT outputs, @b 0 disables.
+    std::uint8_t navPvtRate = 1U;
+
+    /// @brief Epochs between NAV-SOL outputs, @b 0 disables.
+    std::uint8_t navSolRate = 1U;
+
+    /// @brief Epochs between NAV-SVINFO outputs, @b 0 disables.
+    std::uint8_t navSvinfoRate = 1U;
+
+    /// @brief Epochs between RXM-RAW outputs, @b 0 disables.
+    std::uint8_t rxmRawRate = 0U;
+
+    /// @brief Epochs between INF-NOTICE outputs, @b 0 disables.
+    std::uint8_t infNoticeRate = 0U;
+
+    /// @brief Seed of the pseudo-random noise.
+    std::uint32_t seed = 1U;
+};
+
+/// @brief Generator of the simulated receiver output.
+/// @details Produces the frames of NAV-PVT, NAV-SOL, NAV-SVINFO, RXM-RAW and
+///     INF-NOTICE messages the receiver would output every epoch, according
+///     to the configured rates. The messages are serialised using the
+///     message definitions of this library. The receiver moves along
+///     circular trajectory, the satellites move slowly across the sky, and
+///     the measurements contain pseudo-random noise, reproducible for the
+///     same seed. The values are plausible, but not physically consistent.
+/// @tparam TMsgBase Common interface class of the messages, must support
+///     write operation into @b std::uint8_t* iterator.
+template <typename TMsgBase = Message>
+class Generator
+{
+public:
+    /// @brief Constructor
+    explicit Generator(const GeneratorConfig& config = GeneratorConfig())
+      : m_config(config),
+        m_iTOW(config.iTOW),
+        m_week(config.week),
+        m_random(config.seed)
+    {
+        if (m_config.measPeriodMs == 0U) {
+            m_config.measPeriodMs = 1000U;
+        }
+    }
+
+    /// @brief Get current configuration.
+    const GeneratorConfig& config() const
+    {
+        return m_config;
+    }
+
+    /// @brief Set measurement period.
+    /// @param[in] ms Period in milliseconds, @b 0 is ignored.
+    void setMeasPeriod(unsigned ms)
+    {
+        if (ms != 0U) {
+            m_config.measPeriodMs = ms;
+        }
+    }
+
+    /// @brief Set output rate of the message.
+    /// @param[in] id ID of the message.
+    /// @param[in] rate Number of the epochs between the outputs, @b 0
+    ///     disables the output.
+    /// @return false if the message is not generated.
+    bool setMsgRate(MsgId id, std::uint8_t rate)
+    {
+        auto* field = rateOf(id);
+        if (field == nullptr) {
+            return false;
+        }
+
+        *field = rate;
+        return true;
+    }
+
+    /// @brief GPS time of week of the next epoch, milliseconds.
+    std::uint32_t iTOW() const
+    {
+        return m_iTOW;
+    }
+
+    /// @brief GPS week of the next epoch.
+    std::uint16_t week() const
+    {
+        return m_week;
+    }
+
+    /// @brief Number of generated epochs.
+    std::size_t epochCount() const
+    {
+        return m_epochs;
+    }
+
+    /// @brief Generate the output of the next epoch.
+    /// @param[out] out Buffer the frames are appended to.
+    /// @return Number of generated frames.
+    std::size_t epoch(std::vector<std::uint8_t>& out)
+    {
+        auto frames = m_frames;
+        updateState();
+        if (due(m_config.navPvtRate)) {
+            writeNavPvt(out);
+        }
+
+        if (due(m_config.navSolRate)) {
+            writeNavSol(out);
+        }
+
+        if (due(m_config.navSvinfoRate)) {
+            writeNavSvinfo(out);
+        }
+
+        if (due(m_config.rxmRawRate)) {
+            writeRxmRaw(out);
+        }
+
+        if (due(m_config.infNoticeRate)) {
+            writeInfNotice(out);
+        }
+
+        advance();
+        return m_frames - frames;
+    }
+
+private:
+    static const std::uint32_t MsInWeek = 7U * 24U * 60U * 60U * 1000U;
+
+    template <typename TField, typename TValue>
+    static void assign(TField& field, TValue value)
+    {
+        typedef typename std::decay<decltype(field.value())>::type ValueType;
+        field.value() = static_cast<ValueType>(value);
+    }
+
+    template <typename TMsg>
+    void write(const TMsg& msg, std::vector<std::uint8_t>& out)
+    {
+        if (!details::writePayload(msg, m_payload)) {
+            return;
+        }
+
+        if (!details::writeFrame(
+                details::StaticMsgIdRetriever<TMsg>::Value,
+                m_payload.data(),
+                m_payload.size(),
+                m_frame)) {
+            return;
+        }
+
+        out.insert(out.end(), m_frame.begin(), m_frame.end());
+        ++m_frames;
+    }
+
+    std::uint8_t* rateOf(MsgId id)
+    {
+        switch (id) {
+        case MsgId_NAV_PVT: return &m_config.navPvtRate;
+        case MsgId_NAV_SOL: return &m_config.navSolRate;
+        case MsgId_NAV_SVINFO: return &m_config.navSvinfoRate;
+        case MsgId_RXM_RAW: return &m_config.rxmRawRate;
+        case MsgId_INF_NOTICE: return &m_config.infNoticeRate;
+        default: break;
+        }
+        return nullptr;
+    }
+
+    bool due(std::uint8_t rate) const
+    {
+        return (rate != 0U) && ((m_epochs % rate) == 0U);
+    }
+
+    double noise(double amplitude)
+    {
+        std::uniform_real_distribution<double> distr(-amplitude, amplitude);
+        return distr(m_random);
+    }
+
+    void updateState()
+    {
+        static const double Pi = 3.14159265358979323846;
+        static const double EarthRadius = 6378137.0;
+
+        double seconds = (static_cast<double>(m_epochs) * m_config.measPeriodMs) / 1000.0;
+        double angle = 0.0;
+        if (0.0 < m_config.radius) {
+            angle = (m_config.speed * seconds) / m_config.radius;
+        }
+
+        double north = m_config.radius * std::sin(angle);
+        double east = m_config.radius * std::cos(angle);
+        double centreLat = (m_config.lat * 1e-7 * Pi) / 180.0;
+        m_latRad = centreLat + (north / EarthRadius);
+        m_lonRad = ((m_config.lon * 1e-7 * Pi) / 180.0) + (east / (EarthRadius * std::cos(centreLat)));
+        m_heightM = (m_config.height / 1000.0) + noise(0.5);
+        m_velN = m_config.speed * std::cos(angle) + noise(0.05);
+        m_velE = -m_config.speed * std::sin(angle) + noise(0.05);
+        m_velD = noise(0.05);
+        m_heading = std::atan2(m_velE, m_velN);
+        m_skyAngle = (seconds * 2.0 * Pi) / (12.0 * 60.0 * 60.0);
+    }
+
+    void advance()
+    {
+        ++m_epochs;
+        m_iTOW += m_config.measPeriodMs;
+        if (MsInWeek <= m_iTOW) {
+            m_iTOW -= MsInWeek;
+            ++m_week;
+        }
+    }
+
+    std::size_t usedSvs() const
+    {
+        return std::max(m_config.channels, m_config.svs);
+    }
+
+    void ecef(double& x, double& y, double& z) const
+    {
+        static const double A = 6378137.0;
+        static const double E2 = 6.69437999014e-3;
+        double sinLat = std::sin(m_latRad);
+        double n = A / std::sqrt(1.0 - (E2 * sinLat * sinLat));
+        x = (n + m_heightM) * std::cos(m_latRad) * std::cos(m_lonRad);
+        y = (n + m_heightM) * std::cos(m_latRad) * std::sin(m_lonRad);
+        z = ((n * (1.0 - E2)) + m_heightM) * sinLat;
+    }
+
+    void utc(
+        std::uint16_t& year,
+        std::uint8_t& month,
+        std::uint8_t& day,
+        std::uint8_t& hour,
+        std::uint8_t& min,
+        std::uint8_t& sec) const
+    {
+        // GPS time starts at 1980-01-06, 17 leap seconds since then (2016)
+        static const long long GpsEpochDays = 3657;
+        static const long long LeapSeconds = 17;
+        long long totalSec =
+            (static_cast<long long>(m_week) * 7 * 24 * 3600) +
+            (m_iTOW / 1000U) - LeapSeconds;
+        long long days = GpsEpochDays + (totalSec / 86400);
+        long long secOfDay = totalSec % 86400;
+
+        // Civil date from days since 1970-01-01
+        long long z = days + 719468;
+        long long era = z / 146097;
+        long long doe = z - (era * 146097);
+        long long yoe = (doe - (doe / 1460) + (doe / 36524) - (doe / 146096)) / 365;
+        long long doy = doe - ((365 * yoe) + (yoe / 4) - (yoe / 100));
+        long long mp = ((5 * doy) + 2) / 153;
+        long long d = doy - (((153 * mp) + 2) / 5) + 1;
+        long long m = (mp < 10) ? (mp + 3) : (mp - 9);
+        long long y = yoe + (era * 400) + ((m <= 2) ? 1 : 0);
+
+        year = static_cast<std::uint16_t>(y);
+        month = static_cast<std::uint8_t>(m);
+        day = static_cast<std::uint8_t>(d);
+        hour = static_cast<std::uint8_t>(secOfDay / 3600);
+        min = static_cast<std::uint8_t>((secOfDay / 60) % 60);
+        sec = static_cast<std::uint8_t>(secOfDay % 60);
+    }
+
+    void writeNavPvt(std::vector<std::uint8_t>& out)
+    {
+        typedef message::NavPvt<TMsgBase> Msg;
+        typedef message::NavPvtFields Fields;
+        static const double RadToDeg = 180.0 / 3.14159265358979323846;
+
+        Msg msg;
+        auto& fields = msg.fields();
+        std::uint16_t year = 0U;
+        std::uint8_t month = 0U;
+        std::uint8_t day = 0U;
+        std::uint8_t hour = 0U;
+        std::uint8_t min = 0U;
+        std::uint8_t sec = 0U;
+        utc(year, month, day, hour, min, sec);
+
+        assign(std::get<Msg::FieldIdx_iTOW>(fields), m_iTOW);
+        assign(std::get<Msg::FieldIdx_year>(fields), year);
+        assign(std::get<Msg::FieldIdx_month>(fields), month);
+        assign(std::get<Msg::FieldIdx_day>(fields), day);
+        assign(std::get<Msg::FieldIdx_hour>(fields), hour);
+        assign(std::get<Msg::FieldIdx_min>(fields), min);
+        assign(std::get<Msg::FieldIdx_sec>(fields), sec);
+        assign(std::get<Msg::FieldIdx_valid>(fields), 0x7);
+        assign(std::get<Msg::FieldIdx_tAcc>(fields), 20 + static_cast<int>(noise(5.0)));
+        assign(std::get<Msg::FieldIdx_nano>(fields), static_cast<int>(noise(100.0)));
+        assign(std::get<Msg::FieldIdx_fixType>(fields), field::nav::GpsFix::Fix_3D);
+        assign(
+            std::get<Fields::flags_bits>(std::get<Msg::FieldIdx_flags>(fields).value()),
+            1U << Fields::flagsBits_gnssFixOK);
+        assign(std::get<Msg::FieldIdx_numSV>(fields), usedSvs());
+        assign(std::get<Msg::FieldIdx_lon>(fields), std::lround(m_lonRad * RadToDeg * 1e7));
+        assign(std::get<Msg::FieldIdx_lat>(fields), std::lround(m_latRad * RadToDeg * 1e7));
+        assign(std::get<Msg::FieldIdx_height>(fields), std::lround(m_heightM * 1000.0));
+        assign(std::get<Msg::FieldIdx_hMSL>(fields), std::lround((m_heightM - 47.0) * 1000.0));
+        assign(std::get<Msg::FieldIdx_hAcc>(fields), 1500 + static_cast<int>(noise(300.0)));
+        assign(std::get<Msg::FieldIdx_vAcc>(fields), 2500 + static_cast<int>(noise(500.0)));
+        assign(std::get<Msg::FieldIdx_velN>(fields), std::lround(m_velN * 1000.0));
+        assign(std::get<Msg::FieldIdx_velE>(fields), std::lround(m_velE * 1000.0));
+        assign(std::get<Msg::FieldIdx_velD>(fields), std::lround(m_velD * 1000.0));
+        assign(
+            std::get<Msg::FieldIdx_gSpeed>(fields),
+            std::lround(std::sqrt((m_velN * m_velN) + (m_velE * m_velE)) * 1000.0));
+        auto heading = m_heading * RadToDeg;
+        if (heading < 0.0) {
+            heading += 360.0;
+        }
+        assign(std::get<Msg::FieldIdx_heading>(fields), std::lround(heading * 1e5));
+        assign(std::get<Msg::FieldIdx_sAcc>(fields), 200 + static_cast<int>(noise(50.0)));
+        assign(std::get<Msg::FieldIdx_headingAcc>(fields), 500000 + static_cast<int>(noise(1e5)));
+        assign(std::get<Msg::FieldIdx_pDOP>(fields), 150 + static_cast<int>(noise(30.0)));
+        write(msg, out);
+    }
+
+    void writeNavSol(std::vector<std::uint8_t>& out)
+    {
+        typedef message::NavSol<TMsgBase> Msg;
+
+        Msg msg;
+        auto& fields = msg.fields();
+        double x = 0.0;
+        double y = 0.0;
+        double z = 0.0;
+        ecef(x, y, z);
+
+        assign(std::get<Msg::FieldIdx_iTOW>(fields), m_iTOW);
+        assign(std::get<Msg::FieldIdx_fTOW>(fields), static_cast<int>(noise(1000.0)));
+        assign(std::get<Msg::FieldIdx_week>(fields), m_week);
+        assign(std::get<Msg::FieldIdx_gpsFix>(fields), field::nav::GpsFix::Fix_3D);
+        assign(std::get<Msg::FieldIdx_flags>(fields), 0xd);
+        assign(std::get<Msg::FieldIdx_ecefX>(fields), std::llround(x * 100.0));
+        assign(std::get<Msg::FieldIdx_ecefY>(fields), std::llround(y * 100.0));
+        assign(std::get<Msg::FieldIdx_ecefZ>(fields), std::llround(z * 100.0));
+        assign(std::get<Msg::FieldIdx_pAcc>(fields), 250 + static_cast<int>(noise(50.0)));
+        assign(std::get<Msg::FieldIdx_ecefVX>(fields), static_cast<int>(noise(1000.0)));
+        assign(std::get<Msg::FieldIdx_ecefVY>(fields), static_cast<int>(noise(1000.0)));
+        assign(std::get<Msg::FieldIdx_ecefVZ>(fields), static_cast<int>(noise(100.0)));
+        assign(std::get<Msg::FieldIdx_sAcc>(fields), 20 + static_cast<int>(noise(5.0)));
+        assign(std::get<Msg::FieldIdx_pDOP>(fields), 150 + static_cast<int>(noise(30.0)));
+        assign(std::get<Msg::FieldIdx_numSV>(fields), usedSvs());
+        write(msg, out);
+    }
+
+    void writeNavSvinfo(std::vector<std::uint8_t>& out)
+    {
+        typedef message::NavSvinfo<TMsgBase> Msg;
+        typedef message::NavSvinfoFields Fields;
+
+        Msg msg;
+        auto& fields = msg.fields();
+        assign(std::get<Msg::FieldIdx_iTOW>(fields), m_iTOW);
+        assign(std::get<Msg::FieldIdx_numCh>(fields), m_config.channels);
+
+        auto& blocks = std::get<Msg::FieldIdx_data>(fields).value();
+        blocks.resize(m_config.channels);
+        for (std::size_t idx = 0U; idx < blocks.size(); ++idx) {
+            auto& members = blocks[idx].value();
+            double elev = 0.0;
+            double azim = 0.0;
+            sky(idx, elev, azim);
+            assign(std::get<Fields::block_chn>(members), idx);
+            assign(std::get<Fields::block_svid>(members), idx + 1U);
+            assign(
+                std::get<Fields::block_flags>(members),
+                (1U << Fields::flags_svUsed) | (1U << Fields::flags_orbitAvail) |
+                    (1U << Fields::flags_orbitEph));
+            assign(std::get<Fields::block_quality>(members), Fields::QualityInd::CodeCarrierLocked);
+            assign(std::get<Fields::block_cno>(members), cno(elev));
+            assign(std::get<Fields::block_elev>(members), std::lround(elev));
+            assign(std::get<Fields::block_azim>(members), std::lround(azim));
+            assign(std::get<Fields::block_prRes>(members), static_cast<int>(noise(300.0)));
+        }
+        write(msg, out);
+    }
+
+    void writeRxmRaw(std::vector<std::uint8_t>& out)
+    {
+        typedef message::RxmRaw<TMsgBase> Msg;
+        typedef message::RxmRawFields Fields;
+        static const double SpeedOfLight = 299792458.0;
+        static const double L1Wavelength = SpeedOfLight / 1575.42e6;
+
+        Msg msg;
+        auto& fields = msg.fields();
+        assign(std::get<Msg::FieldIdx_rcvTow>(fields), m_iTOW);
+        assign(std::get<Msg::FieldIdx_week>(fields), m_week);
+        assign(std::get<Msg::FieldIdx_numSV>(fields), m_config.svs);
+
+        double seconds = (static_cast<double>(m_epochs) * m_config.measPeriodMs) / 1000.0;
+        auto& blocks = std::get<Msg::FieldIdx_data>(fields).value();
+        blocks.resize(m_config.svs);
+        for (std::size_t idx = 0U; idx < blocks.size(); ++idx) {
+            auto& members = blocks[idx].value();
+            double elev = 0.0;
+            double azim = 0.0;
+            sky(idx, elev, azim);
+            double doppler = 3000.0 * std::cos((elev * 3.14159265358979323846) / 180.0);
+            double range = 20200e3 + (5000e3 * std::cos((elev * 3.14159265358979323846) / 180.0));
+            range += (doppler * L1Wavelength * seconds) + noise(3.0);
+            assign(std::get<Fields::block_cpMes>(members), range / L1Wavelength);
+            assign(std::get<Fields::block_prMes>(members), range);
+            assign(std::get<Fields::block_doMes>(members), doppler + noise(1.0));
+            assign(std::get<Fields::block_sv>(members), idx + 1U);
+            assign(std::get<Fields::block_mesQI>(members), 7);
+            assign(std::get<Fields::block_cno>(members), cno(elev));
+            assign(std::get<Fields::block_lli>(members), 0);
+        }
+        write(msg, out);
+    }
+
+    void writeInfNotice(std::vector<std::uint8_t>& out)
+    {
+        typedef message::InfNotice<TMsgBase> Msg;
+
+        Msg msg;
+        std::get<Msg::FieldIdx_str>(msg.fields()).value() =
+            "simulated epoch " + std::to_string(m_epochs);
+        write(msg, out);
+    }
+
+    void sky(std::size_t idx, double& elev, double& azim) const
+    {
+        auto phase = m_skyAngle + (static_cast<double>(idx) * 0.7);
+        elev = 45.0 + (40.0 * std::sin(phase));
+        azim = std::fmod((static_cast<double>(idx) * 360.0) / 7.0 + (phase * 10.0), 360.0) - 180.0;
+    }
+
+    int cno(double elev)
+    {
+        return 30 + static_cast<int>(elev / 5.0) + static_cast<int>(noise(2.0));
+    }
+
+    GeneratorConfig m_config;
+    std::uint32_t m_iTOW = 0U;
+    std::uint16_t m_week = 0U;
+    std::size_t m_epochs = 0U;
+    std::size_t m_frames = 0U;
+    std::minstd_rand m_random;
+    std::vector<std::uint8_t> m_payload;
+    std::vector<std::uint8_t> m_frame;
+    double m_latRad = 0.0;
+    double m_lonRad = 0.0;
+    double m_heightM = 0.0;
+    double m_velN = 0.0;
+    double m_velE = 0.0;
+    double m_velD = 0.0;
+    double m_heading = 0.0;
+    double m_skyAngle = 0.0;
+};
+
+}  // namespace sim
+
+}  // namespace ublox
+
+
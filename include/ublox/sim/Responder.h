@@ -0,0 +1,235 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::sim::Responder class.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "comms/comms.h"
+
+#include "ublox/Message.h"
+#include "ublox/MsgId.h"
+#include "ublox/MsgFactory.h"
+#include "ublox/MsgLayout.h"
+#include "ublox/FrameAssembler.h"
+#include "ublox/details/FrameWriter.h"
+#include "ublox/message/AckAck.h"
+#include "ublox/message/AckNak.h"
+#include "ublox/message/CfgMsg.h"
+#include "ublox/message/CfgMsgCurrent.h"
+#include "ublox/message/CfgRate.h"
+#include "Generator.h"
+
+namespace ublox
+{
+
+namespace sim
+{
+
+/// @brief Responder of the simulated receiver to the configuration
+///     requests.
+/// @details Assembles the frames received from the host and replies with
+///     ACK-ACK to every frame of CFG class, or ACK-NAK when its payload
+///     cannot be read. CFG-RATE and CFG-MSG (for current port or with the
+///     rates for all the ports) modify the output of the @ref Generator.
+///     Other configuration, as well as polls, are acknowledged only.
+/// @tparam TMsgBase Common interface class of the messages, must support
+///     read operation from <b>const std::uint8_t*</b> and write operation
+///     into @b std::uint8_t* iterators.
+template <typename TMsgBase = Message>
+class Responder
+{
+public:
+    /// @brief Type of the controlled generator.
+    typedef Generator<TMsgBase> GeneratorType;
+
+    /// @brief Default index of the port in the CFG-MSG rates list (UART1).
+    static const std::size_t DefaultPort = 1U;
+
+    /// @brief Constructor
+    /// @param[in] generator Generator affected by the configuration.
+    explicit Responder(GeneratorType& generator)
+      : m_generator(generator)
+    {
+    }
+
+    /// @brief Set index of the port in the CFG-MSG rates list.
+    void setPort(std::size_t port)
+    {
+        m_port = port;
+    }
+
+    /// @brief Process input received from the host.
+    /// @param[in] data Pointer to the input data.
+    /// @param[in] len Number of bytes in the input data.
+    /// @param[out] out Buffer the reply frames are appended to.
+    /// @return Number of the reply frames.
+    std::size_t process(const std::uint8_t* data, std::size_t len, std::vector<std::uint8_t>& out)
+    {
+        std::size_t count = 0U;
+        m_assembler.process(data, len,
+            [this, &out, &count](const FrameView& view)
+            {
+                if (details::msgClassOf(view.msgId()) != details::msgClassOf(MsgId_CFG_PRT)) {
+                    return;
+                }
+
+                if (reply(view.msgId(), configure(view), out)) {
+                    ++count;
+                }
+            });
+        return count;
+    }
+
+    /// @brief Total number of acknowledged configuration frames.
+    std::size_t ackedCount() const
+    {
+        return m_acked;
+    }
+
+    /// @brief Total number of rejected configuration frames.
+    std::size_t nackedCount() const
+    {
+        return m_nacked;
+    }
+
+    /// @brief Total number of bytes that didn't belong to any valid frame.
+    std::size_t skippedCount() const
+    {
+        return m_assembler.skippedCount();
+    }
+
+private:
+    template <typename TMsg>
+    static bool read(TMsg& msg, const FrameView::Payload& payload)
+    {
+        const std::uint8_t* readIter = payload.data();
+        return msg.read(readIter, payload.size()) == comms::ErrorStatus::Success;
+    }
+
+    bool configure(const FrameView& view)
+    {
+        auto payload = view.payload();
+        if (view.msgId() == MsgId_CFG_RATE) {
+            typedef message::CfgRate<TMsgBase> Msg;
+            if (payload.size() != MsgLayout<Msg>::MinLength) {
+                return true;
+            }
+
+            Msg msg;
+            if (!read(msg, payload)) {
+                return false;
+            }
+
+            m_generator.setMeasPeriod(
+                static_cast<unsigned>(std::get<Msg::FieldIdx_measRate>(msg.fields()).value()));
+            return true;
+        }
+
+        if (view.msgId() != MsgId_CFG_MSG) {
+            return true;
+        }
+
+        typedef message::CfgMsgCurrent<TMsgBase> CurrentMsg;
+        typedef message::CfgMsg<TMsgBase> AllMsg;
+        if (payload.size() == MsgLayout<CurrentMsg>::MinLength) {
+            CurrentMsg msg;
+            if (!read(msg, payload)) {
+                return false;
+            }
+
+            auto& fields = msg.fields();
+            m_generator.setMsgRate(
+                std::get<CurrentMsg::FieldIdx_id>(fields).value(),
+                static_cast<std::uint8_t>(std::get<CurrentMsg::FieldIdx_rate>(fields).value()));
+            return true;
+        }
+
+        if (payload.size() == MsgLayout<AllMsg>::MinLength) {
+            AllMsg msg;
+            if (!read(msg, payload)) {
+                return false;
+            }
+
+            auto& fields = msg.fields();
+            auto& rates = std::get<AllMsg::FieldIdx_rate>(fields).value();
+            if (m_port < rates.size()) {
+                m_generator.setMsgRate(
+                    std::get<AllMsg::FieldIdx_id>(fields).value(),
+                    static_cast<std::uint8_t>(rates[m_port].value()));
+            }
+        }
+
+        return true;
+    }
+
+    bool reply(MsgId id, bool acked, std::vector<std::uint8_t>& out)
+    {
+        bool written = false;
+        if (acked) {
+            typedef message::AckAck<TMsgBase> Msg;
+            Msg msg;
+            std::get<Msg::FieldIdx_id>(msg.fields()).value() = id;
+            written = write(msg, out);
+            ++m_acked;
+        }
+        else {
+            typedef message::AckNak<TMsgBase> Msg;
+            Msg msg;
+            std::get<Msg::FieldIdx_id>(msg.fields()).value() = id;
+            written = write(msg, out);
+            ++m_nacked;
+        }
+
+        return written;
+    }
+
+    template <typename TMsg>
+    bool write(const TMsg& msg, std::vector<std::uint8_t>& out)
+    {
+        if ((!details::writePayload(msg, m_payload)) ||
+            (!details::writeFrame(
+                details::StaticMsgIdRetriever<TMsg>::Value,
+                m_payload.data(),
+                m_payload.size(),
+                m_frame))) {
+            return false;
+        }
+
+        out.insert(out.end(), m_frame.begin(), m_frame.end());
+        return true;
+    }
+
+    GeneratorType& m_generator;
+    FrameAssembler<> m_assembler;
+    std::vector<std::uint8_t> m_payload;
+    std::vector<std::uint8_t> m_frame;
+    std::size_t m_port = DefaultPort;
+    std::size_t m_acked = 0U;
+    std::size_t m_nacked = 0U;
+};
+
+}  // namespace sim
+
+}  // namespace ublox
+
+
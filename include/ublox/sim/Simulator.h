@@ -0,0 +1,450 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of ublox::sim::Simulator class.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cerrno>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include <poll.h>
+#include <unistd.h>
+
+#include "ublox/Message.h"
+#include "Generator.h"
+#include "Corruptor.h"
+#include "Responder.h"
+
+namespace ublox
+{
+
+namespace sim
+{
+
+/// @brief Configuration of the simulated receiver output timing.
+struct SimulatorConfig
+{
+    /// @brief Output rate limit, bytes per second, @b 0 means unlimited.
+    /// @details Use uartBytesPerSecond() to emulate the serial port.
+    std::size_t bytesPerSecond = 0U;
+
+    /// @brief Maximal number of bytes written at once when the output
+    ///     rate is limited, i.e. the burst length.
+    std::size_t chunkLength = 64U;
+
+    /// @brief Length of the transmit buffer, @b 0 means unlimited.
+    /// @details The output of the epoch which doesn't fit into the
+    ///     buffer is discarded, like the receiver does when the port
+    ///     cannot keep up with the configured messages.
+    std::size_t txBufferLength = 0U;
+
+    /// @brief Generate the epochs at measurement period (@b true) or
+    ///     as soon as the output of the previous epoch is written (@b false).
+    bool realTime = true;
+
+    /// @brief Number of the epochs generated by every Simulator::run()
+    ///     invocation, @b 0 means unlimited.
+    std::size_t epochs = 0U;
+};
+
+/// @brief Simulated receiver.
+/// @details Writes the output of the @ref Generator into the file
+///     descriptor (pty master, pipe, file or socket) paced by the configured
+///     output rate, optionally corrupted by @ref Corruptor, and replies to
+///     the configuration requests read from the input descriptor using
+///     @ref Responder. The descriptors are expected to be non-blocking,
+///     the waiting is performed by @b poll(). The descriptors are not
+///     owned, i.e. not closed by the simulator.
+/// @code
+/// ublox::sim::Generator<> generator;
+/// ublox::sim::SimulatorConfig config;
+/// config.bytesPerSecond = 11520;
+/// ublox::sim::Simulator<> simulator(generator, fd, fd, config);
+/// if (!simulator.run()) {
+///     ... // simulator.error() contains errno
+/// }
+/// @endcode
+/// @tparam TMsgBase Common interface class of the messages.
+template <typename TMsgBase = Message>
+class Simulator
+{
+public:
+    /// @brief Type of the generator.
+    typedef Generator<TMsgBase> GeneratorType;
+
+    /// @brief Type of the responder.
+    typedef Responder<TMsgBase> ResponderType;
+
+    /// @brief Constructor
+    /// @param[in] generator Generator of the output.
+    /// @param[in] outFd Output file descriptor.
+    /// @param[in] inFd Input file descriptor, @b -1 if none.
+    /// @param[in] config Timing configuration.
+    Simulator(
+        GeneratorType& generator,
+        int outFd,
+        int inFd = -1,
+        const SimulatorConfig& config = SimulatorConfig())
+      : m_generator(generator),
+        m_responder(generator),
+        m_config(config),
+        m_outFd(outFd),
+        m_inFd(inFd)
+    {
+        if (m_config.chunkLength == 0U) {
+            m_config.chunkLength = 1U;
+        }
+    }
+
+    /// @brief Set configuration of the injected corruption.
+    void setCorruption(const CorruptionConfig& config)
+    {
+        m_corruptor = Corruptor(config);
+    }
+
+    /// @brief Get access to the corruptor.
+    const Corruptor& corruptor() const
+    {
+        return m_corruptor;
+    }
+
+    /// @brief Get access to the responder.
+    ResponderType& responder()
+    {
+        return m_responder;
+    }
+
+    /// @brief Run the simulation.
+    /// @details Returns when the configured number of epochs is generated
+    ///     and written, or stop() is called.
+    /// @return false on I/O error, see error().
+    bool run()
+    {
+        bool result = true;
+        m_lastEpoch = m_generator.epochCount() + m_config.epochs;
+        auto now = Clock::now();
+        m_nextEpoch = now;
+        m_lastRefill = now;
+        while (!m_stopRequested.load(std::memory_order_relaxed)) {
+            now = Clock::now();
+            if (epochDue(now)) {
+                produce();
+            }
+
+            refill(now);
+            if (!flush()) {
+                result = false;
+                break;
+            }
+
+            if (finished()) {
+                break;
+            }
+
+            if (!wait(Clock::now())) {
+                result = false;
+                break;
+            }
+        }
+
+        m_stopRequested = false;
+        return result;
+    }
+
+    /// @brief Request run() to return.
+    /// @details May be called from other thread or signal handler. The
+    ///     request is noticed within the measurement period at most.
+    void stop()
+    {
+        m_stopRequested = true;
+    }
+
+    /// @brief Value of @b errno of the failed I/O operation.
+    int error() const
+    {
+        return m_error;
+    }
+
+    /// @brief Total number of written bytes.
+    std::size_t bytesWritten() const
+    {
+        return m_written;
+    }
+
+    /// @brief Number of bytes waiting to be written.
+    std::size_t pendingCount() const
+    {
+        return m_out.size() - m_outPos;
+    }
+
+    /// @brief Number of the epochs with the output discarded due to
+    ///     the transmit buffer overrun.
+    std::size_t overrunCount() const
+    {
+        return m_overruns;
+    }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    static bool wouldBlock(int error)
+    {
+#if EAGAIN != EWOULDBLOCK
+        if (error == EWOULDBLOCK) {
+            return true;
+        }
+#endif
+        return error == EAGAIN;
+    }
+
+    bool epochsLeft() const
+    {
+        return (m_config.epochs == 0U) || (m_generator.epochCount() < m_lastEpoch);
+    }
+
+    bool epochDue(Clock::time_point now) const
+    {
+        if (!epochsLeft()) {
+            return false;
+        }
+
+        if (m_config.realTime) {
+            return m_nextEpoch <= now;
+        }
+
+        return pendingCount() == 0U;
+    }
+
+    bool finished() const
+    {
+        return (!epochsLeft()) && (pendingCount() == 0U);
+    }
+
+    void produce()
+    {
+        auto from = m_out.size();
+        m_generator.epoch(m_out);
+        m_nextEpoch += std::chrono::milliseconds(m_generator.config().measPeriodMs);
+        if ((m_config.txBufferLength != 0U) &&
+            (m_config.txBufferLength < (m_out.size() - m_outPos))) {
+            m_out.resize(from);
+            ++m_overruns;
+            return;
+        }
+
+        m_corruptor.apply(m_out, from);
+    }
+
+    void refill(Clock::time_point now)
+    {
+        if (m_config.bytesPerSecond == 0U) {
+            return;
+        }
+
+        std::chrono::duration<double> elapsed = now - m_lastRefill;
+        m_lastRefill = now;
+        m_tokens += elapsed.count() * static_cast<double>(m_config.bytesPerSecond);
+        m_tokens = std::min(m_tokens, static_cast<double>(m_config.chunkLength));
+    }
+
+    std::size_t burstLength() const
+    {
+        return std::min(pendingCount(), m_config.chunkLength);
+    }
+
+    bool flush()
+    {
+        while (pendingCount() != 0U) {
+            auto len = pendingCount();
+            if (m_config.bytesPerSecond != 0U) {
+                if (m_tokens < static_cast<double>(burstLength())) {
+                    break;
+                }
+
+                len = burstLength();
+            }
+
+            auto result = ::write(m_outFd, &m_out[m_outPos], len);
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                if (wouldBlock(errno)) {
+                    break;
+                }
+
+                m_error = errno;
+                return false;
+            }
+
+            auto count = static_cast<std::size_t>(result);
+            m_outPos += count;
+            m_written += count;
+            if (m_config.bytesPerSecond != 0U) {
+                m_tokens -= static_cast<double>(count);
+            }
+        }
+
+        compact();
+        return true;
+    }
+
+    void compact()
+    {
+        if (m_outPos == m_out.size()) {
+            m_out.clear();
+            m_outPos = 0U;
+            return;
+        }
+
+        static const std::size_t CompactThreshold = 4096U;
+        if ((CompactThreshold <= m_outPos) && (m_out.size() <= (m_outPos * 2U))) {
+            m_out.erase(m_out.begin(), m_out.begin() + m_outPos);
+            m_outPos = 0U;
+        }
+    }
+
+    int timeout(Clock::time_point now) const
+    {
+        auto result = Clock::duration::max();
+        if (epochsLeft() && m_config.realTime) {
+            result = std::max(m_nextEpoch - now, Clock::duration::zero());
+        }
+
+        if ((pendingCount() != 0U) && (m_config.bytesPerSecond != 0U)) {
+            auto missing = static_cast<double>(burstLength()) - m_tokens;
+            if (0.0 < missing) {
+                std::chrono::duration<double> delay(missing / static_cast<double>(m_config.bytesPerSecond));
+                result = std::min(result, std::chrono::duration_cast<Clock::duration>(delay));
+            }
+        }
+
+        if (result == Clock::duration::max()) {
+            return -1;
+        }
+
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(result).count();
+        if (std::chrono::milliseconds(ms) < result) {
+            ++ms;
+        }
+        return static_cast<int>(ms);
+    }
+
+    bool wait(Clock::time_point now)
+    {
+        std::array<pollfd, 2U> fds;
+        nfds_t count = 0U;
+        bool writable = (pendingCount() != 0U);
+        if ((m_config.bytesPerSecond != 0U) && (m_tokens < static_cast<double>(burstLength()))) {
+            writable = false;
+        }
+
+        if (writable) {
+            fds[count].fd = m_outFd;
+            fds[count].events = POLLOUT;
+            fds[count].revents = 0;
+            ++count;
+        }
+
+        if (0 <= m_inFd) {
+            fds[count].fd = m_inFd;
+            fds[count].events = POLLIN;
+            fds[count].revents = 0;
+            ++count;
+        }
+
+        auto ms = timeout(now);
+        if ((count == 0U) && (ms < 0)) {
+            return true;
+        }
+
+        if (::poll(fds.data(), count, ms) < 0) {
+            if (errno == EINTR) {
+                return true;
+            }
+
+            m_error = errno;
+            return false;
+        }
+
+        for (nfds_t idx = 0U; idx < count; ++idx) {
+            if ((fds[idx].fd == m_inFd) && (fds[idx].revents != 0)) {
+                receive();
+            }
+        }
+        return true;
+    }
+
+    void receive()
+    {
+        while (0 <= m_inFd) {
+            auto result = ::read(m_inFd, m_inBuf.data(), m_inBuf.size());
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                if (!wouldBlock(errno)) {
+                    m_inFd = -1;
+                }
+                return;
+            }
+
+            if (result == 0) {
+                m_inFd = -1;
+                return;
+            }
+
+            auto from = m_out.size();
+            m_responder.process(m_inBuf.data(), static_cast<std::size_t>(result), m_out);
+            m_corruptor.apply(m_out, from);
+        }
+    }
+
+    GeneratorType& m_generator;
+    ResponderType m_responder;
+    Corruptor m_corruptor;
+    SimulatorConfig m_config;
+    int m_outFd = -1;
+    int m_inFd = -1;
+    int m_error = 0;
+    std::atomic<bool> m_stopRequested{false};
+    std::vector<std::uint8_t> m_out;
+    std::size_t m_outPos = 0U;
+    std::array<std::uint8_t, 1024U> m_inBuf;
+    std::size_t m_written = 0U;
+    std::size_t m_overruns = 0U;
+    std::size_t m_lastEpoch = 0U;
+    double m_tokens = 0.0;
+    Clock::time_point m_nextEpoch;
+    Clock::time_point m_lastRefill;
+};
+
+}  // namespace sim
+
+}  // namespace ublox
+
+
@@ -23,5 +23,14 @@
 
 #include "MsgId.h"
 #include "Message.h"
+#include "MsgLayout.h"
 #include "Stack.h"
+#include "FrameView.h"
+#include "FrameAssembler.h"
+#include "EpochAssembler.h"
+#include "NavStateStore.h"
+#include "CfgTransactions.h"
+#include "LinkBudget.h"
+#include "PollScheduler.h"
+#include "OutputPlanner.h"
 
@@ -0,0 +1,306 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of columnar decoders of the lists of repeated
+///     blocks.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <vector>
+
+#include "comms/comms.h"
+
+#include "common.h"
+
+namespace ublox
+{
+
+namespace view
+{
+
+namespace details
+{
+
+template <typename TMembers>
+struct BlockColumnsStorage;
+
+template <typename... TMembers>
+struct BlockColumnsStorage<std::tuple<TMembers...> >
+{
+    typedef std::tuple<
+        std::vector<typename FieldTraits<TMembers>::ValueType>...
+    > Type;
+};
+
+}  // namespace details
+
+/// @brief Columnar (structure of arrays) storage of the repeated blocks.
+/// @details Every member field of the block is decoded into its own
+///     contiguous array, suitable for vectorised processing. The arrays
+///     retain their capacity between the decode() calls, i.e. reusing the
+///     same object for multiple frames doesn't allocate memory once
+///     the largest number of blocks has been seen. The stored values are
+///     not scaled, use @ref FieldValue to apply the scaling specified
+///     in the field definition if needed.
+/// @tparam TBlock Definition of the block, expected to be a variant of
+///     <a href="https://dl.dropboxusercontent.com/u/46999418/comms_champion/comms/html/classcomms_1_1field_1_1Bundle.html">comms::field::Bundle</a>
+///     with fixed serialisation length, such as
+///     @ref ublox::message::NavSvinfoFields::block.
+template <typename TBlock>
+class BlockColumns
+{
+public:
+    /// @brief Definition of the block.
+    typedef TBlock Block;
+
+    /// @brief Member fields of the block bundled in std::tuple.
+    typedef typename details::BundleMembers<Block>::Type Members;
+
+    /// @brief Number of columns, i.e. the member fields of the block.
+    static const std::size_t NumOfColumns = std::tuple_size<Members>::value;
+
+    /// @brief Serialisation length of the single block.
+    static const std::size_t BlockLength =
+        ublox::details::FieldsMaxLength<Members>::Value;
+
+    static_assert(0U < NumOfColumns, "The block is expected to have members");
+    static_assert(ublox::details::FieldsMinLength<Members>::Value == BlockLength,
+        "The block is expected to have fixed length");
+
+    /// @brief Definition of the member field stored in the column.
+    template <std::size_t TIdx>
+    using ColumnField = typename std::tuple_element<TIdx, Members>::type;
+
+    /// @brief Type of the values stored in the column.
+    template <std::size_t TIdx>
+    using ColumnValueType = typename details::FieldTraits<ColumnField<TIdx> >::ValueType;
+
+    /// @brief Decode the blocks.
+    /// @param[in] data Pointer to the first byte of the first block.
+    /// @param[in] len Number of bytes available.
+    /// @param[in] count Number of blocks.
+    /// @return @b comms::ErrorStatus::Success on success,
+    ///     @b comms::ErrorStatus::NotEnoughData if the data is too short,
+    ///     in which case the storage becomes empty.
+    comms::ErrorStatus decode(const std::uint8_t* data, std::size_t len, std::size_t count)
+    {
+        if ((len / BlockLength) < count) {
+            clear();
+            return comms::ErrorStatus::NotEnoughData;
+        }
+
+        decodeColumns(data, count, typename ublox::details::MakeIndexSeq<NumOfColumns>::Type());
+        m_size = count;
+        return comms::ErrorStatus::Success;
+    }
+
+    /// @brief Number of decoded blocks.
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /// @brief Check whether there are no decoded blocks.
+    bool empty() const
+    {
+        return m_size == 0U;
+    }
+
+    /// @brief Get access to the column.
+    /// @tparam TIdx Index of the member field in the block.
+    /// @return Pointer to the first of size() contiguous values.
+    template <std::size_t TIdx>
+    const ColumnValueType<TIdx>* column() const
+    {
+        return std::get<TIdx>(m_columns).data();
+    }
+
+    /// @brief Remove all the decoded blocks, the capacity is retained.
+    void clear()
+    {
+        m_size = 0U;
+    }
+
+    /// @brief Reserve space for the provided number of blocks.
+    void reserve(std::size_t count)
+    {
+        reserveColumns(count, typename ublox::details::MakeIndexSeq<NumOfColumns>::Type());
+    }
+
+private:
+    typedef typename details::BlockColumnsStorage<Members>::Type Columns;
+
+    template <std::size_t... TIdx>
+    void decodeColumns(
+        const std::uint8_t* data,
+        std::size_t count,
+        ublox::details::IndexSeq<TIdx...>)
+    {
+        int dummy[] = {(decodeColumn<TIdx>(data, count), 0)...};
+        static_cast<void>(dummy);
+    }
+
+    template <std::size_t TIdx>
+    void decodeColumn(const std::uint8_t* data, std::size_t count)
+    {
+        auto& col = std::get<TIdx>(m_columns);
+        if (col.size() < count) {
+            col.resize(count);
+        }
+
+        auto* iter = data + ublox::details::FieldsOffset<Members, TIdx>::Value;
+        for (std::size_t idx = 0U; idx < count; ++idx) {
+            col[idx] = details::readValue<ColumnField<TIdx> >(iter);
+            iter += BlockLength;
+        }
+    }
+
+    template <std::size_t... TIdx>
+    void reserveColumns(std::size_t count, ublox::details::IndexSeq<TIdx...>)
+    {
+        int dummy[] = {(std::get<TIdx>(m_columns).reserve(count), 0)...};
+        static_cast<void>(dummy);
+    }
+
+    Columns m_columns;
+    std::size_t m_size = 0U;
+};
+
+/// @brief Columnar decoder of the message payload ending with the list
+///     of repeated blocks.
+/// @details The fixed length fields preceding the list (header) are copied,
+///     and the blocks are decoded into @ref BlockColumns, i.e. the decoder
+///     doesn't reference the payload buffer after decode() returns.
+/// @tparam TAllFields All fields of the message bundled in std::tuple.
+///     The last one is expected to be the list of blocks.
+/// @tparam TCountIdx Index of the field containing number of blocks.
+template <typename TAllFields, std::size_t TCountIdx>
+class ListColumns
+{
+public:
+    /// @brief All the fields bundled in std::tuple.
+    typedef TAllFields AllFields;
+
+    /// @brief Index of the list field.
+    static const std::size_t ListIdx = std::tuple_size<AllFields>::value - 1;
+
+    static_assert(TCountIdx < ListIdx, "Invalid index of the count field");
+
+    /// @brief View of the fields preceding the list.
+    typedef PayloadView<details::FieldsPrefix<AllFields, ListIdx> > Header;
+
+    /// @brief Definition of the single block.
+    typedef typename details::ListElement<
+        typename std::tuple_element<ListIdx, AllFields>::type
+    >::Type Block;
+
+    /// @brief Columnar storage of the blocks.
+    typedef BlockColumns<Block> Blocks;
+
+    /// @brief Decode the payload.
+    /// @param[in] payload Pointer to the first byte of the payload.
+    /// @param[in] len Number of bytes in the payload.
+    /// @return @b comms::ErrorStatus::Success on success,
+    ///     @b comms::ErrorStatus::NotEnoughData if the payload is too short.
+    comms::ErrorStatus decode(const std::uint8_t* payload, std::size_t len)
+    {
+        m_blocks.clear();
+        m_decoded = false;
+        if (len < Header::PayloadLength) {
+            return comms::ErrorStatus::NotEnoughData;
+        }
+
+        std::copy_n(payload, Header::PayloadLength, m_header.begin());
+        auto count = static_cast<std::size_t>(field<TCountIdx>().value());
+        auto es =
+            m_blocks.decode(
+                payload + Header::PayloadLength,
+                len - Header::PayloadLength,
+                count);
+
+        m_decoded = (es == comms::ErrorStatus::Success);
+        return es;
+    }
+
+    /// @brief Check whether the last decode() operation was successful.
+    bool decoded() const
+    {
+        return m_decoded;
+    }
+
+    /// @brief Get view of the fields preceding the list.
+    Header header() const
+    {
+        Header view;
+        view.attach(m_header.data(), m_header.size());
+        return view;
+    }
+
+    /// @brief Read the value of the field preceding the list.
+    /// @tparam TIdx Index of the field in @ref AllFields.
+    template <std::size_t TIdx>
+    FieldValue<typename std::tuple_element<TIdx, AllFields>::type> field() const
+    {
+        static_assert(TIdx < ListIdx, "Invalid field index");
+        return header().template field<TIdx>();
+    }
+
+    /// @brief Get access to the decoded blocks.
+    const Blocks& blocks() const
+    {
+        return m_blocks;
+    }
+
+    /// @brief Number of decoded blocks.
+    std::size_t size() const
+    {
+        return m_blocks.size();
+    }
+
+    /// @brief Get access to the column of the blocks.
+    /// @tparam TIdx Index of the member field in the block.
+    template <std::size_t TIdx>
+    const typename Blocks::template ColumnValueType<TIdx>* column() const
+    {
+        return m_blocks.template column<TIdx>();
+    }
+
+    /// @brief Reserve space for the provided number of blocks.
+    void reserve(std::size_t count)
+    {
+        m_blocks.reserve(count);
+    }
+
+private:
+    typedef std::array<std::uint8_t, Header::PayloadLength> HeaderStorage;
+
+    HeaderStorage m_header = HeaderStorage();
+    Blocks m_blocks;
+    bool m_decoded = false;
+};
+
+}  // namespace view
+
+}  // namespace ublox
+
+
@@ -0,0 +1,198 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of the views of the payload ending with the list
+///     of repeated blocks.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <tuple>
+
+#include "comms/comms.h"
+
+#include "ublox/MsgLayout.h"
+#include "common.h"
+
+namespace ublox
+{
+
+namespace view
+{
+
+/// @brief Forward cursor over the repeated blocks.
+/// @details Attaches provided block view to every block in turn, nothing is
+///     copied or allocated. The blocks are expected to be validated against
+///     the payload length beforehand (see @ref ListView::attach()).
+/// @code
+/// auto cursor = view.blocks();
+/// while (cursor.next()) {
+///     auto svid = cursor.block().svid().value();
+/// }
+/// @endcode
+/// @tparam TBlockView View of the single block, expected to be a variant of
+///     @ref PayloadView.
+template <typename TBlockView>
+class BlockCursor
+{
+public:
+    /// @brief View of the single block.
+    typedef TBlockView BlockView;
+
+    /// @brief Serialisation length of the single block.
+    static const std::size_t BlockLength = BlockView::PayloadLength;
+
+    /// @brief Default constructor, creates cursor without any blocks.
+    BlockCursor() = default;
+
+    /// @brief Constructor
+    /// @param[in] data Pointer to the first byte of the first block.
+    /// @param[in] count Number of blocks.
+    BlockCursor(const std::uint8_t* data, std::size_t count)
+      : m_next(data),
+        m_remaining(count)
+    {
+    }
+
+    /// @brief Move to the next block.
+    /// @details Must be called before accessing the first block.
+    /// @return true if the cursor points to the valid block, false when
+    ///     there are no more blocks.
+    bool next()
+    {
+        if (m_remaining == 0U) {
+            m_block = BlockView();
+            return false;
+        }
+
+        m_block.attach(m_next, BlockLength);
+        m_next += BlockLength;
+        --m_remaining;
+        return true;
+    }
+
+    /// @brief Get view of the current block.
+    /// @pre Last call to @ref next() returned true.
+    const BlockView& block() const
+    {
+        return m_block;
+    }
+
+    /// @brief Number of blocks not visited yet.
+    std::size_t remaining() const
+    {
+        return m_remaining;
+    }
+
+private:
+    BlockView m_block;
+    const std::uint8_t* m_next = nullptr;
+    std::size_t m_remaining = 0U;
+};
+
+/// @brief Read-only view of the payload ending with the list of repeated
+///     blocks.
+/// @details Provides access to the fixed length fields preceding the list
+///     (see @ref PayloadView) and @ref BlockCursor over the blocks, which
+///     decodes a single block at a time on demand. Unlike reading of the
+///     message object, the list is not materialised, i.e. memory
+///     consumption doesn't depend on the number of blocks.
+/// @tparam TAllFields All fields of the message bundled in std::tuple.
+///     The last one is expected to be the list of blocks.
+/// @tparam TCountIdx Index of the field containing number of blocks.
+/// @tparam TBlockView View of the single block.
+template <typename TAllFields, std::size_t TCountIdx, typename TBlockView>
+class ListView : public PayloadView<details::FieldsPrefix<TAllFields, std::tuple_size<TAllFields>::value - 1> >
+{
+    typedef PayloadView<details::FieldsPrefix<TAllFields, std::tuple_size<TAllFields>::value - 1> > Base;
+
+public:
+    /// @brief Index of the list field.
+    static const std::size_t ListIdx = std::tuple_size<TAllFields>::value - 1;
+
+    /// @brief Length of the fields preceding the list.
+    static const std::size_t HeaderLength = Base::PayloadLength;
+
+    /// @brief Cursor over the blocks.
+    typedef BlockCursor<TBlockView> Cursor;
+
+    /// @brief Serialisation length of the single block.
+    static const std::size_t BlockLength = Cursor::BlockLength;
+
+    static_assert(TCountIdx < ListIdx, "Invalid index of the count field");
+
+    static_assert(
+        ublox::details::ListElemLength<
+            typename std::tuple_element<ListIdx, TAllFields>::type
+        >::Value == BlockLength,
+        "The block view doesn't match the element of the list");
+
+    /// @brief Attach the view to the payload.
+    /// @details Checks that the payload contains the number of blocks
+    ///     reported by the relevant field, the extra bytes are ignored.
+    /// @param[in] payload Pointer to the first byte of the payload.
+    /// @param[in] len Number of bytes in the payload.
+    /// @return @b comms::ErrorStatus::Success if the payload is long enough,
+    ///     @b comms::ErrorStatus::NotEnoughData otherwise, in which case
+    ///     the view becomes detached.
+    comms::ErrorStatus attach(const std::uint8_t* payload, std::size_t len)
+    {
+        m_count = 0U;
+        auto es = Base::attach(payload, len);
+        if (es != comms::ErrorStatus::Success) {
+            return es;
+        }
+
+        auto count =
+            static_cast<std::size_t>(Base::template field<TCountIdx>().value());
+        if (((len - HeaderLength) / BlockLength) < count) {
+            Base::attach(payload, 0U); // detach
+            return comms::ErrorStatus::NotEnoughData;
+        }
+
+        m_count = count;
+        return comms::ErrorStatus::Success;
+    }
+
+    /// @brief Number of blocks.
+    std::size_t count() const
+    {
+        return m_count;
+    }
+
+    /// @brief Get cursor over the blocks.
+    /// @details Multiple independent cursors may be used at the same time.
+    Cursor blocks() const
+    {
+        if (!Base::attached()) {
+            return Cursor();
+        }
+
+        return Cursor(Base::payload() + HeaderLength, m_count);
+    }
+
+private:
+    std::size_t m_count = 0U;
+};
+
+}  // namespace view
+
+}  // namespace ublox
+
+
@@ -0,0 +1,83 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of the view of NAV-CLOCK message payload.
+
+#pragma once
+
+#include "ublox/message/NavClock.h"
+#include "common.h"
+
+namespace ublox
+{
+
+namespace view
+{
+
+/// @brief Read-only view of NAV-CLOCK message payload.
+/// @details Provides access to the fields of @ref ublox::message::NavClock
+///     message directly in the payload buffer, without creating the message
+///     object. See @ref PayloadView for details.
+/// @code
+/// ublox::view::NavClockView view;
+/// if (view.attach(payload, payloadLen) == comms::ErrorStatus::Success) {
+///     auto iTOW = view.iTOW().value();
+/// }
+/// @endcode
+class NavClockView : public PayloadView<message::NavClockFields::All>
+{
+    typedef PayloadView<message::NavClockFields::All> Base;
+    typedef message::NavClock<> Msg;
+
+public:
+    /// @brief Value of @b iTOW field, see @ref message::NavClockFields::iTOW
+    FieldValue<message::NavClockFields::iTOW> iTOW() const
+    {
+        return Base::field<Msg::FieldIdx_iTOW>();
+    }
+
+    /// @brief Value of @b clkB field, see @ref message::NavClockFields::clkB
+    FieldValue<message::NavClockFields::clkB> clkB() const
+    {
+        return Base::field<Msg::FieldIdx_clkB>();
+    }
+
+    /// @brief Value of @b clkD field, see @ref message::NavClockFields::clkD
+    FieldValue<message::NavClockFields::clkD> clkD() const
+    {
+        return Base::field<Msg::FieldIdx_clkD>();
+    }
+
+    /// @brief Value of @b tAcc field, see @ref message::NavClockFields::tAcc
+    FieldValue<message::NavClockFields::tAcc> tAcc() const
+    {
+        return Base::field<Msg::FieldIdx_tAcc>();
+    }
+
+    /// @brief Value of @b fAcc field, see @ref message::NavClockFields::fAcc
+    FieldValue<message::NavClockFields::fAcc> fAcc() const
+    {
+        return Base::field<Msg::FieldIdx_fAcc>();
+    }
+};
+
+}  // namespace view
+
+}  // namespace ublox
+
+
@@ -0,0 +1,101 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of the view of NAV-DOP message payload.
+
+#pragma once
+
+#include "ublox/message/NavDop.h"
+#include "common.h"
+
+namespace ublox
+{
+
+namespace view
+{
+
+/// @brief Read-only view of NAV-DOP message payload.
+/// @details Provides access to the fields of @ref ublox::message::NavDop
+///     message directly in the payload buffer, without creating the message
+///     object. See @ref PayloadView for details.
+/// @code
+/// ublox::view::NavDopView view;
+/// if (view.attach(payload, payloadLen) == comms::ErrorStatus::Success) {
+///     auto iTOW = view.iTOW().value();
+/// }
+/// @endcode
+class NavDopView : public PayloadView<message::NavDopFields::All>
+{
+    typedef PayloadView<message::NavDopFields::All> Base;
+    typedef message::NavDop<> Msg;
+
+public:
+    /// @brief Value of @b iTOW field, see @ref message::NavDopFields::iTOW
+    FieldValue<message::NavDopFields::iTOW> iTOW() const
+    {
+        return Base::field<Msg::FieldIdx_iTOW>();
+    }
+
+    /// @brief Value of @b gDOP field, see @ref message::NavDopFields::gDOP
+    FieldValue<message::NavDopFields::gDOP> gDOP() const
+    {
+        return Base::field<Msg::FieldIdx_gDOP>();
+    }
+
+    /// @brief Value of @b pDOP field, see @ref message::NavDopFields::pDOP
+    FieldValue<message::NavDopFields::pDOP> pDOP() const
+    {
+        return Base::field<Msg::FieldIdx_pDOP>();
+    }
+
+    /// @brief Value of @b tDOP field, see @ref message::NavDopFields::tDOP
+    FieldValue<message::NavDopFields::tDOP> tDOP() const
+    {
+        return Base::field<Msg::FieldIdx_tDOP>();
+    }
+
+    /// @brief Value of @b vDOP field, see @ref message::NavDopFields::vDOP
+    FieldValue<message::NavDopFields::vDOP> vDOP() const
+    {
+        return Base::field<Msg::FieldIdx_vDOP>();
+    }
+
+    /// @brief Value of @b hDOP field, see @ref message::NavDopFields::hDOP
+    FieldValue<message::NavDopFields::hDOP> hDOP() const
+    {
+        return Base::field<Msg::FieldIdx_hDOP>();
+    }
+
+    /// @brief Value of @b nDOP field, see @ref message::NavDopFields::nDOP
+    FieldValue<message::NavDopFields::nDOP> nDOP() const
+    {
+        return Base::field<Msg::FieldIdx_nDOP>();
+    }
+
+    /// @brief Value of @b eDOP field, see @ref message::NavDopFields::eDOP
+    FieldValue<message::NavDopFields::eDOP> eDOP() const
+    {
+        return Base::field<Msg::FieldIdx_eDOP>();
+    }
+};
+
+}  // namespace view
+
+}  // namespace ublox
+
+
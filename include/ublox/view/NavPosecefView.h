@@ -0,0 +1,83 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of the view of NAV-POSECEF message payload.
+
+#pragma once
+
+#include "ublox/message/NavPosecef.h"
+#include "common.h"
+
+namespace ublox
+{
+
+namespace view
+{
+
+/// @brief Read-only view of NAV-POSECEF message payload.
+/// @details Provides access to the fields of @ref ublox::message::NavPosecef
+///     message directly in the payload buffer, without creating the message
+///     object. See @ref PayloadView for details.
+/// @code
+/// ublox::view::NavPosecefView view;
+/// if (view.attach(payload, payloadLen) == comms::ErrorStatus::Success) {
+///     auto iTOW = view.iTOW().value();
+/// }
+/// @endcode
+class NavPosecefView : public PayloadView<message::NavPosecefFields::All>
+{
+    typedef PayloadView<message::NavPosecefFields::All> Base;
+    typedef message::NavPosecef<> Msg;
+
+public:
+    /// @brief Value of @b iTOW field, see @ref message::NavPosecefFields::iTOW
+    FieldValue<message::NavPosecefFields::iTOW> iTOW() const
+    {
+        return Base::field<Msg::FieldIdx_iTow>();
+    }
+
+    /// @brief Value of @b ecefX field, see @ref message::NavPosecefFields::ecefX
+    FieldValue<message::NavPosecefFields::ecefX> ecefX() const
+    {
+        return Base::field<Msg::FieldIdx_ecefX>();
+    }
+
+    /// @brief Value of @b ecefY field, see @ref message::NavPosecefFields::ecefY
+    FieldValue<message::NavPosecefFields::ecefY> ecefY() const
+    {
+        return Base::field<Msg::FieldIdx_ecefY>();
+    }
+
+    /// @brief Value of @b ecefZ field, see @ref message::NavPosecefFields::ecefZ
+    FieldValue<message::NavPosecefFields::ecefZ> ecefZ() const
+    {
+        return Base::field<Msg::FieldIdx_ecefZ>();
+    }
+
+    /// @brief Value of @b pAcc field, see @ref message::NavPosecefFields::pAcc
+    FieldValue<message::NavPosecefFields::pAcc> pAcc() const
+    {
+        return Base::field<Msg::FieldIdx_pAcc>();
+    }
+};
+
+}  // namespace view
+
+}  // namespace ublox
+
+
@@ -0,0 +1,95 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of the view of NAV-POSLLH message payload.
+
+#pragma once
+
+#include "ublox/message/NavPosllh.h"
+#include "common.h"
+
+namespace ublox
+{
+
+namespace view
+{
+
+/// @brief Read-only view of NAV-POSLLH message payload.
+/// @details Provides access to the fields of @ref ublox::message::NavPosllh
+///     message directly in the payload buffer, without creating the message
+///     object. See @ref PayloadView for details.
+/// @code
+/// ublox::view::NavPosllhView view;
+/// if (view.attach(payload, payloadLen) == comms::ErrorStatus::Success) {
+///     auto iTOW = view.iTOW().value();
+/// }
+/// @endcode
+class NavPosllhView : public PayloadView<message::NavPosllhFields::All>
+{
+    typedef PayloadView<message::NavPosllhFields::All> Base;
+    typedef message::NavPosllh<> Msg;
+
+public:
+    /// @brief Value of @b iTOW field, see @ref message::NavPosllhFields::iTOW
+    FieldValue<message::NavPosllhFields::iTOW> iTOW() const
+    {
+        return Base::field<Msg::FieldIdx_iTOW>();
+    }
+
+    /// @brief Value of @b lon field, see @ref message::NavPosllhFields::lon
+    FieldValue<message::NavPosllhFields::lon> lon() const
+    {
+        return Base::field<Msg::FieldIdx_lon>();
+    }
+
+    /// @brief Value of @b lat field, see @ref message::NavPosllhFields::lat
+    FieldValue<message::NavPosllhFields::lat> lat() const
+    {
+        return Base::field<Msg::FieldIdx_lat>();
+    }
+
+    /// @brief Value of @b height field, see @ref message::NavPosllhFields::height
+    FieldValue<message::NavPosllhFields::height> height() const
+    {
+        return Base::field<Msg::FieldIdx_height>();
+    }
+
+    /// @brief Value of @b hMSL field, see @ref message::NavPosllhFields::hMSL
+    FieldValue<message::NavPosllhFields::hMSL> hMSL() const
+    {
+        return Base::field<Msg::FieldIdx_hMSL>();
+    }
+
+    /// @brief Value of @b hAcc field, see @ref message::NavPosllhFields::hAcc
+    FieldValue<message::NavPosllhFields::hAcc> hAcc() const
+    {
+        return Base::field<Msg::FieldIdx_hAcc>();
+    }
+
+    /// @brief Value of @b vAcc field, see @ref message::NavPosllhFields::vAcc
+    FieldValue<message::NavPosllhFields::vAcc> vAcc() const
+    {
+        return Base::field<Msg::FieldIdx_vAcc>();
+    }
+};
+
+}  // namespace view
+
+}  // namespace ublox
+
+
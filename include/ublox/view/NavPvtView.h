@@ -0,0 +1,215 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of the view of NAV-PVT message payload.
+
+#pragma once
+
+#include "ublox/message/NavPvt.h"
+#include "common.h"
+
+namespace ublox
+{
+
+namespace view
+{
+
+/// @brief Read-only view of NAV-PVT message payload.
+/// @details Provides access to the fields of @ref ublox::message::NavPvt
+///     message directly in the payload buffer, without creating the message
+///     object. See @ref PayloadView for details.
+/// @code
+/// ublox::view::NavPvtView view;
+/// if (view.attach(payload, payloadLen) == comms::ErrorStatus::Success) {
+///     auto iTOW = view.iTOW().value();
+/// }
+/// @endcode
+class NavPvtView : public PayloadView<message::NavPvtFields::All>
+{
+    typedef PayloadView<message::NavPvtFields::All> Base;
+    typedef message::NavPvt<> Msg;
+
+public:
+    /// @brief Value of @b iTOW field, see @ref message::NavPvtFields::iTOW
+    FieldValue<message::NavPvtFields::iTOW> iTOW() const
+    {
+        return Base::field<Msg::FieldIdx_iTOW>();
+    }
+
+    /// @brief Value of @b year field, see @ref message::NavPvtFields::year
+    FieldValue<message::NavPvtFields::year> year() const
+    {
+        return Base::field<Msg::FieldIdx_year>();
+    }
+
+    /// @brief Value of @b month field, see @ref message::NavPvtFields::month
+    FieldValue<message::NavPvtFields::month> month() const
+    {
+        return Base::field<Msg::FieldIdx_month>();
+    }
+
+    /// @brief Value of @b day field, see @ref message::NavPvtFields::day
+    FieldValue<message::NavPvtFields::day> day() const
+    {
+        return Base::field<Msg::FieldIdx_day>();
+    }
+
+    /// @brief Value of @b hour field, see @ref message::NavPvtFields::hour
+    FieldValue<message::NavPvtFields::hour> hour() const
+    {
+        return Base::field<Msg::FieldIdx_hour>();
+    }
+
+    /// @brief Value of @b min field, see @ref message::NavPvtFields::min
+    FieldValue<message::NavPvtFields::min> min() const
+    {
+        return Base::field<Msg::FieldIdx_min>();
+    }
+
+    /// @brief Value of @b sec field, see @ref message::NavPvtFields::sec
+    FieldValue<message::NavPvtFields::sec> sec() const
+    {
+        return Base::field<Msg::FieldIdx_sec>();
+    }
+
+    /// @brief Value of @b valid field, see @ref message::NavPvtFields::valid
+    FieldValue<message::NavPvtFields::valid> valid() const
+    {
+        return Base::field<Msg::FieldIdx_valid>();
+    }
+
+    /// @brief Value of @b tAcc field, see @ref message::NavPvtFields::tAcc
+    FieldValue<message::NavPvtFields::tAcc> tAcc() const
+    {
+        return Base::field<Msg::FieldIdx_tAcc>();
+    }
+
+    /// @brief Value of @b nano field, see @ref message::NavPvtFields::nano
+    FieldValue<message::NavPvtFields::nano> nano() const
+    {
+        return Base::field<Msg::FieldIdx_nano>();
+    }
+
+    /// @brief Value of @b fixType field, see @ref message::NavPvtFields::fixType
+    FieldValue<message::NavPvtFields::fixType> fixType() const
+    {
+        return Base::field<Msg::FieldIdx_fixType>();
+    }
+
+    /// @brief Value of @b flags field, see @ref message::NavPvtFields::flags
+    FieldValue<message::NavPvtFields::flags> flags() const
+    {
+        return Base::field<Msg::FieldIdx_flags>();
+    }
+
+    /// @brief Value of @b numSV field, see @ref message::NavPvtFields::numSV
+    FieldValue<message::NavPvtFields::numSV> numSV() const
+    {
+        return Base::field<Msg::FieldIdx_numSV>();
+    }
+
+    /// @brief Value of @b lon field, see @ref message::NavPvtFields::lon
+    FieldValue<message::NavPvtFields::lon> lon() const
+    {
+        return Base::field<Msg::FieldIdx_lon>();
+    }
+
+    /// @brief Value of @b lat field, see @ref message::NavPvtFields::lat
+    FieldValue<message::NavPvtFields::lat> lat() const
+    {
+        return Base::field<Msg::FieldIdx_lat>();
+    }
+
+    /// @brief Value of @b height field, see @ref message::NavPvtFields::height
+    FieldValue<message::NavPvtFields::height> height() const
+    {
+        return Base::field<Msg::FieldIdx_height>();
+    }
+
+    /// @brief Value of @b hMSL field, see @ref message::NavPvtFields::hMSL
+    FieldValue<message::NavPvtFields::hMSL> hMSL() const
+    {
+        return Base::field<Msg::FieldIdx_hMSL>();
+    }
+
+    /// @brief Value of @b hAcc field, see @ref message::NavPvtFields::hAcc
+    FieldValue<message::NavPvtFields::hAcc> hAcc() const
+    {
+        return Base::field<Msg::FieldIdx_hAcc>();
+    }
+
+    /// @brief Value of @b vAcc field, see @ref message::NavPvtFields::vAcc
+    FieldValue<message::NavPvtFields::vAcc> vAcc() const
+    {
+        return Base::field<Msg::FieldIdx_vAcc>();
+    }
+
+    /// @brief Value of @b velN field, see @ref message::NavPvtFields::velN
+    FieldValue<message::NavPvtFields::velN> velN() const
+    {
+        return Base::field<Msg::FieldIdx_velN>();
+    }
+
+    /// @brief Value of @b velE field, see @ref message::NavPvtFields::velE
+    FieldValue<message::NavPvtFields::velE> velE() const
+    {
+        return Base::field<Msg::FieldIdx_velE>();
+    }
+
+    /// @brief Value of @b velD field, see @ref message::NavPvtFields::velD
+    FieldValue<message::NavPvtFields::velD> velD() const
+    {
+        return Base::field<Msg::FieldIdx_velD>();
+    }
+
+    /// @brief Value of @b gSpeed field, see @ref message::NavPvtFields::gSpeed
+    FieldValue<message::NavPvtFields::gSpeed> gSpeed() const
+    {
+        return Base::field<Msg::FieldIdx_gSpeed>();
+    }
+
+    /// @brief Value of @b heading field, see @ref message::NavPvtFields::heading
+    FieldValue<message::NavPvtFields::heading> heading() const
+    {
+        return Base::field<Msg::FieldIdx_heading>();
+    }
+
+    /// @brief Value of @b sAcc field, see @ref message::NavPvtFields::sAcc
+    FieldValue<message::NavPvtFields::sAcc> sAcc() const
+    {
+        return Base::field<Msg::FieldIdx_sAcc>();
+    }
+
+    /// @brief Value of @b headingAcc field, see @ref message::NavPvtFields::headingAcc
+    FieldValue<message::NavPvtFields::headingAcc> headingAcc() const
+    {
+        return Base::field<Msg::FieldIdx_headingAcc>();
+    }
+
+    /// @brief Value of @b pDOP field, see @ref message::NavPvtFields::pDOP
+    FieldValue<message::NavPvtFields::pDOP> pDOP() const
+    {
+        return Base::field<Msg::FieldIdx_pDOP>();
+    }
+};
+
+}  // namespace view
+
+}  // namespace ublox
+
+
@@ -0,0 +1,131 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of the columnar decoder of NAV-SVINFO message payload.
+
+#pragma once
+
+#include "ublox/message/NavSvinfo.h"
+#include "ListColumns.h"
+
+namespace ublox
+{
+
+namespace view
+{
+
+/// @brief Columnar decoder of NAV-SVINFO message payload.
+/// @details Decodes the repeated blocks of @ref ublox::message::NavSvinfo
+///     message into contiguous per field arrays, without creating the message
+///     object. See @ref ListColumns for details.
+/// @code
+/// ublox::view::NavSvinfoColumns cols;
+/// if (cols.decode(payload, payloadLen) == comms::ErrorStatus::Success) {
+///     auto* chn = cols.chn();
+///     for (std::size_t idx = 0U; idx < cols.size(); ++idx) {
+///         ... // use chn[idx]
+///     }
+/// }
+/// @endcode
+class NavSvinfoColumns : public ListColumns<message::NavSvinfoFields::All, message::NavSvinfo<>::FieldIdx_numCh>
+{
+    typedef ListColumns<message::NavSvinfoFields::All, message::NavSvinfo<>::FieldIdx_numCh> Base;
+    typedef message::NavSvinfo<> Msg;
+    typedef message::NavSvinfoFields Fields;
+
+public:
+    /// @brief Value of @b iTOW field, see @ref message::NavSvinfoFields::iTOW
+    FieldValue<Fields::iTOW> iTOW() const
+    {
+        return Base::field<Msg::FieldIdx_iTOW>();
+    }
+
+    /// @brief Value of @b numCh field, see @ref message::NavSvinfoFields::numCh
+    FieldValue<Fields::numCh> numCh() const
+    {
+        return Base::field<Msg::FieldIdx_numCh>();
+    }
+
+    /// @brief Value of @b globalFlags field, see @ref message::NavSvinfoFields::globalFlags
+    FieldValue<Fields::globalFlags> globalFlags() const
+    {
+        return Base::field<Msg::FieldIdx_globalFlags>();
+    }
+
+    /// @brief Values of @b chn member of all the blocks, see
+    ///     @ref message::NavSvinfoFields::chn
+    const Blocks::ColumnValueType<0>* chn() const
+    {
+        return Base::column<0>();
+    }
+
+    /// @brief Values of @b svid member of all the blocks, see
+    ///     @ref message::NavSvinfoFields::svid
+    const Blocks::ColumnValueType<1>* svid() const
+    {
+        return Base::column<1>();
+    }
+
+    /// @brief Values of @b flags member of all the blocks, see
+    ///     @ref message::NavSvinfoFields::flags
+    const Blocks::ColumnValueType<2>* flags() const
+    {
+        return Base::column<2>();
+    }
+
+    /// @brief Values of @b quality member of all the blocks, see
+    ///     @ref message::NavSvinfoFields::quality
+    const Blocks::ColumnValueType<3>* quality() const
+    {
+        return Base::column<3>();
+    }
+
+    /// @brief Values of @b cno member of all the blocks, see
+    ///     @ref message::NavSvinfoFields::cno
+    const Blocks::ColumnValueType<4>* cno() const
+    {
+        return Base::column<4>();
+    }
+
+    /// @brief Values of @b elev member of all the blocks, see
+    ///     @ref message::NavSvinfoFields::elev
+    const Blocks::ColumnValueType<5>* elev() const
+    {
+        return Base::column<5>();
+    }
+
+    /// @brief Values of @b azim member of all the blocks, see
+    ///     @ref message::NavSvinfoFields::azim
+    const Blocks::ColumnValueType<6>* azim() const
+    {
+        return Base::column<6>();
+    }
+
+    /// @brief Values of @b prRes member of all the blocks, see
+    ///     @ref message::NavSvinfoFields::prRes
+    const Blocks::ColumnValueType<7>* prRes() const
+    {
+        return Base::column<7>();
+    }
+};
+
+}  // namespace view
+
+}  // namespace ublox
+
+
@@ -0,0 +1,133 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of the view of NAV-SVINFO message payload.
+
+#pragma once
+
+#include "ublox/message/NavSvinfo.h"
+#include "ListView.h"
+
+namespace ublox
+{
+
+namespace view
+{
+
+/// @brief Read-only view of the single block of NAV-SVINFO message, see
+///     @ref message::NavSvinfoFields::block.
+class NavSvinfoBlockView : public PayloadView<details::BundleMembers<message::NavSvinfoFields::block>::Type>
+{
+    typedef PayloadView<details::BundleMembers<message::NavSvinfoFields::block>::Type> Base;
+    typedef message::NavSvinfoFields Fields;
+
+public:
+    /// @brief Value of @b chn member, see @ref message::NavSvinfoFields::chn
+    FieldValue<Fields::chn> chn() const
+    {
+        return Base::field<0>();
+    }
+
+    /// @brief Value of @b svid member, see @ref message::NavSvinfoFields::svid
+    FieldValue<Fields::svid> svid() const
+    {
+        return Base::field<1>();
+    }
+
+    /// @brief Value of @b flags member, see @ref message::NavSvinfoFields::flags
+    FieldValue<Fields::flags> flags() const
+    {
+        return Base::field<2>();
+    }
+
+    /// @brief Value of @b quality member, see @ref message::NavSvinfoFields::quality
+    FieldValue<Fields::quality> quality() const
+    {
+        return Base::field<3>();
+    }
+
+    /// @brief Value of @b cno member, see @ref message::NavSvinfoFields::cno
+    FieldValue<Fields::cno> cno() const
+    {
+        return Base::field<4>();
+    }
+
+    /// @brief Value of @b elev member, see @ref message::NavSvinfoFields::elev
+    FieldValue<Fields::elev> elev() const
+    {
+        return Base::field<5>();
+    }
+
+    /// @brief Value of @b azim member, see @ref message::NavSvinfoFields::azim
+    FieldValue<Fields::azim> azim() const
+    {
+        return Base::field<6>();
+    }
+
+    /// @brief Value of @b prRes member, see @ref message::NavSvinfoFields::prRes
+    FieldValue<Fields::prRes> prRes() const
+    {
+        return Base::field<7>();
+    }
+};
+
+/// @brief Read-only view of NAV-SVINFO message payload.
+/// @details Provides access to the fields of @ref ublox::message::NavSvinfo
+///     message directly in the payload buffer, without creating the message
+///     object. The blocks are accessed one at a time using the cursor.
+///     See @ref ListView for details.
+/// @code
+/// ublox::view::NavSvinfoView view;
+/// if (view.attach(payload, payloadLen) == comms::ErrorStatus::Success) {
+///     auto cursor = view.blocks();
+///     while (cursor.next()) {
+///         auto svid = cursor.block().svid().value();
+///     }
+/// }
+/// @endcode
+class NavSvinfoView : public ListView<message::NavSvinfoFields::All, message::NavSvinfo<>::FieldIdx_numCh, NavSvinfoBlockView>
+{
+    typedef ListView<message::NavSvinfoFields::All, message::NavSvinfo<>::FieldIdx_numCh, NavSvinfoBlockView> Base;
+    typedef message::NavSvinfo<> Msg;
+    typedef message::NavSvinfoFields Fields;
+
+public:
+    /// @brief Value of @b iTOW field, see @ref message::NavSvinfoFields::iTOW
+    FieldValue<Fields::iTOW> iTOW() const
+    {
+        return Base::field<Msg::FieldIdx_iTOW>();
+    }
+
+    /// @brief Value of @b numCh field, see @ref message::NavSvinfoFields::numCh
+    FieldValue<Fields::numCh> numCh() const
+    {
+        return Base::field<Msg::FieldIdx_numCh>();
+    }
+
+    /// @brief Value of @b globalFlags field, see @ref message::NavSvinfoFields::globalFlags
+    FieldValue<Fields::globalFlags> globalFlags() const
+    {
+        return Base::field<Msg::FieldIdx_globalFlags>();
+    }
+};
+
+}  // namespace view
+
+}  // namespace ublox
+
+
@@ -0,0 +1,89 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of the view of NAV-TIMEGPS message payload.
+
+#pragma once
+
+#include "ublox/message/NavTimegps.h"
+#include "common.h"
+
+namespace ublox
+{
+
+namespace view
+{
+
+/// @brief Read-only view of NAV-TIMEGPS message payload.
+/// @details Provides access to the fields of @ref ublox::message::NavTimegps
+///     message directly in the payload buffer, without creating the message
+///     object. See @ref PayloadView for details.
+/// @code
+/// ublox::view::NavTimegpsView view;
+/// if (view.attach(payload, payloadLen) == comms::ErrorStatus::Success) {
+///     auto iTOW = view.iTOW().value();
+/// }
+/// @endcode
+class NavTimegpsView : public PayloadView<message::NavTimegpsFields::All>
+{
+    typedef PayloadView<message::NavTimegpsFields::All> Base;
+    typedef message::NavTimegps<> Msg;
+
+public:
+    /// @brief Value of @b iTOW field, see @ref message::NavTimegpsFields::iTOW
+    FieldValue<message::NavTimegpsFields::iTOW> iTOW() const
+    {
+        return Base::field<Msg::FieldIdx_iTOW>();
+    }
+
+    /// @brief Value of @b fTOW field, see @ref message::NavTimegpsFields::fTOW
+    FieldValue<message::NavTimegpsFields::fTOW> fTOW() const
+    {
+        return Base::field<Msg::FieldIdx_fTOW>();
+    }
+
+    /// @brief Value of @b week field, see @ref message::NavTimegpsFields::week
+    FieldValue<message::NavTimegpsFields::week> week() const
+    {
+        return Base::field<Msg::FieldIdx_week>();
+    }
+
+    /// @brief Value of @b leapS field, see @ref message::NavTimegpsFields::leapS
+    FieldValue<message::NavTimegpsFields::leapS> leapS() const
+    {
+        return Base::field<Msg::FieldIdx_leapS>();
+    }
+
+    /// @brief Value of @b valid field, see @ref message::NavTimegpsFields::valid
+    FieldValue<message::NavTimegpsFields::valid> valid() const
+    {
+        return Base::field<Msg::FieldIdx_valid>();
+    }
+
+    /// @brief Value of @b tAcc field, see @ref message::NavTimegpsFields::tAcc
+    FieldValue<message::NavTimegpsFields::tAcc> tAcc() const
+    {
+        return Base::field<Msg::FieldIdx_tAcc>();
+    }
+};
+
+}  // namespace view
+
+}  // namespace ublox
+
+
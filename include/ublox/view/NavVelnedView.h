@@ -0,0 +1,107 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of the view of NAV-VELNED message payload.
+
+#pragma once
+
+#include "ublox/message/NavVelned.h"
+#include "common.h"
+
+namespace ublox
+{
+
+namespace view
+{
+
+/// @brief Read-only view of NAV-VELNED message payload.
+/// @details Provides access to the fields of @ref ublox::message::NavVelned
+///     message directly in the payload buffer, without creating the message
+///     object. See @ref PayloadView for details.
+/// @code
+/// ublox::view::NavVelnedView view;
+/// if (view.attach(payload, payloadLen) == comms::ErrorStatus::Success) {
+///     auto iTOW = view.iTOW().value();
+/// }
+/// @endcode
+class NavVelnedView : public PayloadView<message::NavVelnedFields::All>
+{
+    typedef PayloadView<message::NavVelnedFields::All> Base;
+    typedef message::NavVelned<> Msg;
+
+public:
+    /// @brief Value of @b iTOW field, see @ref message::NavVelnedFields::iTOW
+    FieldValue<message::NavVelnedFields::iTOW> iTOW() const
+    {
+        return Base::field<Msg::FieldIdx_iTOW>();
+    }
+
+    /// @brief Value of @b velN field, see @ref message::NavVelnedFields::velN
+    FieldValue<message::NavVelnedFields::velN> velN() const
+    {
+        return Base::field<Msg::FieldIdx_velN>();
+    }
+
+    /// @brief Value of @b velE field, see @ref message::NavVelnedFields::velE
+    FieldValue<message::NavVelnedFields::velE> velE() const
+    {
+        return Base::field<Msg::FieldIdx_velE>();
+    }
+
+    /// @brief Value of @b velD field, see @ref message::NavVelnedFields::velD
+    FieldValue<message::NavVelnedFields::velD> velD() const
+    {
+        return Base::field<Msg::FieldIdx_velD>();
+    }
+
+    /// @brief Value of @b speed field, see @ref message::NavVelnedFields::speed
+    FieldValue<message::NavVelnedFields::speed> speed() const
+    {
+        return Base::field<Msg::FieldIdx_speed>();
+    }
+
+    /// @brief Value of @b gSpeed field, see @ref message::NavVelnedFields::gSpeed
+    FieldValue<message::NavVelnedFields::gSpeed> gSpeed() const
+    {
+        return Base::field<Msg::FieldIdx_gSpeed>();
+    }
+
+    /// @brief Value of @b heading field, see @ref message::NavVelnedFields::heading
+    FieldValue<message::NavVelnedFields::heading> heading() const
+    {
+        return Base::field<Msg::FieldIdx_heading>();
+    }
+
+    /// @brief Value of @b sAcc field, see @ref message::NavVelnedFields::sAcc
+    FieldValue<message::NavVelnedFields::sAcc> sAcc() const
+    {
+        return Base::field<Msg::FieldIdx_sAcc>();
+    }
+
+    /// @brief Value of @b cAcc field, see @ref message::NavVelnedFields::cAcc
+    FieldValue<message::NavVelnedFields::cAcc> cAcc() const
+    {
+        return Base::field<Msg::FieldIdx_cAcc>();
+    }
+};
+
+}  // namespace view
+
+}  // namespace ublox
+
+
@@ -0,0 +1,124 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of the columnar decoder of RXM-RAW message payload.
+
+#pragma once
+
+#include "ublox/message/RxmRaw.h"
+#include "ListColumns.h"
+
+namespace ublox
+{
+
+namespace view
+{
+
+/// @brief Columnar decoder of RXM-RAW message payload.
+/// @details Decodes the repeated blocks of @ref ublox::message::RxmRaw
+///     message into contiguous per field arrays, without creating the message
+///     object. See @ref ListColumns for details.
+/// @code
+/// ublox::view::RxmRawColumns cols;
+/// if (cols.decode(payload, payloadLen) == comms::ErrorStatus::Success) {
+///     auto* cpMes = cols.cpMes();
+///     for (std::size_t idx = 0U; idx < cols.size(); ++idx) {
+///         ... // use cpMes[idx]
+///     }
+/// }
+/// @endcode
+class RxmRawColumns : public ListColumns<message::RxmRawFields::All, message::RxmRaw<>::FieldIdx_numSV>
+{
+    typedef ListColumns<message::RxmRawFields::All, message::RxmRaw<>::FieldIdx_numSV> Base;
+    typedef message::RxmRaw<> Msg;
+    typedef message::RxmRawFields Fields;
+
+public:
+    /// @brief Value of @b rcvTow field, see @ref message::RxmRawFields::rcvTow
+    FieldValue<Fields::rcvTow> rcvTow() const
+    {
+        return Base::field<Msg::FieldIdx_rcvTow>();
+    }
+
+    /// @brief Value of @b week field, see @ref message::RxmRawFields::week
+    FieldValue<Fields::week> week() const
+    {
+        return Base::field<Msg::FieldIdx_week>();
+    }
+
+    /// @brief Value of @b numSV field, see @ref message::RxmRawFields::numSV
+    FieldValue<Fields::numSV> numSV() const
+    {
+        return Base::field<Msg::FieldIdx_numSV>();
+    }
+
+    /// @brief Values of @b cpMes member of all the blocks, see
+    ///     @ref message::RxmRawFields::cpMes
+    const Blocks::ColumnValueType<0>* cpMes() const
+    {
+        return Base::column<0>();
+    }
+
+    /// @brief Values of @b prMes member of all the blocks, see
+    ///     @ref message::RxmRawFields::prMes
+    const Blocks::ColumnValueType<1>* prMes() const
+    {
+        return Base::column<1>();
+    }
+
+    /// @brief Values of @b doMes member of all the blocks, see
+    ///     @ref message::RxmRawFields::doMes
+    const Blocks::ColumnValueType<2>* doMes() const
+    {
+        return Base::column<2>();
+    }
+
+    /// @brief Values of @b sv member of all the blocks, see
+    ///     @ref message::RxmRawFields::sv
+    const Blocks::ColumnValueType<3>* sv() const
+    {
+        return Base::column<3>();
+    }
+
+    /// @brief Values of @b mesQI member of all the blocks, see
+    ///     @ref message::RxmRawFields::mesQI
+    const Blocks::ColumnValueType<4>* mesQI() const
+    {
+        return Base::column<4>();
+    }
+
+    /// @brief Values of @b cno member of all the blocks, see
+    ///     @ref message::RxmRawFields::cno
+    const Blocks::ColumnValueType<5>* cno() const
+    {
+        return Base::column<5>();
+    }
+
+    /// @brief Values of @b lli member of all the blocks, see
+    ///     @ref message::RxmRawFields::lli
+    const Blocks::ColumnValueType<6>* lli() const
+    {
+        return Base::column<6>();
+    }
+};
+
+}  // namespace view
+
+}  // namespace ublox
+
+
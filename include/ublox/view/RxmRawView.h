@@ -0,0 +1,127 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of the view of RXM-RAW message payload.
+
+#pragma once
+
+#include "ublox/message/RxmRaw.h"
+#include "ListView.h"
+
+namespace ublox
+{
+
+namespace view
+{
+
+/// @brief Read-only view of the single block of RXM-RAW message, see
+///     @ref message::RxmRawFields::block.
+class RxmRawBlockView : public PayloadView<details::BundleMembers<message::RxmRawFields::block>::Type>
+{
+    typedef PayloadView<details::BundleMembers<message::RxmRawFields::block>::Type> Base;
+    typedef message::RxmRawFields Fields;
+
+public:
+    /// @brief Value of @b cpMes member, see @ref message::RxmRawFields::cpMes
+    FieldValue<Fields::cpMes> cpMes() const
+    {
+        return Base::field<0>();
+    }
+
+    /// @brief Value of @b prMes member, see @ref message::RxmRawFields::prMes
+    FieldValue<Fields::prMes> prMes() const
+    {
+        return Base::field<1>();
+    }
+
+    /// @brief Value of @b doMes member, see @ref message::RxmRawFields::doMes
+    FieldValue<Fields::doMes> doMes() const
+    {
+        return Base::field<2>();
+    }
+
+    /// @brief Value of @b sv member, see @ref message::RxmRawFields::sv
+    FieldValue<Fields::sv> sv() const
+    {
+        return Base::field<3>();
+    }
+
+    /// @brief Value of @b mesQI member, see @ref message::RxmRawFields::mesQI
+    FieldValue<Fields::mesQI> mesQI() const
+    {
+        return Base::field<4>();
+    }
+
+    /// @brief Value of @b cno member, see @ref message::RxmRawFields::cno
+    FieldValue<Fields::cno> cno() const
+    {
+        return Base::field<5>();
+    }
+
+    /// @brief Value of @b lli member, see @ref message::RxmRawFields::lli
+    FieldValue<Fields::lli> lli() const
+    {
+        return Base::field<6>();
+    }
+};
+
+/// @brief Read-only view of RXM-RAW message payload.
+/// @details Provides access to the fields of @ref ublox::message::RxmRaw
+///     message directly in the payload buffer, without creating the message
+///     object. The blocks are accessed one at a time using the cursor.
+///     See @ref ListView for details.
+/// @code
+/// ublox::view::RxmRawView view;
+/// if (view.attach(payload, payloadLen) == comms::ErrorStatus::Success) {
+///     auto cursor = view.blocks();
+///     while (cursor.next()) {
+///         auto prMes = cursor.block().prMes().value();
+///     }
+/// }
+/// @endcode
+class RxmRawView : public ListView<message::RxmRawFields::All, message::RxmRaw<>::FieldIdx_numSV, RxmRawBlockView>
+{
+    typedef ListView<message::RxmRawFields::All, message::RxmRaw<>::FieldIdx_numSV, RxmRawBlockView> Base;
+    typedef message::RxmRaw<> Msg;
+    typedef message::RxmRawFields Fields;
+
+public:
+    /// @brief Value of @b rcvTow field, see @ref message::RxmRawFields::rcvTow
+    FieldValue<Fields::rcvTow> rcvTow() const
+    {
+        return Base::field<Msg::FieldIdx_rcvTow>();
+    }
+
+    /// @brief Value of @b week field, see @ref message::RxmRawFields::week
+    FieldValue<Fields::week> week() const
+    {
+        return Base::field<Msg::FieldIdx_week>();
+    }
+
+    /// @brief Value of @b numSV field, see @ref message::RxmRawFields::numSV
+    FieldValue<Fields::numSV> numSV() const
+    {
+        return Base::field<Msg::FieldIdx_numSV>();
+    }
+};
+
+}  // namespace view
+
+}  // namespace ublox
+
+
@@ -0,0 +1,116 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of the columnar decoder of RXM-SVSI message payload.
+
+#pragma once
+
+#include "ublox/message/RxmSvsi.h"
+#include "ListColumns.h"
+
+namespace ublox
+{
+
+namespace view
+{
+
+/// @brief Columnar decoder of RXM-SVSI message payload.
+/// @details Decodes the repeated blocks of @ref ublox::message::RxmSvsi
+///     message into contiguous per field arrays, without creating the message
+///     object. See @ref ListColumns for details.
+/// @code
+/// ublox::view::RxmSvsiColumns cols;
+/// if (cols.decode(payload, payloadLen) == comms::ErrorStatus::Success) {
+///     auto* svid = cols.svid();
+///     for (std::size_t idx = 0U; idx < cols.size(); ++idx) {
+///         ... // use svid[idx]
+///     }
+/// }
+/// @endcode
+class RxmSvsiColumns : public ListColumns<message::RxmSvsiFields::All, message::RxmSvsi<>::FieldIdx_numSV>
+{
+    typedef ListColumns<message::RxmSvsiFields::All, message::RxmSvsi<>::FieldIdx_numSV> Base;
+    typedef message::RxmSvsi<> Msg;
+    typedef message::RxmSvsiFields Fields;
+
+public:
+    /// @brief Value of @b iTOW field, see @ref message::RxmSvsiFields::iTOW
+    FieldValue<Fields::iTOW> iTOW() const
+    {
+        return Base::field<Msg::FieldIdx_iTOW>();
+    }
+
+    /// @brief Value of @b week field, see @ref message::RxmSvsiFields::week
+    FieldValue<Fields::week> week() const
+    {
+        return Base::field<Msg::FieldIdx_week>();
+    }
+
+    /// @brief Value of @b numVis field, see @ref message::RxmSvsiFields::numVis
+    FieldValue<Fields::numVis> numVis() const
+    {
+        return Base::field<Msg::FieldIdx_numVis>();
+    }
+
+    /// @brief Value of @b numSV field, see @ref message::RxmSvsiFields::numSV
+    FieldValue<Fields::numSV> numSV() const
+    {
+        return Base::field<Msg::FieldIdx_numSV>();
+    }
+
+    /// @brief Values of @b svid member of all the blocks, see
+    ///     @ref message::RxmSvsiFields::svid
+    const Blocks::ColumnValueType<0>* svid() const
+    {
+        return Base::column<0>();
+    }
+
+    /// @brief Values of @b svFlag member of all the blocks, see
+    ///     @ref message::RxmSvsiFields::svFlag
+    const Blocks::ColumnValueType<1>* svFlag() const
+    {
+        return Base::column<1>();
+    }
+
+    /// @brief Values of @b azim member of all the blocks, see
+    ///     @ref message::RxmSvsiFields::azim
+    const Blocks::ColumnValueType<2>* azim() const
+    {
+        return Base::column<2>();
+    }
+
+    /// @brief Values of @b elev member of all the blocks, see
+    ///     @ref message::RxmSvsiFields::elev
+    const Blocks::ColumnValueType<3>* elev() const
+    {
+        return Base::column<3>();
+    }
+
+    /// @brief Values of @b age member of all the blocks, see
+    ///     @ref message::RxmSvsiFields::age
+    const Blocks::ColumnValueType<4>* age() const
+    {
+        return Base::column<4>();
+    }
+};
+
+}  // namespace view
+
+}  // namespace ublox
+
+
@@ -0,0 +1,121 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of the view of RXM-SVSI message payload.
+
+#pragma once
+
+#include "ublox/message/RxmSvsi.h"
+#include "ListView.h"
+
+namespace ublox
+{
+
+namespace view
+{
+
+/// @brief Read-only view of the single block of RXM-SVSI message, see
+///     @ref message::RxmSvsiFields::block.
+class RxmSvsiBlockView : public PayloadView<details::BundleMembers<message::RxmSvsiFields::block>::Type>
+{
+    typedef PayloadView<details::BundleMembers<message::RxmSvsiFields::block>::Type> Base;
+    typedef message::RxmSvsiFields Fields;
+
+public:
+    /// @brief Value of @b svid member, see @ref message::RxmSvsiFields::svid
+    FieldValue<Fields::svid> svid() const
+    {
+        return Base::field<0>();
+    }
+
+    /// @brief Value of @b svFlag member, see @ref message::RxmSvsiFields::svFlag
+    FieldValue<Fields::svFlag> svFlag() const
+    {
+        return Base::field<1>();
+    }
+
+    /// @brief Value of @b azim member, see @ref message::RxmSvsiFields::azim
+    FieldValue<Fields::azim> azim() const
+    {
+        return Base::field<2>();
+    }
+
+    /// @brief Value of @b elev member, see @ref message::RxmSvsiFields::elev
+    FieldValue<Fields::elev> elev() const
+    {
+        return Base::field<3>();
+    }
+
+    /// @brief Value of @b age member, see @ref message::RxmSvsiFields::age
+    FieldValue<Fields::age> age() const
+    {
+        return Base::field<4>();
+    }
+};
+
+/// @brief Read-only view of RXM-SVSI message payload.
+/// @details Provides access to the fields of @ref ublox::message::RxmSvsi
+///     message directly in the payload buffer, without creating the message
+///     object. The blocks are accessed one at a time using the cursor.
+///     See @ref ListView for details.
+/// @code
+/// ublox::view::RxmSvsiView view;
+/// if (view.attach(payload, payloadLen) == comms::ErrorStatus::Success) {
+///     auto cursor = view.blocks();
+///     while (cursor.next()) {
+///         auto svFlag = cursor.block().svFlag().value();
+///     }
+/// }
+/// @endcode
+class RxmSvsiView : public ListView<message::RxmSvsiFields::All, message::RxmSvsi<>::FieldIdx_numSV, RxmSvsiBlockView>
+{
+    typedef ListView<message::RxmSvsiFields::All, message::RxmSvsi<>::FieldIdx_numSV, RxmSvsiBlockView> Base;
+    typedef message::RxmSvsi<> Msg;
+    typedef message::RxmSvsiFields Fields;
+
+public:
+    /// @brief Value of @b iTOW field, see @ref message::RxmSvsiFields::iTOW
+    FieldValue<Fields::iTOW> iTOW() const
+    {
+        return Base::field<Msg::FieldIdx_iTOW>();
+    }
+
+    /// @brief Value of @b week field, see @ref message::RxmSvsiFields::week
+    FieldValue<Fields::week> week() const
+    {
+        return Base::field<Msg::FieldIdx_week>();
+    }
+
+    /// @brief Value of @b numVis field, see @ref message::RxmSvsiFields::numVis
+    FieldValue<Fields::numVis> numVis() const
+    {
+        return Base::field<Msg::FieldIdx_numVis>();
+    }
+
+    /// @brief Value of @b numSV field, see @ref message::RxmSvsiFields::numSV
+    FieldValue<Fields::numSV> numSV() const
+    {
+        return Base::field<Msg::FieldIdx_numSV>();
+    }
+};
+
+}  // namespace view
+
+}  // namespace ublox
+
+
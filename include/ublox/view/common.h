@@ -0,0 +1,341 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains definition of common classes used by the payload views.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+
+#include "comms/comms.h"
+
+#include "ublox/details/FieldsLength.h"
+#include "ublox/details/MsgIdTables.h"
+
+namespace ublox
+{
+
+namespace view
+{
+
+namespace details
+{
+
+/// @brief Unsigned integral type capable of holding @b TLen bytes.
+template <std::size_t TLen>
+using UnsignedStorage =
+    typename std::conditional<
+        (TLen <= 1U),
+        std::uint8_t,
+        typename std::conditional<
+            (TLen <= 2U),
+            std::uint16_t,
+            typename std::conditional<
+                (TLen <= 4U),
+                std::uint32_t,
+                std::uint64_t
+            >::type
+        >::type
+    >::type;
+
+/// @brief Scaling ratio found among the field options, 1/1 if none.
+template <typename... TOptions>
+struct ScalingOf
+{
+    static const std::intmax_t Num = 1;
+    static const std::intmax_t Denom = 1;
+};
+
+template <std::intmax_t TNum, std::intmax_t TDenom, typename... TRest>
+struct ScalingOf<comms::option::ScalingRatio<TNum, TDenom>, TRest...>
+{
+    static const std::intmax_t Num = TNum;
+    static const std::intmax_t Denom = TDenom;
+};
+
+template <typename TFirst, typename... TRest>
+struct ScalingOf<TFirst, TRest...> : public ScalingOf<TRest...>
+{
+};
+
+/// @brief Value type and scaling of the field when accessed via view.
+/// @details Bitmask and bitfield fields are accessed as raw unsigned value.
+template <typename TField>
+struct FieldTraits : public ScalingOf<>
+{
+    typedef UnsignedStorage<TField::maxLength()> ValueType;
+    typedef ValueType SerialisedType;
+
+    static ValueType fromSerialised(SerialisedType value)
+    {
+        return value;
+    }
+};
+
+template <typename TFieldBase, typename T, typename... TOptions>
+struct FieldTraits<comms::field::IntValue<TFieldBase, T, TOptions...> > :
+    public ScalingOf<TOptions...>
+{
+    typedef T ValueType;
+    typedef T SerialisedType;
+
+    static ValueType fromSerialised(SerialisedType value)
+    {
+        return value;
+    }
+};
+
+template <typename TFieldBase, typename TEnum, typename... TOptions>
+struct FieldTraits<comms::field::EnumValue<TFieldBase, TEnum, TOptions...> > :
+    public ScalingOf<>
+{
+    typedef TEnum ValueType;
+    typedef typename std::underlying_type<TEnum>::type SerialisedType;
+
+    static ValueType fromSerialised(SerialisedType value)
+    {
+        return static_cast<ValueType>(value);
+    }
+};
+
+template <typename TFieldBase, typename T, typename... TOptions>
+struct FieldTraits<comms::field::FloatValue<TFieldBase, T, TOptions...> > :
+    public ScalingOf<>
+{
+    typedef T ValueType;
+    typedef UnsignedStorage<sizeof(T)> SerialisedType;
+
+    static_assert(sizeof(ValueType) == sizeof(SerialisedType),
+        "Unexpected size of floating point value");
+
+    static ValueType fromSerialised(SerialisedType value)
+    {
+        ValueType result;
+        std::memcpy(&result, &value, sizeof(result));
+        return result;
+    }
+};
+
+/// @brief Member fields of the bundle field.
+template <typename TField>
+struct BundleMembers;
+
+template <typename TMembers, typename... TOptions>
+struct BundleMembers<comms::field::Bundle<TMembers, TOptions...> >
+{
+    typedef TMembers Type;
+};
+
+/// @brief Element of the list field.
+template <typename TField>
+struct ListElement;
+
+template <typename TFieldBase, typename TElem, typename... TOptions>
+struct ListElement<comms::field::ArrayList<TFieldBase, TElem, TOptions...> >
+{
+    typedef TElem Type;
+};
+
+template <typename TFields, typename TSeq>
+struct FieldsPrefixHelper;
+
+template <typename TFields, std::size_t... TIdx>
+struct FieldsPrefixHelper<TFields, ublox::details::IndexSeq<TIdx...> >
+{
+    typedef std::tuple<typename std::tuple_element<TIdx, TFields>::type...> Type;
+};
+
+/// @brief First @b TCount fields among the ones bundled in std::tuple.
+template <typename TFields, std::size_t TCount>
+using FieldsPrefix =
+    typename FieldsPrefixHelper<
+        TFields,
+        typename ublox::details::MakeIndexSeq<TCount>::Type
+    >::Type;
+
+/// @brief Load integral value serialised using little endian into
+///     @b TLen bytes.
+/// @details Doesn't depend on alignment of the data and endianness of
+///     the platform.
+template <typename T, std::size_t TLen>
+T loadLittleEndian(const std::uint8_t* data)
+{
+    static_assert(std::is_integral<T>::value, "T must be integral type");
+    static_assert((0U < TLen) && (TLen <= sizeof(std::uint64_t)), "Invalid length");
+
+    static const std::size_t BitsInByte = std::numeric_limits<std::uint8_t>::digits;
+    std::uint64_t value = 0U;
+    for (std::size_t idx = 0U; idx < TLen; ++idx) {
+        value |= static_cast<std::uint64_t>(data[idx]) << (idx * BitsInByte);
+    }
+
+    static const std::size_t SignBitPos = (TLen * BitsInByte) - 1;
+    if (std::is_signed<T>::value &&
+        (TLen < sizeof(T)) &&
+        (((value >> SignBitPos) & 0x1) != 0U)) {
+        value |= (~static_cast<std::uint64_t>(0U)) << SignBitPos;
+    }
+
+    return static_cast<T>(value);
+}
+
+/// @brief Read value of the field serialised at provided location.
+template <typename TField>
+typename FieldTraits<TField>::ValueType readValue(const std::uint8_t* data)
+{
+    typedef FieldTraits<TField> Traits;
+    return
+        Traits::fromSerialised(
+            loadLittleEndian<typename Traits::SerialisedType, TField::maxLength()>(data));
+}
+
+}  // namespace details
+
+/// @brief Value of a single field accessed via payload view.
+/// @details Provides the same value access interface as the relevant
+///     field (@b value() and @b getScaled()), but without any read
+///     functionality.
+/// @tparam TField Definition of the field, such as
+///     @ref ublox::message::NavPvtFields::lon.
+template <typename TField>
+class FieldValue
+{
+    typedef details::FieldTraits<TField> Traits;
+public:
+    /// @brief Type of the field definition.
+    typedef TField Field;
+
+    /// @brief Type of the value.
+    typedef typename Traits::ValueType ValueType;
+
+    /// @brief Constructor
+    explicit FieldValue(ValueType val)
+      : m_value(val)
+    {
+    }
+
+    /// @brief Get access to the value.
+    const ValueType& value() const
+    {
+        return m_value;
+    }
+
+    /// @brief Get the value scaled by the ratio specified with
+    ///     @b comms::option::ScalingRatio option in the field definition.
+    /// @tparam TRet Return type, usually floating point one.
+    template <typename TRet>
+    TRet getScaled() const
+    {
+        return
+            (static_cast<TRet>(m_value) * static_cast<TRet>(Traits::Num)) /
+                static_cast<TRet>(Traits::Denom);
+    }
+
+private:
+    ValueType m_value;
+};
+
+/// @brief Read-only view of the payload of the message with fixed layout.
+/// @details The view doesn't copy anything, every field is read from the
+///     payload buffer at compile time known offset when accessed. The offsets
+///     are calculated from the field definitions of the relevant message,
+///     i.e. the buffer must outlive the view.
+/// @tparam TAllFields All fields of the message bundled in std::tuple, such as
+///     @ref ublox::message::NavPvtFields::All.
+template <typename TAllFields>
+class PayloadView
+{
+public:
+    /// @brief All the fields bundled in std::tuple.
+    typedef TAllFields AllFields;
+
+    /// @brief Length of the payload.
+    static const std::size_t PayloadLength =
+        ublox::details::FieldsMaxLength<AllFields>::Value;
+
+    static_assert(ublox::details::FieldsMinLength<AllFields>::Value == PayloadLength,
+        "The payload is expected to have fixed length");
+
+    /// @brief Default constructor, creates detached view.
+    PayloadView() = default;
+
+    /// @brief Attach the view to the payload.
+    /// @details Longer payload is accepted, the extra bytes are ignored.
+    /// @param[in] payload Pointer to the first byte of the payload.
+    /// @param[in] len Number of bytes in the payload.
+    /// @return @b comms::ErrorStatus::Success if the payload is long enough,
+    ///     @b comms::ErrorStatus::NotEnoughData otherwise, in which case
+    ///     the view becomes detached.
+    comms::ErrorStatus attach(const std::uint8_t* payload, std::size_t len)
+    {
+        if (len < PayloadLength) {
+            m_payload = nullptr;
+            return comms::ErrorStatus::NotEnoughData;
+        }
+
+        m_payload = payload;
+        return comms::ErrorStatus::Success;
+    }
+
+    /// @brief Check whether the view is attached to the payload.
+    /// @details Not named @b valid() to avoid clash with the accessors of
+    ///     the fields having such name.
+    bool attached() const
+    {
+        return m_payload != nullptr;
+    }
+
+    /// @brief Get pointer to the first byte of the payload.
+    const std::uint8_t* payload() const
+    {
+        return m_payload;
+    }
+
+    /// @brief Offset of the field in the payload.
+    /// @tparam TIdx Index of the field in @ref AllFields.
+    template <std::size_t TIdx>
+    static constexpr std::size_t fieldOffset()
+    {
+        return ublox::details::FieldsOffset<AllFields, TIdx>::Value;
+    }
+
+    /// @brief Read the field value.
+    /// @tparam TIdx Index of the field in @ref AllFields.
+    /// @pre @ref attached() returns true.
+    template <std::size_t TIdx>
+    FieldValue<typename std::tuple_element<TIdx, AllFields>::type> field() const
+    {
+        typedef typename std::tuple_element<TIdx, AllFields>::type FieldType;
+        return FieldValue<FieldType>(
+            details::readValue<FieldType>(m_payload + fieldOffset<TIdx>()));
+    }
+
+private:
+    const std::uint8_t* m_payload = nullptr;
+};
+
+}  // namespace view
+
+}  // namespace ublox
+
+
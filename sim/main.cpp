@@ -0,0 +1,332 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <string>
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <termios.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "ublox/LinkBudget.h"
+#include "ublox/sim/Simulator.h"
+
+namespace
+{
+
+typedef ublox::sim::Simulator<> Simulator;
+
+Simulator* SimulatorPtr = nullptr;
+
+enum class Output
+{
+    Pipe,
+    Pty,
+    File,
+    Tcp
+};
+
+struct Options
+{
+    ublox::sim::GeneratorConfig generator;
+    ublox::sim::SimulatorConfig simulator;
+    ublox::sim::CorruptionConfig corruption;
+    Output output = Output::Pipe;
+    std::string path;
+    unsigned port = 0U;
+};
+
+void usage(const char* name)
+{
+    std::fprintf(stderr,
+        "Usage: %s [options]\n"
+        "Emulates u-blox receiver producing NAV-PVT, NAV-SOL, NAV-SVINFO,\n"
+        "RXM-RAW and INF-NOTICE output, acknowledging CFG requests.\n\n"
+        "Output (standard output by default):\n"
+        "  --pty               create pseudo-terminal, print its name to stderr\n"
+        "  --file PATH         write into the file\n"
+        "  --tcp PORT          accept single connection on 127.0.0.1:PORT\n\n"
+        "Contents:\n"
+        "  --period MS         measurement period, default 1000\n"
+        "  --channels N        NAV-SVINFO channels, default 12\n"
+        "  --svs N             RXM-RAW satellites, default 8\n"
+        "  --pvt N             NAV-PVT rate (epochs), 0 disables, default 1\n"
+        "  --sol N             NAV-SOL rate, default 1\n"
+        "  --svinfo N          NAV-SVINFO rate, default 1\n"
+        "  --raw N             RXM-RAW rate, default 0\n"
+        "  --inf N             INF-NOTICE rate, default 0\n\n"
+        "Timing:\n"
+        "  --baud N            pace the output as 8N1 UART with the baud rate\n"
+        "  --tx-buffer N       discard epochs overflowing the transmit buffer\n"
+        "  --epochs N          stop after N epochs, default unlimited\n"
+        "  --fast              don't wait for measurement period between epochs\n\n"
+        "Corruption:\n"
+        "  --flip P            probability of bit flip in every byte\n"
+        "  --drop P            probability of every byte to be dropped\n"
+        "  --garbage P         probability of garbage inserted into every epoch\n"
+        "  --seed N            seed of the pseudo-random generators\n",
+        name);
+}
+
+bool parse(int argc, char* argv[], Options& opts)
+{
+    enum
+    {
+        Opt_pty = 256,
+        Opt_file,
+        Opt_tcp,
+        Opt_period,
+        Opt_channels,
+        Opt_svs,
+        Opt_pvt,
+        Opt_sol,
+        Opt_svinfo,
+        Opt_raw,
+        Opt_inf,
+        Opt_baud,
+        Opt_txBuffer,
+        Opt_epochs,
+        Opt_fast,
+        Opt_flip,
+        Opt_drop,
+        Opt_garbage,
+        Opt_seed,
+        Opt_help
+    };
+
+    static const option LongOptions[] = {
+        {"pty", no_argument, nullptr, Opt_pty},
+        {"file", required_argument, nullptr, Opt_file},
+        {"tcp", required_argument, nullptr, Opt_tcp},
+        {"period", required_argument, nullptr, Opt_period},
+        {"channels", required_argument, nullptr, Opt_channels},
+        {"svs", required_argument, nullptr, Opt_svs},
+        {"pvt", required_argument, nullptr, Opt_pvt},
+        {"sol", required_argument, nullptr, Opt_sol},
+        {"svinfo", required_argument, nullptr, Opt_svinfo},
+        {"raw", required_argument, nullptr, Opt_raw},
+        {"inf", required_argument, nullptr, Opt_inf},
+        {"baud", required_argument, nullptr, Opt_baud},
+        {"tx-buffer", required_argument, nullptr, Opt_txBuffer},
+        {"epochs", required_argument, nullptr, Opt_epochs},
+        {"fast", no_argument, nullptr, Opt_fast},
+        {"flip", required_argument, nullptr, Opt_flip},
+        {"drop", required_argument, nullptr, Opt_drop},
+        {"garbage", required_argument, nullptr, Opt_garbage},
+        {"seed", required_argument, nullptr, Opt_seed},
+        {"help", no_argument, nullptr, Opt_help},
+        {nullptr, 0, nullptr, 0}
+    };
+
+    auto number = [](const char* str) { return std::strtoul(str, nullptr, 0); };
+    auto rate = [&number](const char* str) { return static_cast<std::uint8_t>(number(str)); };
+
+    int opt = 0;
+    while ((opt = getopt_long(argc, argv, "h", LongOptions, nullptr)) != -1) {
+        switch (opt) {
+        case Opt_pty: opts.output = Output::Pty; break;
+        case Opt_file: opts.output = Output::File; opts.path = optarg; break;
+        case Opt_tcp: opts.output = Output::Tcp; opts.port = static_cast<unsigned>(number(optarg)); break;
+        case Opt_period: opts.generator.measPeriodMs = static_cast<unsigned>(number(optarg)); break;
+        case Opt_channels: opts.generator.channels = number(optarg); break;
+        case Opt_svs: opts.generator.svs = number(optarg); break;
+        case Opt_pvt: opts.generator.navPvtRate = rate(optarg); break;
+        case Opt_sol: opts.generator.navSolRate = rate(optarg); break;
+        case Opt_svinfo: opts.generator.navSvinfoRate = rate(optarg); break;
+        case Opt_raw: opts.generator.rxmRawRate = rate(optarg); break;
+        case Opt_inf: opts.generator.infNoticeRate = rate(optarg); break;
+        case Opt_baud:
+        {
+            typedef ublox::message::CfgPrtUartFields Fields;
+            auto halfBits =
+                ublox::uartCharHalfBits(
+                    Fields::CharLen::Bits_8,
+                    Fields::Parity::NoParity,
+                    Fields::StopBits::One);
+            opts.simulator.bytesPerSecond = (2U * number(optarg)) / halfBits;
+            break;
+        }
+        case Opt_txBuffer: opts.simulator.txBufferLength = number(optarg); break;
+        case Opt_epochs: opts.simulator.epochs = number(optarg); break;
+        case Opt_fast: opts.simulator.realTime = false; break;
+        case Opt_flip: opts.corruption.bitFlip = std::strtod(optarg, nullptr); break;
+        case Opt_drop: opts.corruption.drop = std::strtod(optarg, nullptr); break;
+        case Opt_garbage: opts.corruption.garbage = std::strtod(optarg, nullptr); break;
+        case Opt_seed:
+            opts.generator.seed = static_cast<std::uint32_t>(number(optarg));
+            opts.corruption.seed = opts.generator.seed;
+            break;
+        default:
+            return false;
+        }
+    }
+
+    return optind == argc;
+}
+
+bool setNonBlocking(int fd)
+{
+    auto flags = ::fcntl(fd, F_GETFL);
+    return (0 <= flags) && (::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0);
+}
+
+int openPty(int& slaveFd)
+{
+    int fd = ::posix_openpt(O_RDWR | O_NOCTTY);
+    if ((fd < 0) || (::grantpt(fd) != 0) || (::unlockpt(fd) != 0)) {
+        return -1;
+    }
+
+    auto* name = ::ptsname(fd);
+    if (name == nullptr) {
+        return -1;
+    }
+
+    // Keep the slave open, otherwise the master reports hang up until
+    // the client opens it.
+    slaveFd = ::open(name, O_RDWR | O_NOCTTY);
+    if (slaveFd < 0) {
+        return -1;
+    }
+
+    termios attrs;
+    if (::tcgetattr(slaveFd, &attrs) == 0) {
+        ::cfmakeraw(&attrs);
+        ::tcsetattr(slaveFd, TCSANOW, &attrs);
+    }
+
+    std::fprintf(stderr, "%s\n", name);
+    return fd;
+}
+
+int acceptTcp(unsigned port)
+{
+    int listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        return -1;
+    }
+
+    int reuse = 1;
+    ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<std::uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int fd = -1;
+    if ((::bind(listenFd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0) &&
+        (::listen(listenFd, 1) == 0)) {
+        std::fprintf(stderr, "Listening on 127.0.0.1:%u\n", port);
+        fd = ::accept(listenFd, nullptr, nullptr);
+    }
+
+    ::close(listenFd);
+    return fd;
+}
+
+void signalHandler(int)
+{
+    if (SimulatorPtr != nullptr) {
+        SimulatorPtr->stop();
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    Options opts;
+    if (!parse(argc, argv, opts)) {
+        usage(argv[0]);
+        return -1;
+    }
+
+    int outFd = STDOUT_FILENO;
+    int inFd = -1;
+    int slaveFd = -1;
+    switch (opts.output) {
+    case Output::Pty:
+        outFd = openPty(slaveFd);
+        inFd = outFd;
+        break;
+    case Output::File:
+        outFd = ::open(opts.path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        break;
+    case Output::Tcp:
+        outFd = acceptTcp(opts.port);
+        inFd = outFd;
+        break;
+    default:
+        break;
+    }
+
+    if ((outFd < 0) || ((0 <= inFd) && (!setNonBlocking(inFd)))) {
+        std::perror("Failed to open output");
+        return -1;
+    }
+
+    ublox::sim::Generator<> generator(opts.generator);
+    Simulator simulator(generator, outFd, inFd, opts.simulator);
+    simulator.setCorruption(opts.corruption);
+
+    SimulatorPtr = &simulator;
+    std::signal(SIGINT, &signalHandler);
+    std::signal(SIGTERM, &signalHandler);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    bool result = simulator.run();
+    SimulatorPtr = nullptr;
+    if (!result) {
+        std::fprintf(stderr, "Output failed: %s\n", std::strerror(simulator.error()));
+    }
+
+    auto& corruptor = simulator.corruptor();
+    auto& responder = simulator.responder();
+    std::fprintf(stderr,
+        "Epochs: %zu, bytes: %zu, overruns: %zu, acked: %zu, nacked: %zu, "
+        "flipped: %zu, dropped: %zu, garbage: %zu\n",
+        generator.epochCount(),
+        simulator.bytesWritten(),
+        simulator.overrunCount(),
+        responder.ackedCount(),
+        responder.nackedCount(),
+        corruptor.flippedCount(),
+        corruptor.droppedCount(),
+        corruptor.garbageCount());
+
+    if (outFd != STDOUT_FILENO) {
+        ::close(outFd);
+    }
+
+    if (0 <= slaveFd) {
+        ::close(slaveFd);
+    }
+
+    return result ? 0 : -1;
+}
+
+
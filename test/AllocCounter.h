@@ -0,0 +1,110 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains replacement of the global operator new counting the
+///     allocations.
+/// @details Defines the replacement functions, i.e. expected to be included
+///     by single source file of the test.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace ublox
+{
+
+namespace test
+{
+
+/// @brief Counter of the allocations.
+class AllocCounter
+{
+public:
+    /// @brief Start counting from 0.
+    static void start()
+    {
+        count() = 0U;
+        enabled() = true;
+    }
+
+    /// @brief Stop counting.
+    /// @return Number of allocations since @ref start().
+    static std::size_t stop()
+    {
+        enabled() = false;
+        return count();
+    }
+
+    /// @brief Record the allocation.
+    static void allocated()
+    {
+        if (enabled()) {
+            ++count();
+        }
+    }
+
+private:
+    static bool& enabled()
+    {
+        static bool Enabled = false;
+        return Enabled;
+    }
+
+    static std::size_t& count()
+    {
+        static std::size_t Count = 0U;
+        return Count;
+    }
+};
+
+}  // namespace test
+
+}  // namespace ublox
+
+void* operator new(std::size_t size)
+{
+    ublox::test::AllocCounter::allocated();
+    void* ptr = std::malloc(size == 0U ? 1U : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+#pragma GCC diagnostic pop
+#endif
+
+
@@ -0,0 +1,241 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Checks save / load of CaptureIndex sidecar data: rejection of the stale
+// index (different fingerprint of the capture) and of the corrupted one,
+// and the frame offsets beyond 4 GiB.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ublox/capture/CaptureIndex.h"
+#include "ublox/capture/CaptureReader.h"
+#include "ublox/sim/Generator.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+typedef ublox::capture::CaptureIndex CaptureIndex;
+typedef ublox::capture::CaptureFingerprint CaptureFingerprint;
+
+static const std::size_t NumOfEpochs = 1000U;
+static const std::uint64_t ModTime = 1500000000U;
+static const std::size_t HeaderLength = 40U;
+static const std::size_t EntryLength = 16U;
+static const std::size_t FrameNumLength = 4U;
+
+std::vector<std::uint8_t> buildCapture()
+{
+    ublox::sim::GeneratorConfig config;
+    config.rxmRawRate = 1U;
+
+    ublox::sim::Generator<> generator(config);
+    std::vector<std::uint8_t> capture;
+    for (std::size_t idx = 0U; idx < NumOfEpochs; ++idx) {
+        generator.epoch(capture);
+    }
+    return capture;
+}
+
+std::string save(const CaptureIndex& index)
+{
+    std::ostringstream stream;
+    UBLOX_TEST_CHECK(index.save(stream));
+    return stream.str();
+}
+
+bool load(CaptureIndex& index, const std::string& data, const CaptureFingerprint& source)
+{
+    std::istringstream stream(data);
+    return index.load(stream, source);
+}
+
+void putValue(std::string& data, std::size_t offset, std::uint64_t value)
+{
+    for (std::size_t idx = 0U; idx < sizeof(value); ++idx) {
+        data[offset + idx] = static_cast<char>(static_cast<std::uint8_t>(value >> (8U * idx)));
+    }
+}
+
+void testRoundTrip(const std::vector<std::uint8_t>& capture)
+{
+    CaptureIndex index;
+    UBLOX_TEST_CHECK(index.build(capture.data(), capture.size(), ModTime));
+    UBLOX_TEST_CHECK(index.size() == NumOfEpochs * 4U);
+    UBLOX_TEST_CHECK(index.fingerprint() == CaptureFingerprint::of(capture.data(), capture.size(), ModTime));
+
+    CaptureIndex loaded;
+    UBLOX_TEST_CHECK(load(loaded, save(index), index.fingerprint()));
+    UBLOX_TEST_CHECK(loaded.size() == index.size());
+    UBLOX_TEST_CHECK(loaded.fingerprint() == index.fingerprint());
+    for (std::size_t idx = 0U; idx < index.size(); ++idx) {
+        UBLOX_TEST_CHECK(loaded.entry(idx).offset == index.entry(idx).offset);
+        UBLOX_TEST_CHECK(loaded.entry(idx).msgId == index.entry(idx).msgId);
+    }
+
+    UBLOX_TEST_CHECK(loaded.countOf(ublox::MsgId_RXM_RAW) == NumOfEpochs);
+    UBLOX_TEST_CHECK(loaded.findNth(ublox::MsgId_NAV_SOL, 10) == index.findNth(ublox::MsgId_NAV_SOL, 10));
+}
+
+void testStale(const std::vector<std::uint8_t>& capture)
+{
+    CaptureIndex index;
+    index.build(capture.data(), capture.size(), ModTime);
+    auto data = save(index);
+
+    CaptureIndex loaded;
+    UBLOX_TEST_CHECK(!load(loaded, data, CaptureFingerprint::of(capture.data(), capture.size(), ModTime + 1)));
+    UBLOX_TEST_CHECK(loaded.empty());
+    UBLOX_TEST_CHECK(!load(loaded, data, CaptureFingerprint::of(capture.data(), capture.size() - 1, ModTime)));
+
+    // Same length and modification time, different contents at the
+    // beginning and at the end.
+    auto modified = capture;
+    modified[100] ^= 0xff;
+    UBLOX_TEST_CHECK(!load(loaded, data, CaptureFingerprint::of(modified.data(), modified.size(), ModTime)));
+
+    modified = capture;
+    modified[modified.size() - 100] ^= 0xff;
+    UBLOX_TEST_CHECK(!load(loaded, data, CaptureFingerprint::of(modified.data(), modified.size(), ModTime)));
+}
+
+void testCorrupted(const std::vector<std::uint8_t>& capture)
+{
+    CaptureIndex index;
+    index.build(capture.data(), capture.size(), ModTime);
+    auto data = save(index);
+    auto count = index.size();
+    auto byTypeOffset = HeaderLength + (count * EntryLength);
+    UBLOX_TEST_CHECK(data.size() == byTypeOffset + (count * FrameNumLength));
+
+    CaptureIndex loaded;
+    UBLOX_TEST_CHECK(!load(loaded, data.substr(0U, data.size() - 1U), index.fingerprint()));
+    UBLOX_TEST_CHECK(loaded.empty());
+
+    // Frame offsets not increasing
+    auto corrupted = data;
+    std::swap(corrupted[HeaderLength], corrupted[HeaderLength + EntryLength]);
+    UBLOX_TEST_CHECK(!load(loaded, corrupted, index.fingerprint()));
+
+    // Duplicate frame number in the index by type
+    corrupted = data;
+    corrupted.replace(byTypeOffset + FrameNumLength, FrameNumLength, data, byTypeOffset, FrameNumLength);
+    UBLOX_TEST_CHECK(!load(loaded, corrupted, index.fingerprint()));
+
+    // Valid permutation, but not sorted by message ID
+    corrupted = data;
+    auto lastOffset = byTypeOffset + ((count - 1U) * FrameNumLength);
+    corrupted.replace(byTypeOffset, FrameNumLength, data, lastOffset, FrameNumLength);
+    corrupted.replace(lastOffset, FrameNumLength, data, byTypeOffset, FrameNumLength);
+    UBLOX_TEST_CHECK(!load(loaded, corrupted, index.fingerprint()));
+
+    UBLOX_TEST_CHECK(load(loaded, data, index.fingerprint()));
+}
+
+// The sidecar of the capture longer than 4 GiB is produced by shifting the
+// frame offsets, only the fingerprint of such capture is needed.
+void testLargeOffsets(const std::vector<std::uint8_t>& capture)
+{
+    static const std::uint64_t Shift = 5ULL << 30;
+    static const std::size_t LengthOffset = 8U;
+    static const std::size_t CountOffset = 32U;
+
+    CaptureIndex index;
+    index.build(capture.data(), capture.size(), ModTime);
+    auto data = save(index);
+
+    auto fingerprint = index.fingerprint();
+    fingerprint.length += Shift;
+    putValue(data, LengthOffset, fingerprint.length);
+    for (std::size_t idx = 0U; idx < index.size(); ++idx) {
+        putValue(data, HeaderLength + (idx * EntryLength), index.entry(idx).offset + Shift);
+    }
+
+    CaptureIndex loaded;
+    UBLOX_TEST_CHECK(load(loaded, data, fingerprint));
+    UBLOX_TEST_CHECK(loaded.size() == index.size());
+    UBLOX_TEST_CHECK(loaded.sourceLength() == fingerprint.length);
+    for (std::size_t idx = 0U; idx < index.size(); ++idx) {
+        UBLOX_TEST_CHECK(loaded.entry(idx).offset == (index.entry(idx).offset + Shift));
+    }
+
+    auto resaved = save(loaded);
+    UBLOX_TEST_CHECK(resaved == data);
+
+    // More frames than can be numbered
+    putValue(data, CountOffset, static_cast<std::uint64_t>(CaptureIndex::MaxSize) + 1U);
+    UBLOX_TEST_CHECK(!load(loaded, data, fingerprint));
+    UBLOX_TEST_CHECK(loaded.empty());
+}
+
+void writeFile(const std::string& path, const std::vector<std::uint8_t>& data)
+{
+    std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+void testReader(const std::vector<std::uint8_t>& capture)
+{
+    static const std::string Path("CaptureIndexTest.ubx");
+    writeFile(Path, capture);
+    std::remove(CaptureIndex::sidecarPath(Path).c_str());
+
+    ublox::capture::CaptureReader reader;
+    UBLOX_TEST_CHECK(reader.open(Path));
+    UBLOX_TEST_CHECK(!reader.indexLoaded());
+    UBLOX_TEST_CHECK(reader.open(Path));
+    UBLOX_TEST_CHECK(reader.indexLoaded());
+    UBLOX_TEST_CHECK(reader.size() == NumOfEpochs * 4U);
+    reader.close();
+
+    // Rewrite with the contents of the same length, most probably within
+    // the same second.
+    auto modified = capture;
+    modified[0] ^= 0xff;
+    writeFile(Path, modified);
+    UBLOX_TEST_CHECK(reader.open(Path));
+    UBLOX_TEST_CHECK(!reader.indexLoaded());
+    UBLOX_TEST_CHECK(reader.size() == (NumOfEpochs * 4U) - 1U);
+    reader.close();
+
+    std::remove(CaptureIndex::sidecarPath(Path).c_str());
+    std::remove(Path.c_str());
+}
+
+}  // namespace
+
+int main()
+{
+    auto capture = buildCapture();
+    UBLOX_TEST_CHECK((2U * CaptureFingerprint::HashedLength) < capture.size());
+
+    testRoundTrip(capture);
+    testStale(capture);
+    testCorrupted(capture);
+    testLargeOffsets(capture);
+    testReader(capture);
+    return ublox::test::result();
+}
+
+
@@ -0,0 +1,227 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Checks CfgTransactions: only one request with the same ID in flight,
+// retransmission and timeout, and the send handler acknowledging or
+// cancelling the requests.
+
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include "ublox/CfgTransactions.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+typedef ublox::CfgTransactions CfgTransactions;
+typedef CfgTransactions::Status Status;
+
+static const std::size_t IdOffset = 2U;
+
+ublox::MsgId frameId(const std::uint8_t* data)
+{
+    return static_cast<ublox::MsgId>(
+        (static_cast<unsigned>(data[IdOffset]) << 8) | data[IdOffset + 1U]);
+}
+
+struct Recorder
+{
+    std::vector<ublox::MsgId> sent;
+    std::vector<std::pair<unsigned, Status> > completed;
+
+    CfgTransactions::CompletionHandler handler(unsigned tag)
+    {
+        return
+            [this, tag](Status status)
+            {
+                completed.push_back(std::make_pair(tag, status));
+            };
+    }
+};
+
+bool submit(CfgTransactions& transactions, Recorder& recorder, ublox::MsgId id, unsigned tag, CfgTransactions::TimePoint now)
+{
+    static const std::uint8_t Payload[] = {0x01, 0x02, 0x03};
+    return transactions.submitPayload(id, Payload, sizeof(Payload), recorder.handler(tag), now);
+}
+
+void testSameIdQueued()
+{
+    auto now = CfgTransactions::Clock::now();
+    Recorder recorder;
+    CfgTransactions transactions(
+        [&recorder](const std::uint8_t* data, std::size_t)
+        {
+            recorder.sent.push_back(frameId(data));
+            return true;
+        });
+
+    UBLOX_TEST_CHECK(submit(transactions, recorder, ublox::MsgId_CFG_MSG, 0U, now));
+    UBLOX_TEST_CHECK(submit(transactions, recorder, ublox::MsgId_CFG_MSG, 1U, now));
+    UBLOX_TEST_CHECK(submit(transactions, recorder, ublox::MsgId_CFG_RATE, 2U, now));
+    UBLOX_TEST_CHECK(submit(transactions, recorder, ublox::MsgId_CFG_MSG, 3U, now));
+
+    UBLOX_TEST_CHECK(recorder.sent.size() == 2U);
+    UBLOX_TEST_CHECK(recorder.sent[0] == ublox::MsgId_CFG_MSG);
+    UBLOX_TEST_CHECK(recorder.sent[1] == ublox::MsgId_CFG_RATE);
+    UBLOX_TEST_CHECK(transactions.inFlightCount() == 2U);
+    UBLOX_TEST_CHECK(transactions.queuedCount() == 2U);
+
+    UBLOX_TEST_CHECK(transactions.acknowledge(ublox::MsgId_CFG_MSG, true, now));
+    UBLOX_TEST_CHECK(recorder.sent.size() == 3U);
+    UBLOX_TEST_CHECK(transactions.acknowledge(ublox::MsgId_CFG_RATE, true, now));
+    UBLOX_TEST_CHECK(recorder.sent.size() == 3U);
+    UBLOX_TEST_CHECK(transactions.acknowledge(ublox::MsgId_CFG_MSG, false, now));
+    UBLOX_TEST_CHECK(recorder.sent.size() == 4U);
+    UBLOX_TEST_CHECK(transactions.acknowledge(ublox::MsgId_CFG_MSG, true, now));
+    UBLOX_TEST_CHECK(!transactions.acknowledge(ublox::MsgId_CFG_MSG, true, now));
+
+    UBLOX_TEST_CHECK(transactions.idle());
+    UBLOX_TEST_CHECK(transactions.unmatchedCount() == 1U);
+    UBLOX_TEST_CHECK(recorder.completed.size() == 4U);
+    if (recorder.completed.size() == 4U) {
+        UBLOX_TEST_CHECK(recorder.completed[0] == std::make_pair(0U, CfgTransactions::Status_Acked));
+        UBLOX_TEST_CHECK(recorder.completed[1] == std::make_pair(2U, CfgTransactions::Status_Acked));
+        UBLOX_TEST_CHECK(recorder.completed[2] == std::make_pair(1U, CfgTransactions::Status_Nacked));
+        UBLOX_TEST_CHECK(recorder.completed[3] == std::make_pair(3U, CfgTransactions::Status_Acked));
+    }
+}
+
+void testTimeout()
+{
+    auto now = CfgTransactions::Clock::now();
+    auto timeout = std::chrono::milliseconds(100);
+    Recorder recorder;
+    CfgTransactions transactions(
+        [&recorder](const std::uint8_t* data, std::size_t)
+        {
+            recorder.sent.push_back(frameId(data));
+            return true;
+        },
+        CfgTransactions::DefaultWindow,
+        timeout,
+        1U);
+
+    UBLOX_TEST_CHECK(submit(transactions, recorder, ublox::MsgId_CFG_PRT, 0U, now));
+    UBLOX_TEST_CHECK(transactions.nextDeadline() == now + timeout);
+
+    transactions.tick(now + timeout / 2);
+    UBLOX_TEST_CHECK(recorder.sent.size() == 1U);
+
+    now += timeout;
+    transactions.tick(now);
+    UBLOX_TEST_CHECK(recorder.sent.size() == 2U);
+    UBLOX_TEST_CHECK(transactions.retransmissionCount() == 1U);
+    UBLOX_TEST_CHECK(recorder.completed.empty());
+
+    now += timeout;
+    transactions.tick(now);
+    UBLOX_TEST_CHECK(recorder.sent.size() == 2U);
+    UBLOX_TEST_CHECK(transactions.idle());
+    UBLOX_TEST_CHECK(recorder.completed.size() == 1U);
+    UBLOX_TEST_CHECK(!recorder.completed.empty() && recorder.completed[0].second == CfgTransactions::Status_TimedOut);
+}
+
+void testAckFromSendHandler()
+{
+    auto now = CfgTransactions::Clock::now();
+    Recorder recorder;
+    CfgTransactions* transactionsPtr = nullptr;
+    CfgTransactions transactions(
+        [&recorder, &transactionsPtr, now](const std::uint8_t* data, std::size_t)
+        {
+            auto id = frameId(data);
+            recorder.sent.push_back(id);
+            transactionsPtr->acknowledge(id, true, now);
+            return true;
+        },
+        1U);
+    transactionsPtr = &transactions;
+
+    UBLOX_TEST_CHECK(submit(transactions, recorder, ublox::MsgId_CFG_PRT, 0U, now));
+    UBLOX_TEST_CHECK(submit(transactions, recorder, ublox::MsgId_CFG_MSG, 1U, now));
+    UBLOX_TEST_CHECK(submit(transactions, recorder, ublox::MsgId_CFG_MSG, 2U, now));
+    UBLOX_TEST_CHECK(transactions.idle());
+    UBLOX_TEST_CHECK(recorder.sent.size() == 3U);
+    UBLOX_TEST_CHECK(recorder.completed.size() == 3U);
+    UBLOX_TEST_CHECK(transactions.unmatchedCount() == 0U);
+}
+
+void testCancelFromSendHandler()
+{
+    static const std::size_t NumOfRequests = 64U;
+    static const ublox::MsgId FirstId = ublox::MsgId_CFG_PRT;
+
+    auto now = CfgTransactions::Clock::now();
+    auto timeout = std::chrono::milliseconds(100);
+    Recorder recorder;
+    CfgTransactions* transactionsPtr = nullptr;
+    bool cancel = false;
+    CfgTransactions transactions(
+        [&recorder, &transactionsPtr, &cancel](const std::uint8_t* data, std::size_t)
+        {
+            recorder.sent.push_back(frameId(data));
+            if (cancel) {
+                cancel = false;
+                transactionsPtr->cancelAll();
+            }
+            return true;
+        },
+        NumOfRequests / 2U,
+        timeout);
+    transactionsPtr = &transactions;
+
+    for (unsigned idx = 0U; idx < NumOfRequests; ++idx) {
+        auto id = static_cast<ublox::MsgId>(FirstId + idx);
+        UBLOX_TEST_CHECK(submit(transactions, recorder, id, idx, now));
+    }
+    UBLOX_TEST_CHECK(transactions.inFlightCount() == NumOfRequests / 2U);
+
+    cancel = true;
+    transactions.tick(now + timeout);
+    UBLOX_TEST_CHECK(transactions.idle());
+    UBLOX_TEST_CHECK(recorder.sent.size() == (NumOfRequests / 2U) + 1U);
+    UBLOX_TEST_CHECK(recorder.completed.size() == NumOfRequests);
+    for (auto& completed : recorder.completed) {
+        UBLOX_TEST_CHECK(completed.second == CfgTransactions::Status_Cancelled);
+    }
+
+    // Cancellation while sending from submit()
+    cancel = true;
+    recorder.completed.clear();
+    UBLOX_TEST_CHECK(submit(transactions, recorder, FirstId, 0U, now));
+    UBLOX_TEST_CHECK(transactions.idle());
+    UBLOX_TEST_CHECK(recorder.completed.size() == 1U);
+}
+
+}  // namespace
+
+int main()
+{
+    testSameIdQueued();
+    testTimeout();
+    testAckFromSendHandler();
+    testCancelFromSendHandler();
+    return ublox::test::result();
+}
+
+
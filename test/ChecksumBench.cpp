@@ -0,0 +1,85 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Compares the contiguous buffer (SIMD) path of ChecksumCalc with the
+// byte by byte loop on frame sizes from 8 bytes to 64 KiB.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#include "ublox/protocol/ChecksumCalc.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+typedef ublox::protocol::details::ChecksumCalcHelper Helper;
+
+std::uint16_t checksumLoop(const std::uint8_t* buf, std::size_t len)
+{
+    std::uint32_t ckA = 0U;
+    std::uint32_t ckB = 0U;
+    Helper::calcGeneric(buf, len, ckA, ckB);
+    return static_cast<std::uint16_t>(((ckB & 0xff) << 8) | (ckA & 0xff));
+}
+
+}  // namespace
+
+int main()
+{
+    static const std::size_t MaxLength = 64U * 1024U;
+    static const std::size_t Misalignment = 32U;
+    static const std::size_t BytesPerRun = 256U * 1024U * 1024U;
+
+    std::vector<std::uint8_t> buf(MaxLength + Misalignment);
+    for (std::size_t idx = 0U; idx < buf.size(); ++idx) {
+        buf[idx] = static_cast<std::uint8_t>((idx * 7U) + (idx >> 8U));
+    }
+
+    std::printf("%8s %12s %12s %8s\n", "length", "simd ns", "loop ns", "speedup");
+    for (std::size_t len = 8U; len <= MaxLength; len *= 2U) {
+        auto iterations = (BytesPerRun / len) + 1U;
+        for (std::size_t offset = 0U; offset < Misalignment; ++offset) {
+            const std::uint8_t* iter = &buf[offset];
+            UBLOX_TEST_CHECK(ublox::protocol::ChecksumCalc()(iter, len) == checksumLoop(&buf[offset], len));
+        }
+
+        auto simdNs =
+            ublox::test::measureNs(iterations,
+                [&buf, len](std::size_t idx)
+                {
+                    const std::uint8_t* iter = &buf[idx % Misalignment];
+                    ublox::test::consume(ublox::protocol::ChecksumCalc()(iter, len));
+                });
+
+        auto loopNs =
+            ublox::test::measureNs(iterations,
+                [&buf, len](std::size_t idx)
+                {
+                    ublox::test::consume(checksumLoop(&buf[idx % Misalignment], len));
+                });
+
+        std::printf("%8zu %12.1f %12.1f %7.1fx\n", len, simdNs, loopNs, loopNs / simdNs);
+    }
+
+    return ublox::test::result();
+}
+
+
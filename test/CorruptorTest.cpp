@@ -0,0 +1,126 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Checks Corruptor with the probabilities at the limits of the allowed
+// range: 0 leaves the data intact, 1 corrupts every byte.
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "ublox/sim/Corruptor.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+typedef ublox::sim::Corruptor Corruptor;
+typedef ublox::sim::CorruptionConfig CorruptionConfig;
+
+static const std::size_t DataLength = 1000U;
+static const std::size_t From = 10U;
+
+std::vector<std::uint8_t> buildData()
+{
+    std::vector<std::uint8_t> data(DataLength);
+    for (std::size_t idx = 0U; idx < data.size(); ++idx) {
+        data[idx] = static_cast<std::uint8_t>(idx);
+    }
+    return data;
+}
+
+unsigned bitCount(unsigned value)
+{
+    unsigned result = 0U;
+    for (; value != 0U; value >>= 1U) {
+        result += (value & 1U);
+    }
+    return result;
+}
+
+void testDisabled()
+{
+    Corruptor corruptor;
+    UBLOX_TEST_CHECK(!corruptor.enabled());
+
+    auto data = buildData();
+    UBLOX_TEST_CHECK(corruptor.apply(data) == 0U);
+    UBLOX_TEST_CHECK(data == buildData());
+}
+
+void testFlipEveryByte()
+{
+    CorruptionConfig config;
+    config.bitFlip = 2.0;
+    Corruptor corruptor(config);
+    UBLOX_TEST_CHECK(corruptor.config().bitFlip == 1.0);
+
+    auto data = buildData();
+    auto original = data;
+    UBLOX_TEST_CHECK(corruptor.apply(data, From) == DataLength - From);
+    UBLOX_TEST_CHECK(corruptor.flippedCount() == DataLength - From);
+    UBLOX_TEST_CHECK(data.size() == original.size());
+    for (std::size_t idx = 0U; idx < data.size(); ++idx) {
+        auto expectedBits = (idx < From) ? 0U : 1U;
+        UBLOX_TEST_CHECK(bitCount(static_cast<unsigned>(data[idx] ^ original[idx])) == expectedBits);
+    }
+}
+
+void testDropEveryByte()
+{
+    CorruptionConfig config;
+    config.drop = 1.0;
+    Corruptor corruptor(config);
+
+    auto data = buildData();
+    UBLOX_TEST_CHECK(corruptor.apply(data, From) == DataLength - From);
+    UBLOX_TEST_CHECK(corruptor.droppedCount() == DataLength - From);
+    UBLOX_TEST_CHECK(data.size() == From);
+
+    auto original = buildData();
+    original.resize(From);
+    UBLOX_TEST_CHECK(data == original);
+}
+
+void testGarbageEveryChunk()
+{
+    CorruptionConfig config;
+    config.garbage = 1.0;
+    config.garbageLength = 4U;
+    Corruptor corruptor(config);
+
+    for (std::size_t idx = 0U; idx < 10U; ++idx) {
+        auto data = buildData();
+        UBLOX_TEST_CHECK(corruptor.apply(data) == 1U);
+        UBLOX_TEST_CHECK(DataLength < data.size());
+        UBLOX_TEST_CHECK(data.size() <= DataLength + config.garbageLength);
+    }
+}
+
+}  // namespace
+
+int main()
+{
+    testDisabled();
+    testFlipEveryByte();
+    testDropEveryByte();
+    testGarbageEveryChunk();
+    return ublox::test::result();
+}
+
+
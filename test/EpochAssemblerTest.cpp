@@ -0,0 +1,255 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Feeds the messages of the navigation epochs to EpochAssembler and checks
+// the reported epochs: complete ones, partial ones closed by the message of
+// the next epoch or by flush(), the messages arriving after their epoch
+// has been reported, and no allocation per epoch with fixed list storage.
+
+#include <cstdint>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#include "ublox/EpochAssembler.h"
+#include "ublox/message/NavPvt.h"
+#include "ublox/message/NavSol.h"
+#include "ublox/message/NavSvinfo.h"
+
+#include "TestCommon.h"
+#include "AllocCounter.h"
+
+namespace
+{
+
+typedef ublox::message::NavPvt<> NavPvt;
+typedef ublox::message::NavSol<> NavSol;
+typedef ublox::message::NavSvinfo<ublox::Message, ublox::option::FixedListStorage> NavSvinfo;
+typedef ublox::EpochAssembler<std::tuple<NavPvt, NavSol, NavSvinfo> > Assembler;
+
+static const std::size_t NumOfChannels = 16U;
+
+struct Reported
+{
+    std::uint32_t m_iTOW;
+    std::size_t m_size;
+    bool m_complete;
+    bool m_hasSvinfo;
+};
+
+class Tester
+{
+public:
+    Tester()
+    {
+        m_reported.reserve(16U);
+        auto& data = std::get<NavSvinfo::FieldIdx_data>(m_svinfo.fields()).value();
+        for (std::size_t idx = 0U; idx < NumOfChannels; ++idx) {
+            data.push_back(ublox::message::NavSvinfoFields::block());
+        }
+        std::get<NavSvinfo::FieldIdx_numCh>(m_svinfo.fields()).value() = NumOfChannels;
+
+        m_assembler.setEpochHandler(
+            [this](const Assembler::Epoch& epoch)
+            {
+                if (epoch.has<NavSvinfo>()) {
+                    auto& svinfo = epoch.get<NavSvinfo>();
+                    UBLOX_TEST_CHECK(std::get<NavSvinfo::FieldIdx_iTOW>(svinfo.fields()).value() == epoch.iTOW());
+                    UBLOX_TEST_CHECK(std::get<NavSvinfo::FieldIdx_data>(svinfo.fields()).value().size() == NumOfChannels);
+                }
+
+                if (epoch.has<NavPvt>()) {
+                    UBLOX_TEST_CHECK(std::get<NavPvt::FieldIdx_iTOW>(epoch.get<NavPvt>().fields()).value() == epoch.iTOW());
+                }
+
+                if (m_reported.size() < m_reported.capacity()) {
+                    Reported reported = {epoch.iTOW(), epoch.size(), epoch.complete(), epoch.has<NavSvinfo>()};
+                    m_reported.push_back(reported);
+                }
+            });
+    }
+
+    Assembler& assembler()
+    {
+        return m_assembler;
+    }
+
+    std::vector<Reported>& reported()
+    {
+        return m_reported;
+    }
+
+    void pvt(std::uint32_t iTOW)
+    {
+        std::get<NavPvt::FieldIdx_iTOW>(m_pvt.fields()).value() = iTOW;
+        m_assembler.handle(m_pvt);
+    }
+
+    void sol(std::uint32_t iTOW)
+    {
+        std::get<NavSol::FieldIdx_iTOW>(m_sol.fields()).value() = iTOW;
+        m_assembler.handle(m_sol);
+    }
+
+    void svinfo(std::uint32_t iTOW)
+    {
+        std::get<NavSvinfo::FieldIdx_iTOW>(m_svinfo.fields()).value() = iTOW;
+        m_assembler.handle(m_svinfo);
+    }
+
+private:
+    Assembler m_assembler;
+    std::vector<Reported> m_reported;
+    NavPvt m_pvt;
+    NavSol m_sol;
+    NavSvinfo m_svinfo;
+};
+
+void testComplete()
+{
+    Tester tester;
+    tester.pvt(1000U);
+    tester.sol(1000U);
+    UBLOX_TEST_CHECK(tester.reported().empty());
+    UBLOX_TEST_CHECK(tester.assembler().pending().size() == 2U);
+
+    tester.svinfo(1000U);
+    UBLOX_TEST_CHECK(tester.reported().size() == 1U);
+    UBLOX_TEST_CHECK(tester.assembler().pending().empty());
+
+    // Any order
+    tester.svinfo(2000U);
+    tester.pvt(2000U);
+    tester.sol(2000U);
+    UBLOX_TEST_CHECK(tester.reported().size() == 2U);
+
+    for (auto& reported : tester.reported()) {
+        UBLOX_TEST_CHECK(reported.m_complete);
+        UBLOX_TEST_CHECK(reported.m_size == 3U);
+    }
+    UBLOX_TEST_CHECK(tester.reported()[0].m_iTOW == 1000U);
+    UBLOX_TEST_CHECK(tester.reported()[1].m_iTOW == 2000U);
+    UBLOX_TEST_CHECK(tester.assembler().epochCount() == 2U);
+    UBLOX_TEST_CHECK(tester.assembler().incompleteCount() == 0U);
+    UBLOX_TEST_CHECK(tester.assembler().lateCount() == 0U);
+}
+
+void testPartial()
+{
+    Tester tester;
+
+    // Closed by the message of the next epoch
+    tester.pvt(1000U);
+    tester.sol(1000U);
+    tester.pvt(2000U);
+    UBLOX_TEST_CHECK(tester.reported().size() == 1U);
+    UBLOX_TEST_CHECK(tester.assembler().pending().size() == 1U);
+    UBLOX_TEST_CHECK(tester.assembler().pending().iTOW() == 2000U);
+
+    // Closed by the end of input
+    tester.assembler().flush();
+    UBLOX_TEST_CHECK(tester.reported().size() == 2U);
+    tester.assembler().flush();
+    UBLOX_TEST_CHECK(tester.reported().size() == 2U);
+
+    auto& reported = tester.reported();
+    UBLOX_TEST_CHECK((reported[0].m_iTOW == 1000U) && (reported[0].m_size == 2U));
+    UBLOX_TEST_CHECK((!reported[0].m_complete) && (!reported[0].m_hasSvinfo));
+    UBLOX_TEST_CHECK((reported[1].m_iTOW == 2000U) && (reported[1].m_size == 1U));
+    UBLOX_TEST_CHECK(!reported[1].m_complete);
+    UBLOX_TEST_CHECK(tester.assembler().epochCount() == 2U);
+    UBLOX_TEST_CHECK(tester.assembler().incompleteCount() == 2U);
+
+    // Dropped without being reported
+    tester.pvt(3000U);
+    tester.assembler().reset();
+    UBLOX_TEST_CHECK(tester.assembler().pending().empty());
+    tester.assembler().flush();
+    UBLOX_TEST_CHECK(tester.reported().size() == 2U);
+}
+
+void testLate()
+{
+    Tester tester;
+    tester.assembler().setExpected<NavSvinfo>(false);
+
+    // NAV-SVINFO is not expected and arrives after the epoch is complete
+    tester.pvt(1000U);
+    tester.sol(1000U);
+    UBLOX_TEST_CHECK(tester.reported().size() == 1U);
+    tester.svinfo(1000U);
+    UBLOX_TEST_CHECK(tester.assembler().pending().empty());
+    UBLOX_TEST_CHECK(tester.assembler().lateCount() == 1U);
+
+    tester.pvt(2000U);
+    tester.svinfo(2000U);
+    tester.sol(2000U);
+    UBLOX_TEST_CHECK(tester.reported().size() == 2U);
+
+    // Late member of the reported epoch while the next one is assembled
+    tester.pvt(3000U);
+    tester.sol(2000U);
+    UBLOX_TEST_CHECK(tester.reported().size() == 2U);
+    UBLOX_TEST_CHECK(tester.assembler().pending().iTOW() == 3000U);
+    UBLOX_TEST_CHECK(tester.assembler().pending().size() == 1U);
+    tester.sol(3000U);
+
+    auto& reported = tester.reported();
+    UBLOX_TEST_CHECK(reported.size() == 3U);
+    for (auto& epoch : reported) {
+        UBLOX_TEST_CHECK(epoch.m_complete);
+    }
+    UBLOX_TEST_CHECK(!reported[0].m_hasSvinfo);
+    UBLOX_TEST_CHECK(reported[1].m_hasSvinfo);
+    UBLOX_TEST_CHECK(reported[2].m_iTOW == 3000U);
+    UBLOX_TEST_CHECK(tester.assembler().epochCount() == 3U);
+    UBLOX_TEST_CHECK(tester.assembler().incompleteCount() == 0U);
+    UBLOX_TEST_CHECK(tester.assembler().lateCount() == 2U);
+}
+
+void testNoAllocation()
+{
+    static const std::size_t NumOfEpochs = 1000U;
+
+    Tester tester;
+    ublox::test::AllocCounter::start();
+    for (std::size_t idx = 0U; idx < NumOfEpochs; ++idx) {
+        auto iTOW = static_cast<std::uint32_t>(idx * 1000U);
+        tester.pvt(iTOW);
+        tester.sol(iTOW);
+        if ((idx % 2U) == 0U) {
+            tester.svinfo(iTOW);
+        }
+    }
+    tester.assembler().flush();
+    UBLOX_TEST_CHECK(ublox::test::AllocCounter::stop() == 0U);
+    UBLOX_TEST_CHECK(tester.assembler().epochCount() == NumOfEpochs);
+    UBLOX_TEST_CHECK(tester.assembler().incompleteCount() == (NumOfEpochs / 2U));
+}
+
+}  // namespace
+
+int main()
+{
+    testComplete();
+    testPartial();
+    testLate();
+    testNoAllocation();
+    return ublox::test::result();
+}
+
+
@@ -0,0 +1,96 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Measures throughput of FrameAssembler when the input arrives in chunks
+// of 1 byte (interrupt driven UART), 64 bytes (USB / FIFO) and 4 KiB
+// (file / socket reads).
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "ublox/FrameAssembler.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+std::size_t buildStream(std::vector<std::uint8_t>& stream)
+{
+    static const std::size_t NumOfEpochs = 20000U;
+    static const std::size_t SvinfoChannels = 16U;
+
+    std::size_t frames = 0U;
+    std::vector<std::uint8_t> pvt(84U, 0U);
+    std::vector<std::uint8_t> svinfo(8U + (SvinfoChannels * 12U), 0U);
+    std::vector<std::uint8_t> nmea = {'$', 'G', 'P', 'G', 'G', 'A', ',', '*', '5', '6', '\r', '\n'};
+    for (std::size_t epoch = 0U; epoch < NumOfEpochs; ++epoch) {
+        ublox::test::putValue(pvt, 0U, static_cast<std::uint32_t>(epoch * 1000U));
+        ublox::test::appendFrame(stream, ublox::MsgId_NAV_PVT, pvt);
+        ublox::test::putValue(svinfo, 0U, static_cast<std::uint32_t>(epoch * 1000U));
+        ublox::test::appendFrame(stream, ublox::MsgId_NAV_SVINFO, svinfo);
+        frames += 2U;
+        if ((epoch % 10U) == 0U) {
+            stream.insert(stream.end(), nmea.begin(), nmea.end());
+        }
+    }
+    return frames;
+}
+
+}  // namespace
+
+int main()
+{
+    std::vector<std::uint8_t> stream;
+    auto expectedFrames = buildStream(stream);
+
+    std::printf("stream: %zu bytes, %zu frames\n", stream.size(), expectedFrames);
+    std::printf("%8s %12s %12s\n", "chunk", "MB/s", "ns/frame");
+    for (std::size_t chunk : {std::size_t(1U), std::size_t(64U), std::size_t(4096U)}) {
+        ublox::FrameAssembler<> assembler;
+        std::size_t frames = 0U;
+        std::size_t bytes = 0U;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t offset = 0U; offset < stream.size(); offset += chunk) {
+            assembler.process(
+                &stream[offset],
+                std::min(chunk, stream.size() - offset),
+                [&frames, &bytes](const ublox::FrameView& view)
+                {
+                    ++frames;
+                    bytes += view.length();
+                });
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        UBLOX_TEST_CHECK(frames == expectedFrames);
+        UBLOX_TEST_CHECK(assembler.checksumErrorCount() == 0U);
+        ublox::test::consume(bytes);
+        std::printf("%8zu %12.1f %12.1f\n",
+            chunk,
+            (static_cast<double>(stream.size()) / 1e6) / elapsed.count(),
+            (elapsed.count() * 1e9) / static_cast<double>(frames));
+    }
+
+    return ublox::test::result();
+}
+
+
@@ -0,0 +1,187 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Checks FrameView: valid frames with and without payload, truncated
+// frames, invalid synchronisation characters and checksum, and LENGTH
+// field exceeding the available data.
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "ublox/FrameView.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+typedef ublox::FrameView FrameView;
+
+std::vector<std::uint8_t> buildFrame(std::size_t payloadLen)
+{
+    std::vector<std::uint8_t> payload(payloadLen);
+    for (std::size_t idx = 0U; idx < payload.size(); ++idx) {
+        payload[idx] = static_cast<std::uint8_t>(idx * 3U);
+    }
+
+    std::vector<std::uint8_t> frame;
+    ublox::test::appendFrame(frame, ublox::MsgId_NAV_PVT, payload);
+    return frame;
+}
+
+comms::ErrorStatus readExact(FrameView& view, const std::vector<std::uint8_t>& buf, std::size_t len)
+{
+    // Copy into the buffer of exact length to catch the reads past its end
+    // with address sanitizer.
+    std::vector<std::uint8_t> exact(buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(len));
+    const std::uint8_t* iter = exact.data();
+    auto es = view.read(iter, exact.size());
+    if (es == comms::ErrorStatus::Success) {
+        UBLOX_TEST_CHECK(iter == exact.data() + view.length());
+    }
+    else {
+        UBLOX_TEST_CHECK(iter == exact.data());
+        UBLOX_TEST_CHECK(!view.valid());
+        UBLOX_TEST_CHECK(view.length() == 0U);
+        UBLOX_TEST_CHECK(view.payload().empty());
+    }
+    return es;
+}
+
+void testValid()
+{
+    static const std::size_t PayloadLengths[] = {0U, 1U, 92U, 1000U};
+    for (auto payloadLen : PayloadLengths) {
+        auto frame = buildFrame(payloadLen);
+        UBLOX_TEST_CHECK(FrameView::frameLength(frame.data(), frame.size()) == frame.size());
+
+        std::vector<std::uint8_t> buf(frame);
+        buf.insert(buf.end(), frame.begin(), frame.end());
+        const std::uint8_t* iter = buf.data();
+        for (unsigned count = 0U; count < 2U; ++count) {
+            FrameView view;
+            UBLOX_TEST_CHECK(view.read(iter, static_cast<std::size_t>(buf.data() + buf.size() - iter)) == comms::ErrorStatus::Success);
+            UBLOX_TEST_CHECK(view.valid());
+            UBLOX_TEST_CHECK(view.msgId() == ublox::MsgId_NAV_PVT);
+            UBLOX_TEST_CHECK(view.classId() == 0x01);
+            UBLOX_TEST_CHECK(view.id() == 0x07);
+            UBLOX_TEST_CHECK(view.length() == frame.size());
+            UBLOX_TEST_CHECK(view.data() == iter - frame.size());
+            UBLOX_TEST_CHECK(view.payload().size() == payloadLen);
+            UBLOX_TEST_CHECK(view.payload().empty() == (payloadLen == 0U));
+            UBLOX_TEST_CHECK(view.payload().data() == view.data() + FrameView::HeaderLength);
+            for (std::size_t idx = 0U; idx < payloadLen; ++idx) {
+                UBLOX_TEST_CHECK(view.payload()[idx] == static_cast<std::uint8_t>(idx * 3U));
+            }
+        }
+        UBLOX_TEST_CHECK(iter == buf.data() + buf.size());
+    }
+}
+
+void testTruncated()
+{
+    static const std::size_t PayloadLengths[] = {0U, 40U};
+    for (auto payloadLen : PayloadLengths) {
+        auto frame = buildFrame(payloadLen);
+        for (std::size_t len = 0U; len < frame.size(); ++len) {
+            FrameView view;
+            UBLOX_TEST_CHECK(readExact(view, frame, len) == comms::ErrorStatus::NotEnoughData);
+            if (len < FrameView::HeaderLength) {
+                UBLOX_TEST_CHECK(FrameView::frameLength(frame.data(), len) == 0U);
+            }
+        }
+
+        FrameView view;
+        UBLOX_TEST_CHECK(readExact(view, frame, frame.size()) == comms::ErrorStatus::Success);
+    }
+}
+
+void testInvalidSync()
+{
+    auto frame = buildFrame(10U);
+    for (std::size_t idx = 0U; idx < 2U; ++idx) {
+        auto corrupted = frame;
+        corrupted[idx] ^= 0x01;
+        UBLOX_TEST_CHECK(FrameView::frameLength(corrupted.data(), corrupted.size()) == 0U);
+        for (auto len = idx + 1U; len <= corrupted.size(); ++len) {
+            FrameView view;
+            UBLOX_TEST_CHECK(readExact(view, corrupted, len) == comms::ErrorStatus::ProtocolError);
+        }
+    }
+}
+
+void testInvalidChecksum()
+{
+    static const std::size_t PayloadLengths[] = {0U, 20U};
+    for (auto payloadLen : PayloadLengths) {
+        auto frame = buildFrame(payloadLen);
+        // Every byte covered by the checksum, except LENGTH, and the
+        // checksum itself.
+        for (std::size_t idx = 2U; idx < frame.size(); ++idx) {
+            if ((idx == 4U) || (idx == 5U)) {
+                continue;
+            }
+
+            auto corrupted = frame;
+            corrupted[idx] ^= 0x80;
+            FrameView view;
+            UBLOX_TEST_CHECK(readExact(view, corrupted, corrupted.size()) == comms::ErrorStatus::ProtocolError);
+        }
+    }
+
+    // Invalid frame resets previously read one
+    auto frame = buildFrame(4U);
+    FrameView view;
+    UBLOX_TEST_CHECK(readExact(view, frame, frame.size()) == comms::ErrorStatus::Success);
+    frame.back() ^= 0x01;
+    UBLOX_TEST_CHECK(readExact(view, frame, frame.size()) == comms::ErrorStatus::ProtocolError);
+}
+
+void testLengthOverrun()
+{
+    auto frame = buildFrame(10U);
+    frame[4] = 0xe8; // 1000 bytes
+    frame[5] = 0x03;
+    UBLOX_TEST_CHECK(FrameView::frameLength(frame.data(), frame.size()) == 1000U + FrameView::OverheadLength);
+
+    FrameView view;
+    UBLOX_TEST_CHECK(readExact(view, frame, frame.size()) == comms::ErrorStatus::NotEnoughData);
+
+    frame[4] = 0xff;
+    frame[5] = 0xff;
+    UBLOX_TEST_CHECK(readExact(view, frame, frame.size()) == comms::ErrorStatus::NotEnoughData);
+
+    // Shorter LENGTH makes the checksum mismatch
+    frame[4] = 0x02;
+    frame[5] = 0x00;
+    UBLOX_TEST_CHECK(readExact(view, frame, frame.size()) == comms::ErrorStatus::ProtocolError);
+}
+
+}  // namespace
+
+int main()
+{
+    testValid();
+    testTruncated();
+    testInvalidSync();
+    testInvalidChecksum();
+    testLengthOverrun();
+    return ublox::test::result();
+}
+
+
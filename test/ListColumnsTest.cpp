@@ -0,0 +1,221 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Compares the columns decoded by the columnar decoders of NAV-SVINFO,
+// RXM-RAW, RXM-SVSI and MON-IO payloads with the fields of the messages
+// read from the same payloads, including the empty lists, the payloads
+// too short for the reported number of blocks and the reuse of the
+// decoder for multiple frames.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "ublox/message/MonIo.h"
+#include "ublox/message/NavSvinfo.h"
+#include "ublox/message/RxmRaw.h"
+#include "ublox/message/RxmSvsi.h"
+#include "ublox/view/NavSvinfoColumns.h"
+#include "ublox/view/RxmRawColumns.h"
+#include "ublox/view/RxmSvsiColumns.h"
+
+#include "TestCommon.h"
+#include "ListTestCommon.h"
+
+namespace
+{
+
+typedef ublox::message::NavSvinfo<> NavSvinfo;
+typedef ublox::message::RxmRaw<> RxmRaw;
+typedef ublox::message::RxmSvsi<> RxmSvsi;
+typedef ublox::message::MonIo<> MonIo;
+
+static const std::size_t BlockCounts[] = {0U, 1U, 12U, 72U, 5U, 0U};
+
+template <typename TMsg>
+bool readMsg(TMsg& msg, const std::vector<std::uint8_t>& payload)
+{
+    const std::uint8_t* iter = payload.data();
+    return msg.read(iter, payload.size()) == comms::ErrorStatus::Success;
+}
+
+template <std::size_t TIdx, typename TColumns, typename TBlocks>
+void checkColumn(const TColumns& cols, const TBlocks& blocks)
+{
+    auto* col = cols.template column<TIdx>();
+    for (std::size_t idx = 0U; idx < blocks.size(); ++idx) {
+        UBLOX_TEST_CHECK(ublox::test::sameValue(col[idx], std::get<TIdx>(blocks[idx].value())));
+    }
+}
+
+template <typename TColumns, typename TBlocks, std::size_t... TIdx>
+void checkColumns(const TColumns& cols, const TBlocks& blocks, ublox::details::IndexSeq<TIdx...>)
+{
+    int dummy[] = {(checkColumn<TIdx>(cols, blocks), 0)...};
+    static_cast<void>(dummy);
+}
+
+// Decodes the payloads with different number of blocks using the same
+// decoder and compares all the columns with the decoded message.
+template <typename TColumns, typename TMsg, std::size_t TCountIdx>
+void testColumns()
+{
+    typedef typename TColumns::Blocks Blocks;
+    typedef typename ublox::details::MakeIndexSeq<Blocks::NumOfColumns>::Type Columns;
+    static const std::size_t ListIdx = TColumns::ListIdx;
+
+    std::mt19937 gen(TCountIdx);
+    TColumns cols;
+    for (auto count : BlockCounts) {
+        auto payload = ublox::test::listPayload<TMsg, TCountIdx>(gen, count, count);
+        TMsg msg;
+        UBLOX_TEST_CHECK(readMsg(msg, payload));
+
+        UBLOX_TEST_CHECK(cols.decode(payload.data(), payload.size()) == comms::ErrorStatus::Success);
+        UBLOX_TEST_CHECK(cols.decoded());
+        UBLOX_TEST_CHECK(cols.size() == count);
+        UBLOX_TEST_CHECK(cols.blocks().empty() == (count == 0U));
+        UBLOX_TEST_CHECK(cols.template field<TCountIdx>().value() == count);
+        UBLOX_TEST_CHECK(
+            std::memcmp(cols.header().payload(), payload.data(), TColumns::Header::PayloadLength) == 0);
+
+        auto& blocks = std::get<ListIdx>(msg.fields()).value();
+        UBLOX_TEST_CHECK(blocks.size() == count);
+        checkColumns(cols, blocks, Columns());
+    }
+}
+
+template <typename TColumns, typename TMsg, std::size_t TCountIdx>
+void testShortPayload()
+{
+    std::mt19937 gen(TCountIdx);
+    TColumns cols;
+    auto payload = ublox::test::listPayload<TMsg, TCountIdx>(gen, 4U, 4U);
+    UBLOX_TEST_CHECK(cols.decode(payload.data(), payload.size()) == comms::ErrorStatus::Success);
+
+    // One block is missing
+    payload = ublox::test::listPayload<TMsg, TCountIdx>(gen, 5U, 4U);
+    UBLOX_TEST_CHECK(cols.decode(payload.data(), payload.size()) == comms::ErrorStatus::NotEnoughData);
+    UBLOX_TEST_CHECK(!cols.decoded());
+    UBLOX_TEST_CHECK(cols.size() == 0U);
+
+    // Partial block
+    payload.resize(payload.size() + TColumns::Blocks::BlockLength - 1U);
+    UBLOX_TEST_CHECK(cols.decode(payload.data(), payload.size()) == comms::ErrorStatus::NotEnoughData);
+    UBLOX_TEST_CHECK(cols.size() == 0U);
+
+    // No header
+    UBLOX_TEST_CHECK(cols.decode(payload.data(), TColumns::Header::PayloadLength - 1U) == comms::ErrorStatus::NotEnoughData);
+    UBLOX_TEST_CHECK(!cols.decoded());
+    UBLOX_TEST_CHECK(cols.size() == 0U);
+}
+
+void testNavSvinfoAccessors()
+{
+    typedef ublox::message::NavSvinfoFields Fields;
+    static const std::size_t NumOfChannels = 32U;
+
+    std::mt19937 gen(1U);
+    auto payload = ublox::test::listPayload<NavSvinfo, NavSvinfo::FieldIdx_numCh>(gen, NumOfChannels, NumOfChannels);
+    NavSvinfo msg;
+    UBLOX_TEST_CHECK(readMsg(msg, payload));
+
+    ublox::view::NavSvinfoColumns cols;
+    UBLOX_TEST_CHECK(cols.decode(payload.data(), payload.size()) == comms::ErrorStatus::Success);
+    UBLOX_TEST_CHECK(cols.iTOW().value() == std::get<NavSvinfo::FieldIdx_iTOW>(msg.fields()).value());
+    UBLOX_TEST_CHECK(cols.numCh().value() == NumOfChannels);
+
+    auto& blocks = std::get<NavSvinfo::FieldIdx_data>(msg.fields()).value();
+    UBLOX_TEST_CHECK(blocks.size() == NumOfChannels);
+    for (std::size_t idx = 0U; idx < blocks.size(); ++idx) {
+        auto& members = blocks[idx].value();
+        UBLOX_TEST_CHECK(cols.chn()[idx] == std::get<Fields::block_chn>(members).value());
+        UBLOX_TEST_CHECK(cols.svid()[idx] == std::get<Fields::block_svid>(members).value());
+        UBLOX_TEST_CHECK(cols.flags()[idx] == std::get<Fields::block_flags>(members).value());
+        UBLOX_TEST_CHECK(cols.quality()[idx] == std::get<Fields::block_quality>(members).value());
+        UBLOX_TEST_CHECK(cols.cno()[idx] == std::get<Fields::block_cno>(members).value());
+        UBLOX_TEST_CHECK(cols.elev()[idx] == std::get<Fields::block_elev>(members).value());
+        UBLOX_TEST_CHECK(cols.azim()[idx] == std::get<Fields::block_azim>(members).value());
+        UBLOX_TEST_CHECK(cols.prRes()[idx] == std::get<Fields::block_prRes>(members).value());
+    }
+
+    // Smaller frame reuses the columns
+    auto* prRes = cols.prRes();
+    payload = ublox::test::listPayload<NavSvinfo, NavSvinfo::FieldIdx_numCh>(gen, 3U, 3U);
+    UBLOX_TEST_CHECK(cols.decode(payload.data(), payload.size()) == comms::ErrorStatus::Success);
+    UBLOX_TEST_CHECK(cols.size() == 3U);
+    UBLOX_TEST_CHECK(cols.prRes() == prRes);
+}
+
+// MON-IO has no count field, the number of blocks is derived from the
+// payload length.
+void testMonIo()
+{
+    typedef ublox::message::MonIoFields Fields;
+    typedef ublox::view::BlockColumns<Fields::block> Columns;
+    typedef typename ublox::details::MakeIndexSeq<Columns::NumOfColumns>::Type Indices;
+
+    std::mt19937 gen(2U);
+    Columns cols;
+    for (auto count : BlockCounts) {
+        std::vector<std::uint8_t> payload(count * Columns::BlockLength);
+        for (auto& byte : payload) {
+            byte = static_cast<std::uint8_t>(gen());
+        }
+
+        MonIo msg;
+        UBLOX_TEST_CHECK(readMsg(msg, payload));
+        auto& blocks = std::get<MonIo::FieldIdx_data>(msg.fields()).value();
+        UBLOX_TEST_CHECK(blocks.size() == count);
+
+        auto es = cols.decode(payload.data(), payload.size(), payload.size() / Columns::BlockLength);
+        UBLOX_TEST_CHECK(es == comms::ErrorStatus::Success);
+        UBLOX_TEST_CHECK(cols.size() == count);
+        UBLOX_TEST_CHECK(cols.empty() == (count == 0U));
+        checkColumns(cols, blocks, Indices());
+
+        for (std::size_t idx = 0U; idx < blocks.size(); ++idx) {
+            auto& members = blocks[idx].value();
+            UBLOX_TEST_CHECK(cols.column<Fields::block_rxBytes>()[idx] == std::get<Fields::block_rxBytes>(members).value());
+            UBLOX_TEST_CHECK(cols.column<Fields::block_txBytes>()[idx] == std::get<Fields::block_txBytes>(members).value());
+        }
+    }
+
+    std::vector<std::uint8_t> payload(Columns::BlockLength - 1U);
+    UBLOX_TEST_CHECK(cols.decode(payload.data(), payload.size(), 1U) == comms::ErrorStatus::NotEnoughData);
+    UBLOX_TEST_CHECK(cols.empty());
+}
+
+}  // namespace
+
+int main()
+{
+    testColumns<ublox::view::NavSvinfoColumns, NavSvinfo, NavSvinfo::FieldIdx_numCh>();
+    testColumns<ublox::view::RxmRawColumns, RxmRaw, RxmRaw::FieldIdx_numSV>();
+    testColumns<ublox::view::RxmSvsiColumns, RxmSvsi, RxmSvsi::FieldIdx_numSV>();
+    testShortPayload<ublox::view::NavSvinfoColumns, NavSvinfo, NavSvinfo::FieldIdx_numCh>();
+    testShortPayload<ublox::view::RxmRawColumns, RxmRaw, RxmRaw::FieldIdx_numSV>();
+    testShortPayload<ublox::view::RxmSvsiColumns, RxmSvsi, RxmSvsi::FieldIdx_numSV>();
+    testNavSvinfoAccessors();
+    testMonIo();
+    return ublox::test::result();
+}
+
+
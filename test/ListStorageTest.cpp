@@ -0,0 +1,145 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Checks the list capacity limits of option::FixedListStorage: CFG-GNSS
+// and NAV-SVINFO with the number of blocks up to and above the capacity of
+// the list, compared with the default dynamic storage.
+
+#include <cstdint>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#include "ublox/options.h"
+#include "ublox/message/CfgGnss.h"
+#include "ublox/message/NavSvinfo.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+typedef ublox::option::FixedListStorage FixedListStorage;
+
+std::vector<std::uint8_t> cfgGnssPayload(std::size_t blocks)
+{
+    static const std::size_t BlockLength = 8U;
+    std::vector<std::uint8_t> payload(4U + (blocks * BlockLength));
+    payload[1] = 32U;
+    payload[2] = 32U;
+    payload[3] = static_cast<std::uint8_t>(blocks);
+    for (std::size_t idx = 0U; idx < blocks; ++idx) {
+        auto offset = 4U + (idx * BlockLength);
+        payload[offset] = (idx % 2U) == 0U ? 0U : 6U; // GPS or GLONASS
+        payload[offset + 1U] = static_cast<std::uint8_t>(idx);
+        payload[offset + 2U] = 16U;
+        ublox::test::putValue<std::uint32_t>(payload, offset + 4U, 1U);
+    }
+    return payload;
+}
+
+std::vector<std::uint8_t> navSvinfoPayload(std::size_t channels)
+{
+    static const std::size_t BlockLength = 12U;
+    std::vector<std::uint8_t> payload(8U + (channels * BlockLength));
+    ublox::test::putValue<std::uint32_t>(payload, 0U, 123456U);
+    payload[4] = static_cast<std::uint8_t>(channels);
+    for (std::size_t idx = 0U; idx < channels; ++idx) {
+        auto offset = 8U + (idx * BlockLength);
+        payload[offset] = static_cast<std::uint8_t>(idx);
+        payload[offset + 1U] = static_cast<std::uint8_t>(idx + 1U);
+        payload[offset + 4U] = 40U;
+    }
+    return payload;
+}
+
+template <typename TMsg>
+comms::ErrorStatus read(TMsg& msg, const std::vector<std::uint8_t>& payload)
+{
+    typename TMsg::ReadIterator iter = payload.data();
+    return msg.read(iter, payload.size());
+}
+
+template <typename TMsg, typename TFunc>
+void checkCapacity(
+    std::size_t capacity,
+    TFunc&& buildPayload,
+    std::size_t (*listSize)(const TMsg&))
+{
+    for (std::size_t count = 0U; count <= capacity + 1U; ++count) {
+        TMsg msg;
+        auto es = read(msg, buildPayload(count));
+        if (count <= capacity) {
+            UBLOX_TEST_CHECK(es == comms::ErrorStatus::Success);
+            UBLOX_TEST_CHECK(listSize(msg) == count);
+        }
+        else {
+            UBLOX_TEST_CHECK(es == comms::ErrorStatus::InvalidMsgData);
+        }
+    }
+}
+
+template <typename TMsg>
+std::size_t cfgGnssBlocks(const TMsg& msg)
+{
+    return std::get<TMsg::FieldIdx_blocksList>(msg.fields()).value().size();
+}
+
+template <typename TMsg>
+std::size_t navSvinfoChannels(const TMsg& msg)
+{
+    return std::get<TMsg::FieldIdx_data>(msg.fields()).value().size();
+}
+
+void testCfgGnss()
+{
+    typedef ublox::message::CfgGnss<ublox::Message, FixedListStorage> FixedCfgGnss;
+    typedef ublox::message::CfgGnss<> DynamicCfgGnss;
+
+    checkCapacity<FixedCfgGnss>(
+        FixedListStorage::CfgGnssBlocksList, cfgGnssPayload, &cfgGnssBlocks<FixedCfgGnss>);
+
+    DynamicCfgGnss msg;
+    auto count = FixedListStorage::CfgGnssBlocksList + 1U;
+    UBLOX_TEST_CHECK(read(msg, cfgGnssPayload(count)) == comms::ErrorStatus::Success);
+    UBLOX_TEST_CHECK(cfgGnssBlocks(msg) == count);
+}
+
+void testNavSvinfo()
+{
+    typedef ublox::message::NavSvinfo<ublox::Message, FixedListStorage> FixedNavSvinfo;
+    typedef ublox::message::NavSvinfo<> DynamicNavSvinfo;
+
+    checkCapacity<FixedNavSvinfo>(
+        FixedListStorage::NavSvinfoData, navSvinfoPayload, &navSvinfoChannels<FixedNavSvinfo>);
+
+    DynamicNavSvinfo msg;
+    auto count = FixedListStorage::NavSvinfoData + 1U;
+    UBLOX_TEST_CHECK(read(msg, navSvinfoPayload(count)) == comms::ErrorStatus::Success);
+    UBLOX_TEST_CHECK(navSvinfoChannels(msg) == count);
+}
+
+}  // namespace
+
+int main()
+{
+    testCfgGnss();
+    testNavSvinfo();
+    return ublox::test::result();
+}
+
+
@@ -0,0 +1,92 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains helpers of the tests of the views and columnar decoders
+///     of the messages ending with the list of repeated blocks.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "comms/comms.h"
+
+#include "ublox/MsgLayout.h"
+#include "ublox/view/common.h"
+
+namespace ublox
+{
+
+namespace test
+{
+
+/// @brief Generate the payload of the message with pseudo-random contents.
+/// @details The payload consists of the fields preceding the list followed
+///     by @b blocks blocks, the field at @b TCountIdx is set to @b count.
+/// @tparam TMsg Message type, such as message::NavSvinfo.
+/// @tparam TCountIdx Index of the one byte field containing number of blocks.
+template <typename TMsg, std::size_t TCountIdx>
+std::vector<std::uint8_t> listPayload(
+    std::mt19937& gen,
+    std::size_t count,
+    std::size_t blocks)
+{
+    typedef MsgLayout<TMsg> Layout;
+    static_assert(Layout::fieldFixedLength(TCountIdx) && (Layout::fieldMinLength(TCountIdx) == 1U),
+        "The count field is expected to be single byte");
+
+    std::vector<std::uint8_t> payload(Layout::MinLength + (blocks * Layout::BlockLength));
+    for (auto& byte : payload) {
+        byte = static_cast<std::uint8_t>(gen());
+    }
+
+    payload[Layout::fieldOffset(TCountIdx)] = static_cast<std::uint8_t>(count);
+    return payload;
+}
+
+/// @brief Check the value accessed via view against the field of the
+///     decoded message.
+/// @details The field is serialised and read back the way the views read
+///     the payload, and the values are compared bitwise, which covers the
+///     bitfields (accessed as raw values) and NaNs of the floating point
+///     fields.
+template <typename TField>
+bool sameValue(
+    const typename view::details::FieldTraits<TField>::ValueType& value,
+    const TField& field)
+{
+    std::uint8_t buf[sizeof(std::uint64_t)] = {0};
+    static_assert(TField::maxLength() <= sizeof(buf), "The field is too long");
+
+    auto* iter = &buf[0];
+    if (field.write(iter, sizeof(buf)) != comms::ErrorStatus::Success) {
+        return false;
+    }
+
+    auto expected = view::details::readValue<TField>(&buf[0]);
+    return std::memcmp(&expected, &value, sizeof(value)) == 0;
+}
+
+}  // namespace test
+
+}  // namespace ublox
+
+
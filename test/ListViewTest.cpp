@@ -0,0 +1,199 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Walks the blocks of NAV-SVINFO, RXM-RAW and RXM-SVSI payloads with the
+// cursor of the list views and compares every accessed value with the
+// fields of the message read from the same payload. Also checks the
+// rejection of the payloads too short for the reported number of blocks,
+// the empty lists and the behaviour of the cursor past the last block.
+
+#include <cstdint>
+#include <cstddef>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "ublox/message/NavSvinfo.h"
+#include "ublox/message/RxmRaw.h"
+#include "ublox/message/RxmSvsi.h"
+#include "ublox/view/NavSvinfoView.h"
+#include "ublox/view/RxmRawView.h"
+#include "ublox/view/RxmSvsiView.h"
+
+#include "TestCommon.h"
+#include "ListTestCommon.h"
+
+namespace
+{
+
+typedef ublox::message::NavSvinfo<> NavSvinfo;
+typedef ublox::message::RxmRaw<> RxmRaw;
+typedef ublox::message::RxmSvsi<> RxmSvsi;
+
+static const std::size_t BlockCounts[] = {0U, 1U, 12U, 72U, 255U};
+
+template <typename TMsg>
+bool readMsg(TMsg& msg, const std::vector<std::uint8_t>& payload)
+{
+    const std::uint8_t* iter = payload.data();
+    return msg.read(iter, payload.size()) == comms::ErrorStatus::Success;
+}
+
+template <typename TView, typename TFields, std::size_t... TIdx>
+void checkFields(const TView& view, const TFields& fields, ublox::details::IndexSeq<TIdx...>)
+{
+    int dummy[] = {(UBLOX_TEST_CHECK(ublox::test::sameValue(view.template field<TIdx>().value(), std::get<TIdx>(fields))), 0)...};
+    static_cast<void>(dummy);
+}
+
+template <typename TView, typename TMsg, std::size_t TCountIdx>
+void testView()
+{
+    typedef typename TView::Cursor::BlockView BlockView;
+    typedef typename ublox::details::MakeIndexSeq<TView::ListIdx>::Type HeaderFields;
+    typedef typename ublox::details::MakeIndexSeq<
+        std::tuple_size<typename BlockView::AllFields>::value
+    >::Type BlockFields;
+
+    std::mt19937 gen(TCountIdx);
+    for (auto count : BlockCounts) {
+        auto payload = ublox::test::listPayload<TMsg, TCountIdx>(gen, count, count);
+        TMsg msg;
+        UBLOX_TEST_CHECK(readMsg(msg, payload));
+
+        TView view;
+        UBLOX_TEST_CHECK(view.attach(payload.data(), payload.size()) == comms::ErrorStatus::Success);
+        UBLOX_TEST_CHECK(view.attached());
+        UBLOX_TEST_CHECK(view.count() == count);
+        checkFields(view, msg.fields(), HeaderFields());
+
+        auto& blocks = std::get<TView::ListIdx>(msg.fields()).value();
+        UBLOX_TEST_CHECK(blocks.size() == count);
+
+        auto cursor = view.blocks();
+        std::size_t idx = 0U;
+        while (cursor.next()) {
+            UBLOX_TEST_CHECK(cursor.block().attached());
+            UBLOX_TEST_CHECK(cursor.remaining() == (count - idx - 1U));
+            if (idx < blocks.size()) {
+                checkFields(cursor.block(), blocks[idx].value(), BlockFields());
+            }
+            ++idx;
+        }
+
+        UBLOX_TEST_CHECK(idx == count);
+        UBLOX_TEST_CHECK(!cursor.block().attached());
+        UBLOX_TEST_CHECK(!cursor.next());
+    }
+}
+
+template <typename TView, typename TMsg, std::size_t TCountIdx>
+void testBounds()
+{
+    std::mt19937 gen(TCountIdx);
+    TView view;
+
+    // One block is missing
+    auto payload = ublox::test::listPayload<TMsg, TCountIdx>(gen, 5U, 4U);
+    UBLOX_TEST_CHECK(view.attach(payload.data(), payload.size()) == comms::ErrorStatus::NotEnoughData);
+    UBLOX_TEST_CHECK(!view.attached());
+    UBLOX_TEST_CHECK(view.count() == 0U);
+    UBLOX_TEST_CHECK(!view.blocks().next());
+
+    // Partial block
+    payload.resize(payload.size() + TView::BlockLength - 1U);
+    UBLOX_TEST_CHECK(view.attach(payload.data(), payload.size()) == comms::ErrorStatus::NotEnoughData);
+    UBLOX_TEST_CHECK(!view.attached());
+
+    // The whole block
+    payload.resize(payload.size() + 1U);
+    UBLOX_TEST_CHECK(view.attach(payload.data(), payload.size()) == comms::ErrorStatus::Success);
+    UBLOX_TEST_CHECK(view.count() == 5U);
+
+    // No header
+    UBLOX_TEST_CHECK(view.attach(payload.data(), TView::HeaderLength - 1U) == comms::ErrorStatus::NotEnoughData);
+    UBLOX_TEST_CHECK(!view.attached());
+    UBLOX_TEST_CHECK(view.count() == 0U);
+    UBLOX_TEST_CHECK(!view.blocks().next());
+
+    // Extra blocks beyond the reported count are ignored
+    payload = ublox::test::listPayload<TMsg, TCountIdx>(gen, 2U, 6U);
+    UBLOX_TEST_CHECK(view.attach(payload.data(), payload.size()) == comms::ErrorStatus::Success);
+    UBLOX_TEST_CHECK(view.count() == 2U);
+    auto cursor = view.blocks();
+    UBLOX_TEST_CHECK(cursor.remaining() == 2U);
+    UBLOX_TEST_CHECK(cursor.next());
+    UBLOX_TEST_CHECK(cursor.next());
+    UBLOX_TEST_CHECK(!cursor.next());
+
+    typename TView::Cursor detached;
+    UBLOX_TEST_CHECK(detached.remaining() == 0U);
+    UBLOX_TEST_CHECK(!detached.next());
+    UBLOX_TEST_CHECK(!detached.block().attached());
+}
+
+void testNavSvinfoAccessors()
+{
+    typedef ublox::message::NavSvinfoFields Fields;
+    static const std::size_t NumOfChannels = 32U;
+
+    std::mt19937 gen(1U);
+    auto payload = ublox::test::listPayload<NavSvinfo, NavSvinfo::FieldIdx_numCh>(gen, NumOfChannels, NumOfChannels);
+    NavSvinfo msg;
+    UBLOX_TEST_CHECK(readMsg(msg, payload));
+
+    ublox::view::NavSvinfoView view;
+    UBLOX_TEST_CHECK(view.attach(payload.data(), payload.size()) == comms::ErrorStatus::Success);
+    UBLOX_TEST_CHECK(view.iTOW().value() == std::get<NavSvinfo::FieldIdx_iTOW>(msg.fields()).value());
+    UBLOX_TEST_CHECK(view.numCh().value() == NumOfChannels);
+
+    auto& blocks = std::get<NavSvinfo::FieldIdx_data>(msg.fields()).value();
+    UBLOX_TEST_CHECK(blocks.size() == NumOfChannels);
+    auto cursor = view.blocks();
+    for (std::size_t idx = 0U; (idx < blocks.size()) && cursor.next(); ++idx) {
+        auto& members = blocks[idx].value();
+        auto& block = cursor.block();
+        UBLOX_TEST_CHECK(block.chn().value() == std::get<Fields::block_chn>(members).value());
+        UBLOX_TEST_CHECK(block.svid().value() == std::get<Fields::block_svid>(members).value());
+        UBLOX_TEST_CHECK(block.flags().value() == std::get<Fields::block_flags>(members).value());
+        UBLOX_TEST_CHECK(block.quality().value() == std::get<Fields::block_quality>(members).value());
+        UBLOX_TEST_CHECK(block.cno().value() == std::get<Fields::block_cno>(members).value());
+        UBLOX_TEST_CHECK(block.elev().value() == std::get<Fields::block_elev>(members).value());
+        UBLOX_TEST_CHECK(block.azim().value() == std::get<Fields::block_azim>(members).value());
+        UBLOX_TEST_CHECK(block.prRes().value() == std::get<Fields::block_prRes>(members).value());
+        UBLOX_TEST_CHECK(
+            block.prRes().getScaled<double>() ==
+            (static_cast<double>(std::get<Fields::block_prRes>(members).value()) / 100.0));
+    }
+    UBLOX_TEST_CHECK(!cursor.next());
+}
+
+}  // namespace
+
+int main()
+{
+    testView<ublox::view::NavSvinfoView, NavSvinfo, NavSvinfo::FieldIdx_numCh>();
+    testView<ublox::view::RxmRawView, RxmRaw, RxmRaw::FieldIdx_numSV>();
+    testView<ublox::view::RxmSvsiView, RxmSvsi, RxmSvsi::FieldIdx_numSV>();
+    testBounds<ublox::view::NavSvinfoView, NavSvinfo, NavSvinfo::FieldIdx_numCh>();
+    testBounds<ublox::view::RxmRawView, RxmRaw, RxmRaw::FieldIdx_numSV>();
+    testBounds<ublox::view::RxmSvsiView, RxmSvsi, RxmSvsi::FieldIdx_numSV>();
+    testNavSvinfoAccessors();
+    return ublox::test::result();
+}
+
+
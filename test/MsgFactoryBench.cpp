@@ -0,0 +1,134 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Compares the direct indexed lookup of MsgFactory with the binary search
+// over the sorted message IDs, which is the lookup the MsgIdLayer of the
+// COMMS library performs by default, on NAV heavy mix of the message IDs.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "ublox/InputMessages.h"
+#include "ublox/MsgFactory.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+typedef ublox::MsgFactory<ublox::Message, ublox::InputMessages<> > Factory;
+typedef std::pair<std::uint16_t, std::size_t> IdEntry;
+
+std::vector<IdEntry> sortedIds()
+{
+    std::vector<IdEntry> ids;
+    for (std::size_t idx = 0U; idx < Factory::NumOfMessages; ++idx) {
+        ids.push_back(IdEntry(static_cast<std::uint16_t>(Factory::msgIdOf(idx)), idx));
+    }
+
+    std::stable_sort(ids.begin(), ids.end(),
+        [](const IdEntry& first, const IdEntry& second)
+        {
+            return first.first < second.first;
+        });
+    return ids;
+}
+
+std::size_t binarySearch(const std::vector<IdEntry>& ids, ublox::MsgId id)
+{
+    auto iter =
+        std::lower_bound(ids.begin(), ids.end(), static_cast<std::uint16_t>(id),
+            [](const IdEntry& entry, std::uint16_t value)
+            {
+                return entry.first < value;
+            });
+
+    if ((iter == ids.end()) || (iter->first != static_cast<std::uint16_t>(id))) {
+        return Factory::NumOfMessages;
+    }
+    return iter->second;
+}
+
+std::vector<ublox::MsgId> navHeavyMix()
+{
+    static const std::size_t NumOfIds = 1000000U;
+    static const std::pair<ublox::MsgId, unsigned> Weights[] = {
+        {ublox::MsgId_NAV_PVT, 20U},
+        {ublox::MsgId_NAV_SOL, 10U},
+        {ublox::MsgId_NAV_POSLLH, 10U},
+        {ublox::MsgId_NAV_VELNED, 10U},
+        {ublox::MsgId_NAV_TIMEGPS, 10U},
+        {ublox::MsgId_NAV_DOP, 10U},
+        {ublox::MsgId_NAV_SVINFO, 10U},
+        {ublox::MsgId_NAV_STATUS, 5U},
+        {ublox::MsgId_RXM_RAW, 5U},
+        {ublox::MsgId_RXM_SFRB, 4U},
+        {ublox::MsgId_MON_HW, 2U},
+        {ublox::MsgId_ACK_ACK, 2U},
+        {ublox::MsgId_CFG_PRT, 1U},
+        {ublox::MsgId_INF_NOTICE, 1U}
+    };
+
+    std::vector<ublox::MsgId> mix;
+    for (auto& weight : Weights) {
+        mix.insert(mix.end(), (NumOfIds * weight.second) / 100U, weight.first);
+    }
+
+    std::shuffle(mix.begin(), mix.end(), std::minstd_rand(1U));
+    return mix;
+}
+
+}  // namespace
+
+int main()
+{
+    auto ids = sortedIds();
+    auto mix = navHeavyMix();
+
+    for (unsigned id = 0U; id <= 0xffffU; ++id) {
+        auto msgId = static_cast<ublox::MsgId>(id);
+        UBLOX_TEST_CHECK(Factory::firstIndex(msgId) == binarySearch(ids, msgId));
+    }
+
+    static const std::size_t Repeat = 20U;
+    auto iterations = mix.size() * Repeat;
+    auto directNs =
+        ublox::test::measureNs(iterations,
+            [&mix](std::size_t idx)
+            {
+                ublox::test::consume(Factory::firstIndex(mix[idx % mix.size()]));
+            });
+
+    auto searchNs =
+        ublox::test::measureNs(iterations,
+            [&mix, &ids](std::size_t idx)
+            {
+                ublox::test::consume(binarySearch(ids, mix[idx % mix.size()]));
+            });
+
+    std::printf("messages: %zu, lookups: %zu\n", Factory::NumOfMessages, iterations);
+    std::printf("direct index:  %6.2f ns/lookup\n", directNs);
+    std::printf("binary search: %6.2f ns/lookup\n", searchNs);
+    return ublox::test::result();
+}
+
+
@@ -0,0 +1,171 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Checks the selection of the message type by the payload length and
+// contents done by MsgFactory (including the fallback to the extended
+// message), and that the frames rejected by the payload length check of
+// the protocol stack are the ones MsgFactory doesn't select any type for.
+
+#include <cstdint>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#include "ublox/MsgFactory.h"
+#include "ublox/MsgLayout.h"
+#include "ublox/Stack.h"
+#include "ublox/message/CfgPrtUart.h"
+#include "ublox/message/CfgPrtUsb.h"
+#include "ublox/message/CfgPrtSpi.h"
+#include "ublox/message/CfgPrtDdc.h"
+#include "ublox/message/NavPvt.h"
+#include "ublox/message/NavSvinfo.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+typedef ublox::message::CfgPrtUart<> CfgPrtUart;
+typedef ublox::message::CfgPrtUsb<> CfgPrtUsb;
+typedef ublox::message::CfgPrtSpi<> CfgPrtSpi;
+typedef ublox::message::CfgPrtDdc<> CfgPrtDdc;
+typedef ublox::message::NavPvt<> NavPvt;
+typedef ublox::message::NavSvinfo<> NavSvinfo;
+typedef std::tuple<CfgPrtUart, CfgPrtUsb, CfgPrtSpi, CfgPrtDdc, NavPvt, NavSvinfo> AllMessages;
+typedef ublox::MsgFactory<ublox::Message, AllMessages> Factory;
+
+static const std::size_t CfgPrtLength = ublox::MsgLayout<CfgPrtUart>::MaxLength;
+static const std::size_t NavPvtLength = ublox::MsgLayout<NavPvt>::MaxLength;
+static const std::size_t NavSvinfoMinLength = ublox::MsgLayout<NavSvinfo>::MinLength;
+static const std::size_t NavSvinfoBlockLength = ublox::MsgLayout<NavSvinfo>::BlockLength;
+
+std::size_t selectIndex(ublox::MsgId id, std::size_t len, std::uint8_t key = 0U)
+{
+    std::vector<std::uint8_t> payload(len, 0U);
+    if (!payload.empty()) {
+        payload[0] = key;
+    }
+    return Factory::selectIndex(id, payload.data(), payload.size());
+}
+
+void testSelectIndex()
+{
+    static const std::size_t None = Factory::NumOfMessages;
+
+    UBLOX_TEST_CHECK(selectIndex(ublox::MsgId_CFG_PRT, CfgPrtLength, 0U) == 3U);
+    UBLOX_TEST_CHECK(selectIndex(ublox::MsgId_CFG_PRT, CfgPrtLength, 1U) == 0U);
+    UBLOX_TEST_CHECK(selectIndex(ublox::MsgId_CFG_PRT, CfgPrtLength, 2U) == 0U);
+    UBLOX_TEST_CHECK(selectIndex(ublox::MsgId_CFG_PRT, CfgPrtLength, 3U) == 1U);
+    UBLOX_TEST_CHECK(selectIndex(ublox::MsgId_CFG_PRT, CfgPrtLength, 4U) == 2U);
+    UBLOX_TEST_CHECK(selectIndex(ublox::MsgId_CFG_PRT, CfgPrtLength, 5U) == None);
+    UBLOX_TEST_CHECK(selectIndex(ublox::MsgId_CFG_PRT, CfgPrtLength - 1U, 1U) == None);
+    UBLOX_TEST_CHECK(selectIndex(ublox::MsgId_CFG_PRT, 0U) == None);
+
+    // Extended by newer protocol version, the type is still selected by the key
+    UBLOX_TEST_CHECK(selectIndex(ublox::MsgId_CFG_PRT, CfgPrtLength + 4U, 3U) == 1U);
+    UBLOX_TEST_CHECK(selectIndex(ublox::MsgId_CFG_PRT, CfgPrtLength + 4U, 5U) == None);
+
+    UBLOX_TEST_CHECK(selectIndex(ublox::MsgId_NAV_PVT, NavPvtLength) == 4U);
+    UBLOX_TEST_CHECK(selectIndex(ublox::MsgId_NAV_PVT, NavPvtLength + 8U) == 4U);
+    UBLOX_TEST_CHECK(selectIndex(ublox::MsgId_NAV_PVT, NavPvtLength - 1U) == None);
+
+    UBLOX_TEST_CHECK(selectIndex(ublox::MsgId_NAV_SVINFO, NavSvinfoMinLength) == 5U);
+    UBLOX_TEST_CHECK(selectIndex(ublox::MsgId_NAV_SVINFO, NavSvinfoMinLength + (3U * NavSvinfoBlockLength)) == 5U);
+    UBLOX_TEST_CHECK(selectIndex(ublox::MsgId_NAV_SVINFO, NavSvinfoMinLength + NavSvinfoBlockLength + 1U) == None);
+    UBLOX_TEST_CHECK(selectIndex(ublox::MsgId_NAV_SVINFO, NavSvinfoMinLength - 1U) == None);
+
+    UBLOX_TEST_CHECK(selectIndex(ublox::MsgId_NAV_SOL, 52U) == None);
+}
+
+void testValidLength()
+{
+    // Same rule as the one of selectIndex() apart from the key
+    for (std::size_t len = 0U; len < 200U; ++len) {
+        auto pvt = (selectIndex(ublox::MsgId_NAV_PVT, len) < Factory::NumOfMessages);
+        UBLOX_TEST_CHECK(Factory::validLength(ublox::MsgId_NAV_PVT, len) == pvt);
+
+        auto svinfo = (selectIndex(ublox::MsgId_NAV_SVINFO, len) < Factory::NumOfMessages);
+        UBLOX_TEST_CHECK(Factory::validLength(ublox::MsgId_NAV_SVINFO, len) == svinfo);
+
+        auto prt = (selectIndex(ublox::MsgId_CFG_PRT, len, 1U) < Factory::NumOfMessages);
+        UBLOX_TEST_CHECK(Factory::validLength(ublox::MsgId_CFG_PRT, len) == prt);
+    }
+
+    UBLOX_TEST_CHECK(!Factory::validLength(ublox::MsgId_NAV_SOL, 52U));
+}
+
+void testInvalidLengthCount()
+{
+    typedef ublox::Stack<ublox::Message, AllMessages, ublox::option::PayloadLengthCheck> Stack;
+
+    struct Frame
+    {
+        ublox::MsgId m_id;
+        std::size_t m_len;
+        bool m_valid;
+    };
+
+    static const Frame Frames[] = {
+        {ublox::MsgId_NAV_PVT, NavPvtLength, true},
+        {ublox::MsgId_NAV_PVT, NavPvtLength + 8U, true},
+        {ublox::MsgId_NAV_PVT, NavPvtLength - 1U, false},
+        {ublox::MsgId_NAV_SVINFO, NavSvinfoMinLength + (2U * NavSvinfoBlockLength), true},
+        {ublox::MsgId_NAV_SVINFO, NavSvinfoMinLength + NavSvinfoBlockLength + 3U, false},
+        {ublox::MsgId_CFG_PRT, CfgPrtLength, true},
+        {ublox::MsgId_CFG_PRT, CfgPrtLength - 1U, false},
+    };
+
+    Stack stack;
+    std::size_t invalidCount = 0U;
+    for (auto& frame : Frames) {
+        std::vector<std::uint8_t> payload(frame.m_len, 0U);
+        payload[0] = 1U;
+        std::vector<std::uint8_t> buf;
+        ublox::test::appendFrame(buf, frame.m_id, payload);
+
+        Stack::MsgPtr msg;
+        const std::uint8_t* iter = buf.data();
+        auto es = stack.read(msg, iter, buf.size());
+        if (frame.m_valid) {
+            UBLOX_TEST_CHECK(es == comms::ErrorStatus::Success);
+            UBLOX_TEST_CHECK(static_cast<bool>(msg));
+        }
+        else {
+            ++invalidCount;
+            UBLOX_TEST_CHECK(es == comms::ErrorStatus::ProtocolError);
+            UBLOX_TEST_CHECK(!msg);
+        }
+
+        UBLOX_TEST_CHECK(stack.nextLayer().nextLayer().nextLayer().invalidLengthCount() == invalidCount);
+    }
+
+    stack.nextLayer().nextLayer().nextLayer().resetInvalidLengthCount();
+    UBLOX_TEST_CHECK(stack.nextLayer().nextLayer().nextLayer().invalidLengthCount() == 0U);
+}
+
+}  // namespace
+
+int main()
+{
+    testSelectIndex();
+    testValidLength();
+    testInvalidLengthCount();
+    return ublox::test::result();
+}
+
+
@@ -0,0 +1,156 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Checks the compile time layout tables of MsgLayout against the run time
+// serialisation lengths of the fields of all the input messages.
+
+#include <cstdint>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+#include "ublox/MsgLayout.h"
+#include "ublox/InputMessages.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+static const std::size_t NumOfBlocks = 3U;
+
+template <typename TLayout, typename TFields, std::size_t TIdx, std::size_t TCount>
+struct FieldsChecker
+{
+    static void check(const TFields& fields, std::size_t offset, bool fixedOffset)
+    {
+        auto len = std::get<TIdx>(fields).length();
+        UBLOX_TEST_CHECK(TLayout::fieldMinLength(TIdx) <= len);
+        UBLOX_TEST_CHECK(len <= TLayout::fieldMaxLength(TIdx));
+        if (TLayout::fieldFixedLength(TIdx)) {
+            UBLOX_TEST_CHECK(len == TLayout::fieldMinLength(TIdx));
+        }
+
+        UBLOX_TEST_CHECK(TLayout::fieldFixedOffset(TIdx) == fixedOffset);
+        if (fixedOffset) {
+            UBLOX_TEST_CHECK(TLayout::fieldOffset(TIdx) == offset);
+        }
+        else {
+            UBLOX_TEST_CHECK(TLayout::fieldOffset(TIdx) <= offset);
+        }
+
+        FieldsChecker<TLayout, TFields, TIdx + 1, TCount>::check(
+            fields,
+            offset + len,
+            fixedOffset && TLayout::fieldFixedLength(TIdx));
+    }
+};
+
+template <typename TLayout, typename TFields, std::size_t TCount>
+struct FieldsChecker<TLayout, TFields, TCount, TCount>
+{
+    static void check(const TFields&, std::size_t offset, bool fixedOffset)
+    {
+        if (fixedOffset) {
+            UBLOX_TEST_CHECK(TLayout::fieldOffset(TCount) == offset);
+        }
+    }
+};
+
+template <typename TMsg>
+void checkFields(const TMsg& msg)
+{
+    typedef ublox::MsgLayout<TMsg> Layout;
+    typedef typename TMsg::AllFields AllFields;
+    FieldsChecker<Layout, AllFields, 0U, Layout::NumOfFields>::check(msg.fields(), 0U, true);
+}
+
+template <typename TMsg>
+void addBlocks(TMsg&, std::false_type)
+{
+}
+
+template <typename TMsg>
+void addBlocks(TMsg& msg, std::true_type)
+{
+    typedef ublox::MsgLayout<TMsg> Layout;
+    auto& list = std::get<Layout::NumOfFields - 1>(msg.fields()).value();
+    list.resize(NumOfBlocks);
+}
+
+template <typename TMsg>
+void checkMessage()
+{
+    typedef ublox::MsgLayout<TMsg> Layout;
+    static const bool HasBlocks = (Layout::BlockLength != 0U);
+
+    TMsg msg;
+    auto len = msg.length();
+    UBLOX_TEST_CHECK(Layout::MinLength <= len);
+    UBLOX_TEST_CHECK(len <= Layout::MaxLength);
+    UBLOX_TEST_CHECK(Layout::validLength(len));
+    if (Layout::FixedLength) {
+        UBLOX_TEST_CHECK(len == Layout::MinLength);
+        UBLOX_TEST_CHECK(!Layout::validLength(len + 1U));
+    }
+    checkFields(msg);
+
+    if (!HasBlocks) {
+        return;
+    }
+
+    UBLOX_TEST_CHECK(len == Layout::MinLength);
+    addBlocks(msg, std::integral_constant<bool, HasBlocks>());
+    len = msg.length();
+    UBLOX_TEST_CHECK(len == Layout::MinLength + (NumOfBlocks * Layout::BlockLength));
+    UBLOX_TEST_CHECK(Layout::validLength(len));
+    if (1U < Layout::BlockLength) {
+        UBLOX_TEST_CHECK(!Layout::validLength(len + 1U));
+    }
+    checkFields(msg);
+}
+
+template <typename TMessages>
+struct MessagesChecker;
+
+template <>
+struct MessagesChecker<std::tuple<> >
+{
+    static void check()
+    {
+    }
+};
+
+template <typename TFirst, typename... TRest>
+struct MessagesChecker<std::tuple<TFirst, TRest...> >
+{
+    static void check()
+    {
+        checkMessage<TFirst>();
+        MessagesChecker<std::tuple<TRest...> >::check();
+    }
+};
+
+}  // namespace
+
+int main()
+{
+    MessagesChecker<ublox::InputMessages<> >::check();
+    return ublox::test::result();
+}
+
+
@@ -0,0 +1,287 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Checks that the message objects recycled by MsgPool are reset to their
+// default state without losing the capacity of their list and string
+// fields, the usage statistics of the pool, and the reading through the
+// protocol stack with option::PooledAllocation: reset of the optional
+// fields and no allocation once the pool is warmed up.
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "ublox/MsgPool.h"
+#include "ublox/Stack.h"
+#include "ublox/message/NavPvt.h"
+#include "ublox/message/NavSol.h"
+#include "ublox/message/NavSvinfo.h"
+#include "ublox/message/RxmRaw.h"
+#include "ublox/message/InfNotice.h"
+#include "ublox/message/AidAop.h"
+#include "ublox/sim/Generator.h"
+
+#include "TestCommon.h"
+#include "AllocCounter.h"
+
+namespace
+{
+
+typedef ublox::message::NavPvt<> NavPvt;
+typedef ublox::message::NavSvinfo<> NavSvinfo;
+typedef ublox::message::InfNotice<> InfNotice;
+typedef std::tuple<NavPvt, NavSvinfo, InfNotice> AllMessages;
+typedef ublox::MsgPool<ublox::Message, AllMessages> Pool;
+
+void testListCapacity()
+{
+    static const std::size_t NumOfChannels = 32U;
+    static const std::size_t Idx = Pool::indexOf<NavSvinfo>();
+
+    Pool pool;
+    const void* data = nullptr;
+    {
+        auto msg = pool.createByIndex(Idx);
+        auto& fields = static_cast<NavSvinfo&>(*msg).fields();
+        std::get<NavSvinfo::FieldIdx_iTOW>(fields).value() = 123456U;
+        std::get<NavSvinfo::FieldIdx_numCh>(fields).value() = NumOfChannels;
+        auto& list = std::get<NavSvinfo::FieldIdx_data>(fields).value();
+        list.resize(NumOfChannels);
+        data = list.data();
+    }
+
+    auto msg = pool.createByIndex(Idx);
+    UBLOX_TEST_CHECK(pool.createdCount(Idx) == 1U);
+
+    auto& fields = static_cast<NavSvinfo&>(*msg).fields();
+    UBLOX_TEST_CHECK(std::get<NavSvinfo::FieldIdx_iTOW>(fields).value() == 0U);
+    UBLOX_TEST_CHECK(std::get<NavSvinfo::FieldIdx_numCh>(fields).value() == 0U);
+
+    auto& list = std::get<NavSvinfo::FieldIdx_data>(fields).value();
+    UBLOX_TEST_CHECK(list.empty());
+    UBLOX_TEST_CHECK(NumOfChannels <= list.capacity());
+    UBLOX_TEST_CHECK(list.data() == data);
+}
+
+void testStringCapacity()
+{
+    static const std::size_t Length = 200U;
+    static const std::size_t Idx = Pool::indexOf<InfNotice>();
+
+    Pool pool;
+    {
+        auto msg = pool.createByIndex(Idx);
+        auto& fields = static_cast<InfNotice&>(*msg).fields();
+        std::get<InfNotice::FieldIdx_str>(fields).value().assign(Length, 'x');
+    }
+
+    auto msg = pool.createByIndex(Idx);
+    auto& str = std::get<InfNotice::FieldIdx_str>(static_cast<InfNotice&>(*msg).fields()).value();
+    UBLOX_TEST_CHECK(str.empty());
+    UBLOX_TEST_CHECK(Length <= str.capacity());
+}
+
+void testScalars()
+{
+    static const std::size_t Idx = Pool::indexOf<NavPvt>();
+
+    Pool pool;
+    {
+        auto msg = pool.createByIndex(Idx);
+        auto& fields = static_cast<NavPvt&>(*msg).fields();
+        std::get<NavPvt::FieldIdx_iTOW>(fields).value() = 1000U;
+        std::get<NavPvt::FieldIdx_numSV>(fields).value() = 12U;
+    }
+
+    auto msg = pool.createByIndex(Idx);
+    auto& fields = static_cast<NavPvt&>(*msg).fields();
+    UBLOX_TEST_CHECK(std::get<NavPvt::FieldIdx_iTOW>(fields).value() == 0U);
+    UBLOX_TEST_CHECK(std::get<NavPvt::FieldIdx_numSV>(fields).value() == 0U);
+}
+
+void testStatistics()
+{
+    static const std::size_t Idx = Pool::indexOf<NavPvt>();
+    static const std::size_t NumOfMsgs = 3U * Pool::DefaultCapacity;
+
+    Pool pool;
+    std::vector<Pool::MsgPtr> msgs;
+    for (std::size_t idx = 0U; idx < NumOfMsgs; ++idx) {
+        msgs.push_back(pool.createByIndex(Idx));
+    }
+
+    UBLOX_TEST_CHECK(pool.inUseCount(Idx) == NumOfMsgs);
+    UBLOX_TEST_CHECK(pool.freeCount(Idx) == 0U);
+    UBLOX_TEST_CHECK(pool.createdCount(Idx) == NumOfMsgs);
+    UBLOX_TEST_CHECK(pool.highWaterMark(Idx) == NumOfMsgs);
+    UBLOX_TEST_CHECK(pool.highWaterMark<NavPvt>() == NumOfMsgs);
+    UBLOX_TEST_CHECK(pool.inUseCount(Pool::indexOf<NavSvinfo>()) == 0U);
+
+    // Returning the objects to the pool (beyond its initial capacity)
+    // doesn't allocate.
+    ublox::test::AllocCounter::start();
+    msgs.resize(1U);
+    UBLOX_TEST_CHECK(ublox::test::AllocCounter::stop() == 0U);
+
+    UBLOX_TEST_CHECK(pool.inUseCount(Idx) == 1U);
+    UBLOX_TEST_CHECK(pool.freeCount(Idx) == NumOfMsgs - 1U);
+    UBLOX_TEST_CHECK(pool.highWaterMark(Idx) == NumOfMsgs);
+
+    msgs.push_back(pool.createByIndex(Idx));
+    UBLOX_TEST_CHECK(pool.inUseCount(Idx) == 2U);
+    UBLOX_TEST_CHECK(pool.freeCount(Idx) == NumOfMsgs - 2U);
+    UBLOX_TEST_CHECK(pool.createdCount(Idx) == NumOfMsgs);
+
+    msgs.clear();
+    UBLOX_TEST_CHECK(pool.inUseCount(Idx) == 0U);
+    UBLOX_TEST_CHECK(pool.freeCount(Idx) == NumOfMsgs);
+
+    pool.clear();
+    UBLOX_TEST_CHECK(pool.freeCount(Idx) == 0U);
+    UBLOX_TEST_CHECK(pool.highWaterMark(Idx) == NumOfMsgs);
+}
+
+template <typename TStack>
+comms::ErrorStatus readFrame(TStack& stack, typename TStack::MsgPtr& msg, const std::vector<std::uint8_t>& frame)
+{
+    const std::uint8_t* iter = frame.data();
+    return stack.read(msg, iter, frame.size());
+}
+
+void testOptionalReset()
+{
+    typedef ublox::message::AidAop<> AidAop;
+    typedef ublox::Stack<ublox::Message, std::tuple<AidAop>, ublox::option::PooledAllocation> Stack;
+    static const std::size_t ShortLength = 60U;
+    static const std::size_t LongLength = 204U;
+
+    std::vector<std::uint8_t> shortFrame;
+    ublox::test::appendFrame(shortFrame, ublox::MsgId_AID_AOP, std::vector<std::uint8_t>(ShortLength, 0x11));
+    std::vector<std::uint8_t> longFrame;
+    ublox::test::appendFrame(longFrame, ublox::MsgId_AID_AOP, std::vector<std::uint8_t>(LongLength, 0x22));
+
+    Stack stack;
+    const std::vector<std::uint8_t>* frames[] = {&longFrame, &shortFrame, &longFrame, &shortFrame};
+    for (auto* frame : frames) {
+        Stack::MsgPtr msg;
+        UBLOX_TEST_CHECK(readFrame(stack, msg, *frame) == comms::ErrorStatus::Success);
+        if (!msg) {
+            continue;
+        }
+
+        auto expectedLength = frame->size() - ublox::FrameView::OverheadLength;
+        UBLOX_TEST_CHECK(msg->length() == expectedLength);
+
+        auto& optional = std::get<AidAop::FieldIdx_optional>(static_cast<AidAop&>(*msg).fields());
+        auto expectedMode =
+            (expectedLength == LongLength) ?
+                comms::field::OptionalMode::Exists :
+                comms::field::OptionalMode::Missing;
+        UBLOX_TEST_CHECK(optional.getMode() == expectedMode);
+    }
+
+    auto& pool = stack.nextLayer().nextLayer().nextLayer().msgPool();
+    UBLOX_TEST_CHECK(pool.createdCount(0U) == 1U);
+}
+
+void testStack()
+{
+    typedef std::tuple<
+        ublox::message::NavPvt<>,
+        ublox::message::NavSol<>,
+        ublox::message::NavSvinfo<>,
+        ublox::message::RxmRaw<>
+    > Messages;
+    typedef ublox::Stack<ublox::Message, Messages, ublox::option::PooledAllocation> Stack;
+    static const std::size_t NumOfEpochs = 100U;
+    static const std::size_t NumOfMessages = std::tuple_size<Messages>::value;
+
+    ublox::sim::GeneratorConfig config;
+    config.channels = 32U;
+    config.svs = 16U;
+    config.rxmRawRate = 1U;
+    ublox::sim::Generator<> generator(config);
+    std::vector<std::uint8_t> stream;
+    for (std::size_t idx = 0U; idx < NumOfEpochs; ++idx) {
+        generator.epoch(stream);
+    }
+
+    Stack stack;
+    auto& pool = stack.nextLayer().nextLayer().nextLayer().msgPool();
+    typedef typename std::remove_reference<decltype(pool)>::type StackPool;
+    auto replay =
+        [&stack, &stream](std::vector<Stack::MsgPtr>& held) -> std::size_t
+        {
+            std::size_t count = 0U;
+            const std::uint8_t* iter = stream.data();
+            const std::uint8_t* end = iter + stream.size();
+            while (iter < end) {
+                Stack::MsgPtr msg;
+                if (stack.read(msg, iter, static_cast<std::size_t>(end - iter)) != comms::ErrorStatus::Success) {
+                    break;
+                }
+
+                ++count;
+                if (held.size() < held.capacity()) {
+                    held.push_back(std::move(msg));
+                }
+            }
+            return count;
+        };
+
+    // Warm up, the first epoch is held
+    std::vector<Stack::MsgPtr> held;
+    held.reserve(NumOfMessages);
+    UBLOX_TEST_CHECK(replay(held) == NumOfEpochs * NumOfMessages);
+    for (std::size_t idx = 0U; idx < NumOfMessages; ++idx) {
+        UBLOX_TEST_CHECK(pool.inUseCount(idx) == 1U);
+        UBLOX_TEST_CHECK(pool.highWaterMark(idx) == 2U);
+        UBLOX_TEST_CHECK(pool.createdCount(idx) == 2U);
+        UBLOX_TEST_CHECK(pool.freeCount(idx) == 1U);
+    }
+
+    held.clear();
+    for (std::size_t idx = 0U; idx < NumOfMessages; ++idx) {
+        UBLOX_TEST_CHECK(pool.inUseCount(idx) == 0U);
+        UBLOX_TEST_CHECK(pool.freeCount(idx) == 2U);
+    }
+
+    // Neither the message objects nor their lists are allocated again
+    ublox::test::AllocCounter::start();
+    auto count = replay(held);
+    UBLOX_TEST_CHECK(ublox::test::AllocCounter::stop() == 0U);
+    UBLOX_TEST_CHECK(count == NumOfEpochs * NumOfMessages);
+    UBLOX_TEST_CHECK(pool.createdCount(StackPool::indexOf<ublox::message::NavSvinfo<> >()) == 2U);
+}
+
+}  // namespace
+
+int main()
+{
+    testListCapacity();
+    testStringCapacity();
+    testScalars();
+    testStatistics();
+    testOptionalReset();
+    testStack();
+    return ublox::test::result();
+}
+
+
@@ -0,0 +1,172 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Measures NavStateStore with a single writer publishing NAV-PVT updates
+// and 32 concurrent readers during the fixed period: update and read
+// rates, rate of the read retries, and consistency of the snapshots.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "ublox/NavStateStore.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+typedef ublox::message::NavPvt<> NavPvt;
+
+static const std::size_t NumOfReaders = 32U;
+static const std::chrono::milliseconds Duration(500);
+static const std::size_t UpdatesPerClockCheck = 256U;
+
+struct Result
+{
+    std::size_t updates = 0U;
+    std::size_t reads = 0U;
+    std::size_t retries = 0U;
+    std::size_t inconsistent = 0U;
+    double durationMs = 0.0;
+};
+
+void setValues(NavPvt& msg, std::uint32_t value)
+{
+    auto& fields = msg.fields();
+    std::get<NavPvt::FieldIdx_iTOW>(fields).value() = value;
+    std::get<NavPvt::FieldIdx_lat>(fields).value() = static_cast<std::int32_t>(value);
+    std::get<NavPvt::FieldIdx_lon>(fields).value() = static_cast<std::int32_t>(value);
+    std::get<NavPvt::FieldIdx_hAcc>(fields).value() = value;
+}
+
+bool consistent(const ublox::NavState& state)
+{
+    return
+        (state.iTOW == state.updates) &&
+        (static_cast<std::uint32_t>(state.lat) == state.iTOW) &&
+        (static_cast<std::uint32_t>(state.lon) == state.iTOW) &&
+        (state.hAcc == state.iTOW);
+}
+
+Result run(std::size_t readers)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    ublox::NavStateStore store;
+    std::atomic<bool> stop(false);
+    std::atomic<std::size_t> started(0U);
+    std::atomic<std::size_t> reads(0U);
+    std::atomic<std::size_t> retries(0U);
+    std::atomic<std::size_t> inconsistent(0U);
+
+    std::vector<std::thread> threads;
+    for (std::size_t idx = 0U; idx < readers; ++idx) {
+        threads.emplace_back(
+            [&]()
+            {
+                std::size_t localReads = 0U;
+                std::size_t localRetries = 0U;
+                std::size_t localInconsistent = 0U;
+                ublox::NavState state;
+                started.fetch_add(1U);
+                while (!stop.load(std::memory_order_relaxed)) {
+                    if (!store.tryRead(state)) {
+                        ++localRetries;
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    ++localReads;
+                    if (!consistent(state)) {
+                        ++localInconsistent;
+                    }
+                }
+                reads.fetch_add(localReads);
+                retries.fetch_add(localRetries);
+                inconsistent.fetch_add(localInconsistent);
+            });
+    }
+
+    while (started.load() < readers) {
+        std::this_thread::yield();
+    }
+
+    NavPvt msg;
+    std::size_t updates = 0U;
+    auto start = Clock::now();
+    auto deadline = start + Duration;
+    do {
+        for (std::size_t idx = 0U; idx < UpdatesPerClockCheck; ++idx) {
+            ++updates;
+            setValues(msg, static_cast<std::uint32_t>(updates));
+            store.handle(msg);
+        }
+    } while (Clock::now() < deadline);
+
+    stop = true;
+    std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    Result result;
+    result.durationMs = elapsed.count();
+    result.updates = updates;
+    result.reads = reads;
+    result.retries = retries;
+    result.inconsistent = inconsistent;
+    UBLOX_TEST_CHECK(store.updateCount() == updates);
+    return result;
+}
+
+void report(std::size_t readers, const Result& result)
+{
+    auto attempts = result.reads + result.retries;
+    std::printf(
+        "%2zu reader(s): %8.2f M updates/s, %8.2f M reads/s, "
+        "retries %5.2f%%, inconsistent %zu\n",
+        readers,
+        static_cast<double>(result.updates) / (result.durationMs * 1000.0),
+        static_cast<double>(result.reads) / (result.durationMs * 1000.0),
+        (attempts == 0U) ? 0.0 : (100.0 * static_cast<double>(result.retries) / static_cast<double>(attempts)),
+        result.inconsistent);
+}
+
+}  // namespace
+
+int main()
+{
+    std::printf("%u hardware thread(s), %lld ms per run\n",
+        std::thread::hardware_concurrency(),
+        static_cast<long long>(Duration.count()));
+
+    auto idle = run(0U);
+    report(0U, idle);
+
+    auto loaded = run(NumOfReaders);
+    report(NumOfReaders, loaded);
+
+    UBLOX_TEST_CHECK(loaded.inconsistent == 0U);
+    return ublox::test::result();
+}
+
+
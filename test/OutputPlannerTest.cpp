@@ -0,0 +1,171 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// Checks OutputPlanner: the worst case frame lengths of fixed, list and
+// variable length messages, evaluation of the average output and the burst
+// against the link budget and the transmit buffer, and the suggested rates,
+// which are doubled up to 255 before any of the messages is disabled.
+
+#include <cstdint>
+#include <cstddef>
+#include <tuple>
+
+#include "ublox/OutputPlanner.h"
+#include "ublox/message/AidAlm.h"
+#include "ublox/message/NavPvt.h"
+#include "ublox/message/NavSvinfo.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+typedef ublox::message::AidAlm<> AidAlm;
+typedef ublox::message::NavPvt<> NavPvt;
+typedef ublox::message::NavSvinfo<> NavSvinfo;
+typedef ublox::OutputPlanner<std::tuple<NavPvt, NavSvinfo, AidAlm> > Planner;
+
+static const std::size_t PvtFrameLength = ublox::expectedFrameLength<NavPvt>();
+static const std::size_t SvinfoFrameLength =
+    ublox::expectedFrameLength<NavSvinfo>(ublox::option::FixedListStorage::NavSvinfoData);
+
+std::uint8_t rateOf(const Planner::MsgRates& rates, ublox::MsgId id)
+{
+    for (auto& entry : rates) {
+        if (entry.id == id) {
+            return entry.rate;
+        }
+    }
+    return 0U;
+}
+
+Planner makePlanner(double capacity, std::uint8_t pvtRate, std::uint8_t svinfoRate)
+{
+    Planner planner;
+    planner.setLinkCapacity(capacity);
+    planner.setUtilisation(100U);
+    planner.setMsgRate(ublox::MsgId_NAV_PVT, pvtRate);
+    planner.setMsgRate(ublox::MsgId_NAV_SVINFO, svinfoRate);
+    return planner;
+}
+
+void testFrameLength()
+{
+    Planner planner;
+    UBLOX_TEST_CHECK(planner.frameLength(ublox::MsgId_NAV_PVT) == PvtFrameLength);
+    UBLOX_TEST_CHECK(planner.frameLength(ublox::MsgId_NAV_SVINFO) == SvinfoFrameLength);
+    UBLOX_TEST_CHECK(planner.frameLength(ublox::MsgId_AID_ALM) == ublox::maxFrameLength<AidAlm>());
+    UBLOX_TEST_CHECK(planner.frameLength(ublox::MsgId_NAV_SOL) == 0U);
+    UBLOX_TEST_CHECK(!planner.setMsgRate(ublox::MsgId_NAV_SOL, 1U));
+
+    UBLOX_TEST_CHECK(planner.setFrameLength(ublox::MsgId_AID_ALM, 20U));
+    UBLOX_TEST_CHECK(planner.frameLength(ublox::MsgId_AID_ALM) == 20U);
+}
+
+void testEvaluate()
+{
+    auto planner = makePlanner(1000.0, 1U, 2U);
+    auto plan = planner.evaluate();
+    UBLOX_TEST_CHECK(plan.bytesPerSecond == PvtFrameLength + (SvinfoFrameLength / 2.0));
+    UBLOX_TEST_CHECK(plan.burstLength == PvtFrameLength + SvinfoFrameLength);
+    UBLOX_TEST_CHECK(plan.budget == 1000.0);
+    UBLOX_TEST_CHECK(plan.feasible);
+
+    planner.setUtilisation(50U);
+    plan = planner.evaluate();
+    UBLOX_TEST_CHECK(plan.budget == 500.0);
+    UBLOX_TEST_CHECK(!plan.rateFits);
+    UBLOX_TEST_CHECK(plan.burstFits);
+    UBLOX_TEST_CHECK(!plan.feasible);
+
+    // Twice as many epochs per second
+    planner.setUtilisation(100U);
+    planner.setMeasPeriod(500U);
+    plan = planner.evaluate();
+    UBLOX_TEST_CHECK(plan.bytesPerSecond == (2.0 * PvtFrameLength) + SvinfoFrameLength);
+    UBLOX_TEST_CHECK(!plan.rateFits);
+
+    planner.setMeasPeriod(1000U);
+    planner.setTxBufferLength(SvinfoFrameLength);
+    plan = planner.evaluate();
+    UBLOX_TEST_CHECK(plan.rateFits);
+    UBLOX_TEST_CHECK(!plan.burstFits);
+    UBLOX_TEST_CHECK(!plan.feasible);
+}
+
+void testSuggestReduce()
+{
+    // The NAV-SVINFO contribution is the largest one until its rate is 8,
+    // after which the total output fits.
+    auto planner = makePlanner(300.0, 1U, 1U);
+    auto rates = planner.suggest();
+    UBLOX_TEST_CHECK(rateOf(rates, ublox::MsgId_NAV_PVT) == 1U);
+    UBLOX_TEST_CHECK(rateOf(rates, ublox::MsgId_NAV_SVINFO) == 8U);
+    UBLOX_TEST_CHECK(rateOf(rates, ublox::MsgId_AID_ALM) == 0U);
+
+    // Current rates are not modified
+    UBLOX_TEST_CHECK(rateOf(planner.rates(), ublox::MsgId_NAV_SVINFO) == 1U);
+
+    for (auto& entry : rates) {
+        planner.setMsgRate(entry.id, entry.rate);
+    }
+    UBLOX_TEST_CHECK(planner.evaluate().feasible);
+}
+
+void testSuggestMaxRate()
+{
+    // Doubling the rate of NAV-SVINFO exceeds 255, capped rate fits.
+    auto planner = makePlanner(SvinfoFrameLength / 250.0, 0U, 200U);
+    auto rates = planner.suggest();
+    UBLOX_TEST_CHECK(rateOf(rates, ublox::MsgId_NAV_SVINFO) == 255U);
+
+    // NAV-SVINFO can't be reduced any further, NAV-PVT is reduced instead.
+    planner = makePlanner(SvinfoFrameLength / 200.0, 1U, 255U);
+    rates = planner.suggest();
+    UBLOX_TEST_CHECK(rateOf(rates, ublox::MsgId_NAV_SVINFO) == 255U);
+    UBLOX_TEST_CHECK(rateOf(rates, ublox::MsgId_NAV_PVT) == 128U);
+
+    // Nothing fits, both are disabled once they are output every 255 epochs.
+    planner = makePlanner(0.0, 1U, 100U);
+    rates = planner.suggest();
+    UBLOX_TEST_CHECK(rateOf(rates, ublox::MsgId_NAV_SVINFO) == 0U);
+    UBLOX_TEST_CHECK(rateOf(rates, ublox::MsgId_NAV_PVT) == 0U);
+}
+
+void testSuggestBurst()
+{
+    auto planner = makePlanner(100000.0, 1U, 1U);
+    planner.setMsgRate(ublox::MsgId_AID_ALM, 1U);
+    planner.setTxBufferLength(SvinfoFrameLength);
+    auto rates = planner.suggest();
+    UBLOX_TEST_CHECK(rateOf(rates, ublox::MsgId_NAV_SVINFO) == 0U);
+    UBLOX_TEST_CHECK(rateOf(rates, ublox::MsgId_NAV_PVT) == 1U);
+    UBLOX_TEST_CHECK(rateOf(rates, ublox::MsgId_AID_ALM) == 1U);
+}
+
+}  // namespace
+
+int main()
+{
+    testFrameLength();
+    testEvaluate();
+    testSuggestReduce();
+    testSuggestMaxRate();
+    testSuggestBurst();
+    return ublox::test::result();
+}
+
+
@@ -0,0 +1,159 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Measures the scaling of ParallelDecoder from 1 to N worker threads
+// compared with the sequential decoding of the same capture.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "ublox/Stack.h"
+#include "ublox/message/NavPvt.h"
+#include "ublox/message/NavSol.h"
+#include "ublox/message/NavSvinfo.h"
+#include "ublox/message/RxmRaw.h"
+#include "ublox/capture/ParallelDecoder.h"
+#include "ublox/sim/Generator.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+typedef std::tuple<
+    ublox::message::NavPvt<>,
+    ublox::message::NavSol<>,
+    ublox::message::NavSvinfo<>,
+    ublox::message::RxmRaw<>
+> Messages;
+
+typedef ublox::Stack<ublox::Message, Messages> Stack;
+typedef ublox::capture::ParallelDecoder<Stack> Decoder;
+typedef ublox::capture::DecodeStats DecodeStats;
+
+static const std::size_t NumOfEpochs = 4096U;
+static const std::size_t NumOfCopies = 8U;
+static const std::size_t ChunkLength = 1024U * 1024U;
+
+std::vector<std::uint8_t> buildCapture()
+{
+    ublox::sim::GeneratorConfig config;
+    config.channels = 32U;
+    config.svs = 16U;
+    config.rxmRawRate = 1U;
+
+    ublox::sim::Generator<> generator(config);
+    std::vector<std::uint8_t> epochs;
+    for (std::size_t idx = 0U; idx < NumOfEpochs; ++idx) {
+        generator.epoch(epochs);
+    }
+
+    std::vector<std::uint8_t> capture;
+    capture.reserve(epochs.size() * NumOfCopies);
+    for (std::size_t idx = 0U; idx < NumOfCopies; ++idx) {
+        capture.insert(capture.end(), epochs.begin(), epochs.end());
+    }
+    return capture;
+}
+
+template <typename TFunc>
+double measureMs(TFunc&& func)
+{
+    typedef std::chrono::steady_clock Clock;
+    auto start = Clock::now();
+    func();
+    std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* name, std::size_t threads, double ms, double sequentialMs, std::size_t len)
+{
+    std::printf("%-10s %2zu thread(s): %8.1f ms, %7.1f MB/s, x%.2f\n",
+        name, threads, ms, static_cast<double>(len) / (ms * 1000.0), sequentialMs / ms);
+}
+
+}  // namespace
+
+int main()
+{
+    auto capture = buildCapture();
+    auto* data = capture.data();
+    auto len = capture.size();
+
+    std::size_t maxThreads = std::max(4U, std::thread::hardware_concurrency());
+    std::printf("capture: %zu bytes, %u hardware thread(s)\n",
+        len, std::thread::hardware_concurrency());
+
+    DecodeStats expected;
+    auto sequentialMs =
+        measureMs(
+            [&]()
+            {
+                expected =
+                    Decoder::decodeSequential(data, len,
+                        [](Stack::MsgPtr& msg)
+                        {
+                            ublox::test::consume(msg->length());
+                        });
+            });
+    UBLOX_TEST_CHECK(expected.messages == NumOfEpochs * NumOfCopies * 4U);
+    report("sequential", 1U, sequentialMs, sequentialMs, len);
+
+    for (std::size_t threads = 1U; threads <= maxThreads; threads *= 2U) {
+        Decoder decoder(threads, ChunkLength);
+        std::atomic<std::size_t> messages(0U);
+        auto ms =
+            measureMs(
+                [&]()
+                {
+                    decoder.decodeUnordered(data, len,
+                        [&messages](std::size_t, Stack::MsgPtr& msg)
+                        {
+                            ublox::test::consume(msg->length());
+                            messages.fetch_add(1U, std::memory_order_relaxed);
+                        });
+                });
+        UBLOX_TEST_CHECK(messages == expected.messages);
+        report("unordered", threads, ms, sequentialMs, len);
+
+        std::size_t ordered = 0U;
+        ms =
+            measureMs(
+                [&]()
+                {
+                    decoder.decodeOrdered(data, len,
+                        [&ordered](Stack::MsgPtr& msg)
+                        {
+                            ublox::test::consume(msg->length());
+                            ++ordered;
+                        });
+                });
+        UBLOX_TEST_CHECK(ordered == expected.messages);
+        report("ordered", threads, ms, sequentialMs, len);
+    }
+
+    return ublox::test::result();
+}
+
+
@@ -0,0 +1,168 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Checks that ParallelDecoder decodes exactly the same frames as the
+// sequential decoding, including the streams where the split points fall
+// into the payloads containing embedded ("phantom") frames.
+
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <tuple>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "ublox/Stack.h"
+#include "ublox/message/NavPvt.h"
+#include "ublox/message/NavSol.h"
+#include "ublox/message/NavSvinfo.h"
+#include "ublox/message/RxmRaw.h"
+#include "ublox/capture/ParallelDecoder.h"
+#include "ublox/sim/Generator.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+typedef std::tuple<
+    ublox::message::NavPvt<>,
+    ublox::message::NavSol<>,
+    ublox::message::NavSvinfo<>,
+    ublox::message::RxmRaw<>
+> Messages;
+
+typedef ublox::Stack<ublox::Message, Messages> Stack;
+typedef ublox::capture::ParallelDecoder<Stack> Decoder;
+typedef ublox::capture::DecodeStats DecodeStats;
+
+// Type and length of every decoded message
+typedef std::vector<std::pair<std::size_t, std::size_t> > Signature;
+
+static const std::size_t NumOfEpochs = 500U;
+
+// Not known to the stack
+static const ublox::MsgId CarrierId = static_cast<ublox::MsgId>(0x2101);
+
+void addEpochs(std::vector<std::uint8_t>& stream, std::size_t count)
+{
+    ublox::sim::GeneratorConfig config;
+    config.rxmRawRate = 1U;
+    ublox::sim::Generator<> generator(config);
+    for (std::size_t idx = 0U; idx < count; ++idx) {
+        generator.epoch(stream);
+    }
+}
+
+std::vector<std::uint8_t> buildPhantomStream()
+{
+    std::vector<std::uint8_t> stream;
+
+    // Valid frame followed by garbage, preceded by garbage
+    stream.insert(stream.end(), {0x00, 0xb5, 0x62, 0x01});
+    ublox::test::appendFrame(stream, CarrierId, std::vector<std::uint8_t>(10, 0x55));
+    stream.insert(stream.end(), {0xb5, 0x62, 0x01, 0x02, 0x03});
+
+    // Carrier frames containing valid frames of other messages in the
+    // payload interleaved with the frames of the epochs.
+    for (std::size_t idx = 0U; idx < NumOfEpochs; ++idx) {
+        std::vector<std::uint8_t> payload(idx % 7U, 0x00);
+        addEpochs(payload, 1U + (idx % 3U));
+        ublox::test::appendFrame(stream, CarrierId, payload);
+        addEpochs(stream, 1U);
+    }
+    return stream;
+}
+
+template <typename TMsgPtr>
+std::pair<std::size_t, std::size_t> entry(const TMsgPtr& msg)
+{
+    auto& ref = *msg;
+    return std::make_pair(typeid(ref).hash_code(), msg->length());
+}
+
+bool sameStats(const DecodeStats& first, const DecodeStats& second)
+{
+    return
+        (first.frames == second.frames) &&
+        (first.messages == second.messages) &&
+        (first.failures == second.failures) &&
+        (first.bytes == second.bytes) &&
+        (first.skipped == second.skipped);
+}
+
+void checkStream(const std::vector<std::uint8_t>& stream)
+{
+    Signature expected;
+    auto expectedStats =
+        Decoder::decodeSequential(stream.data(), stream.size(),
+            [&expected](Stack::MsgPtr& msg)
+            {
+                expected.push_back(entry(msg));
+            });
+    UBLOX_TEST_CHECK(expectedStats.bytes + expectedStats.skipped == stream.size());
+
+    static const std::size_t ChunkLengths[] = {16U, 100U, 1000U, 4096U, 1024U * 1024U};
+    static const std::size_t Threads[] = {1U, 3U};
+    for (auto chunkLength : ChunkLengths) {
+        for (auto threads : Threads) {
+            Decoder decoder(threads, chunkLength);
+
+            Signature ordered;
+            auto stats =
+                decoder.decodeOrdered(stream.data(), stream.size(),
+                    [&ordered](Stack::MsgPtr& msg)
+                    {
+                        ordered.push_back(entry(msg));
+                    });
+            UBLOX_TEST_CHECK(sameStats(stats, expectedStats));
+            UBLOX_TEST_CHECK(ordered == expected);
+
+            auto chunks = decoder.split(stream.data(), stream.size());
+            std::vector<Signature> byChunk(chunks.size());
+            std::mutex lock;
+            stats =
+                decoder.decodeUnordered(stream.data(), stream.size(),
+                    [&byChunk, &lock](std::size_t chunkIdx, Stack::MsgPtr& msg)
+                    {
+                        std::lock_guard<std::mutex> guard(lock);
+                        byChunk[chunkIdx].push_back(entry(msg));
+                    });
+            UBLOX_TEST_CHECK(sameStats(stats, expectedStats));
+
+            Signature unordered;
+            for (auto& s : byChunk) {
+                unordered.insert(unordered.end(), s.begin(), s.end());
+            }
+            UBLOX_TEST_CHECK(unordered == expected);
+        }
+    }
+}
+
+}  // namespace
+
+int main()
+{
+    std::vector<std::uint8_t> plain;
+    addEpochs(plain, NumOfEpochs);
+    checkStream(plain);
+    checkStream(buildPhantomStream());
+    return ublox::test::result();
+}
+
+
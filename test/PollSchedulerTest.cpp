@@ -0,0 +1,202 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Checks PollScheduler with the polls answered by multiple frames (AID-ALM):
+// the budget of the worst case length of all the frames, and the poll
+// pending until all the frames are received or the timeout (extended by
+// the transmission time of the frames) expires.
+
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <vector>
+
+#include "ublox/PollScheduler.h"
+#include "ublox/message/AidAlm.h"
+#include "ublox/message/AidAlmPoll.h"
+#include "ublox/message/MonHw.h"
+#include "ublox/message/MonHwPoll.h"
+#include "ublox/message/MonIo.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+typedef ublox::PollScheduler PollScheduler;
+typedef ublox::message::AidAlm<> AidAlm;
+typedef ublox::message::MonHw<> MonHw;
+
+static const std::size_t NumOfSvs = 32U;
+static const std::size_t AlmFrameLength = ublox::FrameView::OverheadLength + 40U;
+
+struct Sender
+{
+    std::vector<ublox::MsgId> sent;
+
+    PollScheduler::SendHandler handler()
+    {
+        return
+            [this](const std::uint8_t* data, std::size_t)
+            {
+                sent.push_back(
+                    static_cast<ublox::MsgId>(
+                        (static_cast<unsigned>(data[2]) << 8) | data[3]));
+                return true;
+            };
+    }
+};
+
+void testFrameLength()
+{
+    UBLOX_TEST_CHECK(ublox::maxFrameLength<AidAlm>() == AlmFrameLength);
+    UBLOX_TEST_CHECK(ublox::expectedFrameLength<AidAlm>() < AlmFrameLength);
+    UBLOX_TEST_CHECK(ublox::maxFrameLength<MonHw>() == ublox::expectedFrameLength<MonHw>());
+    UBLOX_TEST_CHECK(
+        ublox::maxFrameLength<ublox::message::MonIo<> >(3U) ==
+        ublox::expectedFrameLength<ublox::message::MonIo<> >(3U));
+}
+
+void testMultipleFrames()
+{
+    auto now = PollScheduler::Clock::now();
+    Sender sender;
+    PollScheduler scheduler(sender.handler());
+    scheduler.setBurstLength(0U);
+
+    auto almPoll =
+        scheduler.add<AidAlm>(
+            ublox::message::AidAlmPoll<>(), PollScheduler::Duration::zero(), 0U, NumOfSvs, now);
+    UBLOX_TEST_CHECK(almPoll != PollScheduler::InvalidPoll);
+    UBLOX_TEST_CHECK(scheduler.trigger(almPoll, now));
+
+    auto hwPoll =
+        scheduler.add<MonHw>(
+            ublox::message::MonHwPoll<>(), std::chrono::seconds(10), 0U, 1U, now);
+    UBLOX_TEST_CHECK(hwPoll != PollScheduler::InvalidPoll);
+
+    // The bucket fits all the AID-ALM frames only, MON-HW waits for refill
+    scheduler.tick(now);
+    UBLOX_TEST_CHECK(sender.sent.size() == 1U);
+    UBLOX_TEST_CHECK(!sender.sent.empty() && sender.sent[0] == ublox::MsgId_AID_ALM);
+
+    auto refill =
+        std::chrono::duration<double>(
+            static_cast<double>(ublox::expectedFrameLength<MonHw>()) / scheduler.responseBudget());
+    scheduler.tick(now + std::chrono::duration_cast<PollScheduler::Duration>(refill / 2));
+    UBLOX_TEST_CHECK(sender.sent.size() == 1U);
+
+    now += std::chrono::duration_cast<PollScheduler::Duration>(refill * 1.1);
+    scheduler.tick(now);
+    UBLOX_TEST_CHECK(sender.sent.size() == 2U);
+
+    for (std::size_t idx = 0U; idx < (NumOfSvs - 1U); ++idx) {
+        UBLOX_TEST_CHECK(scheduler.received(ublox::MsgId_AID_ALM));
+    }
+    UBLOX_TEST_CHECK(!scheduler.trigger(almPoll, now));
+
+    UBLOX_TEST_CHECK(scheduler.received(ublox::MsgId_AID_ALM));
+    UBLOX_TEST_CHECK(!scheduler.received(ublox::MsgId_AID_ALM));
+    UBLOX_TEST_CHECK(scheduler.trigger(almPoll, now));
+    UBLOX_TEST_CHECK(scheduler.missedCount() == 0U);
+}
+
+void testTimeout()
+{
+    auto now = PollScheduler::Clock::now();
+    auto timeout = std::chrono::milliseconds(500);
+    Sender sender;
+    PollScheduler scheduler(sender.handler());
+    scheduler.setResponseTimeout(timeout);
+
+    auto almPoll =
+        scheduler.add<AidAlm>(
+            ublox::message::AidAlmPoll<>(), PollScheduler::Duration::zero(), 0U, NumOfSvs, now);
+    UBLOX_TEST_CHECK(scheduler.trigger(almPoll, now));
+    scheduler.tick(now);
+    UBLOX_TEST_CHECK(sender.sent.size() == 1U);
+
+    for (std::size_t idx = 0U; idx < (NumOfSvs / 2U); ++idx) {
+        UBLOX_TEST_CHECK(scheduler.received(ublox::MsgId_AID_ALM));
+    }
+
+    auto transmission =
+        std::chrono::duration_cast<PollScheduler::Duration>(
+            std::chrono::duration<double>(
+                static_cast<double>(NumOfSvs * AlmFrameLength) / scheduler.responseBudget()));
+
+    scheduler.tick(now + timeout);
+    UBLOX_TEST_CHECK(scheduler.missedCount() == 0U);
+    UBLOX_TEST_CHECK(!scheduler.trigger(almPoll, now + timeout));
+
+    scheduler.tick(now + timeout + (transmission / 2));
+    UBLOX_TEST_CHECK(scheduler.missedCount() == 0U);
+
+    now += timeout + transmission;
+    scheduler.tick(now);
+    UBLOX_TEST_CHECK(scheduler.missedCount() == 1U);
+    UBLOX_TEST_CHECK(!scheduler.received(ublox::MsgId_AID_ALM));
+    UBLOX_TEST_CHECK(scheduler.trigger(almPoll, now));
+}
+
+// The frames are transmitted at the rate available to the responses, the
+// last one arrives long after the timeout alone would expire.
+void testLinkRate()
+{
+    auto now = PollScheduler::Clock::now();
+    auto timeout = std::chrono::milliseconds(200);
+    Sender sender;
+    PollScheduler scheduler(sender.handler());
+    scheduler.setResponseTimeout(timeout);
+
+    auto almPoll =
+        scheduler.add<AidAlm>(
+            ublox::message::AidAlmPoll<>(), std::chrono::seconds(60), 0U, NumOfSvs, now);
+    scheduler.tick(now);
+    UBLOX_TEST_CHECK(sender.sent.size() == 1U);
+
+    auto interval =
+        std::chrono::duration_cast<PollScheduler::Duration>(
+            std::chrono::duration<double>(
+                static_cast<double>(AlmFrameLength) / scheduler.responseBudget()));
+    UBLOX_TEST_CHECK(timeout < (interval * NumOfSvs));
+
+    for (std::size_t idx = 0U; idx < NumOfSvs; ++idx) {
+        now += interval;
+        scheduler.tick(now);
+        UBLOX_TEST_CHECK(scheduler.missedCount() == 0U);
+        UBLOX_TEST_CHECK(scheduler.received(ublox::MsgId_AID_ALM));
+    }
+
+    UBLOX_TEST_CHECK(!scheduler.received(ublox::MsgId_AID_ALM));
+    UBLOX_TEST_CHECK(scheduler.trigger(almPoll, now));
+    UBLOX_TEST_CHECK(scheduler.missedCount() == 0U);
+    UBLOX_TEST_CHECK(sender.sent.size() == 1U);
+}
+
+}  // namespace
+
+int main()
+{
+    testFrameLength();
+    testMultipleFrames();
+    testTimeout();
+    testLinkRate();
+    return ublox::test::result();
+}
+
+
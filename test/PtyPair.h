@@ -0,0 +1,131 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains pseudo terminal helper of the Linux only tests.
+
+#pragma once
+
+#ifndef __linux__
+#error "PtyPair.h is used by the Linux only tests"
+#endif
+
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace ublox
+{
+
+namespace test
+{
+
+/// @brief Pair of connected pseudo terminal descriptors in raw mode.
+/// @details The master side is expected to be added to the tested engine,
+///     the slave side plays the role of the receiver. The slave side is
+///     non-blocking.
+class PtyPair
+{
+public:
+    PtyPair() = default;
+    PtyPair(const PtyPair&) = delete;
+    PtyPair& operator=(const PtyPair&) = delete;
+
+    ~PtyPair()
+    {
+        closeMaster();
+        closeSlave();
+    }
+
+    /// @brief Open the pair.
+    bool open()
+    {
+        m_master = ::posix_openpt(O_RDWR | O_NOCTTY);
+        if ((m_master < 0) || (::grantpt(m_master) != 0) || (::unlockpt(m_master) != 0)) {
+            return false;
+        }
+
+        auto* name = ::ptsname(m_master);
+        if (name == nullptr) {
+            return false;
+        }
+
+        m_slave = ::open(name, O_RDWR | O_NOCTTY | O_NONBLOCK);
+        return (0 <= m_slave) && makeRaw(m_master) && makeRaw(m_slave);
+    }
+
+    /// @brief Master descriptor.
+    int master() const
+    {
+        return m_master;
+    }
+
+    /// @brief Slave descriptor.
+    int slave() const
+    {
+        return m_slave;
+    }
+
+    /// @brief Give up the ownership of the master descriptor.
+    int releaseMaster()
+    {
+        auto fd = m_master;
+        m_master = -1;
+        return fd;
+    }
+
+    /// @brief Close the master descriptor.
+    void closeMaster()
+    {
+        if (0 <= m_master) {
+            ::close(m_master);
+            m_master = -1;
+        }
+    }
+
+    /// @brief Close the slave descriptor.
+    void closeSlave()
+    {
+        if (0 <= m_slave) {
+            ::close(m_slave);
+            m_slave = -1;
+        }
+    }
+
+private:
+    static bool makeRaw(int fd)
+    {
+        termios attrs;
+        if (::tcgetattr(fd, &attrs) != 0) {
+            return false;
+        }
+
+        ::cfmakeraw(&attrs);
+        return ::tcsetattr(fd, TCSANOW, &attrs) == 0;
+    }
+
+    int m_master = -1;
+    int m_slave = -1;
+};
+
+}  // namespace test
+
+}  // namespace ublox
+
+
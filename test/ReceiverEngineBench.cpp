@@ -0,0 +1,168 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Measures how many receivers a single core running ReceiverEngine can
+// serve. Every device connected via pseudo terminal pair outputs
+// NAV-PVT, NAV-SOL, NAV-SVINFO (32 channels) and RXM-RAW (16 satellites)
+// at 10 Hz. The processor time of the engine thread spent in poll() is
+// compared with the simulated duration of the output.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <unistd.h>
+
+#include "ublox/Stack.h"
+#include "ublox/message/NavPvt.h"
+#include "ublox/message/NavSol.h"
+#include "ublox/message/NavSvinfo.h"
+#include "ublox/message/RxmRaw.h"
+#include "ublox/io/ReceiverEngine.h"
+#include "ublox/sim/Generator.h"
+
+#include "TestCommon.h"
+#include "PtyPair.h"
+
+namespace
+{
+
+typedef std::tuple<
+    ublox::message::NavPvt<>,
+    ublox::message::NavSol<>,
+    ublox::message::NavSvinfo<>,
+    ublox::message::RxmRaw<>
+> Messages;
+
+typedef ublox::Stack<ublox::Message, Messages, ublox::option::PooledAllocation> Stack;
+typedef ublox::io::ReceiverEngine<Stack> Engine;
+
+static const unsigned MeasPeriodMs = 100U;
+static const std::size_t NumOfEpochs = 100U;
+static const std::size_t MessagesPerEpoch = 4U;
+
+std::vector<std::uint8_t> buildOutput()
+{
+    ublox::sim::GeneratorConfig config;
+    config.measPeriodMs = MeasPeriodMs;
+    config.channels = 32U;
+    config.svs = 16U;
+    config.rxmRawRate = 1U;
+
+    ublox::sim::Generator<> generator(config);
+    std::vector<std::uint8_t> output;
+    for (std::size_t idx = 0U; idx < NumOfEpochs; ++idx) {
+        generator.epoch(output);
+    }
+    return output;
+}
+
+double threadCpuSeconds()
+{
+    timespec ts;
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) + (static_cast<double>(ts.tv_nsec) / 1e9);
+}
+
+void run(std::size_t numOfDevices, const std::vector<std::uint8_t>& output)
+{
+    std::vector<std::unique_ptr<ublox::test::PtyPair> > pairs;
+    Engine engine;
+    std::size_t messages = 0U;
+    for (std::size_t idx = 0U; idx < numOfDevices; ++idx) {
+        pairs.emplace_back(new ublox::test::PtyPair);
+        if (!pairs.back()->open()) {
+            std::printf("failed to open pty pair %zu\n", idx);
+            UBLOX_TEST_CHECK(false);
+            return;
+        }
+
+        engine.addDevice(pairs.back()->releaseMaster(),
+            [&messages](Engine::DeviceId, Stack::MsgPtr& msg)
+            {
+                ublox::test::consume(msg->length());
+                ++messages;
+            });
+    }
+
+    double engineCpu = 0.0;
+    auto poll =
+        [&engine, &engineCpu](int timeoutMs) -> int
+        {
+            auto start = threadCpuSeconds();
+            auto result = engine.poll(timeoutMs);
+            engineCpu += threadCpuSeconds() - start;
+            return result;
+        };
+
+    std::vector<std::size_t> offsets(numOfDevices, 0U);
+    bool more = true;
+    while (more) {
+        more = false;
+        for (std::size_t idx = 0U; idx < numOfDevices; ++idx) {
+            auto& offset = offsets[idx];
+            if (output.size() <= offset) {
+                continue;
+            }
+
+            more = true;
+            auto count = ::write(pairs[idx]->slave(), &output[offset], output.size() - offset);
+            if (0 < count) {
+                offset += static_cast<std::size_t>(count);
+            }
+        }
+
+        while (0 < poll(0)) {
+        }
+    }
+
+    while (0 < poll(20)) {
+    }
+
+    UBLOX_TEST_CHECK(messages == numOfDevices * NumOfEpochs * MessagesPerEpoch);
+
+    auto simulatedSeconds = static_cast<double>(NumOfEpochs * MeasPeriodMs) / 1000.0;
+    auto bytes = static_cast<double>(output.size() * numOfDevices);
+    std::printf(
+        "%4zu devices: engine %7.1f ms CPU for %.0f s of output, %6.1f MB/s, "
+        "%5.1f%% of core, %6.0f devices per core\n",
+        numOfDevices,
+        engineCpu * 1000.0,
+        simulatedSeconds,
+        bytes / (engineCpu * 1e6),
+        100.0 * engineCpu / simulatedSeconds,
+        static_cast<double>(numOfDevices) * simulatedSeconds / engineCpu);
+}
+
+}  // namespace
+
+int main()
+{
+    auto output = buildOutput();
+    std::printf("%zu bytes per device per second\n",
+        output.size() * 1000U / (NumOfEpochs * MeasPeriodMs));
+
+    run(100U, output);
+    run(250U, output);
+    return ublox::test::result();
+}
+
+
@@ -0,0 +1,287 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Checks ReceiverEngine serving multiple devices connected via pseudo
+// terminal pairs: delivery of the messages in order per device, sending,
+// closure of the device, removal from the handler and stop request.
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <unistd.h>
+
+#include "ublox/Stack.h"
+#include "ublox/message/NavPvt.h"
+#include "ublox/io/ReceiverEngine.h"
+
+#include "TestCommon.h"
+#include "PtyPair.h"
+
+namespace
+{
+
+typedef ublox::message::NavPvt<> NavPvt;
+typedef ublox::Stack<ublox::Message, std::tuple<NavPvt> > Stack;
+typedef ublox::io::ReceiverEngine<Stack> Engine;
+typedef std::vector<std::unique_ptr<ublox::test::PtyPair> > PtyPairs;
+
+static const int PollTimeoutMs = 20;
+
+std::uint32_t iTOW(Stack::MsgPtr& msg)
+{
+    return std::get<NavPvt::FieldIdx_iTOW>(static_cast<NavPvt&>(*msg).fields()).value();
+}
+
+void appendNavPvt(std::vector<std::uint8_t>& out, std::uint32_t value)
+{
+    std::vector<std::uint8_t> payload(84U, 0U);
+    ublox::test::putValue(payload, 0U, value);
+    ublox::test::appendFrame(out, ublox::MsgId_NAV_PVT, payload);
+}
+
+bool openPairs(PtyPairs& pairs, std::size_t count)
+{
+    for (std::size_t idx = 0U; idx < count; ++idx) {
+        pairs.emplace_back(new ublox::test::PtyPair);
+        if (!pairs.back()->open()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void drain(Engine& engine)
+{
+    while (0 < engine.poll(PollTimeoutMs)) {
+    }
+}
+
+void testMultipleDevices()
+{
+    static const std::size_t NumOfDevices = 16U;
+    static const std::uint32_t NumOfFrames = 200U;
+    static const std::uint8_t Garbage[] = {0x00, 0xb5, 0x00, 0x62, 0xb5};
+
+    PtyPairs pairs;
+    UBLOX_TEST_CHECK(openPairs(pairs, NumOfDevices));
+
+    Engine engine;
+    UBLOX_TEST_CHECK(engine.isOpen());
+
+    std::vector<std::vector<std::uint32_t> > received(NumOfDevices);
+    std::vector<std::vector<std::uint8_t> > streams(NumOfDevices);
+    for (std::size_t idx = 0U; idx < NumOfDevices; ++idx) {
+        auto id =
+            engine.addDevice(pairs[idx]->releaseMaster(),
+                [&received](Engine::DeviceId dev, Stack::MsgPtr& msg)
+                {
+                    received[dev].push_back(iTOW(msg));
+                });
+        UBLOX_TEST_CHECK(id == idx);
+
+        auto& stream = streams[idx];
+        stream.assign(std::begin(Garbage), std::end(Garbage));
+        for (std::uint32_t frame = 0U; frame < NumOfFrames; ++frame) {
+            appendNavPvt(stream, static_cast<std::uint32_t>(idx * 100000U) + frame);
+        }
+    }
+    UBLOX_TEST_CHECK(engine.deviceCount() == NumOfDevices);
+
+    // Write in chunks of various lengths, interleaved between the devices
+    std::vector<std::size_t> offsets(NumOfDevices, 0U);
+    bool more = true;
+    for (std::size_t round = 0U; more; ++round) {
+        more = false;
+        for (std::size_t idx = 0U; idx < NumOfDevices; ++idx) {
+            auto& stream = streams[idx];
+            auto& offset = offsets[idx];
+            if (stream.size() <= offset) {
+                continue;
+            }
+
+            more = true;
+            auto len = std::min(stream.size() - offset, 1U + ((round * 7U + idx * 13U) % 300U));
+            auto count = ::write(pairs[idx]->slave(), &stream[offset], len);
+            if (0 < count) {
+                offset += static_cast<std::size_t>(count);
+            }
+        }
+
+        while (0 < engine.poll(0)) {
+        }
+    }
+    drain(engine);
+
+    for (std::size_t idx = 0U; idx < NumOfDevices; ++idx) {
+        auto& values = received[idx];
+        UBLOX_TEST_CHECK(values.size() == NumOfFrames);
+        for (std::size_t frame = 0U; frame < values.size(); ++frame) {
+            UBLOX_TEST_CHECK(values[frame] == (idx * 100000U) + frame);
+        }
+
+        auto stats = engine.stats(idx);
+        UBLOX_TEST_CHECK(stats.bytes == streams[idx].size());
+        UBLOX_TEST_CHECK(stats.frames == NumOfFrames);
+        UBLOX_TEST_CHECK(stats.messages == NumOfFrames);
+        UBLOX_TEST_CHECK(stats.failures == 0U);
+        UBLOX_TEST_CHECK(stats.skipped == sizeof(Garbage));
+    }
+}
+
+void testSend()
+{
+    static const std::size_t Length = 256U * 1024U;
+
+    ublox::test::PtyPair pair;
+    UBLOX_TEST_CHECK(pair.open());
+
+    Engine engine;
+    auto id = engine.addDevice(pair.releaseMaster(), Engine::MessageHandler());
+
+    std::vector<std::uint8_t> data(Length);
+    for (std::size_t idx = 0U; idx < data.size(); ++idx) {
+        data[idx] = static_cast<std::uint8_t>(idx * 31U);
+    }
+
+    // Larger than the pty buffer, part of it is queued
+    UBLOX_TEST_CHECK(engine.send(id, data.data(), data.size()));
+    UBLOX_TEST_CHECK(engine.pendingOutput(id) != 0U);
+
+    std::vector<std::uint8_t> received;
+    std::vector<std::uint8_t> buf(4096U);
+    for (std::size_t attempt = 0U; (received.size() < Length) && (attempt < 10000U); ++attempt) {
+        engine.poll(1);
+        auto count = ::read(pair.slave(), buf.data(), buf.size());
+        if (0 < count) {
+            received.insert(received.end(), buf.begin(), buf.begin() + count);
+        }
+    }
+
+    UBLOX_TEST_CHECK(received == data);
+    UBLOX_TEST_CHECK(engine.pendingOutput(id) == 0U);
+}
+
+void testClose()
+{
+    PtyPairs pairs;
+    UBLOX_TEST_CHECK(openPairs(pairs, 2U));
+
+    Engine engine;
+    std::vector<Engine::DeviceId> closed;
+    engine.setCloseHandler(
+        [&closed](Engine::DeviceId id, int)
+        {
+            closed.push_back(id);
+        });
+
+    auto first = engine.addDevice(pairs[0]->releaseMaster(), Engine::MessageHandler());
+    auto second = engine.addDevice(pairs[1]->releaseMaster(), Engine::MessageHandler());
+
+    pairs[1]->closeSlave();
+    for (std::size_t attempt = 0U; (closed.empty()) && (attempt < 100U); ++attempt) {
+        engine.poll(PollTimeoutMs);
+    }
+
+    UBLOX_TEST_CHECK((closed.size() == 1U) && (closed[0] == second));
+    UBLOX_TEST_CHECK(!engine.hasDevice(second));
+    UBLOX_TEST_CHECK(engine.hasDevice(first));
+    UBLOX_TEST_CHECK(engine.deviceCount() == 1U);
+
+    // Removed device doesn't invoke close handler
+    UBLOX_TEST_CHECK(engine.removeDevice(first));
+    UBLOX_TEST_CHECK(!engine.removeDevice(first));
+    UBLOX_TEST_CHECK(closed.size() == 1U);
+}
+
+void testRemoveFromHandler()
+{
+    static const std::size_t NumOfFrames = 10U;
+    static const std::size_t RemoveAfter = 3U;
+
+    PtyPairs pairs;
+    UBLOX_TEST_CHECK(openPairs(pairs, 2U));
+
+    Engine engine;
+    std::vector<std::size_t> counts(2U, 0U);
+    std::vector<Engine::DeviceId> ids;
+    for (std::size_t idx = 0U; idx < pairs.size(); ++idx) {
+        ids.push_back(
+            engine.addDevice(pairs[idx]->releaseMaster(),
+                [&engine, &counts](Engine::DeviceId id, Stack::MsgPtr&)
+                {
+                    ++counts[id];
+                    if (counts[id] == RemoveAfter) {
+                        engine.removeDevice(id);
+                    }
+                }));
+    }
+
+    std::vector<std::uint8_t> stream;
+    for (std::size_t frame = 0U; frame < NumOfFrames; ++frame) {
+        appendNavPvt(stream, static_cast<std::uint32_t>(frame));
+    }
+
+    // All the frames arrive in single read
+    for (auto& pair : pairs) {
+        UBLOX_TEST_CHECK(::write(pair->slave(), stream.data(), stream.size()) == static_cast<ssize_t>(stream.size()));
+    }
+    drain(engine);
+
+    UBLOX_TEST_CHECK(counts[ids[0]] == RemoveAfter);
+    UBLOX_TEST_CHECK(counts[ids[1]] == RemoveAfter);
+    UBLOX_TEST_CHECK(engine.deviceCount() == 0U);
+}
+
+void testStop()
+{
+    ublox::test::PtyPair pair;
+    UBLOX_TEST_CHECK(pair.open());
+
+    Engine engine;
+    engine.addDevice(pair.releaseMaster(), Engine::MessageHandler());
+
+    std::thread stopper(
+        [&engine]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            engine.stop();
+        });
+
+    UBLOX_TEST_CHECK(engine.run());
+    stopper.join();
+    UBLOX_TEST_CHECK(engine.deviceCount() == 1U);
+}
+
+}  // namespace
+
+int main()
+{
+    testMultipleDevices();
+    testSend();
+    testClose();
+    testRemoveFromHandler();
+    testStop();
+    return ublox::test::result();
+}
+
+
@@ -0,0 +1,130 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Replays a long stream of NAV and RXM frames through StaticStack while
+// counting the invocations of the global operator new. No allocation is
+// expected when the messages with variable length lists are defined with
+// fixed list storage.
+
+#include <cstdint>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#include "ublox/Stack.h"
+#include "ublox/message/NavPvt.h"
+#include "ublox/message/NavSol.h"
+#include "ublox/message/NavSvinfo.h"
+#include "ublox/message/RxmRaw.h"
+#include "ublox/sim/Generator.h"
+
+#include "TestCommon.h"
+#include "AllocCounter.h"
+
+namespace
+{
+
+static const std::size_t NumOfEpochs = 5000U;
+static const std::size_t NumOfRuns = 4U;
+
+typedef std::tuple<
+    ublox::message::NavPvt<>,
+    ublox::message::NavSol<>,
+    ublox::message::NavSvinfo<ublox::Message, ublox::option::FixedListStorage>,
+    ublox::message::RxmRaw<ublox::Message, ublox::option::FixedListStorage>
+> FixedMessages;
+
+typedef std::tuple<
+    ublox::message::NavPvt<>,
+    ublox::message::NavSol<>,
+    ublox::message::NavSvinfo<>,
+    ublox::message::RxmRaw<>
+> DynamicMessages;
+
+std::size_t buildStream(std::vector<std::uint8_t>& stream)
+{
+    ublox::sim::GeneratorConfig config;
+    config.channels = 32U;
+    config.svs = 16U;
+    config.rxmRawRate = 1U;
+
+    ublox::sim::Generator<> generator(config);
+    std::size_t frames = 0U;
+    for (std::size_t idx = 0U; idx < NumOfEpochs; ++idx) {
+        frames += generator.epoch(stream);
+    }
+    return frames;
+}
+
+template <typename TStack>
+std::size_t replay(TStack& stack, const std::vector<std::uint8_t>& stream)
+{
+    typename TStack::MsgPtr msg;
+    std::size_t count = 0U;
+    const std::uint8_t* iter = stream.data();
+    const std::uint8_t* end = iter + stream.size();
+    while (iter < end) {
+        auto es = stack.read(msg, iter, static_cast<std::size_t>(end - iter));
+        if (es != comms::ErrorStatus::Success) {
+            break;
+        }
+        ++count;
+        msg.reset();
+    }
+    return count;
+}
+
+template <typename TMessages>
+std::size_t countAllocations(
+    const std::vector<std::uint8_t>& stream,
+    std::size_t expectedFrames)
+{
+    // Counted from the construction of the stack and the very first read,
+    // i.e. no warm up allocation is allowed either.
+    ublox::test::AllocCounter::start();
+    ublox::StaticStack<ublox::Message, TMessages> stack;
+    std::size_t frames = 0U;
+    for (std::size_t run = 0U; run < NumOfRuns; ++run) {
+        frames += replay(stack, stream);
+    }
+    auto allocations = ublox::test::AllocCounter::stop();
+
+    UBLOX_TEST_CHECK(frames == expectedFrames * NumOfRuns);
+    return allocations;
+}
+
+}  // namespace
+
+int main()
+{
+    std::vector<std::uint8_t> stream;
+    auto frames = buildStream(stream);
+    UBLOX_TEST_CHECK(frames == NumOfEpochs * 4U);
+
+    auto fixedAllocs = countAllocations<FixedMessages>(stream, frames);
+    auto dynamicAllocs = countAllocations<DynamicMessages>(stream, frames);
+
+    std::printf("%zu frames x %zu runs: %zu allocations with fixed list "
+                "storage, %zu with dynamic list storage\n",
+        frames, NumOfRuns, fixedAllocs, dynamicAllocs);
+
+    UBLOX_TEST_CHECK(fixedAllocs == 0U);
+    UBLOX_TEST_CHECK(dynamicAllocs != 0U);
+    return ublox::test::result();
+}
+
+
@@ -0,0 +1,106 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Compares SyncScanner with the byte by byte search over 1 MiB of garbage
+// containing no synchronisation word, with various densities of the
+// false 0xb5 bytes.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "ublox/protocol/SyncScanner.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+const std::uint8_t* naiveFind(const std::uint8_t* begin, const std::uint8_t* end)
+{
+    for (auto* iter = begin; iter != end; ++iter) {
+        if (*iter != ublox::protocol::SyncChar1) {
+            continue;
+        }
+
+        if (((iter + 1) == end) || (*(iter + 1) == ublox::protocol::SyncChar2)) {
+            return iter;
+        }
+    }
+    return end;
+}
+
+std::vector<std::uint8_t> buildGarbage(std::size_t len, unsigned falseSyncPermille)
+{
+    std::minstd_rand random(1U);
+    std::uniform_int_distribution<unsigned> byteDistr(0U, 0xffU);
+    std::uniform_int_distribution<unsigned> permilleDistr(0U, 999U);
+    std::vector<std::uint8_t> data(len);
+    for (auto& byte : data) {
+        do {
+            byte = static_cast<std::uint8_t>(byteDistr(random));
+        } while ((byte == ublox::protocol::SyncChar1) || (byte == ublox::protocol::SyncChar2));
+
+        if (permilleDistr(random) < falseSyncPermille) {
+            byte = ublox::protocol::SyncChar1;
+        }
+    }
+    return data;
+}
+
+}  // namespace
+
+int main()
+{
+    static const std::size_t DataLength = 1024U * 1024U;
+    static const std::size_t Iterations = 200U;
+    static const unsigned FalseSyncPermilles[] = {0U, 1U, 10U, 100U};
+
+    std::printf("%10s %12s %12s %8s\n", "false b5", "scan MB/s", "naive MB/s", "speedup");
+    for (auto permille : FalseSyncPermilles) {
+        auto data = buildGarbage(DataLength, permille);
+        auto* begin = data.data();
+        auto* end = begin + data.size();
+        UBLOX_TEST_CHECK(ublox::protocol::SyncScanner::find(begin, end) == naiveFind(begin, end));
+
+        auto scanNs =
+            ublox::test::measureNs(Iterations,
+                [begin, end](std::size_t)
+                {
+                    ublox::test::consume(ublox::protocol::SyncScanner::find(begin, end) - begin);
+                });
+
+        auto naiveNs =
+            ublox::test::measureNs(Iterations,
+                [begin, end](std::size_t)
+                {
+                    ublox::test::consume(naiveFind(begin, end) - begin);
+                });
+
+        std::printf("%9.1f%% %12.1f %12.1f %7.1fx\n",
+            static_cast<double>(permille) / 10.0,
+            static_cast<double>(DataLength) * 1000.0 / scanNs,
+            static_cast<double>(DataLength) * 1000.0 / naiveNs,
+            naiveNs / scanNs);
+    }
+
+    return ublox::test::result();
+}
+
+
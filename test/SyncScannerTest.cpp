@@ -0,0 +1,169 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Compares SyncScanner with the naive byte by byte search: random data with
+// dense false 0xb5 bytes, synchronisation word split between the chunks and
+// empty input.
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "ublox/protocol/SyncScanner.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+typedef ublox::protocol::SyncScanner SyncScanner;
+
+const std::uint8_t* naiveFind(const std::uint8_t* begin, const std::uint8_t* end)
+{
+    for (auto* iter = begin; iter != end; ++iter) {
+        if (*iter != ublox::protocol::SyncChar1) {
+            continue;
+        }
+
+        if (((iter + 1) == end) || (*(iter + 1) == ublox::protocol::SyncChar2)) {
+            return iter;
+        }
+    }
+    return end;
+}
+
+std::vector<std::uint8_t> buildData(std::size_t len, unsigned syncPercent, unsigned seed)
+{
+    std::minstd_rand random(seed);
+    std::uniform_int_distribution<unsigned> byteDistr(0U, 0xffU);
+    std::uniform_int_distribution<unsigned> percentDistr(0U, 99U);
+    std::vector<std::uint8_t> data(len);
+    for (auto& byte : data) {
+        auto percent = percentDistr(random);
+        if (percent < syncPercent) {
+            byte = ublox::protocol::SyncChar1;
+        }
+        else if (percent < (2U * syncPercent)) {
+            byte = ublox::protocol::SyncChar2;
+        }
+        else {
+            byte = static_cast<std::uint8_t>(byteDistr(random));
+        }
+    }
+    return data;
+}
+
+void testEmpty()
+{
+    std::uint8_t byte = ublox::protocol::SyncChar1;
+    UBLOX_TEST_CHECK(SyncScanner::find(&byte, &byte) == &byte);
+
+    SyncScanner scanner;
+    const std::uint8_t* iter = &byte;
+    UBLOX_TEST_CHECK(scanner.scan(iter, 0U) == 0U);
+    UBLOX_TEST_CHECK(iter == &byte);
+    UBLOX_TEST_CHECK(scanner.skippedCount() == 0U);
+}
+
+void testFind()
+{
+    static const std::size_t MaxLength = 200U;
+    static const std::size_t Misalignment = 32U;
+    static const unsigned SyncPercents[] = {0U, 1U, 5U, 20U};
+
+    unsigned seed = 1U;
+    for (auto syncPercent : SyncPercents) {
+        for (std::size_t len = 0U; len <= MaxLength; ++len) {
+            auto data = buildData(len + Misalignment, syncPercent, seed++);
+            for (std::size_t offset = 0U; offset < Misalignment; ++offset) {
+                auto* begin = data.data() + offset;
+                auto* end = begin + len;
+                UBLOX_TEST_CHECK(SyncScanner::find(begin, end) == naiveFind(begin, end));
+            }
+        }
+    }
+}
+
+void testFalseSyncChar()
+{
+    // Every 0xb5 is followed by something else than 0x62, except the
+    // last one in the buffer.
+    std::vector<std::uint8_t> data(1000U, ublox::protocol::SyncChar1);
+    auto* begin = data.data();
+    auto* end = begin + data.size();
+    UBLOX_TEST_CHECK(SyncScanner::find(begin, end) == end - 1);
+
+    data.back() = 0x00;
+    UBLOX_TEST_CHECK(SyncScanner::find(begin, end) == end);
+
+    data[700] = ublox::protocol::SyncChar2;
+    UBLOX_TEST_CHECK(SyncScanner::find(begin, end) == begin + 699);
+}
+
+void testChunks()
+{
+    static const std::size_t DataLength = 10000U;
+    static const std::size_t ChunkLengths[] = {1U, 2U, 7U, 16U, 33U, 100U};
+
+    auto data = buildData(DataLength, 2U, 100U);
+    std::vector<std::size_t> expected;
+    for (std::size_t pos = 0U; pos + 1U < data.size(); ++pos) {
+        if ((data[pos] == ublox::protocol::SyncChar1) && (data[pos + 1U] == ublox::protocol::SyncChar2)) {
+            expected.push_back(pos);
+        }
+    }
+    UBLOX_TEST_CHECK(!expected.empty());
+
+    for (auto chunkLength : ChunkLengths) {
+        // The candidate at the end of the chunk is confirmed by appending
+        // the next chunk, like the reader accumulating the input does.
+        SyncScanner scanner;
+        std::vector<std::size_t> found;
+        std::size_t pos = 0U;
+        std::size_t available = 0U;
+        while (pos < data.size()) {
+            available = std::min(std::max(available, pos) + chunkLength, data.size());
+            const std::uint8_t* iter = &data[pos];
+            scanner.scan(iter, available - pos);
+            pos = static_cast<std::size_t>(iter - data.data());
+            if (pos + 1U < available) {
+                found.push_back(pos);
+                ++pos;
+            }
+            else if ((available == data.size()) && (pos < data.size())) {
+                ++pos;
+            }
+        }
+
+        UBLOX_TEST_CHECK(found == expected);
+    }
+}
+
+}  // namespace
+
+int main()
+{
+    testEmpty();
+    testFind();
+    testFalseSyncChar();
+    testChunks();
+    return ublox::test::result();
+}
+
+
@@ -0,0 +1,117 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file
+/// @brief Contains common helpers of the tests and benchmarks.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <chrono>
+#include <vector>
+
+#include "ublox/MsgId.h"
+#include "ublox/details/FrameWriter.h"
+
+/// @brief Check the condition, report and record the failure.
+#define UBLOX_TEST_CHECK(cond_) \
+    ublox::test::check((cond_), #cond_, __FILE__, __LINE__)
+
+namespace ublox
+{
+
+namespace test
+{
+
+/// @brief Number of failed checks.
+inline std::size_t& failureCount()
+{
+    static std::size_t Count = 0U;
+    return Count;
+}
+
+/// @brief Check the condition, used by @ref UBLOX_TEST_CHECK.
+inline bool check(bool cond, const char* expr, const char* file, int line)
+{
+    if (!cond) {
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+        ++failureCount();
+    }
+    return cond;
+}
+
+/// @brief Exit code of the test.
+inline int result()
+{
+    if (failureCount() != 0U) {
+        std::fprintf(stderr, "%zu check(s) failed\n", failureCount());
+        return 1;
+    }
+
+    std::printf("OK\n");
+    return 0;
+}
+
+/// @brief Append the frame with provided ID and payload.
+inline void appendFrame(
+    std::vector<std::uint8_t>& out,
+    MsgId id,
+    const std::vector<std::uint8_t>& payload)
+{
+    std::vector<std::uint8_t> frame;
+    details::writeFrame(id, payload.data(), payload.size(), frame);
+    out.insert(out.end(), frame.begin(), frame.end());
+}
+
+/// @brief Write little endian value into the buffer.
+template <typename T>
+void putValue(std::vector<std::uint8_t>& buf, std::size_t offset, T value)
+{
+    for (std::size_t idx = 0U; idx < sizeof(T); ++idx) {
+        buf[offset + idx] = static_cast<std::uint8_t>(static_cast<std::uint64_t>(value) >> (8U * idx));
+    }
+}
+
+/// @brief Average duration of the single invocation of the function.
+/// @return Nanoseconds.
+template <typename TFunc>
+double measureNs(std::size_t iterations, TFunc&& func)
+{
+    typedef std::chrono::steady_clock Clock;
+    auto start = Clock::now();
+    for (std::size_t idx = 0U; idx < iterations; ++idx) {
+        func(idx);
+    }
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    return elapsed.count() / static_cast<double>(iterations);
+}
+
+/// @brief Prevent the compiler from optimising away the value.
+template <typename T>
+void consume(const T& value)
+{
+    static volatile std::uint64_t Sink = 0U;
+    Sink = Sink + static_cast<std::uint64_t>(value);
+}
+
+}  // namespace test
+
+}  // namespace ublox
+
+
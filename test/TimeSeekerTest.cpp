@@ -0,0 +1,280 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Compares the positions found by TimeSeeker using the binary search with
+// the ones found by the sequential scan of the whole capture, including
+// the capture with the stretch of frames without time longer than the
+// probe limit, and checks that the captures with decreasing time (or
+// with the frames found inside the payload of other frames) or without
+// any time anchor don't make the search leave the capture.
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "ublox/FrameView.h"
+#include "ublox/capture/FrameTime.h"
+#include "ublox/capture/TimeSeeker.h"
+#include "ublox/sim/Generator.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+typedef ublox::capture::GpsTime GpsTime;
+typedef ublox::capture::TimeSeeker TimeSeeker;
+
+static const std::size_t ProbeLimit = 4U * 1024U;
+static const std::uint16_t Week = 1890U;
+static const std::uint32_t EpochMs = 1000U;
+
+void appendEpochs(std::vector<std::uint8_t>& capture, std::uint32_t iTOW, std::size_t count)
+{
+    ublox::sim::GeneratorConfig config;
+    config.week = Week;
+    config.iTOW = iTOW;
+    config.measPeriodMs = EpochMs;
+    ublox::sim::Generator<> generator(config);
+    for (std::size_t idx = 0U; idx < count; ++idx) {
+        generator.epoch(capture);
+    }
+}
+
+// Frames without time
+void appendNotices(std::vector<std::uint8_t>& capture, std::size_t len)
+{
+    std::vector<std::uint8_t> payload(100U, 'x');
+    auto end = capture.size() + len;
+    while (capture.size() < end) {
+        ublox::test::appendFrame(capture, ublox::MsgId_INF_NOTICE, payload);
+    }
+}
+
+std::size_t seek(const std::vector<std::uint8_t>& capture, const GpsTime& time, std::size_t probeLimit)
+{
+    TimeSeeker seeker(capture.data(), capture.size(), probeLimit);
+    return seeker.seek(time);
+}
+
+// The probe limit exceeding the capture length results in sequential scan.
+std::size_t scan(const std::vector<std::uint8_t>& capture, const GpsTime& time)
+{
+    return seek(capture, time, capture.size() + 1U);
+}
+
+bool epochStart(const std::vector<std::uint8_t>& capture, std::size_t offset)
+{
+    if (capture.size() <= offset) {
+        return offset == capture.size();
+    }
+
+    ublox::FrameView frame;
+    const std::uint8_t* iter = capture.data() + offset;
+    return
+        (frame.read(iter, capture.size() - offset) == comms::ErrorStatus::Success) &&
+        ublox::capture::FrameTime::hasLeadingItow(frame.msgId());
+}
+
+void checkSeek(const std::vector<std::uint8_t>& capture, std::uint32_t iTOW)
+{
+    GpsTime times[] = {
+        GpsTime(Week, iTOW),
+        GpsTime(GpsTime::UnknownWeek, iTOW)
+    };
+
+    for (auto& time : times) {
+        auto expected = scan(capture, time);
+        UBLOX_TEST_CHECK(seek(capture, time, ProbeLimit) == expected);
+    }
+}
+
+void testMonotonic()
+{
+    static const std::size_t NumOfEpochs = 3000U;
+    static const std::uint32_t FirstTow = 100000U;
+
+    std::vector<std::uint8_t> capture;
+    appendEpochs(capture, FirstTow, NumOfEpochs);
+    UBLOX_TEST_CHECK((100U * ProbeLimit) < capture.size());
+
+    static const std::uint32_t Tows[] = {
+        0U,
+        FirstTow,
+        FirstTow + 1U,
+        FirstTow + (10U * EpochMs) + (EpochMs / 2U),
+        FirstTow + (1234U * EpochMs),
+        FirstTow + ((NumOfEpochs - 1U) * EpochMs),
+        FirstTow + (NumOfEpochs * EpochMs)
+    };
+
+    for (auto iTOW : Tows) {
+        checkSeek(capture, iTOW);
+    }
+
+    TimeSeeker seeker(capture.data(), capture.size(), ProbeLimit);
+    auto offset = seeker.seek(GpsTime(Week, FirstTow + (1234U * EpochMs)));
+    UBLOX_TEST_CHECK(epochStart(capture, offset));
+    UBLOX_TEST_CHECK(offset < capture.size());
+    UBLOX_TEST_CHECK(seeker.scannedCount() < (capture.size() / 10U));
+}
+
+// The probes in the middle of the gap don't find any anchor within the
+// limit, while the ones close to its end find the anchor beyond the upper
+// bound of the search range.
+void testGap()
+{
+    static const std::size_t NumOfEpochs = 1000U;
+    static const std::uint32_t SecondTow = NumOfEpochs * EpochMs;
+
+    std::vector<std::uint8_t> capture;
+    appendEpochs(capture, 0U, NumOfEpochs);
+    appendNotices(capture, 5U * ProbeLimit);
+    appendEpochs(capture, SecondTow, NumOfEpochs);
+
+    static const std::uint32_t Tows[] = {
+        SecondTow - EpochMs,
+        SecondTow - 1U,
+        SecondTow,
+        SecondTow + EpochMs,
+        SecondTow + (500U * EpochMs)
+    };
+
+    for (auto iTOW : Tows) {
+        checkSeek(capture, iTOW);
+    }
+}
+
+void testNonMonotonic()
+{
+    static const std::size_t NumOfEpochs = 1000U;
+    static const std::uint32_t FirstTow = 500000U;
+
+    std::vector<std::uint8_t> capture;
+    appendEpochs(capture, FirstTow, NumOfEpochs);
+    appendNotices(capture, 3U * ProbeLimit);
+    appendEpochs(capture, 0U, NumOfEpochs);
+    appendNotices(capture, 3U * ProbeLimit);
+    appendEpochs(capture, FirstTow / 2U, NumOfEpochs);
+
+    static const std::uint32_t Tows[] = {
+        0U,
+        FirstTow / 2U,
+        FirstTow,
+        FirstTow + (NumOfEpochs * EpochMs) / 2U,
+        FirstTow + (NumOfEpochs * EpochMs)
+    };
+
+    for (auto iTOW : Tows) {
+        GpsTime times[] = {
+            GpsTime(Week, iTOW),
+            GpsTime(GpsTime::UnknownWeek, iTOW)
+        };
+
+        for (auto& time : times) {
+            UBLOX_TEST_CHECK(epochStart(capture, seek(capture, time, ProbeLimit)));
+            TimeSeeker seeker(capture.data(), capture.size(), ProbeLimit);
+            auto range = seeker.window(time, GpsTime(time.week, time.iTOW + EpochMs));
+            UBLOX_TEST_CHECK(range.first <= range.second);
+            UBLOX_TEST_CHECK(range.second <= capture.size());
+        }
+    }
+}
+
+// INF-NOTICE frames with the NAV-PVT frame reporting much later time
+// embedded in the payload, which is found only by the probes starting
+// inside the notice. The scan starting before the notice skips it and
+// finds the next anchor with earlier time beyond the probe point.
+void testEmbedded()
+{
+    static const std::size_t NumOfEpochs = 300U;
+    static const std::uint32_t FakeTow = 600000000U;
+
+    std::vector<std::uint8_t> fake;
+    {
+        ublox::sim::GeneratorConfig config;
+        config.week = Week;
+        config.iTOW = FakeTow;
+        config.navSolRate = 0U;
+        config.navSvinfoRate = 0U;
+        ublox::sim::Generator<> generator(config);
+        generator.epoch(fake);
+    }
+
+    std::vector<std::uint8_t> filler(1000U, 'x');
+    std::vector<std::uint8_t> container(filler);
+    container.insert(container.end(), fake.begin(), fake.end());
+
+    std::vector<std::uint8_t> capture;
+    for (std::size_t idx = 0U; idx < NumOfEpochs; ++idx) {
+        ublox::test::appendFrame(capture, ublox::MsgId_INF_NOTICE, filler);
+        ublox::test::appendFrame(capture, ublox::MsgId_INF_NOTICE, container);
+        appendEpochs(capture, static_cast<std::uint32_t>(idx * EpochMs), 1U);
+    }
+
+    for (std::size_t probeLimit = 1024U; probeLimit <= ProbeLimit; probeLimit += 512U) {
+        for (std::uint32_t iTOW = 0U; iTOW <= (NumOfEpochs * EpochMs); iTOW += (EpochMs * 7U) + 1U) {
+            GpsTime times[] = {
+                GpsTime(Week, iTOW),
+                GpsTime(GpsTime::UnknownWeek, iTOW)
+            };
+
+            for (auto& time : times) {
+                UBLOX_TEST_CHECK(epochStart(capture, seek(capture, time, probeLimit)));
+            }
+        }
+    }
+}
+
+void testNoAnchors()
+{
+    std::vector<std::uint8_t> capture;
+    appendNotices(capture, 20U * ProbeLimit);
+
+    static const GpsTime Times[] = {
+        GpsTime(Week, 0U),
+        GpsTime(Week, 100000U),
+        GpsTime(GpsTime::UnknownWeek, 0U),
+        GpsTime(GpsTime::UnknownWeek, 100000U)
+    };
+
+    for (auto& time : Times) {
+        TimeSeeker seeker(capture.data(), capture.size(), ProbeLimit);
+        UBLOX_TEST_CHECK(seeker.seek(time) == capture.size());
+        auto range = seeker.window(time, GpsTime(time.week, time.iTOW + EpochMs));
+        UBLOX_TEST_CHECK(range.first == capture.size());
+        UBLOX_TEST_CHECK(range.second == capture.size());
+    }
+
+    std::vector<std::uint8_t> empty;
+    TimeSeeker seeker(empty.data(), empty.size(), ProbeLimit);
+    UBLOX_TEST_CHECK(seeker.seek(GpsTime(Week, 0U)) == 0U);
+}
+
+}  // namespace
+
+int main()
+{
+    testMonotonic();
+    testGap();
+    testNonMonotonic();
+    testEmbedded();
+    testNoAnchors();
+    return ublox::test::result();
+}
+
+
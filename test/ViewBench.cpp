@@ -0,0 +1,207 @@
+//
+// Copyright 2016 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Compares the cost per million frames of accessing the fields of NAV-PVT
+// and NAV-SVINFO payloads via the views with reading the message objects.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#include "ublox/message/NavPvt.h"
+#include "ublox/message/NavSvinfo.h"
+#include "ublox/view/NavPvtView.h"
+#include "ublox/view/NavSvinfoView.h"
+#include "ublox/sim/Generator.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+
+static const std::size_t NumOfFrames = 1000000U;
+static const std::size_t NumOfEpochs = 256U;
+static const std::size_t FrameHeaderLength = 6U;
+static const std::size_t FrameChecksumLength = 2U;
+
+struct Payload
+{
+    const std::uint8_t* data;
+    std::size_t len;
+};
+
+typedef std::vector<Payload> Payloads;
+
+void collectPayloads(
+    const std::vector<std::uint8_t>& stream,
+    Payloads& pvt,
+    Payloads& svinfo)
+{
+    std::size_t pos = 0U;
+    while (pos + FrameHeaderLength + FrameChecksumLength <= stream.size()) {
+        auto id = static_cast<ublox::MsgId>((stream[pos + 2] << 8) | stream[pos + 3]);
+        auto len = static_cast<std::size_t>(stream[pos + 4]) | (static_cast<std::size_t>(stream[pos + 5]) << 8);
+        Payload payload = {&stream[pos + FrameHeaderLength], len};
+        if (id == ublox::MsgId_NAV_PVT) {
+            pvt.push_back(payload);
+        }
+        else if (id == ublox::MsgId_NAV_SVINFO) {
+            svinfo.push_back(payload);
+        }
+        pos += FrameHeaderLength + len + FrameChecksumLength;
+    }
+}
+
+template <typename TFunc>
+std::uint64_t sumAll(const Payloads& payloads, double& msPerMillion, TFunc&& func)
+{
+    std::uint64_t sum = 0U;
+    auto ns = ublox::test::measureNs(NumOfFrames,
+        [&payloads, &sum, &func](std::size_t idx)
+        {
+            auto& payload = payloads[idx % payloads.size()];
+            sum += func(payload);
+        });
+    msPerMillion = ns; // nanoseconds per frame == milliseconds per million frames
+    ublox::test::consume(sum);
+    return sum;
+}
+
+void report(const char* name, double readMs, double viewMs)
+{
+    std::printf("%-10s read: %8.1f ms, view: %8.1f ms per million frames (x%.1f)\n",
+        name, readMs, viewMs, readMs / viewMs);
+}
+
+void benchNavPvt(const Payloads& payloads)
+{
+    typedef ublox::message::NavPvt<> Msg;
+
+    double readMs = 0.0;
+    Msg msg;
+    auto readSum = sumAll(payloads, readMs,
+        [&msg](const Payload& payload) -> std::uint64_t
+        {
+            auto iter = payload.data;
+            if (msg.read(iter, payload.len) != comms::ErrorStatus::Success) {
+                return 0U;
+            }
+
+            auto& fields = msg.fields();
+            return
+                static_cast<std::uint64_t>(std::get<Msg::FieldIdx_iTOW>(fields).value()) +
+                static_cast<std::uint64_t>(std::get<Msg::FieldIdx_fixType>(fields).value()) +
+                static_cast<std::uint64_t>(std::get<Msg::FieldIdx_numSV>(fields).value()) +
+                static_cast<std::uint32_t>(std::get<Msg::FieldIdx_lon>(fields).value()) +
+                static_cast<std::uint32_t>(std::get<Msg::FieldIdx_lat>(fields).value()) +
+                static_cast<std::uint32_t>(std::get<Msg::FieldIdx_hMSL>(fields).value());
+        });
+
+    double viewMs = 0.0;
+    ublox::view::NavPvtView view;
+    auto viewSum = sumAll(payloads, viewMs,
+        [&view](const Payload& payload) -> std::uint64_t
+        {
+            if (view.attach(payload.data, payload.len) != comms::ErrorStatus::Success) {
+                return 0U;
+            }
+
+            return
+                static_cast<std::uint64_t>(view.iTOW().value()) +
+                static_cast<std::uint64_t>(view.fixType().value()) +
+                static_cast<std::uint64_t>(view.numSV().value()) +
+                static_cast<std::uint32_t>(view.lon().value()) +
+                static_cast<std::uint32_t>(view.lat().value()) +
+                static_cast<std::uint32_t>(view.hMSL().value());
+        });
+
+    UBLOX_TEST_CHECK(readSum == viewSum);
+    report("NAV-PVT", readMs, viewMs);
+}
+
+void benchNavSvinfo(const Payloads& payloads)
+{
+    typedef ublox::message::NavSvinfo<> Msg;
+
+    double readMs = 0.0;
+    Msg msg;
+    auto readSum = sumAll(payloads, readMs,
+        [&msg](const Payload& payload) -> std::uint64_t
+        {
+            auto iter = payload.data;
+            if (msg.read(iter, payload.len) != comms::ErrorStatus::Success) {
+                return 0U;
+            }
+
+            std::uint64_t sum = 0U;
+            for (auto& block : std::get<Msg::FieldIdx_data>(msg.fields()).value()) {
+                auto& members = block.value();
+                sum += std::get<1>(members).value();
+                sum += std::get<4>(members).value();
+            }
+            return sum;
+        });
+
+    double viewMs = 0.0;
+    ublox::view::NavSvinfoView view;
+    auto viewSum = sumAll(payloads, viewMs,
+        [&view](const Payload& payload) -> std::uint64_t
+        {
+            if (view.attach(payload.data, payload.len) != comms::ErrorStatus::Success) {
+                return 0U;
+            }
+
+            std::uint64_t sum = 0U;
+            auto cursor = view.blocks();
+            while (cursor.next()) {
+                sum += cursor.block().svid().value();
+                sum += cursor.block().cno().value();
+            }
+            return sum;
+        });
+
+    UBLOX_TEST_CHECK(readSum == viewSum);
+    report("NAV-SVINFO", readMs, viewMs);
+}
+
+}  // namespace
+
+int main()
+{
+    ublox::sim::GeneratorConfig config;
+    config.channels = 32U;
+    config.navSolRate = 0U;
+
+    ublox::sim::Generator<> generator(config);
+    std::vector<std::uint8_t> stream;
+    for (std::size_t idx = 0U; idx < NumOfEpochs; ++idx) {
+        generator.epoch(stream);
+    }
+
+    Payloads pvt;
+    Payloads svinfo;
+    collectPayloads(stream, pvt, svinfo);
+    UBLOX_TEST_CHECK(pvt.size() == NumOfEpochs);
+    UBLOX_TEST_CHECK(svinfo.size() == NumOfEpochs);
+
+    benchNavPvt(pvt);
+    benchNavSvinfo(svinfo);
+    return ublox::test::result();
+}
+
+